@@ -0,0 +1,184 @@
+#include <algorithm>
+#include "AllocationTracker.h"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/*
+ * The replacements of the global operator new and delete. Every form of operator new is
+ * replaced so that none of them is counted twice or missed, and every form of operator delete
+ * so that memory from malloc() is only given to free().
+ */
+static void* allocate(std::size_t size)
+{
+    AllocationTracker::recordAllocation(size);
+
+    // malloc(0) may return nullptr, operator new must return a unique pointer.
+    void* memory = std::malloc(std::max<std::size_t>(size, 1));
+    while (memory == nullptr)
+    {
+        std::new_handler newHandler = std::get_new_handler();
+        if (newHandler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        newHandler();
+        memory = std::malloc(std::max<std::size_t>(size, 1));
+    }
+
+    return memory;
+}
+
+static void* allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    AllocationTracker::recordAllocation(size);
+
+    // aligned_alloc() needs a size that is a multiple of the alignment.
+    std::size_t alignmentBytes = static_cast<std::size_t>(alignment);
+    std::size_t alignedSize = (std::max<std::size_t>(size, 1) + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+    void* memory = std::aligned_alloc(alignmentBytes, alignedSize);
+    while (memory == nullptr)
+    {
+        std::new_handler newHandler = std::get_new_handler();
+        if (newHandler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        newHandler();
+        memory = std::aligned_alloc(alignmentBytes, alignedSize);
+    }
+
+    return memory;
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocateAligned(size, alignment);
+    }
+
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocateAligned(size, alignment);
+    }
+
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
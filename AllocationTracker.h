@@ -0,0 +1,50 @@
+#ifndef ALLOCATIONTRACKER_H_
+#define ALLOCATIONTRACKER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Counts the heap allocations of each thread. AllocationTracker.cpp replaces the global
+ * operator new and delete, every form of operator new adds to the counts of the allocating
+ * thread while tracking is enabled. When tracking is disabled an allocation only checks one
+ * flag. Memory allocated by C libraries with malloc() isn't counted.
+ *
+ * The counts are kept per thread without locks, a ProfileZone reads them when it opens and
+ * closes so the profile shows the allocations of each database call and of the zones within it.
+ */
+class AllocationTracker
+{
+public:
+    struct Counts
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    static void enable() { enabled.store(true, std::memory_order_relaxed); };
+    static void disable() { enabled.store(false, std::memory_order_relaxed); };
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); };
+
+/*
+ * The allocations of the calling thread since it started, while tracking was enabled.
+ */
+    static Counts getThreadCounts() { return threadCounts; };
+
+    static void recordAllocation(std::size_t bytes)
+    {
+        if (isEnabled())
+        {
+            ++threadCounts.allocations;
+            threadCounts.bytes += bytes;
+        }
+    };
+
+private:
+    inline static std::atomic<bool> enabled = false;
+    // Trivially constructed, so operator new can use it before anything else on the thread.
+    inline static thread_local Counts threadCounts{0, 0};
+};
+
+#endif // ALLOCATIONTRACKER_H_
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include "BatchReplanner.h"
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <memory>
+#include "ScheduleDbInterface.h"
+#include "ScheduleItemModel.h"
+#include "SchedulePlanner.h"
+#include <string>
+#include "TaskModel.h"
+#include "TaskScheduler.h"
+#include "UserModel.h"
+#include <vector>
+#include "WorkStealingPool.h"
+
+using PhaseClock = std::chrono::steady_clock;
+
+BatchReplanner::BatchReplanner(unsigned int workerCount)
+: pool{workerCount}
+{
+}
+
+bool BatchReplanner::replanUsers(const UserList& users, std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay)
+{
+    PhaseClock::time_point replanStart = PhaseClock::now();
+
+    phaseTimings = PhaseTimings();
+    plannedUserCount = 0;
+    failedUserIDs.clear();
+    errorMessages.clear();
+    pool.clearErrorMessages();
+
+    // Database interfaces are not thread safe, each worker gets its own.
+    workerStates.clear();
+    for (unsigned int workerIndex = 0; workerIndex < pool.getWorkerCount(); ++workerIndex)
+    {
+        workerStates.push_back(std::make_unique<WorkerState>());
+    }
+
+    for (auto user: users)
+    {
+        pool.submit([this, user, firstDay, lastDay](unsigned int workerIndex)
+            { replanUser(*workerStates[workerIndex], *user, firstDay, lastDay); });
+    }
+    pool.waitForAll();
+
+    // Write the partial batches that are left over, one job per worker state.
+    for (auto& state: workerStates)
+    {
+        pool.submit([this, workerState = state.get(), firstDay, lastDay](unsigned int)
+            { writePendingSchedules(*workerState, firstDay, lastDay); });
+    }
+    pool.waitForAll();
+
+    for (const auto& state: workerStates)
+    {
+        phaseTimings.load += state->timings.load;
+        phaseTimings.schedule += state->timings.schedule;
+        phaseTimings.write += state->timings.write;
+        plannedUserCount += state->plannedUserCount;
+        failedUserIDs.insert(failedUserIDs.end(), state->failedUserIDs.begin(), state->failedUserIDs.end());
+        errorMessages.append(state->errorMessages);
+    }
+    errorMessages.append(pool.getAllErrorMessages());
+    phaseTimings.elapsed = PhaseClock::now() - replanStart;
+
+    return errorMessages.empty();
+}
+
+/*
+ * Private methods.
+ */
+void BatchReplanner::replanUser(WorkerState& state, UserModel& user, std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay)
+{
+    PhaseClock::time_point loadStart = PhaseClock::now();
+
+    TaskList openTasks;
+    ScheduleItemList fixedItems;
+    bool loaded = state.loader.loadPlanningData(user, firstDay, lastDay, openTasks, fixedItems);
+
+    PhaseClock::time_point scheduleStart = PhaseClock::now();
+    state.timings.load += scheduleStart - loadStart;
+
+    if (!loaded)
+    {
+        state.failedUserIDs.push_back(user.getUserID());
+        state.errorMessages.append(std::format("In BatchReplanner::replanUser({}) : {}\n", user.getUserID(),
+            state.loader.getAllErrorMessages()));
+        return;
+    }
+
+    TaskScheduler scheduler(user);
+    TaskScheduler::ScheduleResult result = scheduler.schedule(openTasks, fixedItems, firstDay, lastDay);
+
+    state.pendingUserIDs.push_back(user.getUserID());
+    std::ranges::move(result.taskExecutionItems, std::back_inserter(state.pendingItems));
+    TaskScheduler::WorkingHours workingHours = scheduler.getWorkingHours();
+    for (auto workingDay: scheduler.getWorkingDays(firstDay, lastDay))
+    {
+        state.pendingDays.push_back({user.getUserID(), workingDay, workingHours.dayStart, workingHours.dayEnd});
+    }
+
+    state.timings.schedule += PhaseClock::now() - scheduleStart;
+
+    if (state.pendingUserIDs.size() >= UsersPerWriteBatch)
+    {
+        writePendingSchedules(state, firstDay, lastDay);
+    }
+}
+
+void BatchReplanner::writePendingSchedules(WorkerState& state, std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay)
+{
+    if (state.pendingUserIDs.empty())
+    {
+        return;
+    }
+
+    PhaseClock::time_point writeStart = PhaseClock::now();
+
+    if (state.scheduleDbInterface.replaceTaskExecutionItemsForUsers(state.pendingUserIDs, firstDay, lastDay,
+        state.pendingItems, state.pendingDays))
+    {
+        state.plannedUserCount += state.pendingUserIDs.size();
+    }
+    else
+    {
+        state.failedUserIDs.insert(state.failedUserIDs.end(), state.pendingUserIDs.begin(), state.pendingUserIDs.end());
+        state.errorMessages.append(state.scheduleDbInterface.getAllErrorMessages() + "\n");
+    }
+
+    state.pendingUserIDs.clear();
+    state.pendingItems.clear();
+    state.pendingDays.clear();
+
+    state.timings.write += PhaseClock::now() - writeStart;
+}
@@ -0,0 +1,73 @@
+#ifndef BATCHREPLANNER_H_
+#define BATCHREPLANNER_H_
+
+#include <chrono>
+#include <memory>
+#include "ScheduleDbInterface.h"
+#include "ScheduleItemModel.h"
+#include "SchedulePlanner.h"
+#include <string>
+#include "UserModel.h"
+#include <vector>
+#include "WorkStealingPool.h"
+
+/*
+ * Nightly replan of many users. Schedules are independent per user so users are spread over a
+ * work stealing pool, each worker loads the user's data through its own database interfaces,
+ * schedules it and collects the results. The collected schedules are written UsersPerWriteBatch
+ * users per transaction.
+ */
+class BatchReplanner
+{
+public:
+/*
+ * The load, schedule and write times are summed over all of the workers, elapsed is the wall
+ * clock time of the whole replan.
+ */
+    struct PhaseTimings
+    {
+        std::chrono::duration<double> load{0};
+        std::chrono::duration<double> schedule{0};
+        std::chrono::duration<double> write{0};
+        std::chrono::duration<double> elapsed{0};
+    };
+
+    explicit BatchReplanner(unsigned int workerCount = 0);
+    ~BatchReplanner() = default;
+    bool replanUsers(const UserList& users, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay);
+    unsigned int getWorkerCount() const { return pool.getWorkerCount(); };
+    PhaseTimings getPhaseTimings() const { return phaseTimings; };
+    std::size_t getPlannedUserCount() const { return plannedUserCount; };
+    std::vector<std::size_t> getFailedUserIDs() const { return failedUserIDs; };
+    std::string getAllErrorMessages() const { return errorMessages; };
+
+    static constexpr std::size_t UsersPerWriteBatch = 64;
+
+private:
+    struct WorkerState
+    {
+        SchedulePlanner loader;
+        ScheduleDbInterface scheduleDbInterface;
+        std::vector<std::size_t> pendingUserIDs;
+        ScheduleItemList pendingItems;
+        std::vector<ScheduleDbInterface::DayScheduleRow> pendingDays;
+        PhaseTimings timings;
+        std::size_t plannedUserCount = 0;
+        std::vector<std::size_t> failedUserIDs;
+        std::string errorMessages;
+    };
+
+    void replanUser(WorkerState& state, UserModel& user, std::chrono::year_month_day firstDay,
+        std::chrono::year_month_day lastDay);
+    void writePendingSchedules(WorkerState& state, std::chrono::year_month_day firstDay,
+        std::chrono::year_month_day lastDay);
+
+    WorkStealingPool pool;
+    std::vector<std::unique_ptr<WorkerState>> workerStates;
+    PhaseTimings phaseTimings;
+    std::size_t plannedUserCount = 0;
+    std::vector<std::size_t> failedUserIDs;
+    std::string errorMessages;
+};
+
+#endif // BATCHREPLANNER_H_
@@ -4,6 +4,10 @@
 #include "BoostDBInterfaceCore.h"
 #include <functional>
 #include <iostream>
+#include "Metrics.h"
+#include "Profiler.h"
+#include <string_view>
+#include <unordered_map>
 
 BoostDBInterfaceCore::BoostDBInterfaceCore()
 : errorMessages{""},
@@ -20,6 +24,7 @@ BoostDBInterfaceCore::BoostDBInterfaceCore()
  */
 NSBM::results BoostDBInterfaceCore::runQueryAsync(std::function<NSBA::awaitable<NSBM::results>(void)> queryFunc)
 {
+    ProfileZone zone("runQueryAsync");
     NSBM::results localResult;
     NSBA::io_context ctx;
 
@@ -43,6 +48,7 @@ NSBM::results BoostDBInterfaceCore::runQueryAsync(std::function<NSBA::awaitable<
 NSBM::results BoostDBInterfaceCore::runQueryAsync(
     std::function<NSBA::awaitable<NSBM::results>(std::size_t)> queryFunc, std::size_t id)
 {
+    ProfileZone zone("runQueryAsync");
     NSBM::results localResult;
     NSBA::io_context ctx;
 
@@ -64,3 +70,61 @@ NSBM::results BoostDBInterfaceCore::runQueryAsync(
 }
 
 
+
+/*
+ * Private methods.
+ * The bytes are those of the field values, strings and blobs by length and other values as 8.
+ * Counting the rows is cheap, the bytes are only added up when measureBytes is set.
+ */
+BoostDBInterfaceCore::ResultSize BoostDBInterfaceCore::measureResults(const NSBM::results& result, bool measureBytes)
+{
+    ResultSize resultSize;
+    if (!result.has_value())
+    {
+        return resultSize;
+    }
+
+    for (std::size_t resultSetIndex = 0; resultSetIndex < result.size(); ++resultSetIndex)
+    {
+        NSBM::rows_view rows = result.at(resultSetIndex).rows();
+        resultSize.rows += rows.size();
+        if (!measureBytes)
+        {
+            continue;
+        }
+        for (NSBM::row_view row: rows)
+        {
+            for (NSBM::field_view field: row)
+            {
+                resultSize.bytes += field.is_string()? field.get_string().size() :
+                    field.is_blob()? field.get_blob().size() : field.is_null()? 0 : 8;
+            }
+        }
+    }
+
+    return resultSize;
+}
+
+/*
+ * The function names are string literals, so each call site is looked up by pointer and the
+ * registry is only searched on the first call from a thread.
+ */
+void BoostDBInterfaceCore::countCall(const char* functionName)
+{
+    thread_local std::unordered_map<const char*, Metrics::Counter> callCounters;
+
+    auto callCounter = callCounters.find(functionName);
+    if (callCounter == callCounters.end())
+    {
+        // "TaskList TaskDbInterface::getAllTasks()" is labelled TaskDbInterface::getAllTasks.
+        std::string_view methodName(functionName);
+        methodName = methodName.substr(0, methodName.find('('));
+        if (std::size_t returnTypeEnd = methodName.rfind(' '); returnTypeEnd != std::string_view::npos)
+        {
+            methodName.remove_prefix(returnTypeEnd + 1);
+        }
+        callCounter = callCounters.emplace(functionName, Metrics::counter("planner_db_calls_total",
+            "Calls of the database interface methods.", {"method", methodName})).first;
+    }
+    callCounter->second.add();
+}
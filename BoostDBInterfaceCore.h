@@ -6,9 +6,20 @@
 #include <boost/mysql.hpp>
 #include <chrono>
 #include "CommandLineParser.h"
+#include "CompactDate.h"
+#include <cstdint>
 #include <functional>
+#include "Metrics.h"
+#include <optional>
+#include "Profiler.h"
+#include "QueryStatistics.h"
+#include <source_location>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace NSBA = boost::asio;
 namespace NSBM = boost::mysql;
@@ -19,9 +30,15 @@ public:
     BoostDBInterfaceCore();
     virtual ~BoostDBInterfaceCore() = default;
     std::string getAllErrorMessages() const { return errorMessages; };
+/*
+ * True when the last call ran its query and found no rows, which some calls also report with
+ * an error message. Only the calls that report it set it.
+ */
+    bool hasEmptyResult() const { return emptyResult; };
 
 protected:
     std::string errorMessages;
+    bool emptyResult = false;
 /*
  * Design decision. While putting the arguments for each select statement into a vector of std::any()
  * is not the most maintainable or safest way to program, it reduces the number of implementations of
@@ -31,12 +48,26 @@ protected:
  * this is necessary.
  */
     std::vector<std::any> selectStatementWhatArgs;
-    void prepareForRunQueryAsync()
+/*
+ * Every public method starts with ProfileZone callZone = prepareForRunQueryAsync(); the zone is
+ * named after the method and encloses the queries, decoding and hydration of the call, in the
+ * profile and in a trace, where they share the call's correlation ID.
+ */
+    [[nodiscard]] ProfileZone prepareForRunQueryAsync(std::source_location caller = std::source_location::current())
     {
         errorMessages.clear();
+        emptyResult = false;
         selectStatementWhatArgs.clear();
+        countCall(caller.function_name());
+        return ProfileZone(caller.function_name());
+    };
+    void appendErrorMessage(std::string newError)
+    {
+        static const Metrics::Counter errorCount = Metrics::counter("planner_db_errors_total",
+            "Errors reported by the database interfaces.");
+        errorCount.add();
+        errorMessages.append(newError);
     };
-    void appendErrorMessage(std::string newError) { errorMessages.append(newError); };
 
 /*
  * All calls to runQueryAsync should be implemented within try blocks.
@@ -47,6 +78,27 @@ protected:
  */
     NSBM::results runQueryAsync(std::function<NSBA::awaitable<NSBM::results>(std::size_t)>queryFunc, std::size_t id);
 
+/*
+ * Connecting and executing go through these so that their time is profiled under the call and
+ * recorded in QueryStatistics. The query only has to live until the co_await completes, as the
+ * temporaries of co_await coRoExecute(conn, NSBM::with_params(...), result) do.
+ */
+    NSBA::awaitable<void> coRoConnect(NSBM::any_connection& conn)
+    {
+        ProfileZone zone("connect");
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        co_await conn.async_connect(dbConnectionParameters);
+        QueryStatistics::recordConnect(std::chrono::steady_clock::now() - start);
+    };
+    template <typename Query>
+    static NSBA::awaitable<void> coRoExecute(NSBM::any_connection& conn, const Query& query, NSBM::results& result)
+    {
+        ProfileZone zone("execute");
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        co_await conn.async_execute(query, result);
+        recordQuery(conn, query, std::chrono::steady_clock::now() - start, result);
+    }
+
 /*
  * Date converters are located here because they will be used by multiple dependent classes.
  */
@@ -64,10 +116,112 @@ protected:
         std::chrono::year_month_day converted{year, month, day};
         return converted;
     };
+    static constexpr NSBM::date convertCompactDateToBoostMySQLDate(CompactDate source)
+    {
+        return source.hasValue()? NSBM::date(source.toSysDays()) : NSBM::date();
+    };
+    static constexpr CompactDate convertBoostMySQLDateToCompactDate(NSBM::date source)
+    {
+        return source.valid()?
+            CompactDate(static_cast<CompactDate::DayNumber>(source.get_time_point().time_since_epoch().count())) :
+            CompactDate();
+    };
+    NSBM::datetime convertChronoTimeToBoostMySQLDateTime(std::chrono::sys_time<std::chrono::minutes> source)
+    {
+        NSBM::datetime boostDateTime(std::chrono::time_point_cast<NSBM::datetime::time_point::duration>(source));
+        return boostDateTime;
+    };
+    std::chrono::sys_time<std::chrono::minutes> convertBoostMySQLDateTimeToChronoTime(NSBM::datetime source)
+    {
+        return std::chrono::time_point_cast<std::chrono::minutes>(source.as_time_point());
+    };
 
 protected:
     NSBM::connect_params dbConnectionParameters;
     bool verboseOutput;
+
+private:
+    struct ResultSize
+    {
+        std::uint64_t rows = 0;
+        std::uint64_t bytes = 0;
+    };
+
+/*
+ * Only single values are formatted into the slow query log, see QueryStatistics.
+ */
+    template <typename Parameter>
+    struct isLoggableParameter : std::bool_constant<std::is_arithmetic_v<Parameter> ||
+        std::is_convertible_v<const Parameter&, std::string_view> || std::is_same_v<Parameter, NSBM::date> ||
+        std::is_same_v<Parameter, NSBM::datetime>> {};
+    template <typename Parameter>
+    struct isLoggableParameter<std::optional<Parameter>> : isLoggableParameter<Parameter> {};
+
+    static ResultSize measureResults(const NSBM::results& result, bool measureBytes);
+/*
+ * Counts the call in planner_db_calls_total, labelled with the class and method name taken from
+ * the function name.
+ */
+    static void countCall(const char* functionName);
+    template <typename Query>
+    static void recordQuery(NSBM::any_connection& conn, const Query& query, std::chrono::nanoseconds executeTime,
+        const NSBM::results& result)
+    {
+        constexpr bool hasParameters = requires { query.query; query.args; };
+        std::string_view sql;
+        if constexpr (hasParameters)
+        {
+            sql = query.query.get();
+        }
+        else
+        {
+            sql = query;
+        }
+
+        bool isSlow = QueryStatistics::isSlow(executeTime);
+        ResultSize resultSize = measureResults(result, isSlow || QueryStatistics::isMeasuringResultBytes());
+        QueryStatistics::recordQuery(sql, executeTime, resultSize.rows, resultSize.bytes);
+        if (!isSlow)
+        {
+            return;
+        }
+
+        std::vector<std::string> parameters;
+        if constexpr (hasParameters)
+        {
+            parameters = formatParameters(conn, sql, query.args);
+        }
+        QueryStatistics::recordSlowQuery({std::chrono::system_clock::now(), std::string(sql), std::move(parameters),
+            executeTime, resultSize.rows, resultSize.bytes});
+    }
+    template <typename... Parameters>
+    static std::vector<std::string> formatParameters(NSBM::any_connection& conn, std::string_view sql,
+        const std::tuple<Parameters...>& parameters)
+    {
+        std::vector<bool> redacted = QueryStatistics::findRedactedParameters(sql, sizeof...(Parameters));
+        NSBM::format_options formatOptions = conn.format_opts().value();
+        std::vector<std::string> formatted;
+        formatted.reserve(sizeof...(Parameters));
+
+        auto formatParameter = [&]<typename Parameter>(const Parameter& parameter)
+        {
+            if (redacted[formatted.size()])
+            {
+                formatted.emplace_back(QueryStatistics::RedactedParameter);
+            }
+            else if constexpr (isLoggableParameter<std::remove_cvref_t<Parameter>>::value)
+            {
+                formatted.push_back(NSBM::format_sql(formatOptions, "{}", parameter));
+            }
+            else
+            {
+                formatted.emplace_back(QueryStatistics::OmittedParameter);
+            }
+        };
+        std::apply([&](const Parameters&... parameter) { (formatParameter(parameter), ...); }, parameters);
+
+        return formatted;
+    }
 };
 
 #endif // BOOSTMYSQLDBINTERFACECORE_H_
@@ -0,0 +1,74 @@
+#ifndef BOUNDEDQUEUE_H_
+#define BOUNDEDQUEUE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/*
+ * Multiple producer, multiple consumer queue with a fixed capacity. push() blocks while the
+ * queue is full, which slows producers down to the speed of the consumers and keeps the memory
+ * held by queued items bounded. After close() push() discards new items and pop() returns the
+ * remaining items, then std::nullopt.
+ */
+template <typename Item>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(std::size_t capacityIn) : capacity{capacityIn > 0? capacityIn : 1} {};
+    ~BoundedQueue() = default;
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool push(Item item)
+    {
+        std::unique_lock<std::mutex> queueLock(mutex);
+        notFull.wait(queueLock, [this]() { return closed || items.size() < capacity; });
+        if (closed)
+        {
+            return false;
+        }
+        items.push_back(std::move(item));
+        queueLock.unlock();
+        notEmpty.notify_one();
+        return true;
+    };
+
+    std::optional<Item> pop()
+    {
+        std::unique_lock<std::mutex> queueLock(mutex);
+        notEmpty.wait(queueLock, [this]() { return closed || !items.empty(); });
+        if (items.empty())
+        {
+            return std::nullopt;
+        }
+        std::optional<Item> item(std::move(items.front()));
+        items.pop_front();
+        queueLock.unlock();
+        notFull.notify_one();
+        return item;
+    };
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> queueLock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    };
+
+private:
+    const std::size_t capacity;
+    std::deque<Item> items;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+};
+
+#endif // BOUNDEDQUEUE_H_
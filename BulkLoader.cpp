@@ -0,0 +1,688 @@
+#include <algorithm>
+#include <array>
+#include <boost/asio.hpp>
+#include <boost/mysql.hpp>
+#include "BoostDBInterfaceCore.h"
+#include "BulkLoader.h"
+#include <charconv>
+#include "commonUtilities.h"
+#include "CSVImporter.h"
+#include "CSVParser.h"
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include "ImportHash.h"
+#include <optional>
+#include "Profiler.h"
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include "TaskModel.h"
+#include <type_traits>
+#include <unistd.h>
+#include "UserModel.h"
+#include <utility>
+#include <vector>
+
+/*
+ * Staging file fields are in the default format of LOAD DATA: tab separated, one row per line,
+ * backslash escapes and \N for NULL.
+ */
+static constexpr std::string_view NullField("\\N");
+
+struct RawField
+{
+    std::string_view text;
+};
+
+static void appendStagingField(std::string& text, RawField field)
+{
+    text.append(field.text);
+}
+
+static void appendStagingField(std::string& text, std::string_view field)
+{
+    for (char character: field)
+    {
+        switch (character)
+        {
+            case '\\': text.append("\\\\"); break;
+            case '\t': text.append("\\t"); break;
+            case '\n': text.append("\\n"); break;
+            case '\r': text.append("\\r"); break;
+            case '\0': text.append("\\0"); break;
+            default: text.push_back(character); break;
+        }
+    }
+}
+
+static void appendStagingField(std::string& text, bool field)
+{
+    text.push_back(field? '1' : '0');
+}
+
+template <typename Number>
+requires std::is_arithmetic_v<Number>
+static void appendStagingField(std::string& text, Number field)
+{
+    std::array<char, 32> buffer;
+    auto [numberEnd, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), field);
+    text.append(buffer.data(), numberEnd);
+}
+
+template <typename... Fields>
+static void appendStagingLine(std::string& text, const Fields&... fields)
+{
+    bool firstField = true;
+    ((text.append(firstField? "" : "\t"), appendStagingField(text, fields), firstField = false), ...);
+    text.push_back('\n');
+}
+
+static std::optional<NSBM::date> nullableDate(CompactDate date)
+{
+    return date.hasValue()? std::optional<NSBM::date>(NSBM::date(date.toSysDays())) : std::nullopt;
+}
+
+/*
+ * Collects the rows of one staging table and sends them StagingBatchSize at a time, either to
+ * the staging file or as one multi-row INSERT. The staging file is removed when the table
+ * goes out of scope.
+ */
+template <typename Row>
+class BulkLoader::StagingTable
+{
+public:
+    StagingTable(std::string_view tableNameIn, std::filesystem::path filePathIn)
+    : tableName{tableNameIn}, filePath{std::move(filePathIn)}
+    {
+        rows.reserve(StagingBatchSize);
+        if (!filePath.empty())
+        {
+            stagingFile.open(filePath, std::ios::binary | std::ios::trunc);
+            if (!stagingFile)
+            {
+                throw std::runtime_error(std::format("Can't create the staging file {}", filePath.string()));
+            }
+        }
+    };
+    ~StagingTable()
+    {
+        if (!filePath.empty())
+        {
+            stagingFile.close();
+            std::error_code ignored;
+            std::filesystem::remove(filePath, ignored);
+        }
+    };
+    StagingTable(const StagingTable&) = delete;
+    StagingTable& operator=(const StagingTable&) = delete;
+
+/*
+ * Returns true when a full batch is waiting for coRoFlush().
+ */
+    bool add(Row row)
+    {
+        rows.push_back(std::move(row));
+        ++rowCount;
+        return rows.size() >= StagingBatchSize;
+    };
+    std::size_t getRowCount() const { return rowCount; };
+
+    NSBA::awaitable<void> coRoFlush(NSBM::any_connection& conn)
+    {
+        if (rows.empty())
+        {
+            co_return;
+        }
+
+        if (filePath.empty())
+        {
+            NSBM::results result;
+            co_await coRoExecute(conn,
+                NSBM::with_params("INSERT INTO {0} VALUES {1}", NSBM::identifier(tableName),
+                    NSBM::sequence(std::span<const Row>(rows),
+                        [](const Row& row, NSBM::format_context_base& ctx)
+                        {
+                            row.formatSql(ctx);
+                        })),
+                result
+            );
+        }
+        else
+        {
+            text.clear();
+            for (const auto& row: rows)
+            {
+                row.appendText(text);
+            }
+            if (!stagingFile.write(text.data(), static_cast<std::streamsize>(text.size())))
+            {
+                throw std::runtime_error(std::format("Can't write the staging file {}", filePath.string()));
+            }
+        }
+        rows.clear();
+    };
+
+/*
+ * Sends the remaining rows, with a staging file the whole file is loaded now.
+ */
+    NSBA::awaitable<void> coRoLoad(NSBM::any_connection& conn)
+    {
+        co_await coRoFlush(conn);
+
+        if (!filePath.empty())
+        {
+            stagingFile.close();
+
+            NSBM::results result;
+            co_await coRoExecute(conn,
+                NSBM::with_params("LOAD DATA INFILE {0} INTO TABLE {1} CHARACTER SET utf8mb4"
+                    " FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\' LINES TERMINATED BY '\\n'",
+                    filePath.string(), NSBM::identifier(tableName)),
+                result
+            );
+        }
+    };
+
+private:
+    std::string tableName;
+    std::filesystem::path filePath;
+    std::ofstream stagingFile;
+    std::vector<Row> rows;
+    std::size_t rowCount = 0;
+    std::string text;
+};
+
+BulkLoader::BulkLoader()
+: BoostDBInterfaceCore()
+{
+}
+
+bool BulkLoader::loadUsers(const std::string& fileName)
+{
+    ProfileZone callZone = startLoad(fileName);
+
+    CSVParser input(fileName);
+    if (!input.isOpen())
+    {
+        appendErrorMessage(input.getAllErrorMessages());
+        return false;
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoLoadUsers(input),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In BulkLoader::loadUsers({}) : {}", fileName, e.what()));
+    }
+
+    if (input.hasReadError())
+    {
+        appendErrorMessage(input.getAllErrorMessages());
+    }
+
+    return errorMessages.empty();
+}
+
+bool BulkLoader::loadTasks(const std::string& fileName, UserModel_shp owner)
+{
+    ProfileZone callZone = startLoad(fileName);
+
+    if (!owner || !owner->isInDataBase())
+    {
+        appendErrorMessage(std::format("In BulkLoader::loadTasks({}) : the owner must be a user in the database", fileName));
+        return false;
+    }
+
+    CSVParser input(fileName);
+    if (!input.isOpen())
+    {
+        appendErrorMessage(input.getAllErrorMessages());
+        return false;
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoLoadTasks(input, owner),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In BulkLoader::loadTasks({}) : {}", fileName, e.what()));
+    }
+
+    if (input.hasReadError())
+    {
+        appendErrorMessage(input.getAllErrorMessages());
+    }
+
+    return errorMessages.empty();
+}
+
+/*
+ * Staging row formats, the order of the fields is the order of the columns of the staging tables.
+ */
+void BulkLoader::TaskStagingRow::formatSql(NSBM::format_context_base& ctx) const
+{
+    NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})",
+        recordNumber, lineNumber, description, status, percentageComplete, nullableDate(createdOn),
+        nullableDate(requiredDelivery), nullableDate(scheduledStart), nullableDate(actualStart),
+        nullableDate(estimatedCompletion), nullableDate(completed), estimatedEffortHours, actualEffortHours,
+        schedulePriorityGroup, priorityInGroup, personal, importKeyHash, contentHash);
+}
+
+void BulkLoader::TaskStagingRow::appendText(std::string& text) const
+{
+    const std::array<CompactDate, 6> dates = {createdOn, requiredDelivery, scheduledStart, actualStart,
+        estimatedCompletion, completed};
+    std::array<CompactDate::DayNumber, dates.size()> days;
+    std::ranges::transform(dates, days.begin(), &CompactDate::getDayNumber);
+    std::array<char, dates.size() * ISODateLength> dateText;
+    formatISODates(days, dateText);
+
+    auto dateField = [&dates, &dateText](std::size_t dateIndex)
+    {
+        return RawField{dates[dateIndex].hasValue()?
+            std::string_view(dateText.data() + dateIndex * ISODateLength, ISODateLength) : NullField};
+    };
+
+    appendStagingLine(text, recordNumber, lineNumber, std::string_view(description), status, percentageComplete,
+        dateField(0), dateField(1), dateField(2), dateField(3), dateField(4), dateField(5), estimatedEffortHours,
+        actualEffortHours, schedulePriorityGroup, priorityInGroup, personal, importKeyHash, contentHash);
+}
+
+void BulkLoader::TaskReferenceRow::formatSql(NSBM::format_context_base& ctx) const
+{
+    NSBM::format_sql_to(ctx, "({}, {})", recordNumber, referencedRecordNumber);
+}
+
+void BulkLoader::TaskReferenceRow::appendText(std::string& text) const
+{
+    appendStagingLine(text, recordNumber, referencedRecordNumber);
+}
+
+void BulkLoader::UserStagingRow::formatSql(NSBM::format_context_base& ctx) const
+{
+    NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})",
+        recordNumber, lineNumber, lastName, firstName, middleInitial, email, loginName, password, scheduleDayStart,
+        scheduleDayEnd, includePriorityInSchedule, includeMinorPriorityInSchedule, useLettersForMajorPriority,
+        separatePriorityWithDot, contentHash);
+}
+
+void BulkLoader::UserStagingRow::appendText(std::string& text) const
+{
+    appendStagingLine(text, recordNumber, lineNumber, std::string_view(lastName), std::string_view(firstName),
+        std::string_view(middleInitial), std::string_view(email), std::string_view(loginName),
+        std::string_view(password), std::string_view(scheduleDayStart), std::string_view(scheduleDayEnd),
+        includePriorityInSchedule, includeMinorPriorityInSchedule, useLettersForMajorPriority, separatePriorityWithDot,
+        contentHash);
+}
+
+/*
+ * Private methods.
+ */
+NSBA::awaitable<NSBM::results> BulkLoader::coRoLoadUsers(CSVParser& input)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn,
+        "CREATE TEMPORARY TABLE UserImportStaging (RecordNumber INT UNSIGNED NOT NULL, LineNumber INT UNSIGNED NOT NULL, "
+        "LastName VARCHAR(45) NOT NULL, FirstName VARCHAR(45) NOT NULL, MiddleInitial VARCHAR(45), "
+        "EmailAddress VARCHAR(256), LoginName VARCHAR(45) NOT NULL, HashedPassWord TINYTEXT, "
+        "ScheduleDayStart VARCHAR(45) NOT NULL, ScheduleDayEnd VARCHAR(45) NOT NULL, IncludePriorityInSchedule BOOLEAN, "
+        "IncludeMinorPriorityInSchedule BOOLEAN, UseLettersForMajorPriority BOOLEAN, SeparatePriorityWithDot BOOLEAN, "
+        "ContentHash BIGINT UNSIGNED NOT NULL, PRIMARY KEY (RecordNumber))",
+        result
+    );
+
+    {
+        StagingTable<UserStagingRow> userStaging("UserImportStaging", stagingFilePath("UserImportStaging"));
+        CSVRecord record;
+
+        while (input.readNextRecord(record))
+        {
+            std::size_t recordNumber = ++recordCount;
+            if (record.hasFormatError())
+            {
+                addRecordError(record.getLineNumber(), "malformed quoted field");
+                continue;
+            }
+
+            std::string error;
+            UserModel_shp user = CSVImporter::userFromRecord(record, error);
+            if (!user)
+            {
+                addRecordError(record.getLineNumber(), error);
+                continue;
+            }
+
+            if (userStaging.add({recordNumber, record.getLineNumber(), user->getLastName(), user->getFirstName(),
+                user->getMiddleInitial(), user->getEmail(), user->getLoginName(), user->getPassword(),
+                user->getStartTime(), user->getEndTime(), user->isPriorityInSchedule(),
+                user->isMinorPriorityInSchedule(), user->isUsingLettersForMaorPriority(),
+                user->isSeparatingPriorityWithDot(), CSVImporter::contentHash(record)}))
+            {
+                co_await userStaging.coRoFlush(conn);
+            }
+        }
+
+        co_await userStaging.coRoLoad(conn);
+    }
+
+    co_await coRoExecute(conn,
+        "SELECT LineNumber, LoginName FROM UserImportStaging WHERE "
+        "EXISTS (SELECT 1 FROM UserProfile WHERE UserProfile.LoginName = UserImportStaging.LoginName) OR "
+        "EXISTS (SELECT 1 FROM UserProfile WHERE UserProfile.LastName = UserImportStaging.LastName AND "
+        "UserProfile.FirstName = UserImportStaging.FirstName AND UserProfile.MiddleInitial = UserImportStaging.MiddleInitial) "
+        "ORDER BY RecordNumber",
+        result
+    );
+    for (auto row: result.rows())
+    {
+        addRecordError(row.at(0).as_uint64(), std::format("user {} already exists", row.at(1).as_string()));
+    }
+
+    // Of the records that aren't in UserProfile yet only the first with each login name and each full name
+    // is loaded. The unique index on the full name doesn't treat NULL middle initials as equal.
+    co_await coRoExecute(conn,
+        "CREATE TEMPORARY TABLE UserImportDuplicates (PRIMARY KEY (RecordNumber)) "
+        "SELECT RecordNumber, LineNumber, LoginName FROM (SELECT RecordNumber, LineNumber, LoginName, MiddleInitial, "
+        "ROW_NUMBER() OVER (PARTITION BY LoginName ORDER BY RecordNumber) AS LoginRank, "
+        "ROW_NUMBER() OVER (PARTITION BY LastName, FirstName, MiddleInitial ORDER BY RecordNumber) AS NameRank "
+        "FROM UserImportStaging WHERE "
+        "NOT EXISTS (SELECT 1 FROM UserProfile WHERE UserProfile.LoginName = UserImportStaging.LoginName) AND "
+        "NOT EXISTS (SELECT 1 FROM UserProfile WHERE UserProfile.LastName = UserImportStaging.LastName AND "
+        "UserProfile.FirstName = UserImportStaging.FirstName AND UserProfile.MiddleInitial = UserImportStaging.MiddleInitial)"
+        ") AS RankedRecords WHERE LoginRank > 1 OR (NameRank > 1 AND MiddleInitial IS NOT NULL)",
+        result
+    );
+    co_await coRoExecute(conn, "SELECT LineNumber, LoginName FROM UserImportDuplicates ORDER BY RecordNumber", result);
+    for (auto row: result.rows())
+    {
+        addRecordError(row.at(0).as_uint64(), std::format("user {} has the login name or full name of an earlier "
+            "record", row.at(1).as_string()));
+    }
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+    co_await coRoExecute(conn,
+        "INSERT INTO UserProfile (LastName, FirstName, MiddleInitial, EmailAddress, LoginName, HashedPassWord, "
+        "ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
+        "UseLettersForMajorPriority, SeparatePriorityWithDot, ContentHash) "
+        "SELECT LastName, FirstName, MiddleInitial, EmailAddress, UserImportStaging.LoginName, HashedPassWord, "
+        "ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
+        "UseLettersForMajorPriority, SeparatePriorityWithDot, ContentHash FROM UserImportStaging "
+        "LEFT JOIN UserImportDuplicates ON UserImportDuplicates.RecordNumber = UserImportStaging.RecordNumber "
+        "WHERE UserImportDuplicates.RecordNumber IS NULL AND "
+        "NOT EXISTS (SELECT 1 FROM UserProfile WHERE UserProfile.LoginName = UserImportStaging.LoginName) AND "
+        "NOT EXISTS (SELECT 1 FROM UserProfile WHERE UserProfile.LastName = UserImportStaging.LastName AND "
+        "UserProfile.FirstName = UserImportStaging.FirstName AND UserProfile.MiddleInitial = UserImportStaging.MiddleInitial) "
+        "ORDER BY UserImportStaging.RecordNumber",
+        result
+    );
+    loadedCount = result.affected_rows();
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+/*
+ * The TaskIDs are the highest existing TaskID plus the record number, records that fail
+ * validation leave unused IDs. Parents and dependencies are staged by record number and
+ * converted to TaskIDs by the merge statements.
+ */
+NSBA::awaitable<NSBM::results> BulkLoader::coRoLoadTasks(CSVParser& input, UserModel_shp owner)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn,
+        "CREATE TEMPORARY TABLE TaskImportStaging (RecordNumber INT UNSIGNED NOT NULL, LineNumber INT UNSIGNED NOT NULL, "
+        "Description VARCHAR(256) NOT NULL, Status INT UNSIGNED, PercentageComplete DOUBLE NOT NULL, "
+        "CreatedOn DATE NOT NULL, RequiredDelivery DATE NOT NULL, ScheduledStart DATE NOT NULL, ActualStart DATE, "
+        "EstimatedCompletion DATE, Completed DATE, EstimatedEffortHours INT UNSIGNED NOT NULL, "
+        "ActualEffortHours DOUBLE NOT NULL, SchedulePriorityGroup INT UNSIGNED NOT NULL, "
+        "PriorityInGroup INT UNSIGNED NOT NULL, Personal BOOLEAN, ImportKeyHash BIGINT UNSIGNED NOT NULL, "
+        "ContentHash BIGINT UNSIGNED NOT NULL, PRIMARY KEY (RecordNumber))",
+        result
+    );
+    co_await coRoExecute(conn,
+        "CREATE TEMPORARY TABLE TaskParentImportStaging (RecordNumber INT UNSIGNED NOT NULL, "
+        "ParentRecord INT UNSIGNED NOT NULL, PRIMARY KEY (RecordNumber))",
+        result
+    );
+    co_await coRoExecute(conn,
+        "CREATE TEMPORARY TABLE TaskDependencyImportStaging (RecordNumber INT UNSIGNED NOT NULL, "
+        "DependencyRecord INT UNSIGNED NOT NULL, PRIMARY KEY (RecordNumber, DependencyRecord))",
+        result
+    );
+
+    {
+        StagingTable<TaskStagingRow> taskStaging("TaskImportStaging", stagingFilePath("TaskImportStaging"));
+        StagingTable<TaskReferenceRow> parentStaging("TaskParentImportStaging", stagingFilePath("TaskParentImportStaging"));
+        StagingTable<TaskReferenceRow> dependencyStaging("TaskDependencyImportStaging",
+            stagingFilePath("TaskDependencyImportStaging"));
+        std::vector<ForwardReference> forwardReferences;
+        CSVRecord record;
+
+        // Record numbers start at 1.
+        stagedRecords.assign(1, false);
+        while (input.readNextRecord(record))
+        {
+            std::size_t recordNumber = ++recordCount;
+            std::size_t lineNumber = record.getLineNumber();
+            stagedRecords.push_back(false);
+            if (record.hasFormatError())
+            {
+                addRecordError(lineNumber, "malformed quoted field");
+                continue;
+            }
+
+            CSVImporter::RecordReferences references;
+            std::string error;
+            TaskModel_shp task = CSVImporter::taskFromRecord(record, owner, references, error);
+            if (!task)
+            {
+                addRecordError(lineNumber, error);
+                continue;
+            }
+
+            stagedRecords[recordNumber] = true;
+            if (taskStaging.add({recordNumber, lineNumber, task->getDescription(), task->getStatusIntVal(),
+                task->getPercentageComplete(), task->getCompactCreationDate(), task->getCompactDueDate(),
+                task->getCompactScheduledStart(), task->getCompactActualStartDate(),
+                task->getCompactEstimatedCompletion(), task->getCompactCompletionDate(), task->getEstimatedEffort(),
+                task->getactualEffortToDate(), task->getPriorityGroup(), task->getPriority(), task->isPersonal(),
+                taskImportKey(task->getDescription()), CSVImporter::contentHash(record)}))
+            {
+                co_await taskStaging.coRoFlush(conn);
+            }
+
+            if (references.parentRecordNumber > recordNumber)
+            {
+                forwardReferences.push_back({recordNumber, references.parentRecordNumber, lineNumber, true});
+            }
+            else if (references.parentRecordNumber > 0 &&
+                isValidReference(recordNumber, references.parentRecordNumber, lineNumber, true))
+            {
+                if (parentStaging.add({recordNumber, references.parentRecordNumber}))
+                {
+                    co_await parentStaging.coRoFlush(conn);
+                }
+            }
+
+            std::ranges::sort(references.dependencyRecordNumbers);
+            auto [duplicatesStart, duplicatesEnd] = std::ranges::unique(references.dependencyRecordNumbers);
+            references.dependencyRecordNumbers.erase(duplicatesStart, duplicatesEnd);
+            for (std::size_t dependencyRecordNumber: references.dependencyRecordNumbers)
+            {
+                if (dependencyRecordNumber > recordNumber)
+                {
+                    forwardReferences.push_back({recordNumber, dependencyRecordNumber, lineNumber, false});
+                }
+                else if (isValidReference(recordNumber, dependencyRecordNumber, lineNumber, false))
+                {
+                    if (dependencyStaging.add({recordNumber, dependencyRecordNumber}))
+                    {
+                        co_await dependencyStaging.coRoFlush(conn);
+                    }
+                }
+            }
+        }
+
+        for (const auto& reference: forwardReferences)
+        {
+            if (!isValidReference(reference.recordNumber, reference.referencedRecordNumber, reference.lineNumber,
+                reference.isParent))
+            {
+                continue;
+            }
+
+            StagingTable<TaskReferenceRow>& referenceStaging = reference.isParent? parentStaging : dependencyStaging;
+            if (referenceStaging.add({reference.recordNumber, reference.referencedRecordNumber}))
+            {
+                co_await referenceStaging.coRoFlush(conn);
+            }
+        }
+
+        co_await taskStaging.coRoLoad(conn);
+        co_await parentStaging.coRoLoad(conn);
+        co_await dependencyStaging.coRoLoad(conn);
+    }
+
+    // Temporary tables don't need to be locked. The locks are released after the COMMIT.
+    co_await coRoExecute(conn, "SET autocommit = 0", result);
+    co_await coRoExecute(conn, "LOCK TABLES Tasks WRITE, TaskDependencies WRITE, UserProfile READ", result);
+
+    co_await coRoExecute(conn, "SELECT CAST(COALESCE(MAX(TaskID), 0) AS UNSIGNED) FROM Tasks", result);
+    std::uint64_t taskIDBase = result.rows().at(0).at(0).as_uint64();
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("INSERT INTO Tasks (TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, "
+            "PercentageComplete, CreatedOn, RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, "
+            "EstimatedEffortHours, ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount, "
+            "ImportKeyHash, ContentHash) "
+            "SELECT {0} + RecordNumber, {1}, {2}, Description, NULL, Status, PercentageComplete, CreatedOn, "
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, 0, ImportKeyHash, ContentHash "
+            "FROM TaskImportStaging",
+            taskIDBase, owner->getUserID(), owner->getUserID()),
+        result
+    );
+    loadedCount = result.affected_rows();
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("UPDATE Tasks JOIN TaskParentImportStaging ON Tasks.TaskID = {0} + TaskParentImportStaging.RecordNumber "
+            "SET Tasks.ParentTask = {0} + TaskParentImportStaging.ParentRecord", taskIDBase),
+        result
+    );
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("INSERT INTO TaskDependencies (TaskID, Dependency) "
+            "SELECT {0} + RecordNumber, {0} + DependencyRecord FROM TaskDependencyImportStaging", taskIDBase),
+        result
+    );
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("UPDATE Tasks JOIN (SELECT RecordNumber, COUNT(*) AS Dependencies FROM TaskDependencyImportStaging "
+            "GROUP BY RecordNumber) AS DependencyCounts ON Tasks.TaskID = {0} + DependencyCounts.RecordNumber "
+            "SET Tasks.DependencyCount = DependencyCounts.Dependencies", taskIDBase),
+        result
+    );
+
+    co_await coRoExecute(conn, "COMMIT", result);
+    co_await coRoExecute(conn, "UNLOCK TABLES", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+/*
+ * Only references to records that were staged are kept, the merge could not resolve the others.
+ */
+bool BulkLoader::isValidReference(std::size_t recordNumber, std::size_t referencedRecordNumber, std::size_t lineNumber,
+    bool isParent)
+{
+    if (referencedRecordNumber == recordNumber)
+    {
+        addRecordError(lineNumber, isParent? "a task can't be its own parent" : "a task can't depend on itself");
+        return false;
+    }
+
+    if (referencedRecordNumber >= stagedRecords.size() || !stagedRecords[referencedRecordNumber])
+    {
+        addRecordError(lineNumber, std::format("{} record {} was not imported", isParent? "parent task" : "dependency",
+            referencedRecordNumber));
+        return false;
+    }
+
+    return true;
+}
+
+std::filesystem::path BulkLoader::stagingFilePath(std::string_view tableName) const
+{
+    if (stagingDirectory.empty())
+    {
+        return {};
+    }
+
+    // The process ID keeps concurrent loads into the same directory apart.
+    return std::filesystem::absolute(stagingDirectory) / std::format("{}_{}.tsv", tableName, getpid());
+}
+
+ProfileZone BulkLoader::startLoad(const std::string& fileName, std::source_location caller)
+{
+    loadFileName = fileName;
+    recordCount = 0;
+    loadedCount = 0;
+    stagedRecords.clear();
+    return prepareForRunQueryAsync(caller);
+}
+
+void BulkLoader::addRecordError(std::size_t lineNumber, std::string_view message)
+{
+    appendErrorMessage(std::format("{} line {}: {}\n", loadFileName, lineNumber, message));
+}
@@ -0,0 +1,143 @@
+#ifndef BULKLOADER_H_
+#define BULKLOADER_H_
+
+#include "BoostDBInterfaceCore.h"
+#include "CompactDate.h"
+#include <cstddef>
+#include <cstdint>
+#include "CSVParser.h"
+#include <filesystem>
+#include "Profiler.h"
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "UserModel.h"
+
+/*
+ * Bulk loader for initial loads and migrations of the user and task CSV files, an alternative
+ * to CSVImporter when the files have millions of records. The records are validated and
+ * normalized by the same code as CSVImporter, priority letters, status labels and the accepted
+ * date formats become the values stored in the database. The normalized rows are staged in
+ * temporary tables on one connection and merged into UserProfile, Tasks and TaskDependencies
+ * with a few set-based statements, no per-row statements are sent. The rows are stored with the
+ * same ImportHash as CSVImporter stores, so the files can later be synchronized with
+ * CSVImporter::syncUsers() and CSVImporter::syncTasks().
+ *
+ * When a staging directory is set the rows are written to files there and loaded with
+ * LOAD DATA INFILE. The directory must be readable by the MySQL server (secure_file_priv) and
+ * the MySQL user needs the FILE privilege. Without a staging directory the rows are sent to the
+ * staging tables as multi-row INSERT statements.
+ */
+class BulkLoader : public BoostDBInterfaceCore
+{
+public:
+    BulkLoader();
+    ~BulkLoader() = default;
+
+    void setStagingDirectory(std::string directory) { stagingDirectory = directory; };
+/*
+ * Users that already exist, by login name or full name, are reported and skipped, as are
+ * records with the login name or full name of an earlier record of the file.
+ */
+    bool loadUsers(const std::string& fileName);
+/*
+ * The tasks are created by and assigned to the owner. All of the tasks are merged in one
+ * transaction while Tasks and TaskDependencies are locked, the TaskIDs are allocated as one
+ * range so that parents and dependencies can be set from their record numbers in SQL.
+ */
+    bool loadTasks(const std::string& fileName, UserModel_shp owner);
+    std::size_t getRecordCount() const { return recordCount; };
+    std::size_t getLoadedCount() const { return loadedCount; };
+
+    static constexpr std::size_t StagingBatchSize = 5000;
+
+private:
+    struct TaskStagingRow
+    {
+        std::size_t recordNumber;
+        std::size_t lineNumber;
+        std::string description;
+        unsigned int status;
+        double percentageComplete;
+        CompactDate createdOn;
+        CompactDate requiredDelivery;
+        CompactDate scheduledStart;
+        CompactDate actualStart;
+        CompactDate estimatedCompletion;
+        CompactDate completed;
+        unsigned int estimatedEffortHours;
+        double actualEffortHours;
+        unsigned int schedulePriorityGroup;
+        unsigned int priorityInGroup;
+        bool personal;
+        std::uint64_t importKeyHash;
+        std::uint64_t contentHash;
+
+        void formatSql(NSBM::format_context_base& ctx) const;
+        void appendText(std::string& text) const;
+    };
+
+    struct TaskReferenceRow
+    {
+        std::size_t recordNumber;
+        std::size_t referencedRecordNumber;
+
+        void formatSql(NSBM::format_context_base& ctx) const;
+        void appendText(std::string& text) const;
+    };
+
+    struct UserStagingRow
+    {
+        std::size_t recordNumber;
+        std::size_t lineNumber;
+        std::string lastName;
+        std::string firstName;
+        std::string middleInitial;
+        std::string email;
+        std::string loginName;
+        std::string password;
+        std::string scheduleDayStart;
+        std::string scheduleDayEnd;
+        bool includePriorityInSchedule;
+        bool includeMinorPriorityInSchedule;
+        bool useLettersForMajorPriority;
+        bool separatePriorityWithDot;
+        std::uint64_t contentHash;
+
+        void formatSql(NSBM::format_context_base& ctx) const;
+        void appendText(std::string& text) const;
+    };
+
+/*
+ * A reference to a record later in the file can only be checked after the whole file has been
+ * staged, these are kept until then.
+ */
+    struct ForwardReference
+    {
+        std::size_t recordNumber;
+        std::size_t referencedRecordNumber;
+        std::size_t lineNumber;
+        bool isParent;
+    };
+
+    template <typename Row>
+    class StagingTable;
+
+    NSBA::awaitable<NSBM::results> coRoLoadUsers(CSVParser& input);
+    NSBA::awaitable<NSBM::results> coRoLoadTasks(CSVParser& input, UserModel_shp owner);
+    bool isValidReference(std::size_t recordNumber, std::size_t referencedRecordNumber, std::size_t lineNumber,
+        bool isParent);
+    std::filesystem::path stagingFilePath(std::string_view tableName) const;
+    [[nodiscard]] ProfileZone startLoad(const std::string& fileName,
+        std::source_location caller = std::source_location::current());
+    void addRecordError(std::size_t lineNumber, std::string_view message);
+
+    std::string stagingDirectory;
+    std::string loadFileName;
+    std::size_t recordCount = 0;
+    std::size_t loadedCount = 0;
+    std::vector<bool> stagedRecords;
+};
+
+#endif // BULKLOADER_H_
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cstddef>
+#include "CSVChunker.h"
+#include <string_view>
+#include <vector>
+#include "WorkStealingPool.h"
+
+std::vector<CSVChunk> splitCSVIntoChunks(std::string_view text, std::size_t chunkSize, WorkStealingPool& pool)
+{
+    std::vector<CSVChunk> chunks;
+    if (text.empty())
+    {
+        return chunks;
+    }
+
+    std::size_t rangeCount = (text.size() + chunkSize - 1) / chunkSize;
+    std::vector<std::size_t> quoteCounts(rangeCount);
+    std::vector<std::size_t> lineFeedCounts(rangeCount);
+    for (std::size_t range = 0; range < rangeCount; ++range)
+    {
+        pool.submit([text, chunkSize, range, &quoteCounts, &lineFeedCounts](unsigned int)
+            {
+                std::string_view rangeText = text.substr(range * chunkSize, chunkSize);
+                quoteCounts[range] = static_cast<std::size_t>(std::ranges::count(rangeText, '"'));
+                lineFeedCounts[range] = static_cast<std::size_t>(std::ranges::count(rangeText, '\n'));
+            });
+    }
+    pool.waitForAll();
+
+    std::size_t chunkStart = 0;
+    std::size_t chunkFirstLine = 1;
+    std::size_t quotesBefore = 0;
+    std::size_t lineFeedsBefore = 0;
+    for (std::size_t range = 1; range < rangeCount; ++range)
+    {
+        quotesBefore += quoteCounts[range - 1];
+        lineFeedsBefore += lineFeedCounts[range - 1];
+
+        std::size_t position = range * chunkSize;
+        if (position < chunkStart)
+        {
+            // A quoted field ran past the start of this range, the previous boundary covers it.
+            continue;
+        }
+
+        bool insideQuotes = quotesBefore % 2 != 0;
+        std::size_t lineFeeds = lineFeedsBefore;
+        bool foundBoundary = false;
+        while (position < text.size() && !foundBoundary)
+        {
+            char character = text[position++];
+            if (character == '"')
+            {
+                insideQuotes = !insideQuotes;
+            }
+            else if (character == '\n')
+            {
+                ++lineFeeds;
+                foundBoundary = !insideQuotes;
+            }
+        }
+        if (!foundBoundary || position == text.size())
+        {
+            break;
+        }
+
+        chunks.push_back({chunkStart, position - chunkStart, chunkFirstLine});
+        chunkStart = position;
+        chunkFirstLine = lineFeeds + 1;
+    }
+    chunks.push_back({chunkStart, text.size() - chunkStart, chunkFirstLine});
+
+    return chunks;
+}
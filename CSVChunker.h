@@ -0,0 +1,28 @@
+#ifndef CSVCHUNKER_H_
+#define CSVCHUNKER_H_
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "WorkStealingPool.h"
+
+/*
+ * A piece of in-memory CSV text that starts and ends on record boundaries, so that it can be
+ * parsed on its own. firstLineNumber is the line number of its first line in the whole text.
+ */
+struct CSVChunk
+{
+    std::size_t offset;
+    std::size_t length;
+    std::size_t firstLineNumber;
+};
+
+/*
+ * Splits CSV text into chunks of about chunkSize bytes for parsing in parallel. Only the quotes
+ * and line feeds are counted in parallel on the pool, the boundaries are then found by scanning
+ * forward from each chunkSize offset to the first line feed outside of quotes. Quotes are
+ * assumed to only appear in quoted fields, as RFC 4180 requires.
+ */
+std::vector<CSVChunk> splitCSVIntoChunks(std::string_view text, std::size_t chunkSize, WorkStealingPool& pool);
+
+#endif // CSVCHUNKER_H_
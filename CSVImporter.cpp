@@ -0,0 +1,707 @@
+#include <algorithm>
+#include <array>
+#include "BoundedQueue.h"
+#include <charconv>
+#include "commonUtilities.h"
+#include <cstdint>
+#include "CSVChunker.h"
+#include "CSVImporter.h"
+#include "CSVParser.h"
+#include "DateParser.h"
+#include <exception>
+#include <format>
+#include "ImportHash.h"
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include "TaskDbInterface.h"
+#include "TaskModel.h"
+#include <thread>
+#include <utility>
+#include "UserDbInterface.h"
+#include "UserModel.h"
+#include <vector>
+
+static std::size_t getModelID(const UserModel& user) { return user.getUserID(); }
+static std::size_t getModelID(const TaskModel& task) { return task.getTaskID(); }
+static void setModelID(UserModel& user, std::size_t userID) { user.setUserID(userID); }
+static void setModelID(TaskModel& task, std::size_t taskID) { task.setTaskID(taskID); }
+static std::uint64_t getImportKey(const UserModel& user)
+{
+    return userImportKey(user.getLastName(), user.getFirstName(), user.getMiddleInitial());
+}
+static std::uint64_t getImportKey(const TaskModel& task) { return taskImportKey(task.getDescription()); }
+
+/*
+ * The whole field must be a number, std::stoi() would accept trailing text.
+ */
+template <typename Number>
+static bool parseNumber(std::string_view field, Number& value)
+{
+    const char* fieldEnd = field.data() + field.size();
+    auto [numberEnd, error] = std::from_chars(field.data(), fieldEnd, value);
+    return error == std::errc() && numberEnd == fieldEnd;
+}
+
+/*
+ * The date fields of a task record, in the order of the date parsers of taskFromRecord().
+ */
+struct TaskDateField
+{
+    std::size_t fieldIndex;
+    std::string_view name;
+    bool required;
+};
+
+enum TaskDateIndex
+{
+    RequiredDeliveryDate, ScheduledStartDate, ActualStartDate, CreatedOnDate, EstimatedCompletionDate
+};
+
+static constexpr std::array<TaskDateField, 5> taskDateFields = {{
+    {3, "RequiredDelivery", true},
+    {8, "ScheduledStart", false},
+    {9, "ActualStart", false},
+    {10, "CreatedOn", false},
+    {12, "EstimatedCompletion", false}
+}};
+
+static bool parseDependencies(std::string_view field, std::vector<std::size_t>& dependencyRecordNumbers)
+{
+    constexpr std::string_view separators(" ;");
+
+    std::size_t position = field.find_first_not_of(separators);
+    while (position != std::string_view::npos)
+    {
+        std::size_t numberEnd = std::min(field.find_first_of(separators, position), field.size());
+        std::size_t recordNumber = 0;
+        if (!parseNumber(field.substr(position, numberEnd - position), recordNumber) || recordNumber == 0)
+        {
+            return false;
+        }
+        dependencyRecordNumbers.push_back(recordNumber);
+        position = field.find_first_not_of(separators, numberEnd);
+    }
+
+    return true;
+}
+
+CSVImporter::CSVImporter(unsigned int parseWorkerCount, unsigned int writerCountIn)
+: pool{parseWorkerCount}, writerCount{std::max(1u, writerCountIn)}
+{
+}
+
+bool CSVImporter::importUsers(const std::string& fileName)
+{
+    startImport(fileName);
+
+    return runUserImport();
+}
+
+bool CSVImporter::importTasks(const std::string& fileName, UserModel_shp owner)
+{
+    startImport(fileName);
+
+    return runTaskImport(owner);
+}
+
+bool CSVImporter::syncUsers(const std::string& fileName)
+{
+    startImport(fileName);
+
+    UserDbInterface userDbInterface;
+    std::vector<ImportedRow> importedRows = userDbInterface.getImportedRows();
+    if (!loadPreviousRows(std::move(importedRows), userDbInterface.getAllErrorMessages()))
+    {
+        return false;
+    }
+
+    return runUserImport();
+}
+
+bool CSVImporter::syncTasks(const std::string& fileName, UserModel_shp owner)
+{
+    startImport(fileName);
+
+    if (!owner || !owner->isInDataBase())
+    {
+        addError(0, "the owner of the tasks must be a user in the database");
+        return false;
+    }
+
+    TaskDbInterface taskDbInterface;
+    std::vector<ImportedRow> importedRows = taskDbInterface.getImportedRows(*owner);
+    if (!loadPreviousRows(std::move(importedRows), taskDbInterface.getAllErrorMessages()))
+    {
+        return false;
+    }
+
+    return runTaskImport(owner);
+}
+
+std::string CSVImporter::getAllErrorMessages() const
+{
+    std::string errorMessages;
+
+    for (const auto& importError: importErrors)
+    {
+        errorMessages.append(importError.lineNumber > 0?
+            std::format("{} line {}: {}\n", importFileName, importError.lineNumber, importError.message) :
+            std::format("{}: {}\n", importFileName, importError.message));
+    }
+
+    return errorMessages;
+}
+
+UserModel_shp CSVImporter::userFromRecord(const CSVRecord& record, std::string& error)
+{
+    if (record.size() < 4)
+    {
+        error = std::format("expected 4 fields, found {}", record.size());
+        return nullptr;
+    }
+    if (record[0].empty() || record[1].empty())
+    {
+        error = "last name and first name are required";
+        return nullptr;
+    }
+
+    UserModel_shp user = std::make_shared<UserModel>();
+    user->setLastName(std::string(record[0]));
+    user->setFirstName(std::string(record[1]));
+    user->setMiddleInitial(std::string(record[2]));
+    user->setEmail(std::string(record[3]));
+    user->autoGenerateLoginAndPassword();
+
+    return user;
+}
+
+TaskModel_shp CSVImporter::taskFromRecord(const CSVRecord& record, UserModel_shp owner, RecordReferences& references,
+    std::string& error)
+{
+    if (record.size() < 12)
+    {
+        error = std::format("expected at least 12 fields, found {}", record.size());
+        return nullptr;
+    }
+
+    unsigned int minorPriority = 0;
+    unsigned int estimatedEffortHours = 0;
+    double actualEffortHours = 0.0;
+    if (record[0].size() != 1 || !parseNumber(record[1], minorPriority) || !parseNumber(record[4], estimatedEffortHours) ||
+        !parseNumber(record[5], actualEffortHours) || !parseNumber(record[6], references.parentRecordNumber))
+    {
+        error = "priority group must be one character, priority, effort and parent task must be numbers";
+        return nullptr;
+    }
+    if (record.size() > 13 && !parseDependencies(record[13], references.dependencyRecordNumbers))
+    {
+        error = "dependencies must be record numbers separated by spaces or semicolons";
+        return nullptr;
+    }
+
+    // Each thread keeps a parser per date column, the dates in a column usually share one format.
+    thread_local std::array<DateParser, taskDateFields.size()> dateParsers;
+    std::array<CompactDate, taskDateFields.size()> dates;
+    for (std::size_t dateIndex = 0; dateIndex < taskDateFields.size(); ++dateIndex)
+    {
+        const TaskDateField& dateField = taskDateFields[dateIndex];
+        if (dateField.fieldIndex >= record.size())
+        {
+            continue;
+        }
+
+        auto date = dateParsers[dateIndex].parse(record[dateField.fieldIndex]);
+        if (date.has_value())
+        {
+            dates[dateIndex] = *date;
+        }
+        else if (date.error() != DateParser::Error::Blank || dateField.required)
+        {
+            error = std::format("{}: {}", dateField.name, DateParser::errorMessage(date.error()));
+            return nullptr;
+        }
+    }
+
+    TaskModel_shp task = std::make_shared<TaskModel>(owner, std::string(record[2]));
+    if (!task->hasRequiredValues())
+    {
+        error = "the description must be at least 10 characters";
+        return nullptr;
+    }
+
+    // Required fields first.
+    task->setEstimatedEffort(estimatedEffortHours);
+    task->setActualEffortToDate(actualEffortHours);
+    task->setDueDate(dates[RequiredDeliveryDate]);
+    task->setScheduledStart(dates[ScheduledStartDate].hasValue()? dates[ScheduledStartDate] : getTodaysCompactDate());
+    task->setStatus(std::string(record[7]));
+    task->setPriorityGroup(static_cast<unsigned char>(record[0][0]));
+    task->setPriority(minorPriority);
+    task->setPercentageComplete(0.0);
+
+    // Optional fields
+    if (dates[ActualStartDate].hasValue())
+    {
+        task->setactualStartDate(dates[ActualStartDate]);
+    }
+    if (dates[EstimatedCompletionDate].hasValue())
+    {
+        task->setEstimatedCompletion(dates[EstimatedCompletionDate]);
+    }
+    if (dates[CreatedOnDate].hasValue())
+    {
+        // Override the auto date creation with the actual creation date.
+        task->setCreationDate(dates[CreatedOnDate]);
+    }
+
+    return task;
+}
+
+std::uint64_t CSVImporter::contentHash(const CSVRecord& record)
+{
+    std::size_t fieldCount = record.size();
+    while (fieldCount > 0 && record[fieldCount - 1].empty())
+    {
+        --fieldCount;
+    }
+
+    std::uint64_t hash = ImportHashSeed;
+    for (std::size_t fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex)
+    {
+        hash = hashImportField(hash, record[fieldIndex]);
+    }
+
+    return hash;
+}
+
+/*
+ * Private methods.
+ */
+void CSVImporter::startImport(const std::string& fileName)
+{
+    importFileName = fileName;
+    chunkResults.clear();
+    previousRows.clear();
+    recordCount = 0;
+    importedCount = 0;
+    unchangedCount = 0;
+    importErrors.clear();
+    importedUsers.clear();
+    importedTasks.clear();
+    pool.clearErrorMessages();
+}
+
+/*
+ * The rows are sorted by ID, when rows share an import key the oldest one is matched.
+ */
+bool CSVImporter::loadPreviousRows(std::vector<ImportedRow> importedRows, const std::string& dbErrors)
+{
+    if (!dbErrors.empty())
+    {
+        addError(0, dbErrors);
+        return false;
+    }
+
+    previousRows.reserve(importedRows.size());
+    for (const auto& importedRow: importedRows)
+    {
+        previousRows.try_emplace(importedRow.hash.importKey, importedRow);
+    }
+
+    return true;
+}
+
+bool CSVImporter::runUserImport()
+{
+    KeptModels<UserModel> keptUsers;
+
+    runImport<UserModel, UserDbInterface>(importFileName,
+        [](const CSVRecord& record, RecordReferences&, std::string& error)
+        { return userFromRecord(record, error); },
+        keptUsers);
+
+    for (auto& keptUser: keptUsers)
+    {
+        importedUsers.push_back(keptUser.second);
+    }
+    std::ranges::stable_sort(importErrors, {}, &ImportError::lineNumber);
+
+    return importErrors.empty();
+}
+
+bool CSVImporter::runTaskImport(UserModel_shp owner)
+{
+    KeptModels<TaskModel> keptTasks;
+    taskOwner = owner;
+
+    runImport<TaskModel, TaskDbInterface>(importFileName,
+        [this](const CSVRecord& record, RecordReferences& references, std::string& error)
+        { return taskFromRecord(record, taskOwner, references, error); },
+        keptTasks);
+
+    resolveTaskReferences(keptTasks);
+    reportDuplicateImportKeys();
+
+    for (auto& keptTask: keptTasks)
+    {
+        importedTasks.push_back(keptTask.second);
+    }
+    std::ranges::stable_sort(importErrors, {}, &ImportError::lineNumber);
+
+    return importErrors.empty();
+}
+
+template <typename Model, typename DbInterface, typename RecordBuilder>
+void CSVImporter::runImport(const std::string& fileName, RecordBuilder buildModel, KeptModels<Model>& keptModels)
+{
+    CSVParser input(fileName);
+    if (!input.isOpen())
+    {
+        addError(0, input.getAllErrorMessages());
+        return;
+    }
+
+    BoundedQueue<WriteBatch<Model>> writeQueue(writerCount * QueuedBatchesPerWriter);
+    std::vector<std::jthread> writers;
+    for (unsigned int writerIndex = 0; writerIndex < writerCount; ++writerIndex)
+    {
+        writers.emplace_back([this, &writeQueue, &keptModels]() { writeBatches<Model, DbInterface>(writeQueue, keptModels); });
+    }
+
+    if (input.isStreaming())
+    {
+        // A pipe can only be read in order, each batch of records gets its own chunk result.
+        bool moreRecords = true;
+        while (moreRecords)
+        {
+            ChunkResult& chunkResult = chunkResults.emplace_back();
+            moreRecords = parseRecords<Model>(input, chunkResult, buildModel, writeQueue, WriteBatchSize);
+        }
+        if (input.hasReadError())
+        {
+            addError(0, input.getAllErrorMessages());
+        }
+    }
+    else
+    {
+        std::string_view text = input.getMappedText();
+        std::vector<CSVChunk> chunks = splitCSVIntoChunks(text, ChunkSize, pool);
+
+        // Every chunk result exists before the first parser starts, the deque is not changed again.
+        chunkResults.resize(chunks.size());
+        for (std::size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+        {
+            pool.submit([this, text, chunk = chunks[chunkIndex], chunkResult = &chunkResults[chunkIndex], &buildModel,
+                &writeQueue](unsigned int)
+                {
+                    CSVParser parser(text.data() + chunk.offset, chunk.length, ',', chunk.firstLineNumber);
+                    parseRecords<Model>(parser, *chunkResult, buildModel, writeQueue, std::numeric_limits<std::size_t>::max());
+                });
+        }
+        pool.waitForAll();
+    }
+
+    // The writers finish the queued batches and stop.
+    writeQueue.close();
+    writers.clear();
+
+    for (const auto& chunkResult: chunkResults)
+    {
+        recordCount += chunkResult.recordCount;
+        unchangedCount += chunkResult.unchangedCount;
+    }
+    std::string poolErrors = pool.getAllErrorMessages();
+    if (!poolErrors.empty())
+    {
+        addError(0, poolErrors);
+    }
+    std::ranges::sort(keptModels, {}, &KeptModels<Model>::value_type::first);
+}
+
+/*
+ * Parses up to maximumRecords records into the chunk result and queues them for the writers.
+ * A record that matches a previous row is given the row's ID, it is only queued when its
+ * content changed. The record IDs are sized before the first batch is queued. Returns false
+ * when the parser reached the end of the input.
+ */
+template <typename Model, typename RecordBuilder>
+bool CSVImporter::parseRecords(CSVParser& parser, ChunkResult& chunkResult, RecordBuilder& buildModel,
+    BoundedQueue<WriteBatch<Model>>& writeQueue, std::size_t maximumRecords)
+{
+    std::vector<WriteBatch<Model>> batches;
+    std::vector<std::pair<std::size_t, std::size_t>> unchangedRecords;
+    CSVRecord record;
+    bool moreRecords = true;
+
+    while (chunkResult.recordCount < maximumRecords)
+    {
+        if (!parser.readNextRecord(record))
+        {
+            moreRecords = false;
+            break;
+        }
+
+        std::size_t recordIndex = chunkResult.recordCount++;
+        std::size_t lineNumber = record.getLineNumber();
+        if (record.hasFormatError())
+        {
+            addError(lineNumber, "malformed quoted field");
+            continue;
+        }
+
+        RecordReferences references;
+        std::string error;
+        std::shared_ptr<Model> model = buildModel(record, references, error);
+        if (!model)
+        {
+            addError(lineNumber, error);
+            continue;
+        }
+
+        ImportHash importHash{getImportKey(*model), contentHash(record)};
+        chunkResult.importKeys.push_back({importHash.importKey, lineNumber});
+        if (auto previousRow = previousRows.find(importHash.importKey); previousRow != previousRows.end())
+        {
+            if (previousRow->second.hash.content == importHash.content)
+            {
+                // The references of an unchanged record were written with its row.
+                unchangedRecords.emplace_back(recordIndex, previousRow->second.rowID);
+                continue;
+            }
+            setModelID(*model, previousRow->second.rowID);
+        }
+
+        if (references.parentRecordNumber > 0)
+        {
+            chunkResult.parentReferences.push_back({recordIndex, references.parentRecordNumber, lineNumber});
+        }
+        for (std::size_t dependencyRecordNumber: references.dependencyRecordNumbers)
+        {
+            chunkResult.dependencyReferences.push_back({recordIndex, dependencyRecordNumber, lineNumber});
+        }
+
+        if (batches.empty() || batches.back().models.size() >= WriteBatchSize)
+        {
+            batches.emplace_back().chunkResult = &chunkResult;
+        }
+        WriteBatch<Model>& batch = batches.back();
+        batch.recordIndexes.push_back(recordIndex);
+        batch.lineNumbers.push_back(lineNumber);
+        batch.models.push_back(std::move(model));
+        batch.importHashes.push_back(importHash);
+    }
+
+    chunkResult.recordIDs.assign(chunkResult.recordCount, 0);
+    for (auto [recordIndex, rowID]: unchangedRecords)
+    {
+        chunkResult.recordIDs[recordIndex] = rowID;
+    }
+    chunkResult.unchangedCount = unchangedRecords.size();
+    for (auto& batch: batches)
+    {
+        writeQueue.push(std::move(batch));
+    }
+
+    return moreRecords;
+}
+
+template <typename Model, typename DbInterface>
+void CSVImporter::writeBatches(BoundedQueue<WriteBatch<Model>>& writeQueue, KeptModels<Model>& keptModels)
+{
+    // Database interfaces are not thread safe, each writer has its own.
+    DbInterface dbInterface;
+
+    while (std::optional<WriteBatch<Model>> batch = writeQueue.pop())
+    {
+        try
+        {
+            // Models of changed records have an ID before they are written, it can't tell if the write failed.
+            std::vector<bool> written(batch->models.size(), true);
+            if (!dbInterface.upsertBatch(batch->models, batch->importHashes))
+            {
+                // Find the rows the database rejects by writing them one at a time.
+                for (std::size_t batchIndex = 0; batchIndex < batch->models.size(); ++batchIndex)
+                {
+                    std::vector<std::shared_ptr<Model>> singleModel{batch->models[batchIndex]};
+                    if (!dbInterface.upsertBatch(singleModel, {batch->importHashes[batchIndex]}))
+                    {
+                        written[batchIndex] = false;
+                        addError(batch->lineNumbers[batchIndex], dbInterface.getAllErrorMessages());
+                    }
+                }
+            }
+
+            std::size_t writtenCount = 0;
+            for (std::size_t batchIndex = 0; batchIndex < batch->models.size(); ++batchIndex)
+            {
+                std::size_t modelID = written[batchIndex]? getModelID(*batch->models[batchIndex]) : 0;
+                batch->chunkResult->recordIDs[batch->recordIndexes[batchIndex]] = modelID;
+                writtenCount += modelID > 0;
+            }
+            importedCount += writtenCount;
+
+            if (keepImportedModels)
+            {
+                std::lock_guard<std::mutex> resultLock(resultMutex);
+                for (std::size_t batchIndex = 0; batchIndex < batch->models.size(); ++batchIndex)
+                {
+                    if (written[batchIndex] && getModelID(*batch->models[batchIndex]) > 0)
+                    {
+                        keptModels.emplace_back(batch->lineNumbers[batchIndex], batch->models[batchIndex]);
+                    }
+                }
+            }
+        }
+
+        catch (const std::exception& e)
+        {
+            // The writer keeps draining the queue, a parser blocked on a full queue would never finish.
+            addError(batch->lineNumbers.front(), std::format("In CSVImporter::writeBatches : {}", e.what()));
+        }
+    }
+}
+
+/*
+ * Converts the record numbers of parents and dependencies to the TaskIDs the referenced tasks
+ * were given and writes them.
+ */
+void CSVImporter::resolveTaskReferences(KeptModels<TaskModel>& keptTasks)
+{
+    std::vector<std::size_t> firstRecordNumbers;
+    firstRecordNumbers.reserve(chunkResults.size());
+    std::size_t nextRecordNumber = 1;
+    for (const auto& chunkResult: chunkResults)
+    {
+        firstRecordNumbers.push_back(nextRecordNumber);
+        nextRecordNumber += chunkResult.recordCount;
+    }
+
+    auto taskIDOfRecord = [&](std::size_t recordNumber) -> std::size_t
+    {
+        if (recordNumber == 0 || recordNumber >= nextRecordNumber)
+        {
+            return 0;
+        }
+        auto recordChunk = std::ranges::upper_bound(firstRecordNumbers, recordNumber) - 1;
+        const auto& recordIDs = chunkResults[static_cast<std::size_t>(recordChunk - firstRecordNumbers.begin())].recordIDs;
+        std::size_t recordIndex = recordNumber - *recordChunk;
+        return recordIndex < recordIDs.size()? recordIDs[recordIndex] : 0;
+    };
+
+    auto findKeptTask = [&keptTasks](std::size_t lineNumber) -> TaskModel_shp
+    {
+        auto keptTask = std::ranges::lower_bound(keptTasks, lineNumber, {}, &KeptModels<TaskModel>::value_type::first);
+        return keptTask != keptTasks.end() && keptTask->first == lineNumber? keptTask->second : nullptr;
+    };
+
+    std::vector<TaskDbInterface::ParentAssignment> parentAssignments;
+    std::vector<TaskDbInterface::DependencyAssignment> dependencyAssignments;
+    for (const auto& chunkResult: chunkResults)
+    {
+        if (chunkResult.recordIDs.size() != chunkResult.recordCount)
+        {
+            // The parser of this chunk failed, the error is in the pool's messages.
+            continue;
+        }
+
+        for (const auto& parentReference: chunkResult.parentReferences)
+        {
+            std::size_t taskID = chunkResult.recordIDs[parentReference.recordIndex];
+            if (taskID == 0)
+            {
+                continue;
+            }
+
+            std::size_t parentTaskID = taskIDOfRecord(parentReference.referencedRecordNumber);
+            if (parentTaskID == 0 || parentTaskID == taskID)
+            {
+                addError(parentReference.lineNumber, parentTaskID == taskID? std::string("a task can't be its own parent") :
+                    std::format("parent task record {} was not imported", parentReference.referencedRecordNumber));
+                continue;
+            }
+
+            parentAssignments.push_back({taskID, parentTaskID});
+            if (TaskModel_shp keptTask = findKeptTask(parentReference.lineNumber))
+            {
+                keptTask->setParentTaskID(parentTaskID);
+            }
+        }
+
+        for (const auto& dependencyReference: chunkResult.dependencyReferences)
+        {
+            std::size_t taskID = chunkResult.recordIDs[dependencyReference.recordIndex];
+            if (taskID == 0)
+            {
+                continue;
+            }
+
+            std::size_t dependencyTaskID = taskIDOfRecord(dependencyReference.referencedRecordNumber);
+            if (dependencyTaskID == 0 || dependencyTaskID == taskID)
+            {
+                addError(dependencyReference.lineNumber, dependencyTaskID == taskID?
+                    std::string("a task can't depend on itself") :
+                    std::format("dependency record {} was not imported", dependencyReference.referencedRecordNumber));
+                continue;
+            }
+
+            dependencyAssignments.push_back({taskID, dependencyTaskID});
+            if (TaskModel_shp keptTask = findKeptTask(dependencyReference.lineNumber))
+            {
+                keptTask->addDependency(dependencyTaskID);
+            }
+        }
+    }
+
+    TaskDbInterface taskDbInterface;
+    if (!taskDbInterface.setParentTasks(parentAssignments))
+    {
+        addError(0, taskDbInterface.getAllErrorMessages());
+    }
+    if (!taskDbInterface.addDependencies(dependencyAssignments))
+    {
+        addError(0, taskDbInterface.getAllErrorMessages());
+    }
+}
+
+/*
+ * Records with the same import key can't be told apart by a sync, the later records are
+ * reported. Users aren't checked, the unique full name index of UserProfile rejects them.
+ */
+void CSVImporter::reportDuplicateImportKeys()
+{
+    std::vector<ImportKeyLine> importKeys;
+    for (auto& chunkResult: chunkResults)
+    {
+        importKeys.insert(importKeys.end(), chunkResult.importKeys.begin(), chunkResult.importKeys.end());
+        chunkResult.importKeys = {};
+    }
+    std::ranges::sort(importKeys, [](const ImportKeyLine& left, const ImportKeyLine& right)
+        { return left.importKey != right.importKey? left.importKey < right.importKey : left.lineNumber < right.lineNumber; });
+
+    for (std::size_t keyIndex = 1; keyIndex < importKeys.size(); ++keyIndex)
+    {
+        std::size_t firstIndex = keyIndex - 1;
+        while (keyIndex < importKeys.size() && importKeys[keyIndex].importKey == importKeys[firstIndex].importKey)
+        {
+            addError(importKeys[keyIndex].lineNumber, std::format("the description is the same as on line {}, "
+                "a sync matches both records to one task", importKeys[firstIndex].lineNumber));
+            ++keyIndex;
+        }
+    }
+}
+
+void CSVImporter::addError(std::size_t lineNumber, std::string message)
+{
+    while (!message.empty() && message.back() == '\n')
+    {
+        message.pop_back();
+    }
+
+    std::lock_guard<std::mutex> resultLock(resultMutex);
+    importErrors.push_back({lineNumber, std::move(message)});
+}
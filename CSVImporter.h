@@ -0,0 +1,201 @@
+#ifndef CSVIMPORTER_H_
+#define CSVIMPORTER_H_
+
+#include <atomic>
+#include "BoundedQueue.h"
+#include <cstddef>
+#include <cstdint>
+#include "CSVParser.h"
+#include <deque>
+#include "ImportHash.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "TaskModel.h"
+#include <unordered_map>
+#include <utility>
+#include "UserModel.h"
+#include <vector>
+#include "WorkStealingPool.h"
+
+/*
+ * Parallel import of user and task CSV files into the database. The import is a pipeline:
+ *  - The memory mapped file is split into chunks of about ChunkSize bytes that end on record
+ *    boundaries. Quotes and line feeds are counted in parallel, a line feed ends a record when
+ *    an even number of quotes precede it.
+ *  - The chunks are parsed and validated on a work stealing pool, the records become UserModel
+ *    or TaskModel objects in batches of WriteBatchSize.
+ *  - The batches go through a bounded queue to writer threads that each have their own
+ *    database interface and insert a batch in one transaction. A full queue blocks the parsers,
+ *    so memory use doesn't depend on the size of the file.
+ * Input that can't be memory mapped, such as a pipe, is parsed on the calling thread and still
+ * written by the writer threads.
+ *
+ * Errors are reported per record with the line number and sorted into input order. A record
+ * that fails validation is skipped. A batch that fails to write is retried one row at a time
+ * so that only the rows the database rejects are lost.
+ *
+ * Every row is written with the ImportHash of its record. The sync functions load the hashes
+ * of the rows earlier imports wrote before the pipeline starts, the parsers skip the records
+ * whose content hash didn't change and the writers replace the rows of the changed records in
+ * place, so a daily re-import of a mostly unchanged file only writes the changes. Rows whose
+ * records were removed from the file are kept. Task records with the same description can't be
+ * told apart by a sync and are reported by both the import and the sync.
+ */
+class CSVImporter
+{
+public:
+    struct ImportError
+    {
+        std::size_t lineNumber;
+        std::string message;
+    };
+
+    explicit CSVImporter(unsigned int parseWorkerCount = 0, unsigned int writerCountIn = DefaultWriterCount);
+    ~CSVImporter() = default;
+    CSVImporter(const CSVImporter&) = delete;
+    CSVImporter& operator=(const CSVImporter&) = delete;
+
+/*
+ * User records are LastName, FirstName, MiddleInitial, EmailAddress. The login name and the
+ * password are generated from the name.
+ */
+    bool importUsers(const std::string& fileName);
+/*
+ * Task records are SchedulePriorityGroup, PriorityInGroup, Description, RequiredDelivery,
+ * EstimatedEffortHours, ActualEffortHours, ParentTask, Status, ScheduledStart, ActualStart,
+ * CreatedOn, RequiredDelivery (ignored), an optional EstimatedCompletion and optional
+ * Dependencies. ParentTask is the number of the parent's record in the same file starting at 1,
+ * empty lines aren't counted, 0 is no parent. Dependencies are record numbers in the same way,
+ * separated by spaces or semicolons. Dates must be in a format DateParser accepts, a blank
+ * ScheduledStart is today. Parents and dependencies are set after all of the tasks have been
+ * inserted, so a referenced task can be written by any writer, before or after the task that
+ * references it. The tasks are created by and assigned to the owner.
+ */
+    bool importTasks(const std::string& fileName, UserModel_shp owner);
+/*
+ * Incremental versions of importUsers() and importTasks(). A user is matched by the full name
+ * and only the e-mail address is updated. A task is matched by its description among the
+ * tasks of the owner written by an earlier import or sync, a changed description makes it a
+ * new task. The parent and the dependencies of a changed task are replaced. ParentTask and
+ * Dependencies are record numbers, so adding or removing records also changes the records
+ * that refer to records after them.
+ */
+    bool syncUsers(const std::string& fileName);
+    bool syncTasks(const std::string& fileName, UserModel_shp owner);
+
+/*
+ * References from a task record to other records of the same file, by record number.
+ */
+    struct RecordReferences
+    {
+        std::size_t parentRecordNumber = 0;
+        std::vector<std::size_t> dependencyRecordNumbers;
+    };
+/*
+ * Convert one record to a model. Shared with BulkLoader so that both import paths validate and
+ * normalize records the same way. Returns nullptr and describes the problem in error when the
+ * record is not valid.
+ */
+    static UserModel_shp userFromRecord(const CSVRecord& record, std::string& error);
+    static TaskModel_shp taskFromRecord(const CSVRecord& record, UserModel_shp owner, RecordReferences& references,
+        std::string& error);
+/*
+ * The content part of the record's ImportHash. Trailing empty fields are ignored, a
+ * spreadsheet that gains or loses empty columns at the end doesn't change every record.
+ */
+    static std::uint64_t contentHash(const CSVRecord& record);
+
+/*
+ * Keeps the models that were written by the last import, in input order. Only useful for
+ * small files, the models of a large import would use more memory than the pipeline itself.
+ */
+    void setKeepImportedModels(bool keep) { keepImportedModels = keep; };
+    UserList getImportedUsers() const { return importedUsers; };
+    TaskList getImportedTasks() const { return importedTasks; };
+    std::size_t getRecordCount() const { return recordCount; };
+    std::size_t getImportedCount() const { return importedCount; };
+    std::size_t getUnchangedCount() const { return unchangedCount; };
+    std::vector<ImportError> getImportErrors() const { return importErrors; };
+    std::string getAllErrorMessages() const;
+
+    static constexpr std::size_t ChunkSize = 4 * 1024 * 1024;
+    static constexpr std::size_t WriteBatchSize = 500;
+    static constexpr std::size_t QueuedBatchesPerWriter = 4;
+    static constexpr unsigned int DefaultWriterCount = 4;
+
+private:
+    struct RecordReference
+    {
+        std::size_t recordIndex;
+        std::size_t referencedRecordNumber;
+        std::size_t lineNumber;
+    };
+
+    struct ImportKeyLine
+    {
+        std::uint64_t importKey;
+        std::size_t lineNumber;
+    };
+
+/*
+ * Written by the parser of the chunk before any of its batches are queued, after that the
+ * writers only store the IDs of the records they wrote, each in its own element. Unchanged
+ * records get the IDs of their rows from the parser.
+ */
+    struct ChunkResult
+    {
+        std::size_t recordCount = 0;
+        std::size_t unchangedCount = 0;
+        std::vector<std::size_t> recordIDs;
+        std::vector<RecordReference> parentReferences;
+        std::vector<RecordReference> dependencyReferences;
+        std::vector<ImportKeyLine> importKeys;
+    };
+
+    template <typename Model>
+    struct WriteBatch
+    {
+        ChunkResult* chunkResult = nullptr;
+        std::vector<std::size_t> recordIndexes;
+        std::vector<std::size_t> lineNumbers;
+        std::vector<std::shared_ptr<Model>> models;
+        std::vector<ImportHash> importHashes;
+    };
+
+    template <typename Model>
+    using KeptModels = std::vector<std::pair<std::size_t, std::shared_ptr<Model>>>;
+
+    void startImport(const std::string& fileName);
+    bool loadPreviousRows(std::vector<ImportedRow> importedRows, const std::string& dbErrors);
+    bool runUserImport();
+    bool runTaskImport(UserModel_shp owner);
+    template <typename Model, typename DbInterface, typename RecordBuilder>
+    void runImport(const std::string& fileName, RecordBuilder buildModel, KeptModels<Model>& keptModels);
+    template <typename Model, typename RecordBuilder>
+    bool parseRecords(CSVParser& parser, ChunkResult& chunkResult, RecordBuilder& buildModel,
+        BoundedQueue<WriteBatch<Model>>& writeQueue, std::size_t maximumRecords);
+    template <typename Model, typename DbInterface>
+    void writeBatches(BoundedQueue<WriteBatch<Model>>& writeQueue, KeptModels<Model>& keptModels);
+    void resolveTaskReferences(KeptModels<TaskModel>& keptTasks);
+    void reportDuplicateImportKeys();
+    void addError(std::size_t lineNumber, std::string message);
+
+    WorkStealingPool pool;
+    const unsigned int writerCount;
+    bool keepImportedModels = false;
+    std::string importFileName;
+    UserModel_shp taskOwner;
+    std::deque<ChunkResult> chunkResults;
+    std::unordered_map<std::uint64_t, ImportedRow> previousRows;
+    std::size_t recordCount = 0;
+    std::atomic<std::size_t> importedCount = 0;
+    std::size_t unchangedCount = 0;
+    std::mutex resultMutex;
+    std::vector<ImportError> importErrors;
+    UserList importedUsers;
+    TaskList importedTasks;
+};
+
+#endif // CSVIMPORTER_H_
@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include "CSVParser.h"
+#include <fcntl.h>
+#include <format>
+#include "HardwareCounters.h"
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * The first read in streaming mode, the buffer doubles whenever a single record doesn't fit.
+ */
+static constexpr std::size_t streamBufferSize = 1024 * 1024;
+
+/*
+ * A carriage return that isn't followed by a line feed doesn't end the record, it is field data.
+ * One at the end of the text can't be told apart yet.
+ */
+static bool isLoneCarriageReturn(const char* position, const char* textEnd)
+{
+    return *position == '\r' && position + 1 < textEnd && position[1] != '\n';
+}
+
+void CSVRecord::clear()
+{
+    fields.clear();
+    unescapedFields.clear();
+    unescapedText.clear();
+    formatError = false;
+}
+
+CSVParser::CSVParser(const std::string& fileName, char delimiterIn)
+: delimiter{delimiterIn}
+{
+    int fileDescriptor = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0)
+    {
+        appendErrorMessage(std::format("In CSVParser::CSVParser({}) : {}\n", fileName, std::strerror(errno)));
+        return;
+    }
+
+    inputOpen = true;
+    if (mapFile(fileDescriptor))
+    {
+        close(fileDescriptor);
+        return;
+    }
+
+    // Pipes, devices and anything else that can't be mapped are read a block at a time.
+    streaming = true;
+    streamDescriptor = fileDescriptor;
+    streamBuffer.resize(streamBufferSize);
+    textBegin = textCursor = textEnd = streamBuffer.data();
+}
+
+CSVParser::CSVParser(const char* text, std::size_t length, char delimiterIn, std::size_t firstLineNumber)
+: delimiter{delimiterIn}, inputOpen{true}, textBegin{text}, textCursor{text}, textEnd{text + length},
+  lineNumber{firstLineNumber}
+{
+}
+
+CSVParser::~CSVParser()
+{
+    if (mappedData)
+    {
+        munmap(mappedData, mappedSize);
+    }
+    if (streamDescriptor >= 0)
+    {
+        close(streamDescriptor);
+    }
+}
+
+bool CSVParser::mapFile(int fileDescriptor)
+{
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode))
+    {
+        return false;
+    }
+
+    // mmap() rejects a length of 0, an empty file is simply an empty input.
+    if (fileStatus.st_size == 0)
+    {
+        return true;
+    }
+
+    mappedSize = static_cast<std::size_t>(fileStatus.st_size);
+    void* mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        mappedSize = 0;
+        return false;
+    }
+
+    madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+    mappedData = mapping;
+    textBegin = textCursor = static_cast<const char*>(mapping);
+    textEnd = textBegin + mappedSize;
+
+    return true;
+}
+
+/*
+ * Moves the unparsed end of the buffer to the front and reads more input after it. The buffer
+ * is doubled when the unparsed part already fills it.
+ */
+bool CSVParser::fillBuffer()
+{
+    std::size_t pending = static_cast<std::size_t>(textEnd - textCursor);
+    if (pending == streamBuffer.size())
+    {
+        streamBuffer.resize(streamBuffer.size() * 2);
+    }
+    else if (pending > 0 && textCursor != streamBuffer.data())
+    {
+        std::memmove(streamBuffer.data(), textCursor, pending);
+    }
+
+    ssize_t bytesRead;
+    do
+    {
+        bytesRead = read(streamDescriptor, streamBuffer.data() + pending, streamBuffer.size() - pending);
+    } while (bytesRead < 0 && errno == EINTR);
+
+    textBegin = textCursor = streamBuffer.data();
+    textEnd = textBegin + pending;
+
+    if (bytesRead < 0)
+    {
+        appendErrorMessage(std::format("In CSVParser::fillBuffer() : {}\n", std::strerror(errno)));
+        readError = true;
+        endOfFile = true;
+        return false;
+    }
+
+    endOfFile = bytesRead == 0;
+    textEnd += bytesRead;
+
+    return true;
+}
+
+bool CSVParser::readNextRecord(CSVRecord& record)
+{
+    if (!inputOpen)
+    {
+        return false;
+    }
+
+    HardwareCounterZone zone("CSV parse");
+    while (true)
+    {
+        switch (parseRecord(record))
+        {
+            case ParseStatus::Complete:
+                return true;
+
+            case ParseStatus::EndOfInput:
+                return false;
+
+            case ParseStatus::NeedMoreInput:
+                if (!fillBuffer())
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+}
+
+/*
+ * Returns the first delimiter, line feed or carriage return that can end the record at or after
+ * position, or textEnd.
+ */
+const char* CSVParser::findFieldEnd(const char* position) const
+{
+#if defined(__SSE2__)
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i lineFeeds = _mm_set1_epi8('\n');
+    const __m128i carriageReturns = _mm_set1_epi8('\r');
+
+    while (textEnd - position >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, lineFeeds)),
+            _mm_cmpeq_epi8(block, carriageReturns));
+        unsigned int matchMask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+        while (matchMask != 0)
+        {
+            const char* match = position + std::countr_zero(matchMask);
+            if (!isLoneCarriageReturn(match, textEnd))
+            {
+                return match;
+            }
+            matchMask &= matchMask - 1;
+        }
+        position += 16;
+    }
+#endif
+
+    while (position < textEnd && ((*position != delimiter && *position != '\n' && *position != '\r') ||
+        isLoneCarriageReturn(position, textEnd)))
+    {
+        ++position;
+    }
+
+    return position;
+}
+
+/*
+ * Parses one record starting at textCursor. Nothing is consumed unless the record is complete, so
+ * in streaming mode a record that runs past the end of the buffer is parsed again from its
+ * start once more input has been read.
+ */
+CSVParser::ParseStatus CSVParser::parseRecord(CSVRecord& record)
+{
+    const bool moreInput = streaming && !endOfFile;
+    const char* position = textCursor;
+
+    // Skipping empty lines can be committed right away, it doesn't depend on what follows.
+    while (position < textEnd && (*position == '\n' ||
+        (*position == '\r' && !isLoneCarriageReturn(position, textEnd) && (position + 1 < textEnd || !moreInput))))
+    {
+        lineNumber += *position == '\n';
+        ++position;
+    }
+    textCursor = position;
+
+    if (position == textEnd)
+    {
+        return moreInput? ParseStatus::NeedMoreInput : ParseStatus::EndOfInput;
+    }
+
+    record.clear();
+    record.lineNumber = lineNumber;
+    std::size_t lines = lineNumber;
+    std::string recordErrors;
+
+    while (true)
+    {
+        if (*position == '"')
+        {
+            const char* fieldStart = position + 1;
+            const char* scan = fieldStart;
+            const char* closingQuote = textEnd;
+            bool hasEscapedQuotes = false;
+
+            while (scan < textEnd)
+            {
+                const char* quote = static_cast<const char*>(std::memchr(scan, '"', static_cast<std::size_t>(textEnd - scan)));
+                if (quote == nullptr)
+                {
+                    break;
+                }
+                if (quote + 1 == textEnd && moreInput)
+                {
+                    // Can't tell a closing quote from the first half of an escaped quote yet.
+                    return ParseStatus::NeedMoreInput;
+                }
+                if (quote + 1 < textEnd && quote[1] == '"')
+                {
+                    hasEscapedQuotes = true;
+                    scan = quote + 2;
+                    continue;
+                }
+                closingQuote = quote;
+                break;
+            }
+
+            if (closingQuote == textEnd)
+            {
+                if (moreInput)
+                {
+                    return ParseStatus::NeedMoreInput;
+                }
+                recordErrors.append(std::format("In CSVParser::readNextRecord() : line {} : quoted field is not terminated\n",
+                    lines));
+            }
+
+            lines += static_cast<std::size_t>(std::count(fieldStart, closingQuote, '\n'));
+
+            if (hasEscapedQuotes)
+            {
+                std::size_t offset = record.unescapedText.size();
+                for (const char* character = fieldStart; character < closingQuote; ++character)
+                {
+                    record.unescapedText.push_back(*character);
+                    character += *character == '"';
+                }
+                record.unescapedFields.push_back({record.fields.size(), offset, record.unescapedText.size() - offset});
+                record.fields.emplace_back();
+            }
+            else
+            {
+                record.fields.emplace_back(fieldStart, static_cast<std::size_t>(closingQuote - fieldStart));
+            }
+
+            position = closingQuote == textEnd? textEnd : closingQuote + 1;
+            if (position < textEnd && ((*position != delimiter && *position != '\n' && *position != '\r') ||
+                isLoneCarriageReturn(position, textEnd)))
+            {
+                recordErrors.append(std::format("In CSVParser::readNextRecord() : line {} : unexpected text after closing quote\n",
+                    lines));
+                position = findFieldEnd(position);
+            }
+        }
+        else
+        {
+            const char* fieldEnd = findFieldEnd(position);
+            if (fieldEnd == textEnd && moreInput)
+            {
+                return ParseStatus::NeedMoreInput;
+            }
+            record.fields.emplace_back(position, static_cast<std::size_t>(fieldEnd - position));
+            position = fieldEnd;
+        }
+
+        if (position == textEnd)
+        {
+            if (moreInput)
+            {
+                return ParseStatus::NeedMoreInput;
+            }
+            break;
+        }
+
+        if (*position == delimiter)
+        {
+            ++position;
+            if (position == textEnd)
+            {
+                if (moreInput)
+                {
+                    return ParseStatus::NeedMoreInput;
+                }
+                // A trailing delimiter at the end of the input ends with an empty field.
+                record.fields.emplace_back();
+                break;
+            }
+            continue;
+        }
+
+        // The record ends at LF or CRLF, or a CR at the end of the input.
+        if (*position == '\r')
+        {
+            ++position;
+            if (position == textEnd && moreInput)
+            {
+                return ParseStatus::NeedMoreInput;
+            }
+        }
+        if (position < textEnd && *position == '\n')
+        {
+            ++position;
+            ++lines;
+        }
+        break;
+    }
+
+    for (const auto& unescapedField: record.unescapedFields)
+    {
+        record.fields[unescapedField.fieldIndex] =
+            std::string_view(record.unescapedText.data() + unescapedField.offset, unescapedField.length);
+    }
+
+    record.formatError = !recordErrors.empty();
+    appendErrorMessage(recordErrors);
+    lineNumber = lines;
+    textCursor = position;
+
+    return ParseStatus::Complete;
+}
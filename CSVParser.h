@@ -0,0 +1,145 @@
+#ifndef CSVPARSER_H_
+#define CSVPARSER_H_
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * The fields of one CSV record. Fields point into the parser's input, a quoted field that
+ * contains escaped quotes ("") is unescaped into storage owned by the record.
+ */
+class CSVRecord
+{
+public:
+    std::size_t size() const { return fields.size(); };
+    bool empty() const { return fields.empty(); };
+    std::string_view operator[](std::size_t index) const { return fields[index]; };
+    std::vector<std::string_view>::const_iterator begin() const { return fields.begin(); };
+    std::vector<std::string_view>::const_iterator end() const { return fields.end(); };
+/*
+ * The line of the input the record starts on, the first line is 1.
+ */
+    std::size_t getLineNumber() const { return lineNumber; };
+/*
+ * True when the quoting of the record was malformed, the parser's error messages have the details.
+ */
+    bool hasFormatError() const { return formatError; };
+
+private:
+    friend class CSVParser;
+
+    struct UnescapedField
+    {
+        std::size_t fieldIndex;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    void clear();
+
+    std::vector<std::string_view> fields;
+    std::vector<UnescapedField> unescapedFields;
+    std::string unescapedText;
+    std::size_t lineNumber = 0;
+    bool formatError = false;
+};
+
+/*
+ * RFC 4180 CSV reader. Regular files are memory mapped and the fields of every record stay
+ * valid for the lifetime of the parser. Pipes, character devices and files that can't be mapped
+ * are read in blocks, in that mode the fields are only valid until the next record is read. Text
+ * that is already in memory can be parsed without copying it, firstLineNumber is the line
+ * number of its first line when the text is a chunk of a larger file.
+ *
+ * Fields are separated by the delimiter, records end at LF or CRLF. A CR that isn't followed by
+ * a LF is part of the field, it doesn't end the record or count as a line. Quoted fields can
+ * contain delimiters, line breaks and escaped quotes. Empty lines are skipped.
+ */
+class CSVParser
+{
+public:
+    explicit CSVParser(const std::string& fileName, char delimiterIn = ',');
+    CSVParser(const char* text, std::size_t length, char delimiterIn = ',', std::size_t firstLineNumber = 1);
+    ~CSVParser();
+    CSVParser(const CSVParser&) = delete;
+    CSVParser& operator=(const CSVParser&) = delete;
+
+    bool isOpen() const { return inputOpen; };
+    bool isMemoryMapped() const { return mappedData != nullptr; };
+    bool isStreaming() const { return streaming; };
+    bool hasReadError() const { return readError; };
+/*
+ * The whole input for memory mapped files and in memory text, empty in streaming mode.
+ */
+    std::string_view getMappedText() const { return streaming? std::string_view() : std::string_view(textBegin, textEnd); };
+/*
+ * Returns false at the end of the input or when the input can't be read.
+ */
+    bool readNextRecord(CSVRecord& record);
+    std::string getAllErrorMessages() const { return errorMessages; };
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = CSVRecord;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const CSVRecord*;
+        using reference = const CSVRecord&;
+
+        Iterator() = default;
+        explicit Iterator(CSVParser* parserIn) : parser{parserIn} { ++(*this); };
+        Iterator& operator++()
+        {
+            if (parser && !parser->readNextRecord(record))
+            {
+                parser = nullptr;
+            }
+            return *this;
+        };
+        const CSVRecord& operator*() const { return record; };
+        const CSVRecord* operator->() const { return &record; };
+        bool operator==(const Iterator& other) const { return parser == other.parser; };
+
+    private:
+        CSVParser* parser = nullptr;
+        CSVRecord record;
+    };
+
+    Iterator begin() { return Iterator(this); };
+    Iterator end() { return Iterator(); };
+
+private:
+    enum class ParseStatus
+    {
+        Complete,
+        NeedMoreInput,
+        EndOfInput
+    };
+
+    bool mapFile(int fileDescriptor);
+    bool fillBuffer();
+    ParseStatus parseRecord(CSVRecord& record);
+    const char* findFieldEnd(const char* cursor) const;
+    void appendErrorMessage(std::string newError) { errorMessages.append(newError); };
+
+    const char delimiter;
+    bool inputOpen = false;
+    bool streaming = false;
+    bool endOfFile = false;
+    bool readError = false;
+    int streamDescriptor = -1;
+    void* mappedData = nullptr;
+    std::size_t mappedSize = 0;
+    std::vector<char> streamBuffer;
+    const char* textBegin = nullptr;
+    const char* textCursor = nullptr;
+    const char* textEnd = nullptr;
+    std::size_t lineNumber = 1;
+    std::string errorMessages;
+};
+
+#endif // CSVPARSER_H_
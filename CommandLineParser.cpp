@@ -1,10 +1,13 @@
 #include <algorithm>
 #include <boost/program_options.hpp>
+#include <charconv>
 #include "CommandLineParser.h"
 #include <expected>
 #include <filesystem>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 static std::string simplifyName(char *path)
@@ -19,7 +22,8 @@ static const char optionStarter = '-';
 enum class ProgOptStatus
 {
 	NoErrors,
-	MissingArgument
+	MissingArgument,
+	InvalidArgument
 };
 
 static po::options_description addOptions()
@@ -34,7 +38,27 @@ static po::options_description addOptions()
 		("mysql-dbname", po::value<std::string>()->default_value("PlannerTaskScheduleDB"), "The name of the database that contains the tables")
 		("user-data-file", po::value<std::string>()->default_value("testData/userData.txt"), "File path including file name to user test data")
 		("task-data-file", po::value<std::string>()->default_value("testData/planData.txt"), "File path including file name to task test data")
+		("bulk-load", "Load the user and task data files with the bulk loader instead of running the tests")
+		("bulk-load-dir", po::value<std::string>(), "Directory the MySQL server can read (secure_file_priv), the bulk loader uses LOAD DATA INFILE from there")
+		("sync", "Synchronize the database with the user and task data files, only new and changed records are written, instead of running the tests")
+		("load-test", "Run virtual users concurrently against the database and report the throughput and latencies of each operation, instead of running the tests")
+		("load-test-users", po::value<unsigned int>()->default_value(8), "The number of virtual users of the load test")
+		("load-test-seconds", po::value<unsigned int>()->default_value(30), "How long the load test runs in seconds")
+		("load-test-rate", po::value<unsigned int>()->default_value(0), "Operations per second over all of the virtual users, 0 runs each virtual user closed loop")
+		("load-test-mix", po::value<std::string>()->default_value("login=40,task=40,unstarted=15,insert=5"), "Relative weights of the load test operations: login, task lookup by ID, unstarted tasks of a user and task insert")
+		("load-test-json", po::value<std::string>(), "File path including file name to write the load test report to as JSON")
 		("time-tests", "Time the execution of the tests")
+		("profile", "Report the time spent connecting, executing, decoding and hydrating in each database call")
+		("profile-json", po::value<std::string>(), "File path including file name to write the profile report to as JSON")
+		("query-stats", "Report the time, rows and bytes of each database statement and the slow statements")
+		("query-stats-json", po::value<std::string>(), "File path including file name to write the statement report to as JSON")
+		("trace", po::value<std::string>(), "File path including file name to write a Chrome trace of the database calls to, viewable in Perfetto")
+		("metrics-socket", po::value<std::string>(), "Unix domain socket path to serve live metrics on in the Prometheus text format while the program runs")
+		("slow-query-ms", po::value<unsigned int>()->default_value(100), "Statements that take at least this many milliseconds are kept in the slow statement log")
+		("alloc-stats", "Count the heap allocations of each database call and report them with the profile")
+		("alloc-budget", po::value<std::vector<std::string>>()->composing(), "Fail when one call of a database method makes more heap allocations than the budget, COUNT for every method or Class::method=COUNT, may be repeated")
+		("hw-counters", "Report the cycles, instructions, cache misses and branch misses of the database calls, their decoding and hydration, CSV parsing, date parsing and dictionary lookups")
+		("hw-counters-json", po::value<std::string>(), "File path including file name to write the hardware counter report to as JSON")
 		("verbose", "Output additional information for testing and debugging.")
 	;
 
@@ -96,7 +120,15 @@ static auto checkOptionsWithStringArguments(po::variables_map& inputOptions) ->
 		{"mysql-URL", &progOptions.mySqlUrl},
 		{"mysql-dbname", &progOptions.mySqlDBName},
 		{"user-data-file", &progOptions.userTestDataFile},
-		{"task-data-file", &progOptions.taskTestDataFile}
+		{"task-data-file", &progOptions.taskTestDataFile},
+		{"bulk-load-dir", &progOptions.bulkLoadDirectory},
+		{"profile-json", &progOptions.profileJSONFile},
+		{"query-stats-json", &progOptions.queryStatisticsJSONFile},
+		{"trace", &progOptions.traceFile},
+		{"metrics-socket", &progOptions.metricsSocket},
+		{"hw-counters-json", &progOptions.hardwareCountersJSONFile},
+		{"load-test-mix", &progOptions.loadTestMix},
+		{"load-test-json", &progOptions.loadTestJSONFile}
 	};
 	ProgOptStatus hasArguments = ProgOptStatus::NoErrors;
 	
@@ -123,6 +155,32 @@ static auto checkOptionsWithStringArguments(po::variables_map& inputOptions) ->
 	return progOptions;
 }
 
+static auto parseAllocationBudgets(const std::vector<std::string>& budgetArguments) ->
+	std::expected<std::vector<AllocationBudget>, ProgOptStatus>
+{
+	std::vector<AllocationBudget> budgets;
+	for (std::string_view budgetArgument: budgetArguments)
+	{
+		AllocationBudget budget{};
+		if (std::size_t separator = budgetArgument.rfind('='); separator != std::string_view::npos)
+		{
+			budget.method = budgetArgument.substr(0, separator);
+			budgetArgument.remove_prefix(separator + 1);
+		}
+
+		const char* countEnd = budgetArgument.data() + budgetArgument.size();
+		auto [parsedTo, errorCode] = std::from_chars(budgetArgument.data(), countEnd, budget.allocations);
+		if (errorCode != std::errc() || parsedTo != countEnd)
+		{
+			std::cerr << "The option \'--alloc-budget\' needs COUNT or Class::method=COUNT!\n";
+			return std::unexpected(ProgOptStatus::InvalidArgument);
+		}
+		budgets.push_back(std::move(budget));
+	}
+
+	return budgets;
+}
+
 static auto processProgramOptions(po::variables_map& inputOptions,
 	const std::string& progName) -> std::expected<ProgramOptions, ProgOptStatus>
 {
@@ -151,6 +209,49 @@ static auto processProgramOptions(po::variables_map& inputOptions,
 		programOptions.verboseOutput = true;
 	}
 
+	if (inputOptions.count("bulk-load")) {
+		programOptions.bulkLoad = true;
+	}
+
+	if (inputOptions.count("sync")) {
+		programOptions.syncDataFiles = true;
+	}
+
+	if (inputOptions.count("load-test")) {
+		programOptions.loadTest = true;
+	}
+
+	if (inputOptions.count("profile")) {
+		programOptions.profileOutput = true;
+	}
+
+	if (inputOptions.count("query-stats")) {
+		programOptions.queryStatisticsOutput = true;
+	}
+
+	if (inputOptions.count("alloc-stats")) {
+		programOptions.allocationStatistics = true;
+		programOptions.profileOutput = true;
+	}
+
+	if (inputOptions.count("hw-counters")) {
+		programOptions.hardwareCountersOutput = true;
+	}
+
+	if (inputOptions.count("alloc-budget")) {
+		const auto budgets = parseAllocationBudgets(inputOptions["alloc-budget"].as<std::vector<std::string>>());
+		if (!budgets.has_value())
+		{
+			return std::unexpected(budgets.error());
+		}
+		programOptions.allocationBudgets = *budgets;
+	}
+
+	programOptions.slowQueryMs = inputOptions["slow-query-ms"].as<unsigned int>();
+	programOptions.loadTestUsers = inputOptions["load-test-users"].as<unsigned int>();
+	programOptions.loadTestSeconds = inputOptions["load-test-seconds"].as<unsigned int>();
+	programOptions.loadTestRate = inputOptions["load-test-rate"].as<unsigned int>();
+
 	return programOptions;
 }
 
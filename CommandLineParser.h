@@ -1,8 +1,20 @@
 #ifndef COMMAND_LINE_PARSER_H_
 #define COMMAND_LINE_PARSER_H_
 
+#include <cstdint>
 #include <expected>
 #include <string>
+#include <vector>
+
+/*
+ * The most heap allocations a single call of a database method may make, an empty method
+ * applies to the methods that don't have their own budget.
+ */
+struct AllocationBudget
+{
+    std::string method;
+    std::uint64_t allocations;
+};
 
 struct ProgramOptions
 {
@@ -14,8 +26,28 @@ struct ProgramOptions
     std::string mySqlDBName;
     std::string userTestDataFile;
     std::string taskTestDataFile;
+    std::string bulkLoadDirectory;
+    std::string profileJSONFile;
+    std::string queryStatisticsJSONFile;
+    std::string traceFile;
+    std::string metricsSocket;
+    std::string hardwareCountersJSONFile;
+    std::string loadTestMix;
+    std::string loadTestJSONFile;
+    unsigned int slowQueryMs = 100;
+    unsigned int loadTestUsers = 8;
+    unsigned int loadTestSeconds = 30;
+    unsigned int loadTestRate = 0;
+    std::vector<AllocationBudget> allocationBudgets;
 	bool enableExecutionTime = false;
     bool verboseOutput = false;
+    bool bulkLoad = false;
+    bool syncDataFiles = false;
+    bool loadTest = false;
+    bool profileOutput = false;
+    bool queryStatisticsOutput = false;
+    bool allocationStatistics = false;
+    bool hardwareCountersOutput = false;
 };
 
 enum class CommandLineStatus
@@ -0,0 +1,50 @@
+#ifndef COMPACTDATE_H_
+#define COMPACTDATE_H_
+
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+/*
+ * A date stored as the number of days since 1970-01-01 in 4 bytes. Comparing and subtracting
+ * dates are integer operations, the calendar fields are only computed when a year_month_day is
+ * requested. A default constructed CompactDate has no value, it replaces
+ * std::optional<std::chrono::year_month_day> without the extra storage and converts to the
+ * default year_month_day.
+ */
+class CompactDate
+{
+public:
+    using DayNumber = std::int32_t;
+
+    static constexpr DayNumber NoDate = std::numeric_limits<DayNumber>::min();
+
+    constexpr CompactDate() = default;
+    constexpr explicit CompactDate(DayNumber days) : dayNumber{days} {};
+    constexpr CompactDate(std::chrono::year_month_day date)
+        : dayNumber{date.ok()? static_cast<DayNumber>(std::chrono::sys_days(date).time_since_epoch().count()) : NoDate} {};
+    constexpr CompactDate(std::chrono::sys_days date)
+        : dayNumber{static_cast<DayNumber>(date.time_since_epoch().count())} {};
+    constexpr CompactDate(std::optional<std::chrono::year_month_day> date)
+        : CompactDate(date.has_value()? CompactDate(*date) : CompactDate()) {};
+
+    constexpr bool hasValue() const { return dayNumber != NoDate; };
+    constexpr DayNumber getDayNumber() const { return dayNumber; };
+    constexpr std::chrono::sys_days toSysDays() const { return std::chrono::sys_days(std::chrono::days(dayNumber)); };
+    constexpr std::chrono::year_month_day toYearMonthDay() const
+        { return hasValue()? std::chrono::year_month_day(toSysDays()) : std::chrono::year_month_day(); };
+    constexpr std::optional<std::chrono::year_month_day> toOptional() const
+        { return hasValue()? std::optional<std::chrono::year_month_day>(toYearMonthDay()) : std::nullopt; };
+
+    constexpr CompactDate plusDays(int days) const { return CompactDate(dayNumber + days); };
+    constexpr DayNumber daysUntil(CompactDate other) const { return other.dayNumber - dayNumber; };
+
+    constexpr auto operator<=>(const CompactDate&) const = default;
+
+private:
+    DayNumber dayNumber = NoDate;
+};
+
+#endif // COMPACTDATE_H_
@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include "commonUtilities.h"
+#include "CompactDate.h"
+#include <cstddef>
+#include <cstdint>
+#include "DatasetGenerator.h"
+#include "DateParser.h"
+#include <expected>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static constexpr std::size_t FlushBytes = 1024 * 1024;
+static constexpr std::uint64_t TaskSeedOffset = 0x9E3779B97F4A7C15;
+static constexpr unsigned int ParentPercentage = 50;
+
+static constexpr std::array<std::string_view, 48> lastNames = {
+    "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Rodriguez", "Martinez",
+    "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson", "Thomas", "Taylor", "Moore", "Jackson", "Martin",
+    "Thompson", "White", "Harris", "Sanchez", "Clark", "Ramirez", "Lewis", "Robinson", "Walker", "Young",
+    "Allen", "King", "Wright", "Scott", "Torres", "Nguyen", "Hill", "Flores", "Green", "Adams",
+    "Nelson", "Baker", "Hall", "Rivera", "Campbell", "Mitchell", "Carter", "Roberts"
+};
+
+static constexpr std::array<std::string_view, 48> firstNames = {
+    "James", "Mary", "Robert", "Patricia", "John", "Jennifer", "Michael", "Linda", "David", "Elizabeth",
+    "William", "Barbara", "Richard", "Susan", "Joseph", "Jessica", "Thomas", "Sarah", "Charles", "Karen",
+    "Christopher", "Lisa", "Daniel", "Nancy", "Matthew", "Betty", "Anthony", "Margaret", "Mark", "Sandra",
+    "Donald", "Ashley", "Steven", "Kimberly", "Paul", "Emily", "Andrew", "Donna", "Joshua", "Michelle",
+    "Kenneth", "Carol", "Kevin", "Amanda", "Brian", "Dorothy", "George", "Melissa"
+};
+
+static constexpr std::array<std::string_view, 16> taskVerbs = {
+    "Review", "Update", "Prepare", "Archive", "Schedule", "Design", "Test", "Document",
+    "Migrate", "Install", "Clean up", "Plan", "Estimate", "Deploy", "Audit", "Summarize"
+};
+
+static constexpr std::array<std::string_view, 16> taskObjects = {
+    "quarterly budget report", "project website", "database backups", "team meeting notes",
+    "customer feedback survey", "release checklist", "onboarding guide", "vendor contracts",
+    "home office network", "garden irrigation system", "family photo library", "tax documents",
+    "conference presentation", "monthly newsletter", "server certificates", "travel itinerary"
+};
+
+// In the order of TaskModel::TaskStatus.
+static constexpr std::array<std::string_view, 5> statusLabels = {
+    "Not Started", "On Hold", "Waiting for Dependency", "Work in Progress", "Completed"
+};
+enum StatusIndex : unsigned int
+{
+    NotStarted, OnHold, WaitingForDependency, WorkInProgress, Completed
+};
+
+// Percentages, in the order of statusLabels and of the priority groups A to D.
+static const std::vector<unsigned int> statusWeights = {35, 5, 10, 25, 25};
+static const std::vector<unsigned int> priorityGroupWeights = {20, 40, 30, 10};
+
+template <typename Number>
+static bool parseNumber(std::string_view field, Number& value)
+{
+    const char* fieldEnd = field.data() + field.size();
+    auto [numberEnd, error] = std::from_chars(field.data(), fieldEnd, value);
+    return error == std::errc() && numberEnd == fieldEnd;
+}
+
+static void appendDate(std::string& text, CompactDate date)
+{
+    if (!date.hasValue())
+    {
+        return;
+    }
+
+    std::size_t dateStart = text.size();
+    CompactDate::DayNumber day = date.getDayNumber();
+    text.resize(dateStart + ISODateLength);
+    formatISODates(std::span(&day, 1), std::span(text).subspan(dateStart));
+}
+
+/*
+ * Efforts in hours are rounded to quarter hours, as they are entered.
+ */
+static double roundToQuarterHour(double hours)
+{
+    return std::round(hours * 4.0) / 4.0;
+}
+
+std::expected<DatasetGenerator::Settings, std::string> DatasetGenerator::parseSettings(std::string_view text)
+{
+    Settings settings;
+
+    while (!text.empty())
+    {
+        std::size_t pairEnd = std::min(text.find(','), text.size());
+        std::string_view pair = text.substr(0, pairEnd);
+        text.remove_prefix(std::min(pairEnd + 1, text.size()));
+
+        std::size_t equals = pair.find('=');
+        if (equals == std::string_view::npos)
+        {
+            return std::unexpected(std::format("expected name=value, found {}", pair));
+        }
+        std::string_view name = pair.substr(0, equals);
+        std::string_view value = pair.substr(equals + 1);
+
+        bool validValue = true;
+        if (name == "users")
+        {
+            validValue = parseNumber(value, settings.userCount);
+        }
+        else if (name == "tasks")
+        {
+            validValue = parseNumber(value, settings.taskCount);
+        }
+        else if (name == "seed")
+        {
+            validValue = parseNumber(value, settings.seed);
+        }
+        else if (name == "depth")
+        {
+            validValue = parseNumber(value, settings.hierarchyDepth) && settings.hierarchyDepth >= 1 &&
+                settings.hierarchyDepth <= 255;
+        }
+        else if (name == "fan-in")
+        {
+            validValue = parseNumber(value, settings.dependencyFanIn);
+        }
+        else if (name == "fan-out")
+        {
+            validValue = parseNumber(value, settings.dependencyFanOut);
+        }
+        else if (name == "start")
+        {
+            auto date = DateParser::parseAs(value, DateParser::Format::ISO);
+            validValue = date.has_value() && date->year() >= std::chrono::year{1000} &&
+                date->year() <= std::chrono::year{9000};
+            if (validValue)
+            {
+                settings.firstDate = *date;
+            }
+        }
+        else if (name == "days")
+        {
+            validValue = parseNumber(value, settings.dayCount) && settings.dayCount >= 1 &&
+                settings.dayCount <= 100'000;
+        }
+        else
+        {
+            return std::unexpected(std::format("unknown setting {}", name));
+        }
+
+        if (!validValue)
+        {
+            return std::unexpected(std::format("invalid value {} for {}", value, name));
+        }
+    }
+
+    return settings;
+}
+
+DatasetGenerator::DatasetGenerator(Settings settingsIn)
+: settings{settingsIn}, generator{settingsIn.seed}
+{
+}
+
+/*
+ * Every combination of the names is used once before a number is added to the last name, the
+ * combinations are visited in an order that depends on the seed.
+ */
+bool DatasetGenerator::writeUserFile(const std::string& fileName)
+{
+    std::ofstream userFile(fileName, std::ios::binary | std::ios::trunc);
+    if (!userFile)
+    {
+        errorMessages.append(std::format("Can't create the user file {}\n", fileName));
+        return false;
+    }
+
+    generator.seed(settings.seed);
+    constexpr std::uint64_t middleInitialCount = 26;
+    constexpr std::uint64_t combinationCount = lastNames.size() * firstNames.size() * middleInitialCount;
+    std::uint64_t stride = 1 + uniform(combinationCount - 1);
+    while (std::gcd(stride, combinationCount) != 1)
+    {
+        stride = 1 + uniform(combinationCount - 1);
+    }
+    std::uint64_t offset = uniform(combinationCount);
+
+    std::string text;
+    std::string email;
+    for (std::size_t user = 0; user < settings.userCount; ++user)
+    {
+        std::uint64_t combination = ((user % combinationCount) * stride + offset) % combinationCount;
+        std::size_t generation = user / combinationCount;
+        std::string_view lastName = lastNames[combination / (firstNames.size() * middleInitialCount)];
+        std::string_view firstName = firstNames[combination / middleInitialCount % firstNames.size()];
+        char middleInitial = static_cast<char>('A' + combination % middleInitialCount);
+        std::string nameNumber = generation > 0? std::to_string(generation + 1) : std::string();
+
+        email = std::format("{}.{}.{}{}@example.com", firstName, middleInitial, lastName, nameNumber);
+        std::ranges::transform(email, email.begin(), [](char character)
+            { return character >= 'A' && character <= 'Z'? static_cast<char>(character - 'A' + 'a') : character; });
+        std::format_to(std::back_inserter(text), "{}{},{},{},{}\n", lastName, nameNumber, firstName, middleInitial,
+            email);
+
+        if (text.size() >= FlushBytes && !flushText(userFile, text, fileName))
+        {
+            return false;
+        }
+    }
+
+    return flushText(userFile, text, fileName);
+}
+
+bool DatasetGenerator::writeTaskFile(const std::string& fileName)
+{
+    std::ofstream taskFile(fileName, std::ios::binary | std::ios::trunc);
+    if (!taskFile)
+    {
+        errorMessages.append(std::format("Can't create the task file {}\n", fileName));
+        return false;
+    }
+
+    generator.seed(settings.seed ^ TaskSeedOffset);
+    // Record numbers start at 1, index 0 is unused.
+    taskDepths.assign(settings.taskCount + 1, 0);
+    dependentCounts.assign(settings.taskCount + 1, 0);
+    taskStatuses.assign(settings.taskCount + 1, 0);
+    parentCount = 0;
+    dependencyCount = 0;
+
+    std::string text;
+    TaskRecord task;
+    for (std::size_t recordNumber = 1; recordNumber <= settings.taskCount; ++recordNumber)
+    {
+        chooseReferences(recordNumber, task);
+
+        // Work can't have started while a dependency isn't complete.
+        task.status = static_cast<unsigned int>(chooseWeighted(statusWeights));
+        if ((task.status == WorkInProgress || task.status == Completed) &&
+            std::ranges::any_of(task.dependencyRecordNumbers,
+                [this](std::size_t dependency) { return taskStatuses[dependency] != Completed; }))
+        {
+            task.status = WaitingForDependency;
+        }
+        taskStatuses[recordNumber] = static_cast<unsigned char>(task.status);
+
+        appendTaskRecord(text, recordNumber, task);
+        if (text.size() >= FlushBytes && !flushText(taskFile, text, fileName))
+        {
+            return false;
+        }
+    }
+
+    taskDepths.clear();
+    dependentCounts.clear();
+    taskStatuses.clear();
+
+    return flushText(taskFile, text, fileName);
+}
+
+/*
+ * Private methods.
+ */
+std::size_t DatasetGenerator::chooseWeighted(const std::vector<unsigned int>& weights)
+{
+    std::uint64_t choice = uniform(std::accumulate(weights.begin(), weights.end(), 0u));
+    std::size_t index = 0;
+    while (choice >= weights[index])
+    {
+        choice -= weights[index];
+        ++index;
+    }
+
+    return index;
+}
+
+/*
+ * A task only refers to tasks before it, so the dependencies can't form a cycle.
+ */
+void DatasetGenerator::chooseReferences(std::size_t recordNumber, TaskRecord& task)
+{
+    task.parentRecordNumber = 0;
+    task.dependencyRecordNumbers.clear();
+
+    std::size_t windowStart = recordNumber > ReferenceWindow? recordNumber - ReferenceWindow : 1;
+    std::size_t windowSize = recordNumber - windowStart;
+    if (windowSize == 0)
+    {
+        return;
+    }
+
+    if (settings.hierarchyDepth > 1 && uniform(100) < ParentPercentage)
+    {
+        for (unsigned int attempt = 0; attempt < 4; ++attempt)
+        {
+            std::size_t candidate = windowStart + uniform(windowSize);
+            if (taskDepths[candidate] + 1u < settings.hierarchyDepth)
+            {
+                task.parentRecordNumber = candidate;
+                taskDepths[recordNumber] = static_cast<unsigned char>(taskDepths[candidate] + 1);
+                ++parentCount;
+                break;
+            }
+        }
+    }
+
+    std::size_t wantedDependencies = uniform(settings.dependencyFanIn + 1ull);
+    for (std::size_t attempt = 0; attempt < 4 * wantedDependencies &&
+        task.dependencyRecordNumbers.size() < wantedDependencies; ++attempt)
+    {
+        std::size_t candidate = windowStart + uniform(windowSize);
+        if (candidate == task.parentRecordNumber || dependentCounts[candidate] >= settings.dependencyFanOut ||
+            std::ranges::find(task.dependencyRecordNumbers, candidate) != task.dependencyRecordNumbers.end())
+        {
+            continue;
+        }
+        task.dependencyRecordNumbers.push_back(candidate);
+        ++dependentCounts[candidate];
+    }
+    std::ranges::sort(task.dependencyRecordNumbers);
+    dependencyCount += task.dependencyRecordNumbers.size();
+}
+
+/*
+ * The columns of planData.txt: priority group, priority, description, required delivery,
+ * estimated effort, actual effort, parent record number, status, scheduled start, actual start,
+ * created on, an unused column, estimated completion and the dependency record numbers.
+ */
+void DatasetGenerator::appendTaskRecord(std::string& text, std::size_t recordNumber, const TaskRecord& task)
+{
+    char priorityGroup = static_cast<char>('A' + chooseWeighted(priorityGroupWeights));
+    std::uint64_t priority = 1 + uniform(9);
+    std::string_view verb = taskVerbs[uniform(taskVerbs.size())];
+    std::string_view object = taskObjects[uniform(taskObjects.size())];
+
+    // Most tasks take a few hours, a few take weeks.
+    std::uint64_t effortSize = uniform(100);
+    std::uint64_t estimatedEffort = effortSize < 70? 1 + uniform(8) : effortSize < 95? 9 + uniform(32) : 41 + uniform(160);
+    int effortDays = static_cast<int>(estimatedEffort / 4);
+
+    CompactDate createdOn = CompactDate(settings.firstDate).plusDays(static_cast<int>(uniform(std::max(settings.dayCount, 1u))));
+    CompactDate scheduledStart = createdOn.plusDays(static_cast<int>(uniform(15)));
+    CompactDate requiredDelivery = scheduledStart.plusDays(effortDays + static_cast<int>(uniform(30)));
+    CompactDate actualStart;
+    CompactDate estimatedCompletion;
+    double actualEffort = 0.0;
+    if (task.status == WorkInProgress || task.status == Completed)
+    {
+        actualStart = scheduledStart.plusDays(static_cast<int>(uniform(8)));
+        estimatedCompletion = actualStart.plusDays(effortDays + 1);
+        actualEffort = roundToQuarterHour(task.status == Completed?
+            estimatedEffort * (80 + uniform(41)) / 100.0 : estimatedEffort * uniform(100) / 100.0);
+    }
+
+    std::format_to(std::back_inserter(text), "{},{},{} {} {},", priorityGroup, priority, verb, object, recordNumber);
+    appendDate(text, requiredDelivery);
+    std::format_to(std::back_inserter(text), ",{},{},{},{},", estimatedEffort, actualEffort, task.parentRecordNumber,
+        statusLabels[task.status]);
+    appendDate(text, scheduledStart);
+    text.push_back(',');
+    appendDate(text, actualStart);
+    text.push_back(',');
+    appendDate(text, createdOn);
+    text.append(",,");
+    appendDate(text, estimatedCompletion);
+    text.push_back(',');
+    for (std::size_t dependency: task.dependencyRecordNumbers)
+    {
+        if (dependency != task.dependencyRecordNumbers.front())
+        {
+            text.push_back(';');
+        }
+        std::format_to(std::back_inserter(text), "{}", dependency);
+    }
+    text.push_back('\n');
+}
+
+bool DatasetGenerator::flushText(std::ofstream& file, std::string& text, const std::string& fileName)
+{
+    if (!file.write(text.data(), static_cast<std::streamsize>(text.size())) || !file.flush())
+    {
+        errorMessages.append(std::format("Can't write to {}\n", fileName));
+        return false;
+    }
+    text.clear();
+
+    return true;
+}
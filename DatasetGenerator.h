@@ -0,0 +1,91 @@
+#ifndef DATASETGENERATOR_H_
+#define DATASETGENERATOR_H_
+
+#include <chrono>
+#include "CompactDate.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Generates user and task files in the formats of testData/userData.txt and
+ * testData/planData.txt at any scale, for loading with CSVImporter or BulkLoader. The same
+ * settings always produce the same files: the random numbers come from std::mt19937_64, whose
+ * sequence the standard defines, and are mapped to ranges here rather than by the standard
+ * distributions, whose results differ between libraries.
+ *
+ * Users have unique full names and login names, names repeat with a number added to the last
+ * name once every combination has been used. Tasks get priority groups, priorities, efforts and
+ * statuses in proportions like those of a real planner, dates within the configured range, a
+ * parent hierarchy up to the configured depth and dependencies that form a DAG. A task depends
+ * on up to dependencyFanIn earlier tasks and no task has more than dependencyFanOut dependents.
+ * Parents and dependencies are chosen among the ReferenceWindow tasks before the task, the way
+ * the tasks of one project are close together in a file.
+ *
+ * The task file has no column for the user the tasks belong to, the importers assign all of
+ * them to one owner.
+ */
+class DatasetGenerator
+{
+public:
+    struct Settings
+    {
+        std::uint64_t seed = 1;
+        std::size_t userCount = 1000;
+        std::size_t taskCount = 10000;
+        // The most levels of tasks, 1 means that no task has a parent.
+        unsigned int hierarchyDepth = 3;
+        unsigned int dependencyFanIn = 2;
+        unsigned int dependencyFanOut = 4;
+        std::chrono::year_month_day firstDate{std::chrono::year{2024}, std::chrono::January, std::chrono::day{1}};
+        unsigned int dayCount = 730;
+    };
+
+/*
+ * Settings as comma separated name=value pairs, for example
+ * "users=1000000,tasks=5000000,seed=7,depth=4,fan-in=3,fan-out=6,start=2024-01-01,days=730".
+ * Names that are left out keep their default values.
+ */
+    static std::expected<Settings, std::string> parseSettings(std::string_view text);
+
+    explicit DatasetGenerator(Settings settingsIn);
+
+    bool writeUserFile(const std::string& fileName);
+    bool writeTaskFile(const std::string& fileName);
+    std::size_t getParentCount() const { return parentCount; };
+    std::size_t getDependencyCount() const { return dependencyCount; };
+    std::string getAllErrorMessages() const { return errorMessages; };
+
+    static constexpr std::size_t ReferenceWindow = 1000;
+
+private:
+    struct TaskRecord
+    {
+        std::size_t parentRecordNumber = 0;
+        std::vector<std::size_t> dependencyRecordNumbers;
+        unsigned int status = 0;
+    };
+
+    std::uint64_t uniform(std::uint64_t bound) { return generator() % bound; };
+    std::size_t chooseWeighted(const std::vector<unsigned int>& weights);
+    void chooseReferences(std::size_t recordNumber, TaskRecord& task);
+    void appendTaskRecord(std::string& text, std::size_t recordNumber, const TaskRecord& task);
+    bool flushText(std::ofstream& file, std::string& text, const std::string& fileName);
+
+    Settings settings;
+    std::mt19937_64 generator;
+    // Per task, indexed by record number.
+    std::vector<unsigned char> taskDepths;
+    std::vector<unsigned int> dependentCounts;
+    std::vector<unsigned char> taskStatuses;
+    std::size_t parentCount = 0;
+    std::size_t dependencyCount = 0;
+    std::string errorMessages;
+};
+
+#endif // DATASETGENERATOR_H_
@@ -0,0 +1,230 @@
+#include <array>
+#include <chrono>
+#include "DateParser.h"
+#include <expected>
+#include "HardwareCounters.h"
+#include <string_view>
+
+static constexpr std::array<DateParser::Format, 4> allFormats = {
+    DateParser::Format::ISO,
+    DateParser::Format::MonthNameDayYear,
+    DateParser::Format::SlashMonthDayYear,
+    DateParser::Format::DashMonthDayYear
+};
+
+static constexpr std::array<std::string_view, 12> monthNames = {
+    "january", "february", "march", "april", "may", "june",
+    "july", "august", "september", "october", "november", "december"
+};
+
+static constexpr bool isDigit(char character) { return character >= '0' && character <= '9'; }
+static constexpr bool isSpace(char character) { return character == ' ' || character == '\t'; }
+static constexpr char toLower(char character)
+{
+    return character >= 'A' && character <= 'Z'? static_cast<char>(character - 'A' + 'a') : character;
+}
+
+static std::string_view trimSpaces(std::string_view text)
+{
+    while (!text.empty() && isSpace(text.front()))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back()))
+    {
+        text.remove_suffix(1);
+    }
+
+    return text;
+}
+
+static void skipSpaces(std::string_view& text)
+{
+    while (!text.empty() && isSpace(text.front()))
+    {
+        text.remove_prefix(1);
+    }
+}
+
+/*
+ * Consumes minimumDigits to maximumDigits digits from the front of the text.
+ */
+static bool readNumber(std::string_view& text, std::size_t minimumDigits, std::size_t maximumDigits, unsigned int& value)
+{
+    std::size_t digitCount = 0;
+    value = 0;
+    while (digitCount < text.size() && digitCount < maximumDigits && isDigit(text[digitCount]))
+    {
+        value = value * 10 + static_cast<unsigned int>(text[digitCount] - '0');
+        ++digitCount;
+    }
+    text.remove_prefix(digitCount);
+
+    return digitCount >= minimumDigits;
+}
+
+static bool readCharacter(std::string_view& text, char expected)
+{
+    if (text.empty() || text.front() != expected)
+    {
+        return false;
+    }
+    text.remove_prefix(1);
+
+    return true;
+}
+
+/*
+ * The full English name or its first three letters, in any case.
+ */
+static bool readMonthName(std::string_view& text, unsigned int& month)
+{
+    std::size_t letterCount = 0;
+    while (letterCount < text.size() && toLower(text[letterCount]) >= 'a' && toLower(text[letterCount]) <= 'z')
+    {
+        ++letterCount;
+    }
+    if (letterCount < 3)
+    {
+        return false;
+    }
+
+    for (std::size_t monthIndex = 0; monthIndex < monthNames.size(); ++monthIndex)
+    {
+        std::string_view monthName = monthNames[monthIndex];
+        if (letterCount != 3 && letterCount != monthName.size())
+        {
+            continue;
+        }
+
+        std::size_t letter = 0;
+        while (letter < letterCount && toLower(text[letter]) == monthName[letter])
+        {
+            ++letter;
+        }
+        if (letter == letterCount)
+        {
+            month = static_cast<unsigned int>(monthIndex + 1);
+            text.remove_prefix(letterCount);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static std::expected<std::chrono::year_month_day, DateParser::Error> makeDate(unsigned int year, unsigned int month,
+    unsigned int day)
+{
+    std::chrono::year_month_day date{std::chrono::year{static_cast<int>(year)}, std::chrono::month{month},
+        std::chrono::day{day}};
+    if (!date.ok())
+    {
+        return std::unexpected(DateParser::Error::InvalidDate);
+    }
+
+    return date;
+}
+
+std::expected<std::chrono::year_month_day, DateParser::Error> DateParser::parse(std::string_view text)
+{
+    HardwareCounterZone zone("date parse");
+    text = trimSpaces(text);
+    if (text.empty())
+    {
+        return std::unexpected(Error::Blank);
+    }
+
+    auto date = parseAs(text, lastFormat);
+    if (date.has_value() || date.error() != Error::UnknownFormat)
+    {
+        return date;
+    }
+
+    for (Format format: allFormats)
+    {
+        if (format == lastFormat)
+        {
+            continue;
+        }
+
+        date = parseAs(text, format);
+        if (date.has_value())
+        {
+            lastFormat = format;
+        }
+        if (date.has_value() || date.error() != Error::UnknownFormat)
+        {
+            return date;
+        }
+    }
+
+    return date;
+}
+
+std::expected<std::chrono::year_month_day, DateParser::Error> DateParser::parseAs(std::string_view text, Format format)
+{
+    text = trimSpaces(text);
+    if (text.empty())
+    {
+        return std::unexpected(Error::Blank);
+    }
+
+    unsigned int year = 0;
+    unsigned int month = 0;
+    unsigned int day = 0;
+    bool matched = false;
+
+    switch (format)
+    {
+        case Format::ISO:
+            matched = readNumber(text, 4, 4, year) && readCharacter(text, '-') && readNumber(text, 1, 2, month) &&
+                readCharacter(text, '-') && readNumber(text, 1, 2, day);
+            break;
+
+        case Format::MonthNameDayYear:
+            matched = readMonthName(text, month);
+            if (matched)
+            {
+                skipSpaces(text);
+                matched = readNumber(text, 1, 2, day) && readCharacter(text, ',');
+            }
+            if (matched)
+            {
+                skipSpaces(text);
+                matched = readNumber(text, 4, 4, year);
+            }
+            break;
+
+        case Format::SlashMonthDayYear:
+        case Format::DashMonthDayYear:
+        {
+            char separator = format == Format::SlashMonthDayYear? '/' : '-';
+            matched = readNumber(text, 1, 2, month) && readCharacter(text, separator) && readNumber(text, 1, 2, day) &&
+                readCharacter(text, separator) && readNumber(text, 4, 4, year);
+            break;
+        }
+    }
+
+    if (!matched || !text.empty())
+    {
+        return std::unexpected(Error::UnknownFormat);
+    }
+
+    return makeDate(year, month, day);
+}
+
+std::string_view DateParser::errorMessage(Error error)
+{
+    switch (error)
+    {
+        case Error::Blank:
+            return "the date is blank";
+        case Error::UnknownFormat:
+            return "the date is not in a supported format";
+        case Error::InvalidDate:
+            return "the date does not exist";
+    }
+
+    return "unknown date error";
+}
@@ -0,0 +1,44 @@
+#ifndef DATEPARSER_H_
+#define DATEPARSER_H_
+
+#include <chrono>
+#include <expected>
+#include <string_view>
+
+/*
+ * Parses the date formats accepted in the CSV files by hand, without allocating and without
+ * locales: ISO "2025-04-08", "April 8, 2025" (English month names, full or the first three
+ * letters, any case), "04/08/2025" and "04-08-2025". Leading and trailing spaces are ignored.
+ *
+ * A parser tries the format of the last date it parsed first. Use one parser per column, the
+ * dates in a column usually share one format even when the columns of a file don't. A parser
+ * is not thread safe.
+ */
+class DateParser
+{
+public:
+    enum class Format : unsigned char
+    {
+        ISO, MonthNameDayYear, SlashMonthDayYear, DashMonthDayYear
+    };
+
+    enum class Error : unsigned char
+    {
+        Blank, UnknownFormat, InvalidDate
+    };
+
+    std::expected<std::chrono::year_month_day, Error> parse(std::string_view text);
+    Format getLastFormat() const { return lastFormat; };
+
+/*
+ * Parse text that must be in one format. Error::UnknownFormat means the text doesn't have the
+ * layout of the format, Error::InvalidDate that it does but the date doesn't exist.
+ */
+    static std::expected<std::chrono::year_month_day, Error> parseAs(std::string_view text, Format format);
+    static std::string_view errorMessage(Error error);
+
+private:
+    Format lastFormat = Format::ISO;
+};
+
+#endif // DATEPARSER_H_
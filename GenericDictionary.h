@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <exception>
 #include <expected>
+#include "HardwareCounters.h"
 #include <initializer_list>
 #include <ranges>
 #include <stdexcept>
@@ -72,6 +73,7 @@ public:
 
     auto lookupID(DictName itemName) const -> std::expected<DictID, DictionaryLookUpError>
     {
+        HardwareCounterZone zone("dictionary lookup");
         auto definition = nameSearchTable.find(itemName);
         if (definition != nameSearchTable.end())
         {
@@ -83,6 +85,7 @@ public:
 
     auto lookupName(DictID id) const -> std::expected<DictName, DictionaryLookUpError>
     {
+        HardwareCounterZone zone("dictionary lookup");
         auto definition = idSearchTable.find(id);
         if (definition != idSearchTable.end())
         {
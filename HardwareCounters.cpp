@@ -0,0 +1,470 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include "commonUtilities.h"
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include "HardwareCounters.h"
+#include <linux/perf_event.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Written only by the thread that owns it, read by the reports.
+ */
+struct HardwareCounters::ZoneCounters
+{
+    std::string_view name;
+    std::atomic<std::uint64_t> count = 0;
+    std::array<std::atomic<std::uint64_t>, CounterCount> totals{};
+};
+
+struct ZoneTotals
+{
+    std::uint64_t count = 0;
+    HardwareCounters::Values totals{};
+};
+
+/*
+ * The counters of one thread, one perf event group led by the first counter that opened.
+ * The zones are only added by the owning thread, under zoneMutex so a report can walk them.
+ */
+struct HardwareCounters::ThreadCounters
+{
+    bool opened = false;
+    int groupFd = -1;
+    std::array<int, CounterCount> fds;
+    std::array<std::size_t, CounterCount> groupPositions{};
+    std::size_t groupSize = 0;
+    std::array<perf_event_mmap_page*, CounterCount> pages{};
+    bool userRead = false;
+    std::mutex zoneMutex;
+    std::unordered_map<const char*, ZoneCounters> zones;
+
+    ThreadCounters() { fds.fill(-1); };
+    ~ThreadCounters();
+};
+
+struct HardwareCounters::Registry
+{
+    std::mutex mutex;
+    std::uint32_t availableCounters = 0;
+    std::string errorMessage;
+    std::vector<std::shared_ptr<ThreadCounters>> threadCounters;
+    std::map<std::string, ZoneTotals, std::less<>> retiredTotals;
+};
+
+struct CounterDefinition
+{
+    std::string_view name;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+static constexpr std::array<CounterDefinition, HardwareCounters::CounterCount> counterDefinitions = {{
+    {"Cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"Instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"L1D misses", PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"LLC misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"Branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+}};
+
+static constexpr std::uint32_t AllCounters = (1u << HardwareCounters::CounterCount) - 1;
+
+static int openCounter(const CounterDefinition& definition, int groupFd)
+{
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = definition.type;
+    attributes.config = definition.config;
+    attributes.read_format = PERF_FORMAT_GROUP;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // The leader starts the group once all members are added and pins it, so the members are
+    // always counted together instead of being multiplexed.
+    attributes.disabled = groupFd < 0? 1 : 0;
+    attributes.pinned = groupFd < 0? 1 : 0;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+#if defined(__x86_64__)
+/*
+ * The seqlock protocol of perf_event_mmap_page, the kernel's offset plus the live count of the
+ * hardware counter, sign extended from its width.
+ */
+static std::uint64_t readUserCounter(const perf_event_mmap_page* page)
+{
+    std::uint32_t sequence;
+    std::uint64_t count;
+    do
+    {
+        sequence = __atomic_load_n(&page->lock, __ATOMIC_ACQUIRE);
+        count = static_cast<std::uint64_t>(page->offset);
+        if (std::uint32_t index = page->index; index != 0)
+        {
+            unsigned int unusedBits = 64 - page->pmc_width;
+            std::int64_t hardwareCount = static_cast<std::int64_t>(__builtin_ia32_rdpmc(static_cast<int>(index - 1)));
+            count += static_cast<std::uint64_t>((hardwareCount << unusedBits) >> unusedBits);
+        }
+        std::atomic_signal_fence(std::memory_order_acq_rel);
+    } while (__atomic_load_n(&page->lock, __ATOMIC_ACQUIRE) != sequence);
+
+    return count;
+}
+#endif
+
+bool HardwareCounters::enable()
+{
+    {
+        Registry& countersRegistry = registry();
+        std::lock_guard<std::mutex> registryLock(countersRegistry.mutex);
+        if (countersRegistry.availableCounters == 0)
+        {
+            countersRegistry.availableCounters = AllCounters;
+        }
+    }
+
+    ThreadCounters& counters = threadCounters();
+    if (!counters.opened && !openThreadCounters(counters))
+    {
+        return false;
+    }
+    enabled.store(true, std::memory_order_relaxed);
+
+    for (std::size_t sample = 0; sample < OverheadSamples; ++sample)
+    {
+        HardwareCounterZone overheadZone(OverheadZone);
+    }
+
+    return true;
+}
+
+std::string HardwareCounters::getErrorMessage()
+{
+    Registry& countersRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(countersRegistry.mutex);
+    return countersRegistry.errorMessage;
+}
+
+std::string_view HardwareCounters::getCounterName(Counter counter)
+{
+    return counterDefinitions[static_cast<std::size_t>(counter)].name;
+}
+
+std::vector<HardwareCounters::ZoneReport> HardwareCounters::getReport()
+{
+    std::map<std::string, ZoneTotals, std::less<>> totals;
+    std::uint32_t availableCounters;
+    {
+        Registry& countersRegistry = registry();
+        std::lock_guard<std::mutex> registryLock(countersRegistry.mutex);
+        availableCounters = countersRegistry.availableCounters;
+        totals = countersRegistry.retiredTotals;
+        for (const auto& counters: countersRegistry.threadCounters)
+        {
+            std::lock_guard<std::mutex> zoneLock(counters->zoneMutex);
+            for (const auto& [nameAddress, zone]: counters->zones)
+            {
+                ZoneTotals& zoneTotals = totals.try_emplace(std::string(zone.name)).first->second;
+                zoneTotals.count += zone.count.load(std::memory_order_relaxed);
+                for (std::size_t counter = 0; counter < CounterCount; ++counter)
+                {
+                    zoneTotals.totals[counter] += zone.totals[counter].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    std::vector<ZoneReport> report;
+    for (const auto& [name, zoneTotals]: totals)
+    {
+        if (zoneTotals.count == 0)
+        {
+            continue;
+        }
+
+        ZoneReport& zone = report.emplace_back(name, zoneTotals.count);
+        for (std::size_t counter = 0; counter < CounterCount; ++counter)
+        {
+            if (availableCounters & (1u << counter))
+            {
+                zone.means[counter] =
+                    static_cast<double>(zoneTotals.totals[counter]) / static_cast<double>(zoneTotals.count);
+            }
+        }
+    }
+
+    return report;
+}
+
+/*
+ * The counts are per call of the zone.
+ */
+std::string HardwareCounters::getTextReport()
+{
+    std::vector<ZoneReport> report = getReport();
+
+    std::size_t nameWidth = 4;
+    for (const auto& zone: report)
+    {
+        nameWidth = std::max(nameWidth, zone.name.size());
+    }
+
+    std::string text = std::format("{:<{}} {:>10}", "Zone", nameWidth, "Count");
+    for (const auto& definition: counterDefinitions)
+    {
+        text.append(std::format(" {:>14}", definition.name));
+    }
+    text.append(std::format(" {:>6}\n", "IPC"));
+
+    for (const auto& zone: report)
+    {
+        text.append(std::format("{:<{}} {:>10}", zone.name, nameWidth, zone.count));
+        for (const auto& mean: zone.means)
+        {
+            text.append(mean.has_value()? std::format(" {:>14.1f}", *mean) : std::format(" {:>14}", "n/a"));
+        }
+
+        const auto& cycles = zone.means[static_cast<std::size_t>(Counter::Cycles)];
+        const auto& instructions = zone.means[static_cast<std::size_t>(Counter::Instructions)];
+        text.append(cycles.has_value() && instructions.has_value() && *cycles > 0?
+            std::format(" {:>6.2f}\n", *instructions / *cycles) : std::format(" {:>6}\n", "n/a"));
+    }
+
+    return text;
+}
+
+std::string HardwareCounters::getJSONReport()
+{
+    std::vector<ZoneReport> report = getReport();
+
+    std::string json("{\"zones\":[");
+    for (const auto& zone: report)
+    {
+        json.append(&zone == report.data()? "{\"name\":" : ",{\"name\":");
+        appendJSONString(json, zone.name);
+        json.append(std::format(",\"count\":{},\"perCall\":{{", zone.count));
+        for (std::size_t counter = 0; counter < CounterCount; ++counter)
+        {
+            json.append(counter == 0? "" : ",");
+            appendJSONString(json, counterDefinitions[counter].name);
+            json.append(zone.means[counter].has_value()? std::format(":{}", *zone.means[counter]) : ":null");
+        }
+        json.append("}}");
+    }
+    json.append("]}\n");
+
+    return json;
+}
+
+bool HardwareCounters::readThreadCounters(Values& values)
+{
+    ThreadCounters& counters = threadCounters();
+    if (!counters.opened && !openThreadCounters(counters))
+    {
+        return false;
+    }
+    if (counters.groupFd < 0)
+    {
+        return false;
+    }
+
+    values.fill(0);
+#if defined(__x86_64__)
+    if (counters.userRead)
+    {
+        for (std::size_t counter = 0; counter < CounterCount; ++counter)
+        {
+            if (counters.pages[counter] != nullptr)
+            {
+                values[counter] = readUserCounter(counters.pages[counter]);
+            }
+        }
+        return true;
+    }
+#endif
+
+    // The group is read as the number of counters followed by their values.
+    std::array<std::uint64_t, CounterCount + 1> groupValues;
+    ssize_t expectedSize = static_cast<ssize_t>((counters.groupSize + 1) * sizeof(std::uint64_t));
+    if (read(counters.groupFd, groupValues.data(), sizeof(groupValues)) < expectedSize)
+    {
+        return false;
+    }
+    for (std::size_t counter = 0; counter < CounterCount; ++counter)
+    {
+        if (counters.fds[counter] >= 0)
+        {
+            values[counter] = groupValues[counters.groupPositions[counter] + 1];
+        }
+    }
+
+    return true;
+}
+
+void HardwareCounters::addZone(std::string_view name, const Values& start)
+{
+    Values end;
+    if (!readThreadCounters(end))
+    {
+        return;
+    }
+
+    ThreadCounters& counters = threadCounters();
+    auto zone = counters.zones.find(name.data());
+    if (zone == counters.zones.end())
+    {
+        std::lock_guard<std::mutex> zoneLock(counters.zoneMutex);
+        zone = counters.zones.try_emplace(name.data()).first;
+        zone->second.name = name;
+    }
+
+    // Only the owning thread writes, a load and a store are enough and cheaper than fetch_add().
+    ZoneCounters& zoneCounters = zone->second;
+    zoneCounters.count.store(zoneCounters.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    for (std::size_t counter = 0; counter < CounterCount; ++counter)
+    {
+        std::atomic<std::uint64_t>& total = zoneCounters.totals[counter];
+        total.store(total.load(std::memory_order_relaxed) + (end[counter] - start[counter]), std::memory_order_relaxed);
+    }
+}
+
+/*
+ * Private methods.
+ */
+HardwareCounters::ThreadCounters::~ThreadCounters()
+{
+    for (std::size_t counter = 0; counter < CounterCount; ++counter)
+    {
+        if (pages[counter] != nullptr)
+        {
+            munmap(pages[counter], static_cast<std::size_t>(sysconf(_SC_PAGESIZE)));
+        }
+        if (fds[counter] >= 0)
+        {
+            close(fds[counter]);
+        }
+    }
+}
+
+HardwareCounters::Registry& HardwareCounters::registry()
+{
+    static Registry countersRegistry;
+    return countersRegistry;
+}
+
+/*
+ * The counters are registered on the first zone of the thread after enable(). When the thread
+ * exits its totals are merged into the registry.
+ */
+HardwareCounters::ThreadCounters& HardwareCounters::threadCounters()
+{
+    struct ThreadCountersOwner
+    {
+        std::shared_ptr<ThreadCounters> counters = std::make_shared<ThreadCounters>();
+
+        ThreadCountersOwner()
+        {
+            Registry& countersRegistry = registry();
+            std::lock_guard<std::mutex> registryLock(countersRegistry.mutex);
+            countersRegistry.threadCounters.push_back(counters);
+        }
+        ~ThreadCountersOwner() { retireThread(counters); }
+    };
+
+    thread_local ThreadCountersOwner owner;
+    return *owner.counters;
+}
+
+/*
+ * Only the counters that opened on the first thread are opened on the others, so the reports
+ * of all threads cover the same counters. The first thread's failures are kept as the error
+ * message. The counters are only opened once per thread, whether or not that succeeds.
+ */
+bool HardwareCounters::openThreadCounters(ThreadCounters& counters)
+{
+    counters.opened = true;
+
+    Registry& countersRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(countersRegistry.mutex);
+
+    std::uint32_t openedCounters = 0;
+    for (std::size_t counter = 0; counter < CounterCount; ++counter)
+    {
+        if (!(countersRegistry.availableCounters & (1u << counter)))
+        {
+            continue;
+        }
+
+        int fd = openCounter(counterDefinitions[counter], counters.groupFd);
+        if (fd < 0)
+        {
+            countersRegistry.errorMessage.append(std::format("Can't open the {} counter : {}\n",
+                counterDefinitions[counter].name, std::strerror(errno)));
+            continue;
+        }
+
+        counters.fds[counter] = fd;
+        counters.groupPositions[counter] = counters.groupSize++;
+        counters.groupFd = counters.groupFd < 0? fd : counters.groupFd;
+        openedCounters |= 1u << counter;
+    }
+    if (counters.groupFd < 0)
+    {
+        return false;
+    }
+    countersRegistry.availableCounters &= openedCounters;
+
+#if defined(__x86_64__)
+    counters.userRead = true;
+    std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    for (std::size_t counter = 0; counter < CounterCount; ++counter)
+    {
+        if (counters.fds[counter] < 0)
+        {
+            continue;
+        }
+        void* page = mmap(nullptr, pageSize, PROT_READ, MAP_SHARED, counters.fds[counter], 0);
+        if (page == MAP_FAILED)
+        {
+            counters.userRead = false;
+            continue;
+        }
+        counters.pages[counter] = static_cast<perf_event_mmap_page*>(page);
+        counters.userRead = counters.userRead && counters.pages[counter]->cap_user_rdpmc;
+    }
+#endif
+
+    return ioctl(counters.groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0;
+}
+
+void HardwareCounters::retireThread(const std::shared_ptr<ThreadCounters>& counters)
+{
+    Registry& countersRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(countersRegistry.mutex);
+
+    for (const auto& [nameAddress, zone]: counters->zones)
+    {
+        ZoneTotals& zoneTotals = countersRegistry.retiredTotals.try_emplace(std::string(zone.name)).first->second;
+        zoneTotals.count += zone.count.load(std::memory_order_relaxed);
+        for (std::size_t counter = 0; counter < CounterCount; ++counter)
+        {
+            zoneTotals.totals[counter] += zone.totals[counter].load(std::memory_order_relaxed);
+        }
+    }
+    std::erase(countersRegistry.threadCounters, counters);
+}
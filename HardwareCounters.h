@@ -0,0 +1,120 @@
+#ifndef HARDWARECOUNTERS_H_
+#define HARDWARECOUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Hardware performance counters of named zones, read with Linux perf_event_open(). Each thread
+ * counts the cycles, instructions, L1 data cache read misses, last level cache misses and
+ * branch misses of its own user space code. The counters are only opened once enable() is
+ * called, until then a zone only checks one flag.
+ *
+ * Where the kernel allows it the counters are read in user space with rdpmc, otherwise with one
+ * read() of the counter group. Either way reading the counters costs something, enable() times
+ * a set of empty zones under the name "counter read overhead" to compare small zones against.
+ *
+ * Counters the processor or the virtual machine doesn't have are left out and reported as n/a.
+ * When none can be opened, for example because perf_event_paranoid forbids it, enable() returns
+ * false and zones stay inactive.
+ *
+ * Every ProfileZone is also a counter zone. HardwareCounterZone counts the scopes that are too
+ * small to profile, it costs nothing measurable while the counters are disabled.
+ *
+ * Zone names must have static storage duration, the counts are kept per thread by the address
+ * of the name and merged by name in the reports.
+ */
+class HardwareCounters
+{
+public:
+    enum class Counter : std::size_t
+    {
+        Cycles,
+        Instructions,
+        L1DataMisses,
+        LastLevelCacheMisses,
+        BranchMisses
+    };
+    static constexpr std::size_t CounterCount = 5;
+
+    using Values = std::array<std::uint64_t, CounterCount>;
+
+    struct ZoneReport
+    {
+        std::string name;
+        std::uint64_t count;
+        // Per call of the zone, empty for counters that aren't available.
+        std::array<std::optional<double>, CounterCount> means;
+    };
+
+/*
+ * Opens the counters of the calling thread, other threads open theirs on their first zone.
+ */
+    static bool enable();
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); };
+    static std::string getErrorMessage();
+    static std::string_view getCounterName(Counter counter);
+
+/*
+ * In order of zone name.
+ */
+    static std::vector<ZoneReport> getReport();
+    static std::string getTextReport();
+    static std::string getJSONReport();
+
+/*
+ * Used by the zones. Returns false when the calling thread has no counters.
+ */
+    static bool readThreadCounters(Values& values);
+    static void addZone(std::string_view name, const Values& start);
+
+private:
+    static constexpr std::string_view OverheadZone = "counter read overhead";
+    static constexpr std::size_t OverheadSamples = 1000;
+
+    inline static std::atomic<bool> enabled = false;
+
+    struct ZoneCounters;
+    struct ThreadCounters;
+    struct Registry;
+
+    static Registry& registry();
+    static ThreadCounters& threadCounters();
+    static bool openThreadCounters(ThreadCounters& counters);
+    static void retireThread(const std::shared_ptr<ThreadCounters>& counters);
+};
+
+/*
+ * Counts its scope as a zone of the current thread.
+ */
+class HardwareCounterZone
+{
+public:
+    explicit HardwareCounterZone(std::string_view nameIn)
+    : name{nameIn}, active{HardwareCounters::isEnabled() && HardwareCounters::readThreadCounters(start)}
+    {
+    };
+    ~HardwareCounterZone()
+    {
+        if (active)
+        {
+            HardwareCounters::addZone(name, start);
+        }
+    };
+    HardwareCounterZone(const HardwareCounterZone&) = delete;
+    HardwareCounterZone& operator=(const HardwareCounterZone&) = delete;
+
+private:
+    std::string_view name;
+    HardwareCounters::Values start;
+    bool active;
+};
+
+#endif // HARDWARECOUNTERS_H_
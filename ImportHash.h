@@ -0,0 +1,60 @@
+#ifndef IMPORTHASH_H_
+#define IMPORTHASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*
+ * Hashes that identify a record of an import file across imports. The import key hashes the
+ * fields that name the record, the full name of a user or the description of a task. The content
+ * hash covers every field of the record. Both are stored with the row, a record whose import key
+ * matches a stored row with the same content hash doesn't have to be written again.
+ *
+ * The hashes are 64 bit FNV-1a, stable across runs, compilers and platforms, unlike std::hash.
+ */
+struct ImportHash
+{
+    std::uint64_t importKey = 0;
+    std::uint64_t content = 0;
+};
+
+/*
+ * A row written by an earlier import, rowID is the UserID or the TaskID.
+ */
+struct ImportedRow
+{
+    std::size_t rowID;
+    ImportHash hash;
+};
+
+constexpr std::uint64_t ImportHashSeed = 14695981039346656037ull;
+
+/*
+ * Adds one field to the hash. The field is terminated by a unit separator so that the fields
+ * "ab", "c" and "a", "bc" hash differently.
+ */
+constexpr std::uint64_t hashImportField(std::uint64_t hash, std::string_view field)
+{
+    constexpr std::uint64_t FNVPrime = 1099511628211ull;
+
+    for (char character: field)
+    {
+        hash = (hash ^ static_cast<unsigned char>(character)) * FNVPrime;
+    }
+
+    return (hash ^ 0x1Fu) * FNVPrime;
+}
+
+constexpr std::uint64_t userImportKey(std::string_view lastName, std::string_view firstName,
+    std::string_view middleInitial)
+{
+    return hashImportField(hashImportField(hashImportField(ImportHashSeed, lastName), firstName), middleInitial);
+}
+
+constexpr std::uint64_t taskImportKey(std::string_view description)
+{
+    return hashImportField(ImportHashSeed, description);
+}
+
+#endif // IMPORTHASH_H_
@@ -0,0 +1,369 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include "commonUtilities.h"
+#include "CompactDate.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include "LoadTester.h"
+#include "LogLinearHistogram.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include "TaskDbInterface.h"
+#include "TaskModel.h"
+#include "TaskStore.h"
+#include <thread>
+#include "UserDbInterface.h"
+#include "UserModel.h"
+#include <vector>
+
+static constexpr double NanosecondsPerMs = 1'000'000.0;
+static constexpr unsigned int InsertedTaskDueDays = 14;
+
+// In the order of LoadTester::Operation, the names are the ones parseMix() accepts.
+static constexpr std::array<std::string_view, LoadTester::OperationCount> operationNames = {
+    "login", "task", "unstarted", "insert"
+};
+
+// The percentiles of the reports.
+static constexpr std::array<double, 4> reportPercentiles = {0.50, 0.95, 0.99, 0.999};
+
+static void appendJSONLatencies(std::string& json, const LogLinearHistogram& latencyNs)
+{
+    json.append(std::format("\"latencyMs\":{{\"minimum\":{},\"mean\":{},\"p50\":{},\"p95\":{},\"p99\":{},"
+        "\"p999\":{},\"maximum\":{}}}", static_cast<double>(latencyNs.getMinimum()) / NanosecondsPerMs,
+        latencyNs.getMean() / NanosecondsPerMs, latencyNs.getPercentile(reportPercentiles[0]) / NanosecondsPerMs,
+        latencyNs.getPercentile(reportPercentiles[1]) / NanosecondsPerMs,
+        latencyNs.getPercentile(reportPercentiles[2]) / NanosecondsPerMs,
+        latencyNs.getPercentile(reportPercentiles[3]) / NanosecondsPerMs,
+        static_cast<double>(latencyNs.getMaximum()) / NanosecondsPerMs));
+}
+
+std::expected<LoadTester::OperationMix, std::string> LoadTester::parseMix(std::string_view text)
+{
+    OperationMix mix{};
+
+    while (!text.empty())
+    {
+        std::size_t pairEnd = std::min(text.find(','), text.size());
+        std::string_view pair = text.substr(0, pairEnd);
+        text.remove_prefix(std::min(pairEnd + 1, text.size()));
+
+        std::size_t equals = pair.find('=');
+        if (equals == std::string_view::npos)
+        {
+            return std::unexpected(std::format("expected name=weight, found {}", pair));
+        }
+        std::string_view name = pair.substr(0, equals);
+        std::string_view weight = pair.substr(equals + 1);
+
+        auto operationName = std::ranges::find(operationNames, name);
+        if (operationName == operationNames.end())
+        {
+            return std::unexpected(std::format("unknown operation {}, expected login, task, unstarted or insert", name));
+        }
+
+        unsigned int& operationWeight = mix[static_cast<std::size_t>(operationName - operationNames.begin())];
+        const char* weightEnd = weight.data() + weight.size();
+        auto [parsedTo, errorCode] = std::from_chars(weight.data(), weightEnd, operationWeight);
+        if (errorCode != std::errc() || parsedTo != weightEnd)
+        {
+            return std::unexpected(std::format("invalid weight {} for {}", weight, name));
+        }
+    }
+
+    if (std::ranges::all_of(mix, [](unsigned int weight) { return weight == 0; }))
+    {
+        return std::unexpected(std::string("at least one operation needs a weight above 0"));
+    }
+
+    return mix;
+}
+
+std::string_view LoadTester::operationName(Operation operation)
+{
+    return operationNames[static_cast<std::size_t>(operation)];
+}
+
+LoadTester::LoadTester(Settings settingsIn)
+: settings{settingsIn},
+  pool{std::max(settingsIn.virtualUsers, 1u)}
+{
+    settings.virtualUsers = pool.getWorkerCount();
+    for (unsigned int weight: settings.mix)
+    {
+        mixTotal += weight;
+    }
+}
+
+bool LoadTester::runLoadTest()
+{
+    results = {};
+    elapsed = std::chrono::duration<double>{0};
+    errorMessages.clear();
+    pool.clearErrorMessages();
+
+    if (mixTotal == 0)
+    {
+        errorMessages.append("The operation mix has no operations with a weight above 0\n");
+        return false;
+    }
+
+    if (!loadReferenceData())
+    {
+        return false;
+    }
+
+    // Database interfaces are not thread safe, each virtual user gets its own.
+    virtualUsers.clear();
+    for (unsigned int virtualUserIndex = 0; virtualUserIndex < settings.virtualUsers; ++virtualUserIndex)
+    {
+        virtualUsers.push_back(std::make_unique<VirtualUser>());
+        virtualUsers.back()->generator.seed(virtualUserIndex + 1);
+    }
+
+    LoadClock::time_point start = LoadClock::now();
+    LoadClock::time_point end = start + settings.duration;
+    for (unsigned int virtualUserIndex = 0; virtualUserIndex < settings.virtualUsers; ++virtualUserIndex)
+    {
+        pool.submit([this, virtualUser = virtualUsers[virtualUserIndex].get(), virtualUserIndex, start, end](unsigned int)
+            { runVirtualUser(*virtualUser, virtualUserIndex, start, end); });
+    }
+    pool.waitForAll();
+    elapsed = LoadClock::now() - start;
+
+    for (const auto& virtualUser: virtualUsers)
+    {
+        for (std::size_t operation = 0; operation < OperationCount; ++operation)
+        {
+            results[operation].latencyNs.merge(virtualUser->results[operation].latencyNs);
+            results[operation].errorCount += virtualUser->results[operation].errorCount;
+        }
+        errorMessages.append(virtualUser->errorMessages);
+    }
+    errorMessages.append(pool.getAllErrorMessages());
+
+    return errorMessages.empty();
+}
+
+std::string LoadTester::getTextReport() const
+{
+    double elapsedSeconds = elapsed.count() > 0.0? elapsed.count() : 1.0;
+    LogLinearHistogram allLatencyNs;
+    std::uint64_t allErrorCount = 0;
+    for (const auto& operationResults: results)
+    {
+        allLatencyNs.merge(operationResults.latencyNs);
+        allErrorCount += operationResults.errorCount;
+    }
+
+    std::string text = std::format("{} virtual users, {} for {:.1f} s, {} operations, {:.1f} per second\n\n",
+        settings.virtualUsers, settings.targetRate? std::format("open loop at {} per second", settings.targetRate) :
+        std::string("closed loop"), elapsed.count(), allLatencyNs.getCount(),
+        static_cast<double>(allLatencyNs.getCount()) / elapsedSeconds);
+
+    text.append(std::format("{:<10} {:>10} {:>8} {:>11} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "Operation",
+        "Count", "Errors", "Per second", "Mean ms", "P50 ms", "P95 ms", "P99 ms", "P99.9 ms", "Max ms"));
+    auto appendRow = [&text, elapsedSeconds](std::string_view name, const LogLinearHistogram& latencyNs,
+        std::uint64_t errorCount)
+    {
+        text.append(std::format("{:<10} {:>10} {:>8} {:>11.1f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}\n",
+            name, latencyNs.getCount(), errorCount, static_cast<double>(latencyNs.getCount()) / elapsedSeconds,
+            latencyNs.getMean() / NanosecondsPerMs, latencyNs.getPercentile(reportPercentiles[0]) / NanosecondsPerMs,
+            latencyNs.getPercentile(reportPercentiles[1]) / NanosecondsPerMs,
+            latencyNs.getPercentile(reportPercentiles[2]) / NanosecondsPerMs,
+            latencyNs.getPercentile(reportPercentiles[3]) / NanosecondsPerMs,
+            static_cast<double>(latencyNs.getMaximum()) / NanosecondsPerMs));
+    };
+
+    for (std::size_t operation = 0; operation < OperationCount; ++operation)
+    {
+        if (settings.mix[operation] != 0)
+        {
+            appendRow(operationNames[operation], results[operation].latencyNs, results[operation].errorCount);
+        }
+    }
+    appendRow("all", allLatencyNs, allErrorCount);
+
+    return text;
+}
+
+std::string LoadTester::getJSONReport() const
+{
+    double elapsedSeconds = elapsed.count() > 0.0? elapsed.count() : 1.0;
+    std::uint64_t allCount = 0;
+    for (const auto& operationResults: results)
+    {
+        allCount += operationResults.latencyNs.getCount();
+    }
+
+    std::string json = std::format("{{\"virtualUsers\":{},\"targetRate\":{},\"durationSeconds\":{},"
+        "\"elapsedSeconds\":{},\"operationsPerSecond\":{},\"operations\":[", settings.virtualUsers, settings.targetRate,
+        settings.duration.count(), elapsed.count(), static_cast<double>(allCount) / elapsedSeconds);
+    bool firstOperation = true;
+    for (std::size_t operation = 0; operation < OperationCount; ++operation)
+    {
+        if (settings.mix[operation] == 0)
+        {
+            continue;
+        }
+
+        const OperationResults& operationResults = results[operation];
+        json.append(std::format("{}{{\"name\":\"{}\",\"weight\":{},\"count\":{},\"errors\":{},\"operationsPerSecond\":{},",
+            firstOperation? "" : ",", operationNames[operation], settings.mix[operation],
+            operationResults.latencyNs.getCount(), operationResults.errorCount,
+            static_cast<double>(operationResults.latencyNs.getCount()) / elapsedSeconds));
+        appendJSONLatencies(json, operationResults.latencyNs);
+        json.push_back('}');
+        firstOperation = false;
+    }
+    json.append("]}\n");
+
+    return json;
+}
+
+/*
+ * Private methods.
+ */
+bool LoadTester::loadReferenceData()
+{
+    UserDbInterface userDbInterface;
+    users = userDbInterface.getAllUsers();
+    if (users.empty())
+    {
+        errorMessages.append(std::format("The load test needs users in the database\n{}",
+            userDbInterface.getAllErrorMessages()));
+        return false;
+    }
+
+    taskIDs.clear();
+    if (settings.mix[static_cast<std::size_t>(Operation::TaskByID)] != 0)
+    {
+        TaskDbInterface taskDbInterface;
+        TaskStore taskStore = taskDbInterface.getTaskStoreForAllTasks();
+        taskIDs.assign(taskStore.getTaskIDs().begin(), taskStore.getTaskIDs().end());
+        if (taskIDs.empty())
+        {
+            errorMessages.append(std::format("Task lookups by ID need tasks in the database\n{}",
+                taskDbInterface.getAllErrorMessages()));
+            return false;
+        }
+    }
+
+    // Makes the descriptions of the inserted tasks unique between runs.
+    runLabel = std::format("{:%F %T}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+
+    return true;
+}
+
+void LoadTester::runVirtualUser(VirtualUser& virtualUser, unsigned int virtualUserIndex, LoadClock::time_point start,
+    LoadClock::time_point end)
+{
+    bool openLoop = settings.targetRate != 0;
+    LoadClock::duration interval{0};
+    LoadClock::time_point scheduled = LoadClock::now();
+    if (openLoop)
+    {
+        // Every virtual user runs at its share of the rate, their start times are spread over one interval.
+        interval = std::chrono::duration_cast<LoadClock::duration>(std::chrono::duration<double>(
+            static_cast<double>(settings.virtualUsers) / static_cast<double>(settings.targetRate)));
+        scheduled = start + interval * virtualUserIndex / settings.virtualUsers;
+    }
+
+    while (scheduled < end)
+    {
+        if (openLoop)
+        {
+            std::this_thread::sleep_until(scheduled);
+        }
+
+        Operation operation = chooseOperation(virtualUser);
+        bool succeeded = runOperation(virtualUser, operation, virtualUserIndex);
+        LoadClock::time_point finished = LoadClock::now();
+
+        OperationResults& operationResults = virtualUser.results[static_cast<std::size_t>(operation)];
+        operationResults.latencyNs.add(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(finished - scheduled).count()));
+        if (!succeeded)
+        {
+            ++operationResults.errorCount;
+        }
+
+        scheduled = openLoop? scheduled + interval : finished;
+    }
+}
+
+LoadTester::Operation LoadTester::chooseOperation(VirtualUser& virtualUser)
+{
+    std::uint64_t choice = virtualUser.generator() % mixTotal;
+    std::size_t operation = 0;
+    while (choice >= settings.mix[operation])
+    {
+        choice -= settings.mix[operation];
+        ++operation;
+    }
+
+    return static_cast<Operation>(operation);
+}
+
+/*
+ * Only the first failure of each operation of a virtual user is reported, the rest are counted.
+ */
+bool LoadTester::runOperation(VirtualUser& virtualUser, Operation operation, unsigned int virtualUserIndex)
+{
+    const UserModel_shp& user = users[virtualUser.generator() % users.size()];
+    bool succeeded = false;
+    std::string failure;
+
+    switch (operation)
+    {
+        case Operation::Login:
+            succeeded = virtualUser.userDbInterface.getUserByLoginAndPassword(user->getLoginName(),
+                user->getPassword()) != nullptr;
+            failure = virtualUser.userDbInterface.getAllErrorMessages();
+            break;
+
+        case Operation::TaskByID:
+            succeeded = virtualUser.taskDbInterface.getTaskByTaskID(
+                taskIDs[virtualUser.generator() % taskIDs.size()]) != nullptr;
+            failure = virtualUser.taskDbInterface.getAllErrorMessages();
+            break;
+
+        case Operation::UnstartedTasks:
+            // Users without unstarted tasks are a valid result.
+            virtualUser.taskDbInterface.getUnstartedDueForStartForAssignedUser(*user);
+            if (!virtualUser.taskDbInterface.hasEmptyResult())
+            {
+                failure = virtualUser.taskDbInterface.getAllErrorMessages();
+            }
+            succeeded = failure.empty();
+            break;
+
+        case Operation::InsertTask:
+        {
+            TaskModel task(user, std::format("Load test task {} {}-{}", runLabel, virtualUserIndex,
+                ++virtualUser.insertedCount));
+            task.setStatus(TaskModel::TaskStatus::Not_Started);
+            task.setScheduledStart(getTodaysCompactDate());
+            task.setDueDate(CompactDate(getTodaysDatePlus(InsertedTaskDueDays)));
+            task.setEstimatedEffort(1);
+            task.setPriorityGroup(1);
+            task.setPriority(1);
+            succeeded = virtualUser.taskDbInterface.insert(task) != 0;
+            failure = virtualUser.taskDbInterface.getAllErrorMessages();
+            break;
+        }
+    }
+
+    if (!succeeded && virtualUser.results[static_cast<std::size_t>(operation)].errorCount == 0)
+    {
+        virtualUser.errorMessages.append(std::format("Virtual user {} {} FAILED! {}\n", virtualUserIndex,
+            operationName(operation), failure.empty()? std::string("Nothing was found") : failure));
+    }
+
+    return succeeded;
+}
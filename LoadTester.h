@@ -0,0 +1,109 @@
+#ifndef LOADTESTER_H_
+#define LOADTESTER_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include "LogLinearHistogram.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include "TaskDbInterface.h"
+#include "UserDbInterface.h"
+#include "UserModel.h"
+#include <vector>
+#include "WorkStealingPool.h"
+
+/*
+ * Runs virtual users against the database concurrently, to size the database and the connection
+ * settings. Each virtual user is a worker of a work stealing pool with its own database
+ * interfaces and repeats a weighted mix of logins, task lookups by ID, unstarted task queries
+ * and task inserts until the duration has passed. The users, passwords and task IDs the
+ * operations use are read from the database before the test starts.
+ *
+ * Without a target rate every virtual user starts its next operation as soon as the last one
+ * finishes, closed loop. With a target rate the operations are scheduled at fixed intervals
+ * spread evenly over the virtual users, open loop, and an operation's latency is measured from
+ * the time it was scheduled for, so the time it waited behind slow operations is included.
+ * A virtual user has one operation in flight at a time, the rate can only be reached when the
+ * virtual users together can keep up with it.
+ */
+class LoadTester
+{
+public:
+    enum class Operation
+    {
+        Login,
+        TaskByID,
+        UnstartedTasks,
+        InsertTask
+    };
+    static constexpr std::size_t OperationCount = 4;
+    using OperationMix = std::array<unsigned int, OperationCount>;
+
+    struct Settings
+    {
+        unsigned int virtualUsers = 8;
+        std::chrono::seconds duration{30};
+        // Operations per second over all of the virtual users, 0 runs closed loop.
+        unsigned int targetRate = 0;
+        // Relative weights, in the order of Operation.
+        OperationMix mix{40, 40, 15, 5};
+    };
+
+/*
+ * The mix as comma separated name=weight pairs, for example
+ * "login=40,task=40,unstarted=15,insert=5". Names that are left out get a weight of 0.
+ */
+    static std::expected<OperationMix, std::string> parseMix(std::string_view text);
+    static std::string_view operationName(Operation operation);
+
+    explicit LoadTester(Settings settingsIn);
+
+    bool runLoadTest();
+    std::string getTextReport() const;
+    std::string getJSONReport() const;
+    std::string getAllErrorMessages() const { return errorMessages; };
+
+private:
+    using LoadClock = std::chrono::steady_clock;
+
+    struct OperationResults
+    {
+        LogLinearHistogram latencyNs;
+        std::uint64_t errorCount = 0;
+    };
+
+    struct VirtualUser
+    {
+        UserDbInterface userDbInterface;
+        TaskDbInterface taskDbInterface;
+        std::mt19937_64 generator;
+        std::array<OperationResults, OperationCount> results;
+        std::size_t insertedCount = 0;
+        std::string errorMessages;
+    };
+
+    bool loadReferenceData();
+    void runVirtualUser(VirtualUser& virtualUser, unsigned int virtualUserIndex, LoadClock::time_point start,
+        LoadClock::time_point end);
+    Operation chooseOperation(VirtualUser& virtualUser);
+    bool runOperation(VirtualUser& virtualUser, Operation operation, unsigned int virtualUserIndex);
+
+    Settings settings;
+    unsigned int mixTotal = 0;
+    WorkStealingPool pool;
+    std::vector<std::unique_ptr<VirtualUser>> virtualUsers;
+    // Read only while the virtual users run.
+    UserList users;
+    std::vector<std::uint32_t> taskIDs;
+    std::string runLabel;
+    std::array<OperationResults, OperationCount> results;
+    std::chrono::duration<double> elapsed{0};
+    std::string errorMessages;
+};
+
+#endif // LOADTESTER_H_
@@ -0,0 +1,114 @@
+#ifndef LOGLINEARHISTOGRAM_H_
+#define LOGLINEARHISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*
+ * An HDR style histogram of unsigned values, times in nanoseconds, row counts or byte counts.
+ * Values below 8 get their own bucket, larger values get 8 buckets per power of 2, so a
+ * percentile is within 1/16 of the value over the whole 64 bit range at a fixed size.
+ */
+class LogLinearHistogram
+{
+public:
+    static constexpr std::size_t SubBucketBits = 3;
+    static constexpr std::size_t BucketCount = (64 - SubBucketBits + 1) << SubBucketBits;
+
+    static constexpr std::size_t bucketIndex(std::uint64_t value)
+    {
+        constexpr std::uint64_t SubBucketCount = 1u << SubBucketBits;
+        if (value < SubBucketCount)
+        {
+            return static_cast<std::size_t>(value);
+        }
+
+        std::size_t exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+        std::size_t subBucket = static_cast<std::size_t>(value >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+        return ((exponent - SubBucketBits + 1) << SubBucketBits) + subBucket;
+    };
+    static constexpr double bucketMidpoint(std::size_t bucket)
+    {
+        constexpr std::size_t SubBucketCount = 1u << SubBucketBits;
+        if (bucket < SubBucketCount)
+        {
+            return static_cast<double>(bucket);
+        }
+
+        std::size_t shift = (bucket >> SubBucketBits) - 1;
+        std::uint64_t lowerBound = static_cast<std::uint64_t>(SubBucketCount + (bucket & (SubBucketCount - 1))) << shift;
+        std::uint64_t width = std::uint64_t{1} << shift;
+        return static_cast<double>(lowerBound) + static_cast<double>(width) / 2.0;
+    };
+
+    void add(std::uint64_t value)
+    {
+        ++count;
+        total += value;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+        ++buckets[bucketIndex(value)];
+    };
+    void merge(const LogLinearHistogram& other)
+    {
+        mergeSummary(other.count, other.total, other.minimum, other.maximum);
+        for (std::size_t bucket = 0; bucket < BucketCount; ++bucket)
+        {
+            buckets[bucket] += other.buckets[bucket];
+        }
+    };
+/*
+ * For histograms kept in another form, such as the atomic counters of the profiler.
+ */
+    void mergeSummary(std::uint64_t otherCount, std::uint64_t otherTotal, std::uint64_t otherMinimum,
+        std::uint64_t otherMaximum)
+    {
+        count += otherCount;
+        total += otherTotal;
+        minimum = std::min(minimum, otherMinimum);
+        maximum = std::max(maximum, otherMaximum);
+    };
+    void mergeBucket(std::size_t bucket, std::uint64_t bucketCount) { buckets[bucket] += bucketCount; };
+    void clear() { *this = LogLinearHistogram(); };
+
+    std::uint64_t getCount() const { return count; };
+    std::uint64_t getTotal() const { return total; };
+    std::uint64_t getMinimum() const { return count? minimum : 0; };
+    std::uint64_t getMaximum() const { return maximum; };
+    double getMean() const { return count? static_cast<double>(total) / static_cast<double>(count) : 0.0; };
+/*
+ * The midpoint of the bucket that holds the percentile, limited to the minimum and maximum.
+ */
+    double getPercentile(double percentile) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+
+        std::uint64_t rank = std::max<std::uint64_t>(1,
+            static_cast<std::uint64_t>(std::ceil(percentile * static_cast<double>(count))));
+        std::uint64_t seen = 0;
+        std::size_t bucket = 0;
+        while (bucket < BucketCount - 1 && (seen += buckets[bucket]) < rank)
+        {
+            ++bucket;
+        }
+
+        return std::clamp(bucketMidpoint(bucket), static_cast<double>(minimum), static_cast<double>(maximum));
+    };
+
+private:
+    std::uint64_t count = 0;
+    std::uint64_t total = 0;
+    std::uint64_t minimum = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t maximum = 0;
+    std::array<std::uint64_t, BucketCount> buckets{};
+};
+
+#endif // LOGLINEARHISTOGRAM_H_
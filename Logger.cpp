@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include "Logger.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/*
+ * A single producer, single consumer ring. Only the owning thread writes records and moves
+ * writePosition, only the writer thread reads them and moves readPosition. The positions only
+ * grow, the offset in the buffer is the position modulo BufferBytes.
+ */
+struct Logger::ThreadBuffer
+{
+    alignas(64) std::atomic<std::size_t> writePosition = 0;
+    std::size_t reservedEnd = 0;
+    std::atomic<std::uint64_t> dropped = 0;
+    alignas(64) std::atomic<std::size_t> readPosition = 0;
+    std::atomic<bool> retired = false;
+    alignas(RecordAlignment) std::array<std::byte, BufferBytes> storage;
+};
+
+/*
+ * The buffers of exited threads are kept until the writer has drained them.
+ */
+struct Logger::Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::uint64_t retiredDrops = 0;
+    std::uint64_t reportedDrops = 0;
+    std::uint64_t flushRequests = 0;
+    std::uint64_t completedFlushes = 0;
+    bool stopping = false;
+    std::condition_variable wakeWriter;
+    std::condition_variable flushed;
+    std::mutex outputMutex;
+    std::jthread writerThread;
+
+    Registry() { writerThread = std::jthread(writeRecords, std::ref(*this)); };
+    // Messages logged before exit are written, the main thread's buffer is retired by then.
+    ~Registry()
+    {
+        {
+            std::lock_guard<std::mutex> registryLock(mutex);
+            stopping = true;
+        }
+        wakeWriter.notify_all();
+        writerThread.join();
+    };
+};
+
+static void writeToStandardError(std::string_view text)
+{
+    while (!text.empty())
+    {
+        ssize_t written = write(STDERR_FILENO, text.data(), text.size());
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return;
+        }
+        text.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+void Logger::flush()
+{
+    Registry& loggerRegistry = registry();
+    std::unique_lock<std::mutex> registryLock(loggerRegistry.mutex);
+
+    std::uint64_t flushRequest = ++loggerRegistry.flushRequests;
+    loggerRegistry.wakeWriter.notify_one();
+    loggerRegistry.flushed.wait(registryLock, [&loggerRegistry, flushRequest]()
+        { return loggerRegistry.completedFlushes >= flushRequest || loggerRegistry.stopping; });
+}
+
+std::uint64_t Logger::getDroppedCount()
+{
+    Registry& loggerRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(loggerRegistry.mutex);
+
+    std::uint64_t dropped = loggerRegistry.retiredDrops;
+    for (const auto& buffer: loggerRegistry.buffers)
+    {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+
+    return dropped;
+}
+
+/*
+ * Private methods.
+ * A record that doesn't fit before the end of the buffer starts at the beginning, the space it
+ * skips is a padding record, or is skipped by both sides when even a header doesn't fit.
+ */
+std::byte* Logger::reserveRecord(std::size_t size)
+{
+    constexpr std::size_t headerBytes = alignRecord(sizeof(RecordHeader));
+    ThreadBuffer& buffer = threadBuffer();
+    std::size_t writePosition = buffer.writePosition.load(std::memory_order_relaxed);
+    std::size_t readPosition = buffer.readPosition.load(std::memory_order_acquire);
+
+    std::size_t offset = writePosition % BufferBytes;
+    std::size_t contiguous = BufferBytes - offset;
+    std::size_t padding = contiguous < size? contiguous : 0;
+    if (BufferBytes - (writePosition - readPosition) < padding + size)
+    {
+        buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    if (padding != 0)
+    {
+        if (contiguous >= headerBytes)
+        {
+            RecordHeader paddingHeader{contiguous, nullptr, {}};
+            std::memcpy(buffer.storage.data() + offset, &paddingHeader, sizeof(paddingHeader));
+        }
+        offset = 0;
+    }
+    buffer.reservedEnd = writePosition + padding + size;
+
+    return buffer.storage.data() + offset;
+}
+
+void Logger::commitRecord()
+{
+    ThreadBuffer& buffer = threadBuffer();
+    buffer.writePosition.store(buffer.reservedEnd, std::memory_order_release);
+}
+
+void Logger::writeNow(std::string_view text)
+{
+    flush();
+
+    Registry& loggerRegistry = registry();
+    std::lock_guard<std::mutex> outputLock(loggerRegistry.outputMutex);
+    writeToStandardError(text);
+}
+
+/*
+ * The writer thread is started with the registry, on the first message or flush.
+ */
+Logger::Registry& Logger::registry()
+{
+    static Registry loggerRegistry;
+    return loggerRegistry;
+}
+
+Logger::ThreadBuffer& Logger::threadBuffer()
+{
+    struct ThreadBufferOwner
+    {
+        std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+
+        ThreadBufferOwner()
+        {
+            Registry& loggerRegistry = registry();
+            std::lock_guard<std::mutex> registryLock(loggerRegistry.mutex);
+            loggerRegistry.buffers.push_back(buffer);
+        }
+        ~ThreadBufferOwner() { buffer->retired.store(true, std::memory_order_release); }
+    };
+
+    thread_local ThreadBufferOwner owner;
+    return *owner.buffer;
+}
+
+void Logger::drainBuffer(ThreadBuffer& buffer, std::string& text)
+{
+    constexpr std::size_t headerBytes = alignRecord(sizeof(RecordHeader));
+    std::size_t readPosition = buffer.readPosition.load(std::memory_order_relaxed);
+    std::size_t writePosition = buffer.writePosition.load(std::memory_order_acquire);
+
+    while (readPosition != writePosition)
+    {
+        std::size_t offset = readPosition % BufferBytes;
+        std::size_t contiguous = BufferBytes - offset;
+        if (contiguous < headerBytes)
+        {
+            readPosition += contiguous;
+            continue;
+        }
+
+        RecordHeader header;
+        std::memcpy(&header, buffer.storage.data() + offset, sizeof(header));
+        if (header.decode != nullptr)
+        {
+            header.decode(header.format, buffer.storage.data() + offset + headerBytes, text);
+        }
+        readPosition += header.size;
+    }
+
+    buffer.readPosition.store(readPosition, std::memory_order_release);
+}
+
+/*
+ * The body of the writer thread. Each pass drains every buffer, writes the text and then
+ * completes the flushes that were requested before the pass started.
+ */
+void Logger::writeRecords(Registry& loggerRegistry)
+{
+    std::string text;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    std::unique_lock<std::mutex> registryLock(loggerRegistry.mutex);
+    while (true)
+    {
+        loggerRegistry.wakeWriter.wait_for(registryLock, std::chrono::milliseconds(WriterIntervalMs),
+            [&loggerRegistry]()
+            {
+                return loggerRegistry.stopping || loggerRegistry.flushRequests != loggerRegistry.completedFlushes;
+            });
+        std::uint64_t flushRequests = loggerRegistry.flushRequests;
+        bool stopping = loggerRegistry.stopping;
+        buffers = loggerRegistry.buffers;
+        registryLock.unlock();
+
+        text.clear();
+        for (const auto& buffer: buffers)
+        {
+            drainBuffer(*buffer, text);
+        }
+
+        registryLock.lock();
+        std::uint64_t dropped = loggerRegistry.retiredDrops;
+        for (const auto& buffer: loggerRegistry.buffers)
+        {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        if (dropped > loggerRegistry.reportedDrops)
+        {
+            text.append(std::format("{} log messages were dropped, the log buffer was full\n",
+                dropped - loggerRegistry.reportedDrops));
+            loggerRegistry.reportedDrops = dropped;
+        }
+
+        // A retired buffer is only empty for good once its thread has exited.
+        std::erase_if(loggerRegistry.buffers, [&loggerRegistry](const std::shared_ptr<ThreadBuffer>& buffer)
+            {
+                bool drained = buffer->retired.load(std::memory_order_acquire) &&
+                    buffer->readPosition.load(std::memory_order_relaxed) ==
+                    buffer->writePosition.load(std::memory_order_acquire);
+                if (drained)
+                {
+                    loggerRegistry.retiredDrops += buffer->dropped.load(std::memory_order_relaxed);
+                }
+                return drained;
+            });
+        buffers.clear();
+
+        if (!text.empty())
+        {
+            registryLock.unlock();
+            {
+                std::lock_guard<std::mutex> outputLock(loggerRegistry.outputMutex);
+                writeToStandardError(text);
+            }
+            registryLock.lock();
+        }
+
+        loggerRegistry.completedFlushes = std::max(loggerRegistry.completedFlushes, flushRequests);
+        loggerRegistry.flushed.notify_all();
+        if (stopping)
+        {
+            break;
+        }
+    }
+}
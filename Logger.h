@@ -0,0 +1,260 @@
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+enum class LogLevel : std::uint8_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+/*
+ * Asynchronous logging to standard error. The level is checked before anything else is done,
+ * a message below the level costs one load. A message that passes is copied into a ring buffer
+ * of the calling thread, its format string as a pointer and its arguments as bytes, and is only
+ * formatted by the background writer thread. The writer drains the buffers of all threads about
+ * every WriterIntervalMs. Messages of one thread are written in order, messages of different
+ * threads may be interleaved out of order within a drain.
+ *
+ * Arguments that are strings are copied, other trivially copyable arguments are copied by value.
+ * Arguments of other types that have an operator<<, such as the models, are formatted into a
+ * string on the calling thread. Format strings must be string literals, they are checked at
+ * compile time like those of std::format().
+ *
+ * When a thread's buffer is full its messages are dropped, the writer reports how many. A
+ * message larger than MaximumRecordBytes is formatted and written on the calling thread after
+ * flush().
+ *
+ * Messages are written as they are formatted, as with std::clog they end with their own "\n".
+ */
+class Logger
+{
+private:
+    template <typename T>
+    static constexpr bool isLoggedAsString = std::is_convertible_v<const T&, std::string_view>;
+    template <typename T>
+    static constexpr bool isLoggedAsValue = !isLoggedAsString<T> && std::is_trivially_copyable_v<T>;
+    template <typename T>
+    static constexpr bool isLoggedAsStreamed = !isLoggedAsString<T> && !isLoggedAsValue<T> &&
+        requires(std::ostream& stream, const T& value) { stream << value; };
+
+    template <typename T>
+    using Formatted = std::conditional_t<isLoggedAsString<T> || isLoggedAsStreamed<T>, std::string_view, T>;
+
+public:
+    template <typename... Args>
+    using FormatString = std::format_string<Formatted<std::remove_cvref_t<Args>>...>;
+
+    static void setLevel(LogLevel level) { minimumLevel.store(level, std::memory_order_relaxed); };
+    static bool isEnabled(LogLevel level)
+    {
+        return level != LogLevel::Off && level >= minimumLevel.load(std::memory_order_relaxed);
+    };
+
+    template <typename... Args>
+    static void log(LogLevel level, FormatString<Args...> format, Args&&... args)
+    {
+        if (isEnabled(level))
+        {
+            pushRecord(format.get(), toLogged(args)...);
+        }
+    }
+    template <typename... Args>
+    static void debug(FormatString<Args...> format, Args&&... args)
+    {
+        log<Args...>(LogLevel::Debug, format, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    static void info(FormatString<Args...> format, Args&&... args)
+    {
+        log<Args...>(LogLevel::Info, format, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    static void warning(FormatString<Args...> format, Args&&... args)
+    {
+        log<Args...>(LogLevel::Warning, format, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    static void error(FormatString<Args...> format, Args&&... args)
+    {
+        log<Args...>(LogLevel::Error, format, std::forward<Args>(args)...);
+    }
+
+/*
+ * Returns once every message logged before the call has been written.
+ */
+    static void flush();
+    static std::uint64_t getDroppedCount();
+
+private:
+    static constexpr std::size_t BufferBytes = 64 * 1024;
+    static constexpr std::size_t MaximumRecordBytes = BufferBytes / 4;
+    static constexpr std::size_t RecordAlignment = alignof(std::max_align_t);
+    static constexpr int WriterIntervalMs = 10;
+
+    inline static std::atomic<LogLevel> minimumLevel = LogLevel::Info;
+
+    using DecodeFunction = void (*)(std::string_view format, const std::byte* arguments, std::string& text);
+
+/*
+ * A record without a decode function is padding to the end of the buffer.
+ */
+    struct RecordHeader
+    {
+        std::size_t size;
+        DecodeFunction decode;
+        std::string_view format;
+    };
+
+    struct ThreadBuffer;
+    struct Registry;
+
+    static constexpr std::size_t alignRecord(std::size_t size)
+    {
+        return (size + RecordAlignment - 1) / RecordAlignment * RecordAlignment;
+    };
+
+    template <typename T>
+    static decltype(auto) toLogged(const T& argument)
+    {
+        if constexpr (isLoggedAsStreamed<T>)
+        {
+            std::ostringstream text;
+            text << argument;
+            return text.str();
+        }
+        else
+        {
+            return (argument);
+        }
+    }
+
+    template <typename T>
+    static std::size_t encodedSize(const T& argument)
+    {
+        if constexpr (isLoggedAsString<T>)
+        {
+            return alignRecord(sizeof(std::size_t) + std::string_view(argument).size());
+        }
+        else
+        {
+            return alignRecord(sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static void encodeArgument(std::byte*& position, const T& argument)
+    {
+        if constexpr (isLoggedAsString<T>)
+        {
+            std::string_view text(argument);
+            std::size_t length = text.size();
+            std::memcpy(position, &length, sizeof(length));
+            std::memcpy(position + sizeof(length), text.data(), length);
+        }
+        else
+        {
+            std::memcpy(position, &argument, sizeof(T));
+        }
+        position += encodedSize(argument);
+    }
+
+    template <typename T>
+    static Formatted<T> decodeArgument(const std::byte*& position)
+    {
+        if constexpr (isLoggedAsString<T>)
+        {
+            std::size_t length;
+            std::memcpy(&length, position, sizeof(length));
+            std::string_view text(reinterpret_cast<const char*>(position + sizeof(length)), length);
+            position += alignRecord(sizeof(length) + length);
+            return text;
+        }
+        else
+        {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), position, sizeof(T));
+            position += alignRecord(sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+    }
+
+    template <typename... Logged>
+    static void decodeRecord(std::string_view format, [[maybe_unused]] const std::byte* arguments, std::string& text)
+    {
+        // A braced initializer list is evaluated left to right, in the order the arguments were encoded.
+        std::tuple<Formatted<Logged>...> values{decodeArgument<Logged>(arguments)...};
+        std::apply([format, &text](const auto&... decoded)
+            {
+                std::vformat_to(std::back_inserter(text), format, std::make_format_args(decoded...));
+            }, values);
+    }
+
+    template <typename T>
+    static Formatted<T> asFormatted(const T& argument)
+    {
+        if constexpr (isLoggedAsString<T>)
+        {
+            return std::string_view(argument);
+        }
+        else
+        {
+            return argument;
+        }
+    }
+
+    template <typename... Logged>
+    static void pushRecord(std::string_view format, const Logged&... arguments)
+    {
+        std::size_t size = alignRecord(sizeof(RecordHeader)) + (encodedSize(arguments) + ... + 0);
+        if (size > MaximumRecordBytes)
+        {
+            std::string text;
+            std::apply([format, &text](const auto&... formatted)
+                {
+                    std::vformat_to(std::back_inserter(text), format, std::make_format_args(formatted...));
+                }, std::tuple<Formatted<Logged>...>{asFormatted(arguments)...});
+            writeNow(text);
+            return;
+        }
+
+        std::byte* record = reserveRecord(size);
+        if (record == nullptr)
+        {
+            return;
+        }
+        RecordHeader header{size, &decodeRecord<Logged...>, format};
+        std::memcpy(record, &header, sizeof(header));
+        [[maybe_unused]] std::byte* position = record + alignRecord(sizeof(RecordHeader));
+        (encodeArgument(position, arguments), ...);
+        commitRecord();
+    }
+
+    static std::byte* reserveRecord(std::size_t size);
+    static void commitRecord();
+    static void writeNow(std::string_view text);
+    static Registry& registry();
+    static ThreadBuffer& threadBuffer();
+    static void drainBuffer(ThreadBuffer& buffer, std::string& text);
+    static void writeRecords(Registry& loggerRegistry);
+};
+
+#endif // LOGGER_H_
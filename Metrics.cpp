@@ -0,0 +1,381 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <memory>
+#include "Metrics.h"
+#include <mutex>
+#include <poll.h>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+struct MetricEntry
+{
+    std::string name;
+    std::string help;
+    std::string labels;
+    double scale;
+    std::size_t slot;
+};
+
+struct Metrics::Registry
+{
+    std::mutex mutex;
+    std::vector<MetricEntry> counters;
+    std::vector<MetricEntry> gauges;
+    std::deque<std::atomic<std::int64_t>> gaugeValues;
+    std::vector<std::shared_ptr<ThreadCounters>> threadCounters;
+    std::array<std::uint64_t, MaximumCounters> retiredTotals{};
+};
+
+struct Metrics::Endpoint
+{
+    std::mutex mutex;
+    std::string socketPath;
+    std::jthread serverThread;
+    std::string errorMessage;
+};
+
+static constexpr int PollIntervalMs = 200;
+static constexpr int RequestTimeoutMs = 100;
+
+static std::string formatLabel(Metrics::Label label)
+{
+    if (label.name.empty())
+    {
+        return {};
+    }
+
+    std::string labels = std::format("{}=\"", label.name);
+    for (char character: label.value)
+    {
+        switch (character)
+        {
+            case '\\': labels.append("\\\\"); break;
+            case '"': labels.append("\\\""); break;
+            case '\n': labels.append("\\n"); break;
+            default: labels.push_back(character); break;
+        }
+    }
+    labels.push_back('"');
+
+    return labels;
+}
+
+static std::vector<MetricEntry>::iterator findMetric(std::vector<MetricEntry>& metrics, std::string_view name,
+    std::string_view labels)
+{
+    return std::ranges::find_if(metrics,
+        [name, labels](const MetricEntry& metric) { return metric.name == name && metric.labels == labels; });
+}
+
+Metrics::Counter Metrics::counter(std::string_view name, std::string_view help, Label label, double scale)
+{
+    std::string labels = formatLabel(label);
+    Registry& metricsRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(metricsRegistry.mutex);
+
+    if (auto existing = findMetric(metricsRegistry.counters, name, labels); existing != metricsRegistry.counters.end())
+    {
+        return Counter(existing->slot);
+    }
+
+    std::size_t slot = metricsRegistry.counters.size() + 1;
+    if (slot >= MaximumCounters)
+    {
+        return Counter(OverflowSlot);
+    }
+    metricsRegistry.counters.push_back({std::string(name), std::string(help), std::move(labels), scale, slot});
+
+    return Counter(slot);
+}
+
+Metrics::Gauge Metrics::gauge(std::string_view name, std::string_view help, Label label)
+{
+    std::string labels = formatLabel(label);
+    Registry& metricsRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(metricsRegistry.mutex);
+
+    if (auto existing = findMetric(metricsRegistry.gauges, name, labels); existing != metricsRegistry.gauges.end())
+    {
+        return Gauge(&metricsRegistry.gaugeValues[existing->slot]);
+    }
+
+    std::size_t slot = metricsRegistry.gaugeValues.size();
+    metricsRegistry.gaugeValues.emplace_back(0);
+    metricsRegistry.gauges.push_back({std::string(name), std::string(help), std::move(labels), 1.0, slot});
+
+    return Gauge(&metricsRegistry.gaugeValues[slot]);
+}
+
+/*
+ * Samples of the same name are written together under one HELP and TYPE, in the order the
+ * names were first registered.
+ */
+template <typename ValueFormatter>
+static void appendMetricFamilies(std::string& text, const std::vector<MetricEntry>& metrics, std::string_view type,
+    ValueFormatter formatValue)
+{
+    std::vector<bool> written(metrics.size(), false);
+    for (std::size_t first = 0; first < metrics.size(); ++first)
+    {
+        if (written[first])
+        {
+            continue;
+        }
+
+        text.append(std::format("# HELP {} {}\n# TYPE {} {}\n", metrics[first].name, metrics[first].help,
+            metrics[first].name, type));
+        for (std::size_t metric = first; metric < metrics.size(); ++metric)
+        {
+            if (metrics[metric].name != metrics[first].name)
+            {
+                continue;
+            }
+            written[metric] = true;
+            text.append(metrics[metric].labels.empty()? std::format("{} {}\n", metrics[metric].name,
+                formatValue(metrics[metric])) : std::format("{}{{{}}} {}\n", metrics[metric].name,
+                metrics[metric].labels, formatValue(metrics[metric])));
+        }
+    }
+}
+
+std::string Metrics::getPrometheusText()
+{
+    Registry& metricsRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(metricsRegistry.mutex);
+
+    std::array<std::uint64_t, MaximumCounters> totals = metricsRegistry.retiredTotals;
+    for (const auto& counters: metricsRegistry.threadCounters)
+    {
+        for (std::size_t slot = 0; slot < MaximumCounters; ++slot)
+        {
+            totals[slot] += counters->values[slot].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::string text;
+    appendMetricFamilies(text, metricsRegistry.counters, "counter", [&totals](const MetricEntry& metric)
+        {
+            return metric.scale == 1.0? std::format("{}", totals[metric.slot]) :
+                std::format("{}", static_cast<double>(totals[metric.slot]) / metric.scale);
+        });
+    appendMetricFamilies(text, metricsRegistry.gauges, "gauge", [&metricsRegistry](const MetricEntry& metric)
+        {
+            return std::format("{}", metricsRegistry.gaugeValues[metric.slot].load(std::memory_order_relaxed));
+        });
+
+    return text;
+}
+
+bool Metrics::startEndpoint(const std::string& socketPath)
+{
+    Endpoint& metricsEndpoint = endpoint();
+    std::lock_guard<std::mutex> endpointLock(metricsEndpoint.mutex);
+    metricsEndpoint.errorMessage.clear();
+
+    sockaddr_un address{};
+    if (metricsEndpoint.serverThread.joinable())
+    {
+        metricsEndpoint.errorMessage = std::format("The metrics endpoint is already running on {}\n",
+            metricsEndpoint.socketPath);
+        return false;
+    }
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+    {
+        metricsEndpoint.errorMessage = std::format("The socket path must be 1 to {} characters\n",
+            sizeof(address.sun_path) - 1);
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    // A socket file left by a process that didn't stop its endpoint is replaced, any other file is kept.
+    struct stat pathStatus{};
+    if (lstat(socketPath.c_str(), &pathStatus) == 0)
+    {
+        if (!S_ISSOCK(pathStatus.st_mode))
+        {
+            metricsEndpoint.errorMessage = std::format("{} exists and is not a socket\n", socketPath);
+            return false;
+        }
+        if (unlink(socketPath.c_str()) < 0)
+        {
+            metricsEndpoint.errorMessage = std::format("Can't remove the old socket {} : {}\n", socketPath,
+                std::strerror(errno));
+            return false;
+        }
+    }
+    else if (errno != ENOENT)
+    {
+        metricsEndpoint.errorMessage = std::format("Can't check {} : {}\n", socketPath, std::strerror(errno));
+        return false;
+    }
+
+    int listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenSocket < 0)
+    {
+        metricsEndpoint.errorMessage = std::format("Can't create a socket : {}\n", std::strerror(errno));
+        return false;
+    }
+
+    if (bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenSocket, SOMAXCONN) < 0)
+    {
+        metricsEndpoint.errorMessage = std::format("Can't listen on {} : {}\n", socketPath, std::strerror(errno));
+        close(listenSocket);
+        return false;
+    }
+
+    metricsEndpoint.socketPath = socketPath;
+    metricsEndpoint.serverThread = std::jthread(serveEndpoint, listenSocket);
+
+    return true;
+}
+
+std::string Metrics::getEndpointErrorMessage()
+{
+    Endpoint& metricsEndpoint = endpoint();
+    std::lock_guard<std::mutex> endpointLock(metricsEndpoint.mutex);
+    return metricsEndpoint.errorMessage;
+}
+
+void Metrics::stopEndpoint()
+{
+    Endpoint& metricsEndpoint = endpoint();
+    std::lock_guard<std::mutex> endpointLock(metricsEndpoint.mutex);
+
+    if (!metricsEndpoint.serverThread.joinable())
+    {
+        return;
+    }
+    metricsEndpoint.serverThread.request_stop();
+    metricsEndpoint.serverThread.join();
+    unlink(metricsEndpoint.socketPath.c_str());
+}
+
+/*
+ * Private methods.
+ */
+Metrics::Registry& Metrics::registry()
+{
+    static Registry metricsRegistry;
+    return metricsRegistry;
+}
+
+Metrics::Endpoint& Metrics::endpoint()
+{
+    static Endpoint metricsEndpoint;
+    return metricsEndpoint;
+}
+
+/*
+ * The counters are registered on the first add() of the thread. When the thread exits its
+ * counts are added to the retired totals.
+ */
+Metrics::ThreadCounters& Metrics::threadCounters()
+{
+    struct ThreadCountersOwner
+    {
+        std::shared_ptr<ThreadCounters> counters = std::make_shared<ThreadCounters>();
+
+        ThreadCountersOwner()
+        {
+            Registry& metricsRegistry = registry();
+            std::lock_guard<std::mutex> registryLock(metricsRegistry.mutex);
+            metricsRegistry.threadCounters.push_back(counters);
+        }
+        ~ThreadCountersOwner() { retireThread(counters); }
+    };
+
+    thread_local ThreadCountersOwner owner;
+    return *owner.counters;
+}
+
+void Metrics::retireThread(const std::shared_ptr<ThreadCounters>& counters)
+{
+    Registry& metricsRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(metricsRegistry.mutex);
+
+    for (std::size_t slot = 0; slot < MaximumCounters; ++slot)
+    {
+        metricsRegistry.retiredTotals[slot] += counters->values[slot].load(std::memory_order_relaxed);
+    }
+    std::erase(metricsRegistry.threadCounters, counters);
+}
+
+static bool sendAll(int connection, std::string_view data)
+{
+    while (!data.empty())
+    {
+        ssize_t sent = send(connection, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(sent));
+    }
+
+    return true;
+}
+
+/*
+ * The request is only read to tell HTTP clients from plain ones, a client that sends nothing
+ * gets the metrics after RequestTimeoutMs.
+ */
+static void answerScrape(int connection)
+{
+    std::array<char, 1024> request;
+    ssize_t requestLength = 0;
+    pollfd connectionPoll{connection, POLLIN, 0};
+    if (poll(&connectionPoll, 1, RequestTimeoutMs) > 0)
+    {
+        requestLength = recv(connection, request.data(), request.size(), 0);
+    }
+    std::string_view requestText(request.data(), static_cast<std::size_t>(std::max<ssize_t>(requestLength, 0)));
+
+    std::string metricsText = Metrics::getPrometheusText();
+    if (requestText.starts_with("GET ") || requestText.starts_with("HEAD "))
+    {
+        sendAll(connection, std::format("HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: {}\r\nConnection: close\r\n\r\n", metricsText.size()));
+        if (requestText.starts_with("HEAD "))
+        {
+            return;
+        }
+    }
+    sendAll(connection, metricsText);
+}
+
+void Metrics::serveEndpoint(std::stop_token stopToken, int listenSocket)
+{
+    while (!stopToken.stop_requested())
+    {
+        pollfd listenPoll{listenSocket, POLLIN, 0};
+        if (poll(&listenPoll, 1, PollIntervalMs) <= 0)
+        {
+            continue;
+        }
+
+        int connection = accept4(listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (connection < 0)
+        {
+            continue;
+        }
+        answerScrape(connection);
+        close(connection);
+    }
+
+    close(listenSocket);
+}
@@ -0,0 +1,105 @@
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+/*
+ * Live counters and gauges, exported in the Prometheus text format.
+ *
+ * Every thread adds to its own block of counters, one relaxed load and store without locks.
+ * The blocks are aligned and padded to cache lines, so threads never write to the same line.
+ * A scrape sums the blocks of the running threads and the totals of the threads that have
+ * exited. Counter::add() only takes the registry lock on the first add of a thread. Gauges
+ * are single values shared by all threads.
+ *
+ * Counters and gauges are registered once by name and label, usually in a static, and the
+ * returned handle is kept. Registering the same name and label again returns the same metric.
+ *
+ * startEndpoint() serves the metrics on a Unix domain socket. A connection that sends an HTTP
+ * request gets an HTTP response, curl --unix-socket PATH http://localhost/metrics, any other
+ * connection gets the metrics text.
+ */
+class Metrics
+{
+public:
+    struct Label
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    class Counter
+    {
+    public:
+        void add(std::uint64_t amount = 1) const
+        {
+            std::atomic<std::uint64_t>& value = threadCounters().values[slot];
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        };
+
+    private:
+        friend class Metrics;
+        explicit Counter(std::size_t slotIn) : slot{slotIn} {};
+
+        std::size_t slot;
+    };
+
+    class Gauge
+    {
+    public:
+        void add(std::int64_t amount) const { value->fetch_add(amount, std::memory_order_relaxed); };
+        void set(std::int64_t newValue) const { value->store(newValue, std::memory_order_relaxed); };
+
+    private:
+        friend class Metrics;
+        explicit Gauge(std::atomic<std::int64_t>* valueIn) : value{valueIn} {};
+
+        std::atomic<std::int64_t>* value;
+    };
+
+/*
+ * The exported value of a counter is its total divided by scale, a counter of nanoseconds
+ * named ..._seconds_total uses a scale of 1e9.
+ */
+    static Counter counter(std::string_view name, std::string_view help, Label label = {}, double scale = 1.0);
+    static Gauge gauge(std::string_view name, std::string_view help, Label label = {});
+    static std::string getPrometheusText();
+
+/*
+ * Returns false if the socket can't be created or an endpoint is already running. A socket
+ * left at socketPath by an earlier run is replaced, any other kind of file is an error.
+ */
+    static bool startEndpoint(const std::string& socketPath);
+    static void stopEndpoint();
+    static std::string getEndpointErrorMessage();
+
+private:
+    static constexpr std::size_t CacheLineSize = 64;
+    static constexpr std::size_t MaximumCounters = 512;
+    // Registrations past MaximumCounters all add to this slot, which isn't exported.
+    static constexpr std::size_t OverflowSlot = 0;
+
+    struct alignas(CacheLineSize) ThreadCounters
+    {
+        std::array<std::atomic<std::uint64_t>, MaximumCounters> values{};
+    };
+    static_assert(sizeof(ThreadCounters) % CacheLineSize == 0);
+
+    struct Registry;
+    struct Endpoint;
+
+    static Registry& registry();
+    static Endpoint& endpoint();
+    static ThreadCounters& threadCounters();
+    static void retireThread(const std::shared_ptr<ThreadCounters>& counters);
+    static void serveEndpoint(std::stop_token stopToken, int listenSocket);
+};
+
+#endif // METRICS_H_
@@ -22,6 +22,7 @@ CREATE TABLE IF NOT EXISTS  `PlannerTaskScheduleDB`.`UserProfile` (
     `IncludeMinorPriorityInSchedule` BOOLEAN DEFAULT TRUE,
     `UseLettersForMajorPriority` BOOLEAN DEFAULT TRUE,
     `SeparatePriorityWithDot` BOOLEAN DEFAULT FALSE,
+    `ContentHash` BIGINT UNSIGNED DEFAULT NULL,
     PRIMARY KEY (`UserID`, `LastName`, `LoginName`),
     UNIQUE INDEX `UserID_UNIQUE` (`UserID`),
     UNIQUE INDEX `FullName_UNIQUE` (`LastName`, `FirstName`, `MiddleInitial`),
@@ -108,11 +109,15 @@ CREATE TABLE IF NOT EXISTS  `PlannerTaskScheduleDB`.`Tasks` (
     `PriorityInGroup` INT UNSIGNED NOT NULL,
     `Personal` BOOLEAN,
     `DependencyCount` INT UNSIGNED,
+    `ImportKeyHash` BIGINT UNSIGNED DEFAULT NULL,
+    `ContentHash` BIGINT UNSIGNED DEFAULT NULL,
     PRIMARY KEY (`TaskID`, `CreatedBy`),
     UNIQUE INDEX `TaskID_UNIQUE` (`TaskID` ASC),
     INDEX `fk_Tasks_CreatedBy_idx` (`CreatedBy` ASC),
+    INDEX `ImportHash_idx` (`CreatedBy` ASC, `ImportKeyHash` ASC, `ContentHash` ASC),
     INDEX `fk_Tasks_AsignedTo_idx` (`AsignedTo` ASC),
     INDEX `Description_idx` (`Description` ASC),
+    INDEX `ParentTask_idx` (`ParentTask` ASC),
     CONSTRAINT `fk_Tasks_CreatedBy`
         FOREIGN KEY (`CreatedBy`)
         REFERENCES `UserProfile` (`UserID`)
@@ -156,6 +161,8 @@ CREATE TABLE IF NOT EXISTS  `PlannerTaskScheduleDB`.`TaskDependencies` (
     `Dependency`  INT UNSIGNED NOT NULL,
     PRIMARY KEY (`idTaskDependencies`, `TaskID`),
     UNIQUE INDEX `idTaskDependencies_UNIQUE` (`idTaskDependencies` ASC),
+    INDEX `fk_TaskDependencies_TaskID_idx` (`TaskID` ASC, `Dependency` ASC),
+    INDEX `Dependents_idx` (`Dependency` ASC, `TaskID` ASC),
     CONSTRAINT `fk_TaskDependencies_TaskID`
         FOREIGN KEY (`TaskID`)
         REFERENCES `Tasks` (`TaskID`)
@@ -196,6 +203,7 @@ CREATE TABLE IF NOT EXISTS `PlannerTaskScheduleDB`.`UserDaySchedule` (
     `DailyGoals` VARCHAR(45) NULL,
     PRIMARY KEY (`idUserDaySchedule`, `UserID`),
     UNIQUE INDEX `idUserDaySchedule_UNIQUE` (`idUserDaySchedule` ASC),
+    UNIQUE INDEX `UserDate_UNIQUE` (`UserID` ASC, `DateOfSchedule` ASC),
     INDEX `fk_UserDaySchedule_UserID_idx` (`UserID` ASC),
     CONSTRAINT `fk_UserDaySchedule_UserID`
       FOREIGN KEY (`UserID`)
@@ -215,9 +223,12 @@ CREATE TABLE IF NOT EXISTS `PlannerTaskScheduleDB`.`UserScheduleItem` (
     `ItemType` TINYINT NOT NULL,
     `Title` VARCHAR(128) NOT NULL,
     `Location` VARCHAR(45) DEFAULT NULL,
+    `TaskID` INT UNSIGNED DEFAULT NULL,
     PRIMARY KEY (`idUserScheduleItem`, `UserID`),
     UNIQUE INDEX `idUserScheduleItem_UNIQUE` (`idUserScheduleItem` ASC),
     INDEX `fk_UserScheduleItem_UserID_idx` (`UserID` ASC),
+    INDEX `UserStart_idx` (`UserID` ASC, `StartDateTime` ASC),
+    INDEX `fk_UserScheduleItem_TaskID_idx` (`TaskID` ASC),
     CONSTRAINT `fk_UserScheduleItem_UserID`
       FOREIGN KEY (`UserID`)
       REFERENCES `PlannerTaskScheduleDB`.`UserProfile` (`UserID`)
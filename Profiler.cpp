@@ -0,0 +1,514 @@
+#include <algorithm>
+#include "AllocationTracker.h"
+#include <atomic>
+#include <chrono>
+#include "commonUtilities.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <fstream>
+#include "HardwareCounters.h"
+#include "LogLinearHistogram.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include "Profiler.h"
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct Profiler::Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadProfile>> threadProfiles;
+    std::map<ZonePath, ZoneTotals> retiredTotals;
+};
+
+/*
+ * Only the writer thread writes to the trace file while a trace is running. The control mutex
+ * keeps startTrace() and stopTrace() apart.
+ */
+struct Profiler::TraceWriter
+{
+    std::mutex controlMutex;
+    std::mutex mutex;
+    std::condition_variable eventsQueued;
+    std::deque<TraceBuffer> queuedBuffers;
+    bool stopping = false;
+    bool firstEvent = true;
+    std::int64_t epochNs = 0;
+    std::ofstream traceFile;
+    std::jthread writerThread;
+
+    // A trace that is still running at exit is cut short, the thread is joined by its destructor.
+    ~TraceWriter()
+    {
+        {
+            std::lock_guard<std::mutex> writerLock(mutex);
+            stopping = true;
+        }
+        eventsQueued.notify_all();
+    }
+};
+
+static constexpr double NanosecondsPerMs = 1'000'000.0;
+static constexpr double NanosecondsPerMicrosecond = 1'000.0;
+
+static std::int64_t steadyClockNs(std::chrono::steady_clock::time_point timePoint)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+}
+
+std::vector<Profiler::ZoneReport> Profiler::getReport()
+{
+    std::map<ZonePath, ZoneTotals> totals;
+    {
+        Registry& profileRegistry = registry();
+        std::lock_guard<std::mutex> registryLock(profileRegistry.mutex);
+        totals = profileRegistry.retiredTotals;
+        for (const auto& threadProfile: profileRegistry.threadProfiles)
+        {
+            addThreadTotals(*threadProfile, totals);
+        }
+    }
+
+    // A map of paths is already in tree order, a parent path sorts before its children.
+    std::vector<ZoneReport> report;
+    report.reserve(totals.size());
+    for (const auto& [zonePath, zoneTotals]: totals)
+    {
+        const LogLinearHistogram& times = zoneTotals.times;
+        if (times.getCount() == 0)
+        {
+            continue;
+        }
+
+        std::string path;
+        for (std::string_view name: zonePath)
+        {
+            path.append(path.empty()? "" : "/").append(name);
+        }
+        double count = static_cast<double>(times.getCount());
+        report.push_back({std::move(path), zonePath.back(), zonePath.size() - 1, times.getCount(),
+            static_cast<double>(times.getMinimum()) / NanosecondsPerMs, times.getMean() / NanosecondsPerMs,
+            times.getPercentile(0.50) / NanosecondsPerMs, times.getPercentile(0.99) / NanosecondsPerMs,
+            static_cast<double>(times.getMaximum()) / NanosecondsPerMs,
+            static_cast<double>(zoneTotals.allocations) / count, zoneTotals.maximumAllocations,
+            static_cast<double>(zoneTotals.allocatedBytes) / count, zoneTotals.maximumAllocatedBytes});
+    }
+
+    return report;
+}
+
+/*
+ * The allocation columns are per call of the zone, they are only shown while allocations are tracked.
+ */
+std::string Profiler::getTextReport()
+{
+    std::vector<ZoneReport> report = getReport();
+    bool showAllocations = AllocationTracker::isEnabled();
+
+    std::size_t nameWidth = 4;
+    for (const auto& zone: report)
+    {
+        nameWidth = std::max(nameWidth, zone.depth * 2 + zone.name.size());
+    }
+
+    std::string text = std::format("{:<{}} {:>10} {:>12} {:>12} {:>12} {:>12} {:>12}", "Zone", nameWidth, "Count",
+        "Min ms", "Mean ms", "P50 ms", "P99 ms", "Max ms");
+    text.append(showAllocations? std::format(" {:>12} {:>12} {:>12} {:>12}\n", "Allocs", "Max allocs", "Bytes",
+        "Max bytes") : "\n");
+    for (const auto& zone: report)
+    {
+        std::string indentedName = std::string(zone.depth * 2, ' ').append(zone.name);
+        text.append(std::format("{:<{}} {:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}", indentedName,
+            nameWidth, zone.count, zone.minimumMs, zone.meanMs, zone.medianMs, zone.p99Ms, zone.maximumMs));
+        text.append(showAllocations? std::format(" {:>12.1f} {:>12} {:>12.0f} {:>12}\n", zone.meanAllocations,
+            zone.maximumAllocations, zone.meanAllocatedBytes, zone.maximumAllocatedBytes) : "\n");
+    }
+
+    return text;
+}
+
+std::string Profiler::getJSONReport()
+{
+    std::vector<ZoneReport> report = getReport();
+
+    std::string json("{\"zones\":[");
+    for (const auto& zone: report)
+    {
+        json.append(&zone == report.data()? "{\"path\":" : ",{\"path\":");
+        appendJSONString(json, zone.path);
+        json.append(",\"name\":");
+        appendJSONString(json, zone.name);
+        json.append(std::format(",\"depth\":{},\"count\":{},\"minimumMs\":{},\"meanMs\":{},\"p50Ms\":{},\"p99Ms\":{},"
+            "\"maximumMs\":{},\"meanAllocations\":{},\"maximumAllocations\":{},\"meanAllocatedBytes\":{},"
+            "\"maximumAllocatedBytes\":{}}}", zone.depth, zone.count, zone.minimumMs, zone.meanMs, zone.medianMs,
+            zone.p99Ms, zone.maximumMs, zone.meanAllocations, zone.maximumAllocations, zone.meanAllocatedBytes,
+            zone.maximumAllocatedBytes));
+    }
+    json.append("]}\n");
+
+    return json;
+}
+
+/*
+ * A thread may be adding a time while its zones are cleared, that time is lost or partly kept.
+ */
+void Profiler::reset()
+{
+    Registry& profileRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(profileRegistry.mutex);
+
+    profileRegistry.retiredTotals.clear();
+    for (const auto& threadProfile: profileRegistry.threadProfiles)
+    {
+        std::lock_guard<std::mutex> nodeLock(threadProfile->nodeMutex);
+        for (auto& node: threadProfile->nodes)
+        {
+            node.stats.clear();
+        }
+    }
+}
+
+bool Profiler::startTrace(const std::string& fileName)
+{
+    TraceWriter& writer = traceWriter();
+    std::lock_guard<std::mutex> controlLock(writer.controlMutex);
+    if (isTracing())
+    {
+        return false;
+    }
+
+    writer.traceFile.open(fileName, std::ios::out | std::ios::trunc);
+    if (!(writer.traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["))
+    {
+        writer.traceFile.close();
+        return false;
+    }
+    writer.queuedBuffers.clear();
+    writer.stopping = false;
+    writer.firstEvent = true;
+    writer.epochNs = steadyClockNs(std::chrono::steady_clock::now());
+
+    // Events of zones that were open when the last trace stopped.
+    {
+        Registry& profileRegistry = registry();
+        std::lock_guard<std::mutex> registryLock(profileRegistry.mutex);
+        for (const auto& threadProfile: profileRegistry.threadProfiles)
+        {
+            threadProfile->takeTraceEvents();
+        }
+    }
+
+    writer.writerThread = std::jthread(writeTraceEvents);
+    tracing.store(true, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool Profiler::stopTrace()
+{
+    TraceWriter& writer = traceWriter();
+    std::lock_guard<std::mutex> controlLock(writer.controlMutex);
+    if (!isTracing())
+    {
+        return false;
+    }
+    tracing.store(false, std::memory_order_relaxed);
+
+    {
+        Registry& profileRegistry = registry();
+        std::lock_guard<std::mutex> registryLock(profileRegistry.mutex);
+        for (const auto& threadProfile: profileRegistry.threadProfiles)
+        {
+            queueTraceEvents(threadProfile->takeTraceEvents());
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> writerLock(writer.mutex);
+        writer.stopping = true;
+    }
+    writer.eventsQueued.notify_all();
+    writer.writerThread.join();
+
+    writer.traceFile << "]}\n";
+    bool written = static_cast<bool>(writer.traceFile);
+    writer.traceFile.close();
+
+    return written && !writer.traceFile.fail();
+}
+
+/*
+ * Private methods.
+ */
+void Profiler::ZoneStats::add(std::uint64_t nanoseconds, AllocationTracker::Counts allocated)
+{
+    // Only the owning thread writes, a load and a store are enough and cheaper than fetch_add().
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    totalNs.store(totalNs.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+    if (nanoseconds < minimumNs.load(std::memory_order_relaxed))
+    {
+        minimumNs.store(nanoseconds, std::memory_order_relaxed);
+    }
+    if (nanoseconds > maximumNs.load(std::memory_order_relaxed))
+    {
+        maximumNs.store(nanoseconds, std::memory_order_relaxed);
+    }
+    std::atomic<std::uint64_t>& bucket = buckets[LogLinearHistogram::bucketIndex(nanoseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    allocations.store(allocations.load(std::memory_order_relaxed) + allocated.allocations, std::memory_order_relaxed);
+    allocatedBytes.store(allocatedBytes.load(std::memory_order_relaxed) + allocated.bytes, std::memory_order_relaxed);
+    if (allocated.allocations > maximumAllocations.load(std::memory_order_relaxed))
+    {
+        maximumAllocations.store(allocated.allocations, std::memory_order_relaxed);
+    }
+    if (allocated.bytes > maximumAllocatedBytes.load(std::memory_order_relaxed))
+    {
+        maximumAllocatedBytes.store(allocated.bytes, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::ZoneStats::addTo(ZoneTotals& totals) const
+{
+    totals.times.mergeSummary(count.load(std::memory_order_relaxed), totalNs.load(std::memory_order_relaxed),
+        minimumNs.load(std::memory_order_relaxed), maximumNs.load(std::memory_order_relaxed));
+    for (std::size_t bucket = 0; bucket < LogLinearHistogram::BucketCount; ++bucket)
+    {
+        totals.times.mergeBucket(bucket, buckets[bucket].load(std::memory_order_relaxed));
+    }
+
+    totals.allocations += allocations.load(std::memory_order_relaxed);
+    totals.allocatedBytes += allocatedBytes.load(std::memory_order_relaxed);
+    totals.maximumAllocations = std::max(totals.maximumAllocations, maximumAllocations.load(std::memory_order_relaxed));
+    totals.maximumAllocatedBytes = std::max(totals.maximumAllocatedBytes,
+        maximumAllocatedBytes.load(std::memory_order_relaxed));
+}
+
+void Profiler::ZoneStats::clear()
+{
+    count.store(0, std::memory_order_relaxed);
+    totalNs.store(0, std::memory_order_relaxed);
+    minimumNs.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    maximumNs.store(0, std::memory_order_relaxed);
+    for (auto& bucket: buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    allocations.store(0, std::memory_order_relaxed);
+    allocatedBytes.store(0, std::memory_order_relaxed);
+    maximumAllocations.store(0, std::memory_order_relaxed);
+    maximumAllocatedBytes.store(0, std::memory_order_relaxed);
+}
+
+Profiler::ThreadProfile::ThreadProfile()
+{
+    static std::atomic<std::uint32_t> lastThreadNumber = 0;
+
+    nodes.emplace_back().parent = RootNode;
+    threadNumber = lastThreadNumber.fetch_add(1, std::memory_order_relaxed) + 1;
+    traceEvents.reserve(TraceBufferEvents);
+}
+
+std::size_t Profiler::ThreadProfile::enter(std::string_view name)
+{
+    for (std::size_t child: nodes[currentNode].children)
+    {
+        // Most names are the same literal every time, compare the pointers first.
+        if (nodes[child].name.data() == name.data() || nodes[child].name == name)
+        {
+            currentNode = child;
+            return child;
+        }
+    }
+
+    std::lock_guard<std::mutex> nodeLock(nodeMutex);
+    std::size_t child = nodes.size();
+    ZoneNode& childNode = nodes.emplace_back();
+    childNode.name = name;
+    childNode.parent = currentNode;
+    nodes[currentNode].children.push_back(child);
+    currentNode = child;
+
+    return child;
+}
+
+void Profiler::ThreadProfile::leave(std::size_t node, std::uint64_t nanoseconds, AllocationTracker::Counts allocated)
+{
+    nodes[node].stats.add(nanoseconds, allocated);
+    currentNode = nodes[node].parent;
+}
+
+void Profiler::ThreadProfile::addTraceEvent(const TraceEvent& traceEvent)
+{
+    std::unique_lock<std::mutex> traceLock(traceMutex);
+    traceEvents.push_back(traceEvent);
+    if (traceEvents.size() < TraceBufferEvents)
+    {
+        return;
+    }
+
+    TraceBuffer fullBuffer{threadNumber, std::move(traceEvents)};
+    traceEvents = std::vector<TraceEvent>();
+    traceEvents.reserve(TraceBufferEvents);
+    traceLock.unlock();
+
+    queueTraceEvents(std::move(fullBuffer));
+}
+
+Profiler::TraceBuffer Profiler::ThreadProfile::takeTraceEvents()
+{
+    std::lock_guard<std::mutex> traceLock(traceMutex);
+    TraceBuffer traceBuffer{threadNumber, std::move(traceEvents)};
+    traceEvents.clear();
+    return traceBuffer;
+}
+
+Profiler::Registry& Profiler::registry()
+{
+    static Registry profileRegistry;
+    return profileRegistry;
+}
+
+Profiler::TraceWriter& Profiler::traceWriter()
+{
+    static TraceWriter writer;
+    return writer;
+}
+
+void Profiler::queueTraceEvents(TraceBuffer traceBuffer)
+{
+    if (traceBuffer.events.empty())
+    {
+        return;
+    }
+
+    TraceWriter& writer = traceWriter();
+    {
+        std::lock_guard<std::mutex> writerLock(writer.mutex);
+        writer.queuedBuffers.push_back(std::move(traceBuffer));
+    }
+    writer.eventsQueued.notify_one();
+}
+
+/*
+ * The body of the writer thread, formats and writes the queued buffers until the trace stops.
+ * Times are in microseconds from the start of the trace.
+ */
+void Profiler::writeTraceEvents()
+{
+    TraceWriter& writer = traceWriter();
+    std::string text;
+
+    std::unique_lock<std::mutex> writerLock(writer.mutex);
+    while (true)
+    {
+        writer.eventsQueued.wait(writerLock, [&writer]() { return writer.stopping || !writer.queuedBuffers.empty(); });
+        if (writer.queuedBuffers.empty())
+        {
+            break;
+        }
+        TraceBuffer traceBuffer = std::move(writer.queuedBuffers.front());
+        writer.queuedBuffers.pop_front();
+        writerLock.unlock();
+
+        text.clear();
+        for (const auto& traceEvent: traceBuffer.events)
+        {
+            text.append(writer.firstEvent? "{\"name\":" : ",\n{\"name\":");
+            writer.firstEvent = false;
+            appendJSONString(text, traceEvent.name);
+            text.append(std::format(",\"cat\":\"database\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,"
+                "\"tid\":{},\"args\":{{\"correlationID\":{}}}}}",
+                static_cast<double>(traceEvent.startNs - writer.epochNs) / NanosecondsPerMicrosecond,
+                static_cast<double>(traceEvent.durationNs) / NanosecondsPerMicrosecond, traceBuffer.threadNumber,
+                traceEvent.correlationID));
+        }
+        writer.traceFile << text;
+
+        writerLock.lock();
+    }
+}
+
+/*
+ * The profile is registered on the first zone of the thread. When the thread exits its totals
+ * are merged into the registry, so short lived threads such as import writers don't pile up.
+ */
+Profiler::ThreadProfile& Profiler::threadProfile()
+{
+    struct ThreadProfileOwner
+    {
+        std::shared_ptr<ThreadProfile> profile = std::make_shared<ThreadProfile>();
+
+        ThreadProfileOwner()
+        {
+            Registry& profileRegistry = registry();
+            std::lock_guard<std::mutex> registryLock(profileRegistry.mutex);
+            profileRegistry.threadProfiles.push_back(profile);
+        }
+        ~ThreadProfileOwner() { retireThread(profile); }
+    };
+
+    thread_local ThreadProfileOwner owner;
+    return *owner.profile;
+}
+
+void Profiler::retireThread(const std::shared_ptr<ThreadProfile>& profile)
+{
+    Registry& profileRegistry = registry();
+    std::lock_guard<std::mutex> registryLock(profileRegistry.mutex);
+
+    addThreadTotals(*profile, profileRegistry.retiredTotals);
+    if (isTracing())
+    {
+        queueTraceEvents(profile->takeTraceEvents());
+    }
+    std::erase(profileRegistry.threadProfiles, profile);
+}
+
+void Profiler::addThreadTotals(ThreadProfile& profile, std::map<ZonePath, ZoneTotals>& totals)
+{
+    std::lock_guard<std::mutex> nodeLock(profile.nodeMutex);
+
+    // A node is always added after its parent.
+    std::vector<ZonePath> nodePaths(profile.nodes.size());
+    for (std::size_t node = RootNode + 1; node < profile.nodes.size(); ++node)
+    {
+        const ZoneNode& zoneNode = profile.nodes[node];
+        nodePaths[node] = nodePaths[zoneNode.parent];
+        nodePaths[node].push_back(zoneNode.name);
+        zoneNode.stats.addTo(totals[nodePaths[node]]);
+    }
+}
+
+ProfileZone::ProfileZone(std::string_view name)
+: profile{Profiler::threadProfile()}, node{profile.enter(name)}, traced{Profiler::isTracing()},
+  startAllocations{AllocationTracker::getThreadCounts()}, start{std::chrono::steady_clock::now()},
+  countHardware{HardwareCounters::isEnabled() && HardwareCounters::readThreadCounters(hardwareStart)}
+{
+    if (traced && profile.nodes[node].parent == Profiler::RootNode)
+    {
+        profile.correlationID = Profiler::lastCorrelationID.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+}
+
+ProfileZone::~ProfileZone()
+{
+    if (countHardware)
+    {
+        HardwareCounters::addZone(profile.nodes[node].name, hardwareStart);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    AllocationTracker::Counts allocations = AllocationTracker::getThreadCounts();
+    profile.leave(node, static_cast<std::uint64_t>(elapsed.count()),
+        {allocations.allocations - startAllocations.allocations, allocations.bytes - startAllocations.bytes});
+    if (traced)
+    {
+        profile.addTraceEvent({profile.nodes[node].name, steadyClockNs(start), elapsed.count(), profile.correlationID});
+    }
+}
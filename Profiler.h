@@ -0,0 +1,207 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "AllocationTracker.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include "HardwareCounters.h"
+#include <limits>
+#include "LogLinearHistogram.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Hierarchical profiling zones. A ProfileZone times the scope it lives in and records the time
+ * under its path, the names of the zones that enclose it on the same thread and its own name.
+ * Every thread accumulates into its own zone tree without locks, only the first use of a path
+ * on a thread takes that thread's lock. Profiler::getReport() merges the trees of all threads,
+ * including threads that have exited, into the count, minimum, mean, median, 99th percentile
+ * and maximum time of each path.
+ *
+ * Zone names must have static storage duration, string literals or
+ * std::source_location::function_name(). Zones nest by thread, a zone in a coroutine is only
+ * nested correctly when one coroutine at a time runs on the thread, as with the io_context
+ * that each database call runs.
+ *
+ * While a trace is running every zone is also written to the trace file as a Chrome trace event,
+ * which chrome://tracing and Perfetto display. A zone that doesn't have an enclosing zone on its
+ * thread starts a new correlation ID, the zones nested in it carry the same ID. The events are
+ * buffered per thread and written by a background thread. When no trace is running a zone only
+ * checks one flag.
+ *
+ * While AllocationTracker is enabled a zone also records the heap allocations its thread made
+ * between opening and closing it, including those of the zones nested in it. The first use of a
+ * path on a thread allocates the path's node, which is counted in the enclosing zone.
+ *
+ * While HardwareCounters is enabled every zone is also a hardware counter zone of its name.
+ */
+class Profiler
+{
+public:
+    struct ZoneReport
+    {
+        std::string path;
+        std::string_view name;
+        std::size_t depth;
+        std::uint64_t count;
+        double minimumMs;
+        double meanMs;
+        double medianMs;
+        double p99Ms;
+        double maximumMs;
+        double meanAllocations;
+        std::uint64_t maximumAllocations;
+        double meanAllocatedBytes;
+        std::uint64_t maximumAllocatedBytes;
+    };
+
+/*
+ * The zones in tree order, every zone follows its parent.
+ */
+    static std::vector<ZoneReport> getReport();
+    static std::string getTextReport();
+    static std::string getJSONReport();
+/*
+ * Discards the times recorded so far. Zones that are open keep their paths.
+ */
+    static void reset();
+
+/*
+ * Returns false if the file can't be created or a trace is already running.
+ */
+    static bool startTrace(const std::string& fileName);
+/*
+ * Writes the buffered events and closes the file, returns false if any write failed.
+ */
+    static bool stopTrace();
+    static bool isTracing() { return tracing.load(std::memory_order_relaxed); };
+
+private:
+    friend class ProfileZone;
+
+    static constexpr std::size_t RootNode = 0;
+    static constexpr std::size_t TraceBufferEvents = 4096;
+
+    inline static std::atomic<bool> tracing = false;
+    inline static std::atomic<std::uint64_t> lastCorrelationID = 0;
+
+/*
+ * Written only by the thread that owns it, read by the reports.
+ */
+    struct ZoneTotals
+    {
+        LogLinearHistogram times;
+        std::uint64_t allocations = 0;
+        std::uint64_t allocatedBytes = 0;
+        std::uint64_t maximumAllocations = 0;
+        std::uint64_t maximumAllocatedBytes = 0;
+    };
+
+    struct ZoneStats
+    {
+        std::atomic<std::uint64_t> count = 0;
+        std::atomic<std::uint64_t> totalNs = 0;
+        std::atomic<std::uint64_t> minimumNs = std::numeric_limits<std::uint64_t>::max();
+        std::atomic<std::uint64_t> maximumNs = 0;
+        std::array<std::atomic<std::uint64_t>, LogLinearHistogram::BucketCount> buckets{};
+        std::atomic<std::uint64_t> allocations = 0;
+        std::atomic<std::uint64_t> allocatedBytes = 0;
+        std::atomic<std::uint64_t> maximumAllocations = 0;
+        std::atomic<std::uint64_t> maximumAllocatedBytes = 0;
+
+        void add(std::uint64_t nanoseconds, AllocationTracker::Counts allocated);
+        void addTo(ZoneTotals& totals) const;
+        void clear();
+    };
+
+    struct ZoneNode
+    {
+        std::string_view name;
+        std::size_t parent;
+        std::vector<std::size_t> children;
+        ZoneStats stats;
+    };
+
+    struct TraceEvent
+    {
+        std::string_view name;
+        std::int64_t startNs;
+        std::int64_t durationNs;
+        std::uint64_t correlationID;
+    };
+
+    struct TraceBuffer
+    {
+        std::uint32_t threadNumber;
+        std::vector<TraceEvent> events;
+    };
+
+/*
+ * The nodes are only added by the owning thread, under nodeMutex so a report can walk them.
+ * A deque keeps the nodes in place while it grows. The trace events are only added by the
+ * owning thread, under traceMutex so stopTrace() can take the events of running threads.
+ */
+    struct ThreadProfile
+    {
+        std::mutex nodeMutex;
+        std::deque<ZoneNode> nodes;
+        std::size_t currentNode = RootNode;
+        std::uint32_t threadNumber;
+        std::uint64_t correlationID = 0;
+        std::mutex traceMutex;
+        std::vector<TraceEvent> traceEvents;
+
+        ThreadProfile();
+        std::size_t enter(std::string_view name);
+        void leave(std::size_t node, std::uint64_t nanoseconds, AllocationTracker::Counts allocated);
+        void addTraceEvent(const TraceEvent& traceEvent);
+        TraceBuffer takeTraceEvents();
+    };
+
+    using ZonePath = std::vector<std::string_view>;
+
+/*
+ * The profiles of running threads and the totals of the threads that have exited.
+ */
+    struct Registry;
+    struct TraceWriter;
+
+    static Registry& registry();
+    static TraceWriter& traceWriter();
+    static void queueTraceEvents(TraceBuffer traceBuffer);
+    static void writeTraceEvents();
+    static ThreadProfile& threadProfile();
+    static void retireThread(const std::shared_ptr<ThreadProfile>& profile);
+    static void addThreadTotals(ThreadProfile& profile, std::map<ZonePath, ZoneTotals>& totals);
+};
+
+/*
+ * Times its scope as a zone of the current thread's profile.
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(std::string_view name);
+    ~ProfileZone();
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    Profiler::ThreadProfile& profile;
+    std::size_t node;
+    bool traced;
+    AllocationTracker::Counts startAllocations;
+    std::chrono::steady_clock::time_point start;
+    HardwareCounters::Values hardwareStart;
+    bool countHardware;
+};
+
+#endif // PROFILER_H_
@@ -0,0 +1,540 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include "commonUtilities.h"
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <functional>
+#include "LogLinearHistogram.h"
+#include "Metrics.h"
+#include <mutex>
+#include <optional>
+#include "QueryStatistics.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+static constexpr std::string_view PasswordColumn = "HashedPassWord";
+static constexpr std::string_view OtherQueries = "(other statements)";
+static constexpr double NanosecondsPerMs = 1'000'000.0;
+static constexpr std::size_t TextReportSqlLength = 100;
+
+struct QueryShapeHash
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view sql) const { return std::hash<std::string_view>{}(sql); };
+};
+
+struct QueryStatistics::Registry
+{
+    std::mutex mutex;
+    LogLinearHistogram connectTimes;
+    std::unordered_map<std::string, QueryShape, QueryShapeHash, std::equal_to<>> queryShapes;
+    std::deque<SlowQuery> slowQueries;
+    std::size_t slowQueryLogCapacity = DefaultSlowQueryLogCapacity;
+    std::atomic<bool> measuringResultBytes = false;
+    std::atomic<std::int64_t> slowQueryThresholdNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(DefaultSlowQueryThreshold).count();
+};
+
+void QueryStatistics::recordConnect(std::chrono::nanoseconds connectTime)
+{
+    static const Metrics::Counter connections = Metrics::counter("planner_db_connections_total",
+        "Connections opened to the database.");
+    static const Metrics::Counter connectSeconds = Metrics::counter("planner_db_connect_seconds_total",
+        "Time spent connecting to the database.", {}, 1e9);
+    connections.add();
+    connectSeconds.add(static_cast<std::uint64_t>(connectTime.count()));
+
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+    statistics.connectTimes.add(static_cast<std::uint64_t>(connectTime.count()));
+}
+
+void QueryStatistics::recordQuery(std::string_view sql, std::chrono::nanoseconds executeTime, std::uint64_t rows,
+    std::uint64_t bytes)
+{
+    static const Metrics::Counter statements = Metrics::counter("planner_db_statements_total",
+        "Statements executed.");
+    static const Metrics::Counter executeSeconds = Metrics::counter("planner_db_execute_seconds_total",
+        "Time spent executing statements and reading their results.", {}, 1e9);
+    static const Metrics::Counter rowsDecoded = Metrics::counter("planner_db_rows_total",
+        "Rows returned by statements.");
+    static const Metrics::Counter bytesReceived = Metrics::counter("planner_db_result_bytes_total",
+        "Bytes of field data returned by statements, while result bytes are measured.");
+    statements.add();
+    executeSeconds.add(static_cast<std::uint64_t>(executeTime.count()));
+    rowsDecoded.add(rows);
+    bytesReceived.add(bytes);
+
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+
+    auto queryShape = statistics.queryShapes.find(sql);
+    if (queryShape == statistics.queryShapes.end())
+    {
+        std::string_view shapeSql = statistics.queryShapes.size() < MaximumQueryShapes? sql : OtherQueries;
+        queryShape = statistics.queryShapes.try_emplace(std::string(shapeSql)).first;
+        if (queryShape->second.sql.empty())
+        {
+            queryShape->second.sql = shapeSql;
+        }
+    }
+
+    queryShape->second.executeNs.add(static_cast<std::uint64_t>(executeTime.count()));
+    queryShape->second.rows.add(rows);
+    queryShape->second.bytes.add(bytes);
+}
+
+bool QueryStatistics::isSlow(std::chrono::nanoseconds executeTime)
+{
+    return executeTime.count() >= registry().slowQueryThresholdNs.load(std::memory_order_relaxed);
+}
+
+void QueryStatistics::recordSlowQuery(SlowQuery slowQuery)
+{
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+
+    if (statistics.slowQueryLogCapacity == 0)
+    {
+        return;
+    }
+    while (statistics.slowQueries.size() >= statistics.slowQueryLogCapacity)
+    {
+        statistics.slowQueries.pop_front();
+    }
+    statistics.slowQueries.push_back(std::move(slowQuery));
+}
+
+void QueryStatistics::setMeasuringResultBytes(bool measure)
+{
+    registry().measuringResultBytes.store(measure, std::memory_order_relaxed);
+}
+
+bool QueryStatistics::isMeasuringResultBytes()
+{
+    return registry().measuringResultBytes.load(std::memory_order_relaxed);
+}
+
+void QueryStatistics::setSlowQueryThreshold(std::chrono::nanoseconds threshold)
+{
+    registry().slowQueryThresholdNs.store(threshold.count(), std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds QueryStatistics::getSlowQueryThreshold()
+{
+    return std::chrono::nanoseconds(registry().slowQueryThresholdNs.load(std::memory_order_relaxed));
+}
+
+void QueryStatistics::setSlowQueryLogCapacity(std::size_t capacity)
+{
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+
+    statistics.slowQueryLogCapacity = capacity;
+    while (statistics.slowQueries.size() > capacity)
+    {
+        statistics.slowQueries.pop_front();
+    }
+}
+
+LogLinearHistogram QueryStatistics::getConnectTimes()
+{
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+    return statistics.connectTimes;
+}
+
+std::vector<QueryStatistics::QueryShape> QueryStatistics::getQueryShapes()
+{
+    std::vector<QueryShape> queryShapes;
+    {
+        Registry& statistics = registry();
+        std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+        queryShapes.reserve(statistics.queryShapes.size());
+        for (const auto& queryShape: statistics.queryShapes)
+        {
+            queryShapes.push_back(queryShape.second);
+        }
+    }
+
+    std::ranges::sort(queryShapes, std::ranges::greater(),
+        [](const QueryShape& queryShape) { return queryShape.executeNs.getTotal(); });
+
+    return queryShapes;
+}
+
+std::vector<QueryStatistics::SlowQuery> QueryStatistics::getSlowQueries()
+{
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+    return std::vector<SlowQuery>(statistics.slowQueries.begin(), statistics.slowQueries.end());
+}
+
+/*
+ * Statements are written over several lines in the source, the text report puts each on one.
+ */
+static std::string singleLineSql(std::string_view sql, std::size_t maximumLength)
+{
+    std::string line;
+    for (char character: sql)
+    {
+        bool isSpace = std::isspace(static_cast<unsigned char>(character));
+        if (!isSpace || (!line.empty() && line.back() != ' '))
+        {
+            line.push_back(isSpace? ' ' : character);
+        }
+    }
+
+    if (line.size() > maximumLength)
+    {
+        line.resize(maximumLength - 3);
+        line.append("...");
+    }
+
+    return line;
+}
+
+std::string QueryStatistics::getTextReport()
+{
+    LogLinearHistogram connectTimes = getConnectTimes();
+    std::vector<QueryShape> queryShapes = getQueryShapes();
+    std::vector<SlowQuery> slowQueries = getSlowQueries();
+
+    std::string text = std::format("Connections {}, mean {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, max {:.3f} ms\n\n",
+        connectTimes.getCount(), connectTimes.getMean() / NanosecondsPerMs,
+        connectTimes.getPercentile(0.50) / NanosecondsPerMs, connectTimes.getPercentile(0.99) / NanosecondsPerMs,
+        static_cast<double>(connectTimes.getMaximum()) / NanosecondsPerMs);
+
+    text.append(std::format("{:>8} {:>12} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12}  {}\n", "Count", "Total ms",
+        "Mean ms", "P50 ms", "P99 ms", "Max ms", "Mean rows", "Mean bytes", "Statement"));
+    for (const auto& queryShape: queryShapes)
+    {
+        const LogLinearHistogram& executeNs = queryShape.executeNs;
+        text.append(std::format("{:>8} {:>12.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.1f} {:>12.1f}  {}\n",
+            executeNs.getCount(), static_cast<double>(executeNs.getTotal()) / NanosecondsPerMs,
+            executeNs.getMean() / NanosecondsPerMs, executeNs.getPercentile(0.50) / NanosecondsPerMs,
+            executeNs.getPercentile(0.99) / NanosecondsPerMs, static_cast<double>(executeNs.getMaximum()) / NanosecondsPerMs,
+            queryShape.rows.getMean(), queryShape.bytes.getMean(), singleLineSql(queryShape.sql, TextReportSqlLength)));
+    }
+
+    text.append(std::format("\nStatements slower than {:.3f} ms, {} logged\n",
+        static_cast<double>(getSlowQueryThreshold().count()) / NanosecondsPerMs, slowQueries.size()));
+    for (const auto& slowQuery: slowQueries)
+    {
+        text.append(std::format("{:%F %T} UTC {:>10.3f} ms {:>8} rows {:>10} bytes  {}\n",
+            std::chrono::floor<std::chrono::milliseconds>(slowQuery.finishedAt),
+            static_cast<double>(slowQuery.executeTime.count()) / NanosecondsPerMs, slowQuery.rows, slowQuery.bytes,
+            singleLineSql(slowQuery.sql, TextReportSqlLength)));
+        if (!slowQuery.parameters.empty())
+        {
+            std::string parameters;
+            for (const auto& parameter: slowQuery.parameters)
+            {
+                parameters.append(parameters.empty()? "" : ", ").append(parameter);
+            }
+            text.append(std::format("    Parameters: {}\n", parameters));
+        }
+    }
+
+    return text;
+}
+
+static void appendJSONHistogram(std::string& json, std::string_view name, const LogLinearHistogram& histogram,
+    double scale)
+{
+    json.append(std::format("\"{}\":{{\"count\":{},\"minimum\":{},\"mean\":{},\"p50\":{},\"p99\":{},\"maximum\":{}}}",
+        name, histogram.getCount(), static_cast<double>(histogram.getMinimum()) / scale, histogram.getMean() / scale,
+        histogram.getPercentile(0.50) / scale, histogram.getPercentile(0.99) / scale,
+        static_cast<double>(histogram.getMaximum()) / scale));
+}
+
+std::string QueryStatistics::getJSONReport()
+{
+    LogLinearHistogram connectTimes = getConnectTimes();
+    std::vector<QueryShape> queryShapes = getQueryShapes();
+    std::vector<SlowQuery> slowQueries = getSlowQueries();
+
+    std::string json("{");
+    appendJSONHistogram(json, "connectMs", connectTimes, NanosecondsPerMs);
+
+    json.append(",\"statements\":[");
+    for (const auto& queryShape: queryShapes)
+    {
+        json.append(&queryShape == queryShapes.data()? "{\"sql\":" : ",{\"sql\":");
+        appendJSONString(json, queryShape.sql);
+        json.push_back(',');
+        appendJSONHistogram(json, "executeMs", queryShape.executeNs, NanosecondsPerMs);
+        json.push_back(',');
+        appendJSONHistogram(json, "rows", queryShape.rows, 1.0);
+        json.push_back(',');
+        appendJSONHistogram(json, "bytes", queryShape.bytes, 1.0);
+        json.push_back('}');
+    }
+
+    json.append(std::format("],\"slowQueryThresholdMs\":{},\"slowQueries\":[",
+        static_cast<double>(getSlowQueryThreshold().count()) / NanosecondsPerMs));
+    for (const auto& slowQuery: slowQueries)
+    {
+        json.append(std::format("{}{{\"finishedAt\":\"{:%FT%TZ}\",\"executeMs\":{},\"rows\":{},\"bytes\":{},\"sql\":",
+            &slowQuery == slowQueries.data()? "" : ",", std::chrono::floor<std::chrono::milliseconds>(slowQuery.finishedAt),
+            static_cast<double>(slowQuery.executeTime.count()) / NanosecondsPerMs, slowQuery.rows, slowQuery.bytes));
+        appendJSONString(json, slowQuery.sql);
+        json.append(",\"parameters\":[");
+        for (const auto& parameter: slowQuery.parameters)
+        {
+            if (&parameter != slowQuery.parameters.data())
+            {
+                json.push_back(',');
+            }
+            appendJSONString(json, parameter);
+        }
+        json.append("]}");
+    }
+    json.append("]}\n");
+
+    return json;
+}
+
+void QueryStatistics::reset()
+{
+    Registry& statistics = registry();
+    std::lock_guard<std::mutex> statisticsLock(statistics.mutex);
+
+    statistics.connectTimes.clear();
+    statistics.queryShapes.clear();
+    statistics.slowQueries.clear();
+}
+
+static bool isIdentifierCharacter(char character)
+{
+    return std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '.' ||
+        character == '`';
+}
+
+static bool equalsIgnoringCase(std::string_view left, std::string_view right)
+{
+    return std::ranges::equal(left, right, [](char leftCharacter, char rightCharacter)
+        {
+            return std::tolower(static_cast<unsigned char>(leftCharacter)) ==
+                std::tolower(static_cast<unsigned char>(rightCharacter));
+        });
+}
+
+static std::string_view trimSql(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/*
+ * Drops the table qualifier and the quotes, NewUser.HashedPassWord and `NewUser`.`HashedPassWord`
+ * name the HashedPassWord column.
+ */
+static std::string_view columnName(std::string_view identifier)
+{
+    std::size_t qualifierEnd = identifier.rfind('.');
+    std::string_view column = qualifierEnd == std::string_view::npos? identifier : identifier.substr(qualifierEnd + 1);
+    if (column.size() >= 2 && column.front() == '`' && column.back() == '`')
+    {
+        column = column.substr(1, column.size() - 2);
+    }
+    return column;
+}
+
+/*
+ * The column a placeholder is compared with or assigned to, Column = {} or Column < {}.
+ */
+static std::optional<std::string_view> comparedColumn(std::string_view beforePlaceholder)
+{
+    beforePlaceholder = trimSql(beforePlaceholder);
+    std::size_t operatorLength = 0;
+    while (operatorLength < beforePlaceholder.size() && operatorLength < 2 &&
+        std::string_view("=<>!").contains(beforePlaceholder[beforePlaceholder.size() - 1 - operatorLength]))
+    {
+        ++operatorLength;
+    }
+    if (operatorLength == 0)
+    {
+        return std::nullopt;
+    }
+
+    beforePlaceholder = trimSql(beforePlaceholder.substr(0, beforePlaceholder.size() - operatorLength));
+    std::size_t identifierStart = beforePlaceholder.size();
+    while (identifierStart > 0 && isIdentifierCharacter(beforePlaceholder[identifierStart - 1]))
+    {
+        --identifierStart;
+    }
+    if (identifierStart == beforePlaceholder.size())
+    {
+        return std::nullopt;
+    }
+
+    return columnName(beforePlaceholder.substr(identifierStart));
+}
+
+/*
+ * The column a placeholder in INSERT INTO Table (Column, ...) VALUES ({}, ...) is inserted into.
+ */
+static std::optional<std::string_view> insertedColumn(std::string_view beforePlaceholder)
+{
+    std::size_t valueIndex = 0;
+    std::size_t depth = 0;
+    std::size_t position = beforePlaceholder.size();
+    bool inValueList = false;
+    while (!inValueList && position > 0)
+    {
+        char character = beforePlaceholder[--position];
+        if (character == ')')
+        {
+            ++depth;
+        }
+        else if (character == '(' && depth > 0)
+        {
+            --depth;
+        }
+        else if (character == '(')
+        {
+            inValueList = true;
+        }
+        else if (character == ',' && depth == 0)
+        {
+            ++valueIndex;
+        }
+    }
+
+    // Earlier rows of a multiple row insert, VALUES ({}, {}), ({}, {}).
+    std::string_view beforeValues = trimSql(beforePlaceholder.substr(0, position));
+    while (inValueList && !beforeValues.empty() && beforeValues.back() == ',')
+    {
+        beforeValues = trimSql(beforeValues.substr(0, beforeValues.size() - 1));
+        inValueList = false;
+        depth = 0;
+        position = beforeValues.size();
+        while (!inValueList && position > 0 && (depth > 0 || beforeValues[position - 1] == ')'))
+        {
+            char character = beforeValues[--position];
+            if (character == ')')
+            {
+                ++depth;
+            }
+            else if (character == '(')
+            {
+                inValueList = --depth == 0;
+            }
+        }
+        beforeValues = trimSql(beforeValues.substr(0, position));
+    }
+    constexpr std::string_view ValuesKeyword = "VALUES";
+    if (!inValueList || beforeValues.size() < ValuesKeyword.size() ||
+        !equalsIgnoringCase(beforeValues.substr(beforeValues.size() - ValuesKeyword.size()), ValuesKeyword))
+    {
+        return std::nullopt;
+    }
+
+    std::string_view beforeKeyword = trimSql(beforeValues.substr(0, beforeValues.size() - ValuesKeyword.size()));
+    std::size_t columnListStart = beforeKeyword.rfind('(');
+    if (beforeKeyword.empty() || beforeKeyword.back() != ')' || columnListStart == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+
+    std::string_view columnList = beforeKeyword.substr(columnListStart + 1, beforeKeyword.size() - columnListStart - 2);
+    for (std::size_t column = 0; column < valueIndex; ++column)
+    {
+        std::size_t separator = columnList.find(',');
+        if (separator == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        columnList.remove_prefix(separator + 1);
+    }
+
+    return columnName(trimSql(columnList.substr(0, columnList.find(','))));
+}
+
+/*
+ * Only statements that use the HashedPassWord column are checked. A parameter is shown only when
+ * every placeholder that uses it can be matched to a column other than HashedPassWord.
+ */
+std::vector<bool> QueryStatistics::findRedactedParameters(std::string_view sql, std::size_t parameterCount)
+{
+    std::vector<bool> redacted(parameterCount, false);
+    if (std::ranges::search(sql, PasswordColumn, [](char left, char right)
+        {
+            return std::tolower(static_cast<unsigned char>(left)) == std::tolower(static_cast<unsigned char>(right));
+        }).empty())
+    {
+        return redacted;
+    }
+
+    std::size_t nextAutomaticIndex = 0;
+    for (std::size_t position = 0; position < sql.size(); ++position)
+    {
+        if (sql[position] != '{')
+        {
+            continue;
+        }
+        if (position + 1 < sql.size() && sql[position + 1] == '{')
+        {
+            ++position;
+            continue;
+        }
+
+        std::size_t placeholderEnd = sql.find('}', position);
+        if (placeholderEnd == std::string_view::npos)
+        {
+            break;
+        }
+        std::string_view indexText = sql.substr(position + 1, placeholderEnd - position - 1);
+
+        std::size_t index = nextAutomaticIndex;
+        if (indexText.empty())
+        {
+            ++nextAutomaticIndex;
+        }
+        else if (auto [indexEnd, error] = std::from_chars(indexText.data(), indexText.data() + indexText.size(), index);
+            error != std::errc() || indexEnd != indexText.data() + indexText.size())
+        {
+            // Named placeholders aren't used here, when they are nothing can be matched.
+            return std::vector<bool>(parameterCount, true);
+        }
+
+        std::string_view beforePlaceholder = sql.substr(0, position);
+        std::optional<std::string_view> column = comparedColumn(beforePlaceholder);
+        if (!column)
+        {
+            column = insertedColumn(beforePlaceholder);
+        }
+        if (index < parameterCount && (!column || equalsIgnoringCase(*column, PasswordColumn)))
+        {
+            redacted[index] = true;
+        }
+
+        position = placeholderEnd;
+    }
+
+    return redacted;
+}
+
+/*
+ * Private methods.
+ */
+QueryStatistics::Registry& QueryStatistics::registry()
+{
+    static Registry statistics;
+    return statistics;
+}
@@ -0,0 +1,96 @@
+#ifndef QUERYSTATISTICS_H_
+#define QUERYSTATISTICS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "LogLinearHistogram.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Statistics of every statement executed by the database interfaces, kept for the life of the
+ * program. Statements are grouped by shape, the SQL with its {} placeholders before the
+ * parameters are formatted in. For each shape there are histograms of the execution time, the
+ * rows returned and the bytes of field data returned. The execution time is measured by the
+ * client, from sending the statement to reading the last row. Measuring the bytes walks every
+ * field of the result, the bytes are only measured while setMeasuringResultBytes() is on and for
+ * the statements in the slow query log, otherwise they are recorded as 0.
+ *
+ * Statements slower than the threshold are also kept in a bounded slow query log with their
+ * parameters. Parameters bound to the HashedPassWord column, or that can't be matched to a
+ * column in a statement that uses HashedPassWord, are logged as <redacted>. Parameters that
+ * aren't single values, such as the row sequences of batched inserts, are logged as <omitted>.
+ *
+ * All members are thread safe.
+ */
+class QueryStatistics
+{
+public:
+    struct QueryShape
+    {
+        std::string sql;
+        LogLinearHistogram executeNs;
+        LogLinearHistogram rows;
+        LogLinearHistogram bytes;
+    };
+
+    struct SlowQuery
+    {
+        std::chrono::system_clock::time_point finishedAt;
+        std::string sql;
+        std::vector<std::string> parameters;
+        std::chrono::nanoseconds executeTime;
+        std::uint64_t rows;
+        std::uint64_t bytes;
+    };
+
+    static constexpr std::string_view RedactedParameter = "<redacted>";
+    static constexpr std::string_view OmittedParameter = "<omitted>";
+    static constexpr std::size_t DefaultSlowQueryLogCapacity = 100;
+    static constexpr std::chrono::milliseconds DefaultSlowQueryThreshold{100};
+
+    static void recordConnect(std::chrono::nanoseconds connectTime);
+    static void recordQuery(std::string_view sql, std::chrono::nanoseconds executeTime, std::uint64_t rows,
+        std::uint64_t bytes);
+    static bool isSlow(std::chrono::nanoseconds executeTime);
+    static void recordSlowQuery(SlowQuery slowQuery);
+
+    static void setMeasuringResultBytes(bool measure);
+    static bool isMeasuringResultBytes();
+    static void setSlowQueryThreshold(std::chrono::nanoseconds threshold);
+    static std::chrono::nanoseconds getSlowQueryThreshold();
+/*
+ * The oldest entries are dropped when the log is full.
+ */
+    static void setSlowQueryLogCapacity(std::size_t capacity);
+
+    static LogLinearHistogram getConnectTimes();
+/*
+ * Ordered by total execution time, the most expensive shape first.
+ */
+    static std::vector<QueryShape> getQueryShapes();
+/*
+ * Oldest first.
+ */
+    static std::vector<SlowQuery> getSlowQueries();
+    static std::string getTextReport();
+    static std::string getJSONReport();
+    static void reset();
+
+/*
+ * Returns true for each of the parameterCount parameters of sql that must not be logged.
+ */
+    static std::vector<bool> findRedactedParameters(std::string_view sql, std::size_t parameterCount);
+
+private:
+    // Statements built at run time would add a shape per statement, past this they share one.
+    static constexpr std::size_t MaximumQueryShapes = 1024;
+
+    struct Registry;
+
+    static Registry& registry();
+};
+
+#endif // QUERYSTATISTICS_H_
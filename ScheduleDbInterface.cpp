@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <boost/asio.hpp>
+#include <boost/mysql.hpp>
+#include "BoostDBInterfaceCore.h"
+#include <chrono>
+#include "CommandLineParser.h"
+#include <exception>
+#include <format>
+#include <functional>
+#include "Profiler.h"
+#include <span>
+#include "ScheduleDbInterface.h"
+#include "ScheduleItemModel.h"
+#include <string>
+#include "UserModel.h"
+#include <utility>
+#include <vector>
+
+ScheduleDbInterface::ScheduleDbInterface()
+: BoostDBInterfaceCore()
+{
+}
+
+ScheduleItemList ScheduleDbInterface::getScheduleItemsForUser(UserModel& user, std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    ScheduleItemList items;
+
+    try
+    {
+        std::chrono::sys_days windowEnd = std::chrono::sys_days(lastDay) + std::chrono::days(1);
+        selectStatementWhatArgs.push_back(std::any(user.getUserID()));
+        selectStatementWhatArgs.push_back(std::any(convertChronoTimeToBoostMySQLDateTime(std::chrono::sys_days(firstDay))));
+        selectStatementWhatArgs.push_back(std::any(convertChronoTimeToBoostMySQLDateTime(windowEnd)));
+
+        NSBM::results localResults = runQueryAsync(std::bind(&ScheduleDbInterface::coRoSelectScheduleItemsForUser, this));
+        items = processResults(localResults);
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In ScheduleDbInterface::getScheduleItemsForUser({}) : {}", user.getUserID(), e.what()));
+    }
+
+    return items;
+}
+
+bool ScheduleDbInterface::replaceTaskExecutionItems(UserModel& user, std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay, const ScheduleItemList& items, const std::vector<DayScheduleRow>& days)
+{
+    return replaceTaskExecutionItemsForUsers({user.getUserID()}, firstDay, lastDay, items, days);
+}
+
+bool ScheduleDbInterface::replaceTaskExecutionItemsForUsers(const std::vector<std::size_t>& userIDs,
+    std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay, const ScheduleItemList& items,
+    const std::vector<DayScheduleRow>& days)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (userIDs.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoReplaceTaskExecutionItems(userIDs, firstDay, lastDay, items, days),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+
+        return true;
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In ScheduleDbInterface::replaceTaskExecutionItemsForUsers({} users) : {}",
+            userIDs.size(), e.what()));
+    }
+
+    return false;
+}
+
+bool ScheduleDbInterface::updateTaskExecutionItems(UserModel& user, const ScheduleItemList& removedItems,
+    const ScheduleItemList& addedItems)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoUpdateTaskExecutionItems(user.getUserID(), removedItems, addedItems),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+
+        return true;
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In ScheduleDbInterface::updateTaskExecutionItems({}) : {}", user.getUserID(), e.what()));
+    }
+
+    return false;
+}
+
+/*
+ * Private methods.
+ */
+ScheduleItemList ScheduleDbInterface::processResults(NSBM::results& results)
+{
+    ProfileZone zone("decode");
+    ScheduleItemList items;
+
+    items.reserve(results.rows().size());
+    for (auto row: results.rows())
+    {
+        ScheduleItemModel newItem;
+        processResultRow(row, newItem);
+        items.push_back(newItem);
+    }
+
+    return items;
+}
+
+void ScheduleDbInterface::processResultRow(NSBM::row_view rv, ScheduleItemModel& newItem)
+{
+    // Required fields.
+    newItem.setScheduleItemID(rv.at(scheduleItemIdIdx).as_uint64());
+    newItem.setUserID(rv.at(userIdIdx).as_uint64());
+    newItem.setStartTime(convertBoostMySQLDateTimeToChronoTime(rv.at(startDateTimeIdx).as_datetime()));
+    newItem.setEndTime(convertBoostMySQLDateTimeToChronoTime(rv.at(endDateTimeIdx).as_datetime()));
+    newItem.setItemType(static_cast<ScheduleItemModel::ScheduleItemType>(rv.at(itemTypeIdx).as_int64()));
+    newItem.setTitle(rv.at(titleIdx).as_string());
+
+    // Optional fields.
+    if (!rv.at(locationIdx).is_null())
+    {
+        newItem.setLocation(rv.at(locationIdx).as_string());
+    }
+
+    if (!rv.at(taskIdIdx).is_null())
+    {
+        newItem.setTaskID(rv.at(taskIdIdx).as_uint64());
+    }
+
+    // All the set functions set modified, since this item is new in memory it is not modified.
+    newItem.clearModified();
+}
+
+NSBA::awaitable<NSBM::results> ScheduleDbInterface::coRoSelectScheduleItemsForUser()
+{
+    std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::datetime windowStart = std::any_cast<NSBM::datetime>(selectStatementWhatArgs[1]);
+    NSBM::datetime windowEnd = std::any_cast<NSBM::datetime>(selectStatementWhatArgs[2]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT idUserScheduleItem, UserID, StartDateTime, EndDateTime, ItemType, Title, Location, TaskID "
+            "FROM UserScheduleItem WHERE UserID = {0} AND StartDateTime < {2} AND EndDateTime > {1} ORDER BY StartDateTime ASC",
+            userID, windowStart, windowEnd),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+/*
+ * If any statement throws the connection is closed without a COMMIT and the server rolls the
+ * transaction back, the previous schedule is left in place.
+ */
+NSBA::awaitable<NSBM::results> ScheduleDbInterface::coRoReplaceTaskExecutionItems(const std::vector<std::size_t>& userIDs,
+    std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay, const ScheduleItemList& items,
+    const std::vector<DayScheduleRow>& days)
+{
+    constexpr unsigned int taskExecution = static_cast<unsigned int>(ScheduleItemModel::ScheduleItemType::Task_Execution);
+    NSBM::datetime windowStart = convertChronoTimeToBoostMySQLDateTime(std::chrono::sys_days(firstDay));
+    NSBM::datetime windowEnd = convertChronoTimeToBoostMySQLDateTime(std::chrono::sys_days(lastDay) + std::chrono::days(1));
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("DELETE FROM UserScheduleItem WHERE UserID IN ({0}) AND ItemType = {1} AND TaskID IS NOT NULL"
+            " AND StartDateTime >= {2} AND StartDateTime < {3}",
+            userIDs, taskExecution, windowStart, windowEnd),
+        result
+    );
+
+    co_await coRoInsertScheduleItems(conn, items);
+
+    if (!days.empty())
+    {
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO UserDaySchedule (UserID, DateOfSchedule, StartOfDay, EndOfDay) VALUES {0}"
+                " ON DUPLICATE KEY UPDATE StartOfDay = VALUES(StartOfDay), EndOfDay = VALUES(EndOfDay)",
+                NSBM::sequence(days,
+                    [this](const DayScheduleRow& day, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "({}, {}, {}, {})", day.userID,
+                            convertChronoDateToBoostMySQLDate(day.dateOfSchedule),
+                            NSBM::time(day.startOfDay), NSBM::time(day.endOfDay));
+                    })),
+            result
+        );
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+NSBA::awaitable<NSBM::results> ScheduleDbInterface::coRoUpdateTaskExecutionItems(std::size_t userID,
+    const ScheduleItemList& removedItems, const ScheduleItemList& addedItems)
+{
+    constexpr unsigned int taskExecution = static_cast<unsigned int>(ScheduleItemModel::ScheduleItemType::Task_Execution);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    std::span<const ScheduleItemModel> remainingItems(removedItems);
+    while (!remainingItems.empty())
+    {
+        std::span<const ScheduleItemModel> batch = remainingItems.first(std::min(InsertBatchSize, remainingItems.size()));
+        remainingItems = remainingItems.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("DELETE FROM UserScheduleItem WHERE UserID = {0} AND ItemType = {1}"
+                " AND (TaskID, StartDateTime) IN ({2})",
+                userID, taskExecution,
+                NSBM::sequence(batch,
+                    [this](const ScheduleItemModel& item, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "({}, {})", item.getTaskID(),
+                            convertChronoTimeToBoostMySQLDateTime(item.getStartTime()));
+                    })),
+            result
+        );
+    }
+
+    co_await coRoInsertScheduleItems(conn, addedItems);
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+NSBA::awaitable<void> ScheduleDbInterface::coRoInsertScheduleItems(NSBM::any_connection& conn,
+    const ScheduleItemList& items)
+{
+    NSBM::results result;
+
+    std::span<const ScheduleItemModel> remainingItems(items);
+    while (!remainingItems.empty())
+    {
+        std::span<const ScheduleItemModel> batch = remainingItems.first(std::min(InsertBatchSize, remainingItems.size()));
+        remainingItems = remainingItems.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO UserScheduleItem (UserID, StartDateTime, EndDateTime, ItemType, Title, TaskID)"
+                " VALUES {0}",
+                NSBM::sequence(batch,
+                    [this](const ScheduleItemModel& item, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {})", item.getUserID(),
+                            convertChronoTimeToBoostMySQLDateTime(item.getStartTime()),
+                            convertChronoTimeToBoostMySQLDateTime(item.getEndTime()),
+                            item.getItemTypeIntVal(), item.getTitle(), item.rawTaskID());
+                    })),
+            result
+        );
+    }
+}
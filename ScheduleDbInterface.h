@@ -0,0 +1,74 @@
+#ifndef SCHEDULEDBINTERFACE_H_
+#define SCHEDULEDBINTERFACE_H_
+
+#include "BoostDBInterfaceCore.h"
+#include <chrono>
+#include "CommandLineParser.h"
+#include "ScheduleItemModel.h"
+#include "UserModel.h"
+#include <vector>
+
+class ScheduleDbInterface : public BoostDBInterfaceCore
+{
+public:
+    struct DayScheduleRow
+    {
+        std::size_t userID;
+        std::chrono::year_month_day dateOfSchedule;
+        std::chrono::minutes startOfDay;
+        std::chrono::minutes endOfDay;
+    };
+
+    ScheduleDbInterface();
+    ~ScheduleDbInterface() = default;
+    ScheduleItemList getScheduleItemsForUser(UserModel& user, std::chrono::year_month_day firstDay,
+        std::chrono::year_month_day lastDay);
+/*
+ * Replaces all of the generated task execution items that start between firstDay and lastDay
+ * with the new items and stores the working hours of each day, in one transaction. The items
+ * are written with multi-row INSERT statements.
+ */
+    bool replaceTaskExecutionItems(UserModel& user, std::chrono::year_month_day firstDay,
+        std::chrono::year_month_day lastDay, const ScheduleItemList& items, const std::vector<DayScheduleRow>& days);
+/*
+ * Batch version of replaceTaskExecutionItems(), the schedules of all of the users are replaced
+ * in one transaction. The user of each item and day is taken from the item or day.
+ */
+    bool replaceTaskExecutionItemsForUsers(const std::vector<std::size_t>& userIDs, std::chrono::year_month_day firstDay,
+        std::chrono::year_month_day lastDay, const ScheduleItemList& items, const std::vector<DayScheduleRow>& days);
+/*
+ * Applies the difference between two generated schedules in one transaction. Removed items
+ * are found by their (UserID, TaskID, StartDateTime) key, only the rows that changed are written.
+ */
+    bool updateTaskExecutionItems(UserModel& user, const ScheduleItemList& removedItems, const ScheduleItemList& addedItems);
+
+    static constexpr std::size_t InsertBatchSize = 1000;
+
+private:
+    ScheduleItemList processResults(NSBM::results& results);
+    void processResultRow(NSBM::row_view rv, ScheduleItemModel& newItem);
+    NSBA::awaitable<NSBM::results> coRoSelectScheduleItemsForUser();
+    NSBA::awaitable<NSBM::results> coRoReplaceTaskExecutionItems(const std::vector<std::size_t>& userIDs,
+        std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay, const ScheduleItemList& items,
+        const std::vector<DayScheduleRow>& days);
+    NSBA::awaitable<NSBM::results> coRoUpdateTaskExecutionItems(std::size_t userID, const ScheduleItemList& removedItems,
+        const ScheduleItemList& addedItems);
+    NSBA::awaitable<void> coRoInsertScheduleItems(NSBM::any_connection& conn, const ScheduleItemList& items);
+
+/*
+ * The indexes below are based on the following select statement, maintain this order
+ * for any new select statements, add any new field indexes at the end.
+ *      "SELECT idUserScheduleItem, UserID, StartDateTime, EndDateTime, ItemType, Title, Location, TaskID "
+ *          "FROM UserScheduleItem WHERE UserID = {0}"
+ */
+    const std::size_t scheduleItemIdIdx = 0;
+    const std::size_t userIdIdx = 1;
+    const std::size_t startDateTimeIdx = 2;
+    const std::size_t endDateTimeIdx = 3;
+    const std::size_t itemTypeIdx = 4;
+    const std::size_t titleIdx = 5;
+    const std::size_t locationIdx = 6;
+    const std::size_t taskIdIdx = 7;
+};
+
+#endif // SCHEDULEDBINTERFACE_H_
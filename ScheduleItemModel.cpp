@@ -0,0 +1,70 @@
+#include <chrono>
+#include "ScheduleItemModel.h"
+#include <string>
+
+ScheduleItemModel::ScheduleItemModel()
+: modified{false},
+  scheduleItemID{0},
+  userID{0},
+  itemType{ScheduleItemType::Task_Execution}
+{
+}
+
+ScheduleItemModel::ScheduleItemModel(std::size_t userIDIn, ScheduleTime start, ScheduleTime end,
+    ScheduleItemType type, std::string titleIn)
+: ScheduleItemModel()
+{
+    setUserID(userIDIn);
+    setStartTime(start);
+    setEndTime(end);
+    setItemType(type);
+    setTitle(titleIn);
+}
+
+void ScheduleItemModel::setScheduleItemID(std::size_t newID)
+{
+    modified = true;
+    scheduleItemID = newID;
+}
+
+void ScheduleItemModel::setUserID(std::size_t inUserID)
+{
+    modified = true;
+    userID = inUserID;
+}
+
+void ScheduleItemModel::setStartTime(ScheduleTime start)
+{
+    modified = true;
+    startTime = start;
+}
+
+void ScheduleItemModel::setEndTime(ScheduleTime end)
+{
+    modified = true;
+    endTime = end;
+}
+
+void ScheduleItemModel::setItemType(ScheduleItemType type)
+{
+    modified = true;
+    itemType = type;
+}
+
+void ScheduleItemModel::setTitle(std::string inTitle)
+{
+    modified = true;
+    title = inTitle;
+}
+
+void ScheduleItemModel::setLocation(std::string inLocation)
+{
+    modified = true;
+    location = inLocation;
+}
+
+void ScheduleItemModel::setTaskID(std::size_t inTaskID)
+{
+    modified = true;
+    taskID = inTaskID;
+}
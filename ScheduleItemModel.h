@@ -0,0 +1,104 @@
+#ifndef SCHEDULEITEMMODEL_H_
+#define SCHEDULEITEMMODEL_H_
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * One row of the UserScheduleItem table. Schedule times are wall clock times, the same values
+ * that are stored in the DATETIME columns, no time zone conversion is performed.
+ */
+class ScheduleItemModel
+{
+public:
+/*
+ * The values match the keys of the UserScheduleItemTypeEnum table.
+ */
+    enum class ScheduleItemType
+    {
+        Meeting = 1, Phone_Call, Task_Execution, Personal_Appointment, Personal_Other
+    };
+    using ScheduleTime = std::chrono::sys_time<std::chrono::minutes>;
+
+    ScheduleItemModel();
+    ScheduleItemModel(std::size_t userID, ScheduleTime start, ScheduleTime end, ScheduleItemType type, std::string titleIn);
+    virtual ~ScheduleItemModel() = default;
+
+    bool isInDatabase() const { return scheduleItemID > 0; };
+    bool isModified() const { return modified; };
+    void clearModified() { modified = false; };
+    bool isGeneratedTaskExecution() const
+        { return itemType == ScheduleItemType::Task_Execution && taskID.has_value(); };
+    bool overlaps(const ScheduleItemModel& other) const { return startTime < other.endTime && other.startTime < endTime; };
+    std::size_t getScheduleItemID() const { return scheduleItemID; };
+    std::size_t getUserID() const { return userID; };
+    ScheduleTime getStartTime() const { return startTime; };
+    ScheduleTime getEndTime() const { return endTime; };
+    std::chrono::minutes getDuration() const { return endTime - startTime; };
+    ScheduleItemType getItemType() const { return itemType; };
+    unsigned int getItemTypeIntVal() const { return static_cast<unsigned int>(itemType); };
+    std::string getTitle() const { return title; };
+    std::string getLocation() const { return location.value_or(""); };
+    std::optional<std::string> rawLocation() const { return location; };
+    std::size_t getTaskID() const { return taskID.value_or(0); };
+    std::optional<std::size_t> rawTaskID() const { return taskID; };
+    void setScheduleItemID(std::size_t newID);
+    void setUserID(std::size_t userID);
+    void setStartTime(ScheduleTime start);
+    void setEndTime(ScheduleTime end);
+    void setItemType(ScheduleItemType type);
+    void setTitle(std::string title);
+    void setLocation(std::string location);
+    void setTaskID(std::size_t taskID);
+
+    bool operator==(const ScheduleItemModel& other) const
+    {
+        return userID == other.userID && startTime == other.startTime && endTime == other.endTime &&
+            itemType == other.itemType && taskID == other.taskID && title == other.title;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ScheduleItemModel& item)
+    {
+        constexpr const char* outFmtStr = "\t{}: {}\n";
+        os << "ScheduleItemModel:\n";
+        os << std::format(outFmtStr, "Schedule Item ID", item.scheduleItemID);
+        os << std::format(outFmtStr, "User ID", item.userID);
+        os << std::format(outFmtStr, "Start", item.startTime);
+        os << std::format(outFmtStr, "End", item.endTime);
+        os << std::format(outFmtStr, "Item Type", item.getItemTypeIntVal());
+        os << std::format(outFmtStr, "Title", item.title);
+
+        os << "Optional Fields\n";
+        if (item.location.has_value())
+        {
+            os << std::format(outFmtStr, "Location", item.location.value());
+        }
+        if (item.taskID.has_value())
+        {
+            os << std::format(outFmtStr, "Task ID", item.taskID.value());
+        }
+
+        return os;
+    };
+
+private:
+    bool modified;
+    std::size_t scheduleItemID;
+    std::size_t userID;
+    ScheduleTime startTime;
+    ScheduleTime endTime;
+    ScheduleItemType itemType;
+    std::string title;
+    std::optional<std::string> location;
+    std::optional<std::size_t> taskID;
+};
+
+using ScheduleItemModel_shp = std::shared_ptr<ScheduleItemModel>;
+using ScheduleItemList = std::vector<ScheduleItemModel>;
+
+#endif // SCHEDULEITEMMODEL_H_
@@ -0,0 +1,149 @@
+#include <chrono>
+#include "ScheduleDbInterface.h"
+#include "ScheduleItemModel.h"
+#include "SchedulePlanner.h"
+#include <string>
+#include "TaskDbInterface.h"
+#include "TaskModel.h"
+#include "TaskScheduler.h"
+#include "UserModel.h"
+#include <vector>
+
+bool SchedulePlanner::planUser(UserModel& user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay)
+{
+    errorMessages.clear();
+    lastResult = TaskScheduler::ScheduleResult();
+    lastChanges = ScheduleChanges();
+    userSchedules.erase(user.getUserID());
+
+    TaskList openTasks;
+    ScheduleItemList fixedItems;
+    if (!loadPlanningData(user, firstDay, lastDay, openTasks, fixedItems))
+    {
+        return false;
+    }
+
+    UserSchedule& userSchedule = userSchedules.try_emplace(user.getUserID(), user).first->second;
+    TaskScheduler& scheduler = userSchedule.scheduler;
+    lastResult = scheduler.schedule(openTasks, fixedItems, firstDay, lastDay);
+
+    TaskScheduler::WorkingHours workingHours = scheduler.getWorkingHours();
+    std::vector<ScheduleDbInterface::DayScheduleRow> days;
+    for (auto workingDay: scheduler.getWorkingDays(firstDay, lastDay))
+    {
+        days.push_back({user.getUserID(), workingDay, workingHours.dayStart, workingHours.dayEnd});
+    }
+
+    if (!scheduleDbInterface.replaceTaskExecutionItems(user, firstDay, lastDay, lastResult.taskExecutionItems, days))
+    {
+        errorMessages = scheduleDbInterface.getAllErrorMessages();
+        userSchedules.erase(user.getUserID());
+        return false;
+    }
+
+    userSchedule.firstDay = firstDay;
+    userSchedule.lastDay = lastDay;
+    userSchedule.storedItems = lastResult.taskExecutionItems;
+
+    return true;
+}
+
+bool SchedulePlanner::replanUser(UserModel& user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay)
+{
+    auto previous = userSchedules.find(user.getUserID());
+    if (previous == userSchedules.end() || previous->second.firstDay != firstDay || previous->second.lastDay != lastDay)
+    {
+        return planUser(user, firstDay, lastDay);
+    }
+
+    errorMessages.clear();
+    lastResult = TaskScheduler::ScheduleResult();
+    lastChanges = ScheduleChanges();
+
+    TaskList openTasks;
+    ScheduleItemList fixedItems;
+    if (!loadPlanningData(user, firstDay, lastDay, openTasks, fixedItems))
+    {
+        return false;
+    }
+
+    UserSchedule& userSchedule = previous->second;
+    lastResult = userSchedule.scheduler.reschedule(openTasks, fixedItems, firstDay, lastDay);
+    lastChanges = diffScheduleItems(userSchedule.storedItems, lastResult.taskExecutionItems);
+
+    if (!lastChanges.removedItems.empty() || !lastChanges.addedItems.empty())
+    {
+        if (!scheduleDbInterface.updateTaskExecutionItems(user, lastChanges.removedItems, lastChanges.addedItems))
+        {
+            // The stored schedule is unknown now, the next call will replace it.
+            errorMessages = scheduleDbInterface.getAllErrorMessages();
+            userSchedules.erase(previous);
+            return false;
+        }
+    }
+
+    userSchedule.storedItems = lastResult.taskExecutionItems;
+
+    return true;
+}
+
+bool SchedulePlanner::loadPlanningData(UserModel& user, std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay, TaskList& openTasks, ScheduleItemList& fixedItems)
+{
+    // A user without open tasks still gets an empty schedule, that is not an error.
+    openTasks = taskDbInterface.getOpenTasksForAssignedUser(user);
+    if (openTasks.empty() && !taskDbInterface.hasEmptyResult())
+    {
+        errorMessages = taskDbInterface.getAllErrorMessages();
+        return false;
+    }
+
+    fixedItems = scheduleDbInterface.getScheduleItemsForUser(user, firstDay, lastDay);
+    if (!scheduleDbInterface.getAllErrorMessages().empty())
+    {
+        errorMessages = scheduleDbInterface.getAllErrorMessages();
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Private methods.
+ */
+/*
+ * Generated items never overlap so both lists are ordered by start time, an item that is in
+ * both lists unchanged is not rewritten.
+ */
+SchedulePlanner::ScheduleChanges SchedulePlanner::diffScheduleItems(const ScheduleItemList& previousItems,
+    const ScheduleItemList& currentItems)
+{
+    ScheduleChanges changes;
+
+    auto previousItem = previousItems.begin();
+    auto currentItem = currentItems.begin();
+    while (previousItem != previousItems.end() || currentItem != currentItems.end())
+    {
+        if (currentItem == currentItems.end() ||
+            (previousItem != previousItems.end() && previousItem->getStartTime() < currentItem->getStartTime()))
+        {
+            changes.removedItems.push_back(*previousItem++);
+        }
+        else if (previousItem == previousItems.end() || currentItem->getStartTime() < previousItem->getStartTime())
+        {
+            changes.addedItems.push_back(*currentItem++);
+        }
+        else
+        {
+            if (*previousItem != *currentItem)
+            {
+                changes.removedItems.push_back(*previousItem);
+                changes.addedItems.push_back(*currentItem);
+            }
+            ++previousItem;
+            ++currentItem;
+        }
+    }
+
+    return changes;
+}
@@ -0,0 +1,71 @@
+#ifndef SCHEDULEPLANNER_H_
+#define SCHEDULEPLANNER_H_
+
+#include <chrono>
+#include "ScheduleDbInterface.h"
+#include "ScheduleItemModel.h"
+#include <string>
+#include "TaskDbInterface.h"
+#include "TaskModel.h"
+#include "TaskScheduler.h"
+#include <unordered_map>
+#include "UserModel.h"
+
+/*
+ * Loads a user's open tasks and fixed schedule items, generates the task execution schedule
+ * and writes it back to the database.
+ */
+class SchedulePlanner
+{
+public:
+    struct ScheduleChanges
+    {
+        ScheduleItemList removedItems;
+        ScheduleItemList addedItems;
+    };
+
+    SchedulePlanner() = default;
+    ~SchedulePlanner() = default;
+    bool planUser(UserModel& user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay);
+    bool planUser(UserModel_shp user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay)
+        { return planUser(*user, firstDay, lastDay); };
+/*
+ * Uses the schedule from the previous call for the same user and window, only the part of the
+ * schedule that the edits can affect is recomputed and only the items that changed are written.
+ * Without a previous schedule this is the same as planUser().
+ */
+    bool replanUser(UserModel& user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay);
+    bool replanUser(UserModel_shp user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay)
+        { return replanUser(*user, firstDay, lastDay); };
+    const TaskScheduler::ScheduleResult& getLastResult() const { return lastResult; };
+    const ScheduleChanges& getLastChanges() const { return lastChanges; };
+    std::string getAllErrorMessages() const { return errorMessages; };
+/*
+ * Loads the open tasks and the schedule items of the window, used by the batch replanner
+ * which schedules and writes on its own.
+ */
+    bool loadPlanningData(UserModel& user, std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay,
+        TaskList& openTasks, ScheduleItemList& fixedItems);
+
+private:
+    struct UserSchedule
+    {
+        UserSchedule(UserModel& user) : scheduler{user} {};
+
+        TaskScheduler scheduler;
+        std::chrono::year_month_day firstDay;
+        std::chrono::year_month_day lastDay;
+        ScheduleItemList storedItems;
+    };
+
+    static ScheduleChanges diffScheduleItems(const ScheduleItemList& previousItems, const ScheduleItemList& currentItems);
+
+    TaskDbInterface taskDbInterface;
+    ScheduleDbInterface scheduleDbInterface;
+    TaskScheduler::ScheduleResult lastResult;
+    ScheduleChanges lastChanges;
+    std::unordered_map<std::size_t, UserSchedule> userSchedules;
+    std::string errorMessages;
+};
+
+#endif // SCHEDULEPLANNER_H_
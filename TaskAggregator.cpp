@@ -0,0 +1,417 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <span>
+#include "TaskAggregator.h"
+#include "TaskModel.h"
+#include "TaskStore.h"
+#include <vector>
+
+static constexpr std::uint8_t CompleteStatus = static_cast<std::uint8_t>(TaskModel::TaskStatus::Complete);
+
+TaskAggregator::TaskAggregator(const TaskStore& store)
+: taskStore{store}
+{
+}
+
+TaskAggregator::EffortTotalsList TaskAggregator::effortByPriorityGroup() const
+{
+    return groupEffort(NoFilter);
+}
+
+TaskAggregator::EffortTotalsList TaskAggregator::effortByPriorityGroup(TaskModel::TaskStatus status) const
+{
+    return groupEffort(static_cast<std::uint8_t>(status));
+}
+
+TaskAggregator::StatusCounts TaskAggregator::countByStatus() const
+{
+    StatusCounts statusCounts{};
+    std::span<const std::uint8_t> statuses = taskStore.getStatuses();
+
+    for (std::size_t status = 0; status + 1 < StatusSlots; ++status)
+    {
+        statusCounts[status] = countEqual(statuses, static_cast<std::uint8_t>(status));
+    }
+    statusCounts[StatusSlots - 1] = countEqual(statuses, TaskStore::NoStatus);
+
+    return statusCounts;
+}
+
+std::size_t TaskAggregator::countOverdue(std::chrono::year_month_day today) const
+{
+    return countBeforeWhereNotEqual(taskStore.getDueDays(), TaskStore::toDayNumber(today), taskStore.getStatuses(),
+        CompleteStatus);
+}
+
+std::size_t TaskAggregator::countDueBetween(std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay) const
+{
+    return countBetween(taskStore.getDueDays(), TaskStore::toDayNumber(firstDay), TaskStore::toDayNumber(lastDay));
+}
+
+std::size_t TaskAggregator::countCompletedBetween(std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay) const
+{
+    return countBetween(taskStore.getCompletionDays(), TaskStore::toDayNumber(firstDay), TaskStore::toDayNumber(lastDay));
+}
+
+double TaskAggregator::sum(std::span<const float> values)
+{
+    std::array<double, Lanes> partialSums{};
+    std::size_t row = 0;
+
+    for ( ; row + Lanes <= values.size(); row += Lanes)
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            partialSums[lane] += values[row + lane];
+        }
+    }
+
+    double total = std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+    for ( ; row < values.size(); ++row)
+    {
+        total += values[row];
+    }
+
+    return total;
+}
+
+template <typename Key>
+double TaskAggregator::sumWhereEqualKernel(std::span<const float> values, std::span<const Key> keys, Key key)
+{
+    std::array<double, Lanes> partialSums{};
+    std::size_t row = 0;
+
+    for ( ; row + Lanes <= values.size(); row += Lanes)
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            float selected = static_cast<float>(keys[row + lane] == key);
+            partialSums[lane] += values[row + lane] * selected;
+        }
+    }
+
+    double total = std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+    for ( ; row < values.size(); ++row)
+    {
+        total += values[row] * static_cast<float>(keys[row] == key);
+    }
+
+    return total;
+}
+
+template <typename Key, typename SecondKey>
+double TaskAggregator::sumWhereBothEqualKernel(std::span<const float> values, std::span<const Key> keys, Key key,
+    std::span<const SecondKey> secondKeys, SecondKey secondKey)
+{
+    std::array<double, Lanes> partialSums{};
+    std::size_t row = 0;
+
+    for ( ; row + Lanes <= values.size(); row += Lanes)
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            float selected = static_cast<float>((keys[row + lane] == key) & (secondKeys[row + lane] == secondKey));
+            partialSums[lane] += values[row + lane] * selected;
+        }
+    }
+
+    double total = std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+    for ( ; row < values.size(); ++row)
+    {
+        total += values[row] * static_cast<float>((keys[row] == key) & (secondKeys[row] == secondKey));
+    }
+
+    return total;
+}
+
+/*
+ * The lane counters are 32 bits wide so that they vectorize with the day columns, they are
+ * flushed to the total before they can overflow.
+ */
+template <typename Key>
+std::size_t TaskAggregator::countEqualKernel(std::span<const Key> keys, Key key)
+{
+    constexpr std::size_t flushInterval = Lanes * 0x10000;
+    std::size_t total = 0;
+    std::size_t row = 0;
+
+    while (row + Lanes <= keys.size())
+    {
+        std::array<std::uint32_t, Lanes> partialCounts{};
+        std::size_t blockEnd = std::min(keys.size() - keys.size() % Lanes, row + flushInterval);
+        for ( ; row < blockEnd; row += Lanes)
+        {
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                partialCounts[lane] += keys[row + lane] == key;
+            }
+        }
+        total += std::accumulate(partialCounts.begin(), partialCounts.end(), std::size_t{0});
+    }
+
+    for ( ; row < keys.size(); ++row)
+    {
+        total += keys[row] == key;
+    }
+
+    return total;
+}
+
+template <typename Key, typename SecondKey>
+std::size_t TaskAggregator::countWhereBothEqualKernel(std::span<const Key> keys, Key key,
+    std::span<const SecondKey> secondKeys, SecondKey secondKey)
+{
+    constexpr std::size_t flushInterval = Lanes * 0x10000;
+    std::size_t total = 0;
+    std::size_t row = 0;
+
+    while (row + Lanes <= keys.size())
+    {
+        std::array<std::uint32_t, Lanes> partialCounts{};
+        std::size_t blockEnd = std::min(keys.size() - keys.size() % Lanes, row + flushInterval);
+        for ( ; row < blockEnd; row += Lanes)
+        {
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                partialCounts[lane] += (keys[row + lane] == key) & (secondKeys[row + lane] == secondKey);
+            }
+        }
+        total += std::accumulate(partialCounts.begin(), partialCounts.end(), std::size_t{0});
+    }
+
+    for ( ; row < keys.size(); ++row)
+    {
+        total += (keys[row] == key) & (secondKeys[row] == secondKey);
+    }
+
+    return total;
+}
+
+std::size_t TaskAggregator::countBetween(std::span<const DayNumber> days, DayNumber firstDay, DayNumber lastDay)
+{
+    constexpr std::size_t flushInterval = Lanes * 0x10000;
+    std::size_t total = 0;
+    std::size_t row = 0;
+
+    while (row + Lanes <= days.size())
+    {
+        std::array<std::uint32_t, Lanes> partialCounts{};
+        std::size_t blockEnd = std::min(days.size() - days.size() % Lanes, row + flushInterval);
+        for ( ; row < blockEnd; row += Lanes)
+        {
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                DayNumber day = days[row + lane];
+                partialCounts[lane] += (day >= firstDay) & (day <= lastDay);
+            }
+        }
+        total += std::accumulate(partialCounts.begin(), partialCounts.end(), std::size_t{0});
+    }
+
+    for ( ; row < days.size(); ++row)
+    {
+        total += (days[row] >= firstDay) & (days[row] <= lastDay);
+    }
+
+    return total;
+}
+
+std::size_t TaskAggregator::countBeforeWhereNotEqual(std::span<const DayNumber> days, DayNumber day,
+    std::span<const std::uint8_t> keys, std::uint8_t key)
+{
+    constexpr std::size_t flushInterval = Lanes * 0x10000;
+    std::size_t total = 0;
+    std::size_t row = 0;
+
+    while (row + Lanes <= days.size())
+    {
+        std::array<std::uint32_t, Lanes> partialCounts{};
+        std::size_t blockEnd = std::min(days.size() - days.size() % Lanes, row + flushInterval);
+        for ( ; row < blockEnd; row += Lanes)
+        {
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+            {
+                partialCounts[lane] += (days[row + lane] < day) & (keys[row + lane] != key);
+            }
+        }
+        total += std::accumulate(partialCounts.begin(), partialCounts.end(), std::size_t{0});
+    }
+
+    for ( ; row < days.size(); ++row)
+    {
+        total += (days[row] < day) & (keys[row] != key);
+    }
+
+    return total;
+}
+
+template <typename Key>
+std::array<Key, 2> TaskAggregator::minMaxKernel(std::span<const Key> keys)
+{
+    std::array<Key, Lanes> minimums;
+    std::array<Key, Lanes> maximums{};
+    minimums.fill(std::numeric_limits<Key>::max());
+    std::size_t row = 0;
+
+    for ( ; row + Lanes <= keys.size(); row += Lanes)
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            Key key = keys[row + lane];
+            minimums[lane] = key < minimums[lane]? key : minimums[lane];
+            maximums[lane] = key > maximums[lane]? key : maximums[lane];
+        }
+    }
+
+    Key minimum = *std::ranges::min_element(minimums);
+    Key maximum = *std::ranges::max_element(maximums);
+    for ( ; row < keys.size(); ++row)
+    {
+        minimum = std::min(minimum, keys[row]);
+        maximum = std::max(maximum, keys[row]);
+    }
+
+    return {minimum, maximum};
+}
+
+double TaskAggregator::sumWhereEqual(std::span<const float> values, std::span<const std::uint8_t> keys, std::uint8_t key)
+{
+    return sumWhereEqualKernel(values, keys, key);
+}
+
+double TaskAggregator::sumWhereEqual(std::span<const float> values, std::span<const std::uint32_t> keys, std::uint32_t key)
+{
+    return sumWhereEqualKernel(values, keys, key);
+}
+
+double TaskAggregator::sumWhereBothEqual(std::span<const float> values, std::span<const std::uint8_t> keys,
+    std::uint8_t key, std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey)
+{
+    return sumWhereBothEqualKernel(values, keys, key, secondKeys, secondKey);
+}
+
+double TaskAggregator::sumWhereBothEqual(std::span<const float> values, std::span<const std::uint32_t> keys,
+    std::uint32_t key, std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey)
+{
+    return sumWhereBothEqualKernel(values, keys, key, secondKeys, secondKey);
+}
+
+std::size_t TaskAggregator::countEqual(std::span<const std::uint8_t> keys, std::uint8_t key)
+{
+    return countEqualKernel(keys, key);
+}
+
+std::size_t TaskAggregator::countEqual(std::span<const std::uint32_t> keys, std::uint32_t key)
+{
+    return countEqualKernel(keys, key);
+}
+
+std::size_t TaskAggregator::countWhereBothEqual(std::span<const std::uint8_t> keys, std::uint8_t key,
+    std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey)
+{
+    return countWhereBothEqualKernel(keys, key, secondKeys, secondKey);
+}
+
+std::size_t TaskAggregator::countWhereBothEqual(std::span<const std::uint32_t> keys, std::uint32_t key,
+    std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey)
+{
+    return countWhereBothEqualKernel(keys, key, secondKeys, secondKey);
+}
+
+std::array<std::uint8_t, 2> TaskAggregator::minMax(std::span<const std::uint8_t> keys)
+{
+    return minMaxKernel(keys);
+}
+
+std::array<std::uint32_t, 2> TaskAggregator::minMax(std::span<const std::uint32_t> keys)
+{
+    return minMaxKernel(keys);
+}
+
+/*
+ * Reports use a handful of priority groups, for each possible group one masked pass over the
+ * group, status and effort columns is faster than scattering into a histogram because every
+ * pass vectorizes. A wide range of groups falls back to the histogram.
+ */
+TaskAggregator::EffortTotalsList TaskAggregator::groupEffort(std::uint8_t statusFilter) const
+{
+    EffortTotalsList effortTotals;
+    if (taskStore.empty())
+    {
+        return effortTotals;
+    }
+
+    std::span<const std::uint32_t> groups = taskStore.getPriorityGroups();
+    std::array<std::uint32_t, 2> groupRange = minMax(groups);
+    if (groupRange[1] - groupRange[0] >= MaxKeysForMaskedPasses)
+    {
+        return groupEffortByHistogram(statusFilter);
+    }
+
+    std::span<const std::uint8_t> statuses = taskStore.getStatuses();
+    std::span<const float> estimatedEfforts = taskStore.getEstimatedEfforts();
+    std::span<const float> actualEfforts = taskStore.getActualEfforts();
+
+    for (std::uint32_t offset = 0; offset <= groupRange[1] - groupRange[0]; ++offset)
+    {
+        std::uint32_t key = groupRange[0] + offset;
+        if (statusFilter == NoFilter)
+        {
+            std::size_t taskCount = countEqual(groups, key);
+            if (taskCount > 0)
+            {
+                effortTotals.push_back({key, taskCount, sumWhereEqual(estimatedEfforts, groups, key),
+                    sumWhereEqual(actualEfforts, groups, key)});
+            }
+        }
+        else
+        {
+            std::size_t taskCount = countWhereBothEqual(groups, key, statuses, statusFilter);
+            if (taskCount > 0)
+            {
+                effortTotals.push_back({key, taskCount,
+                    sumWhereBothEqual(estimatedEfforts, groups, key, statuses, statusFilter),
+                    sumWhereBothEqual(actualEfforts, groups, key, statuses, statusFilter)});
+            }
+        }
+    }
+
+    return effortTotals;
+}
+
+TaskAggregator::EffortTotalsList TaskAggregator::groupEffortByHistogram(std::uint8_t statusFilter) const
+{
+    std::map<std::uint32_t, EffortTotals> groupTotals;
+
+    std::span<const std::uint32_t> groups = taskStore.getPriorityGroups();
+    std::span<const std::uint8_t> statuses = taskStore.getStatuses();
+    std::span<const float> estimated = taskStore.getEstimatedEfforts();
+    std::span<const float> actual = taskStore.getActualEfforts();
+
+    for (std::size_t row = 0; row < groups.size(); ++row)
+    {
+        if (statusFilter != NoFilter && statuses[row] != statusFilter)
+        {
+            continue;
+        }
+        EffortTotals& totals = groupTotals.try_emplace(groups[row], EffortTotals{groups[row], 0, 0.0, 0.0}).first->second;
+        ++totals.taskCount;
+        totals.estimatedEffort += estimated[row];
+        totals.actualEffort += actual[row];
+    }
+
+    EffortTotalsList effortTotals;
+    effortTotals.reserve(groupTotals.size());
+    for (const auto& [group, totals] : groupTotals)
+    {
+        effortTotals.push_back(totals);
+    }
+
+    return effortTotals;
+}
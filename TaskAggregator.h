@@ -0,0 +1,110 @@
+#ifndef TASKAGGREGATOR_H_
+#define TASKAGGREGATOR_H_
+
+#include <array>
+#include <chrono>
+#include "commonUtilities.h"
+#include <cstdint>
+#include <span>
+#include "TaskModel.h"
+#include "TaskStore.h"
+#include <vector>
+
+/*
+ * Aggregation kernels for reports over the columns of a TaskStore. The kernels are plain loops
+ * over spans that keep a fixed number of independent partial results so that the compiler can
+ * vectorize them, there are no data dependent branches inside the loops. The row count that
+ * doesn't fill a full set of lanes is handled by a scalar loop. Filtered sums multiply each
+ * value by the 0 or 1 result of the filter, so the values must be finite.
+ */
+class TaskAggregator
+{
+public:
+    using DayNumber = TaskStore::DayNumber;
+
+/*
+ * One slot for each TaskModel::TaskStatus and a last slot for tasks without a status.
+ */
+    static constexpr std::size_t StatusSlots = static_cast<std::size_t>(TaskModel::TaskStatus::Complete) + 2;
+    using StatusCounts = std::array<std::size_t, StatusSlots>;
+
+    struct EffortTotals
+    {
+        std::uint32_t priorityGroup;
+        std::size_t taskCount;
+        double estimatedEffort;
+        double actualEffort;
+    };
+    using EffortTotalsList = std::vector<EffortTotals>;
+
+    explicit TaskAggregator(const TaskStore& taskStore);
+    ~TaskAggregator() = default;
+
+/*
+ * Estimated and actual effort for each SchedulePriorityGroup that has tasks, in group order.
+ */
+    EffortTotalsList effortByPriorityGroup() const;
+    EffortTotalsList effortByPriorityGroup(TaskModel::TaskStatus status) const;
+    StatusCounts countByStatus() const;
+/*
+ * Tasks that are not complete and were due before today.
+ */
+    std::size_t countOverdue(std::chrono::year_month_day today) const;
+    std::size_t countOverdue() const { return countOverdue(getTodaysDate()); };
+    std::size_t countDueBetween(std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay) const;
+    std::size_t countCompletedBetween(std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay) const;
+
+/*
+ * The kernels, usable on any column of the same type. The 8 bit keys are statuses and flags,
+ * the 32 bit keys are priority groups and IDs.
+ */
+    static double sum(std::span<const float> values);
+    static double sumWhereEqual(std::span<const float> values, std::span<const std::uint8_t> keys, std::uint8_t key);
+    static double sumWhereEqual(std::span<const float> values, std::span<const std::uint32_t> keys, std::uint32_t key);
+    static double sumWhereBothEqual(std::span<const float> values, std::span<const std::uint8_t> keys, std::uint8_t key,
+        std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey);
+    static double sumWhereBothEqual(std::span<const float> values, std::span<const std::uint32_t> keys, std::uint32_t key,
+        std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey);
+    static std::size_t countEqual(std::span<const std::uint8_t> keys, std::uint8_t key);
+    static std::size_t countEqual(std::span<const std::uint32_t> keys, std::uint32_t key);
+    static std::size_t countWhereBothEqual(std::span<const std::uint8_t> keys, std::uint8_t key,
+        std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey);
+    static std::size_t countWhereBothEqual(std::span<const std::uint32_t> keys, std::uint32_t key,
+        std::span<const std::uint8_t> secondKeys, std::uint8_t secondKey);
+    static std::size_t countBetween(std::span<const DayNumber> days, DayNumber firstDay, DayNumber lastDay);
+    static std::size_t countBeforeWhereNotEqual(std::span<const DayNumber> days, DayNumber day,
+        std::span<const std::uint8_t> keys, std::uint8_t key);
+    static std::array<std::uint8_t, 2> minMax(std::span<const std::uint8_t> keys);
+    static std::array<std::uint32_t, 2> minMax(std::span<const std::uint32_t> keys);
+
+private:
+    static constexpr std::size_t Lanes = 16;
+/*
+ * Above this many possible keys the group by uses a histogram instead of one pass per key.
+ */
+    static constexpr std::size_t MaxKeysForMaskedPasses = 16;
+    static constexpr std::uint8_t NoFilter = TaskStore::NoStatus;
+
+/*
+ * The kernels for each key width, only instantiated in TaskAggregator.cpp.
+ */
+    template <typename Key>
+    static double sumWhereEqualKernel(std::span<const float> values, std::span<const Key> keys, Key key);
+    template <typename Key, typename SecondKey>
+    static double sumWhereBothEqualKernel(std::span<const float> values, std::span<const Key> keys, Key key,
+        std::span<const SecondKey> secondKeys, SecondKey secondKey);
+    template <typename Key>
+    static std::size_t countEqualKernel(std::span<const Key> keys, Key key);
+    template <typename Key, typename SecondKey>
+    static std::size_t countWhereBothEqualKernel(std::span<const Key> keys, Key key,
+        std::span<const SecondKey> secondKeys, SecondKey secondKey);
+    template <typename Key>
+    static std::array<Key, 2> minMaxKernel(std::span<const Key> keys);
+
+    EffortTotalsList groupEffort(std::uint8_t statusFilter) const;
+    EffortTotalsList groupEffortByHistogram(std::uint8_t statusFilter) const;
+
+    const TaskStore& taskStore;
+};
+
+#endif // TASKAGGREGATOR_H_
@@ -1,21 +1,32 @@
+#include <algorithm>
 #include <boost/asio.hpp>
 #include <boost/mysql.hpp>
 #include <chrono>
 #include "CommandLineParser.h"
 #include "BoostDBInterfaceCore.h"
+#include "CompactDate.h"
+#include <cstdint>
 #include <exception>
 #include <format>
 #include <functional>
+#include "ImportHash.h"
 #include <iostream>
+#include <iterator>
+#include "Logger.h"
 #include <optional>
+#include "Profiler.h"
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include "TaskDbInterface.h"
 #include "TaskModel.h"
+#include "TaskStore.h"
 #include "UserDbInterface.h"
 #include "UserModel.h"
 #include <utility>
+#include <vector>
 
 TaskDbInterface::TaskDbInterface()
 : BoostDBInterfaceCore()
@@ -28,7 +39,7 @@ static constexpr unsigned int TwoWeeks = 14;
 std::size_t TaskDbInterface::insert(TaskModel &task)
 {
     std::size_t taskID = 0;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     if (!task.isModified())
     {
@@ -72,10 +83,139 @@ std::size_t TaskDbInterface::insert(TaskModel &task)
     return taskID;
 }
 
+bool TaskDbInterface::insertBatch(TaskList& tasks)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (tasks.empty())
+    {
+        return true;
+    }
+
+    for (const auto& task: tasks)
+    {
+        if (!task->hasRequiredValues())
+        {
+            appendErrorMessage(std::format("In TaskDbInterface::insertBatch : Task is missing required values! {}",
+                task->getDescription()));
+            return false;
+        }
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoInsertTasks(tasks),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+
+        return true;
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::insertBatch({} tasks) : {}", tasks.size(), e.what()));
+    }
+
+    return false;
+}
+
+bool TaskDbInterface::upsertBatch(TaskList& tasks, const std::vector<ImportHash>& importHashes)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (tasks.size() != importHashes.size())
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::upsertBatch : {} tasks but {} import hashes",
+            tasks.size(), importHashes.size()));
+        return false;
+    }
+
+    if (tasks.empty())
+    {
+        return true;
+    }
+
+    for (const auto& task: tasks)
+    {
+        if (!task->hasRequiredValues())
+        {
+            appendErrorMessage(std::format("In TaskDbInterface::upsertBatch : Task is missing required values! {}",
+                task->getDescription()));
+            return false;
+        }
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoUpsertTasks(tasks, importHashes),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+
+        return true;
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::upsertBatch({} tasks) : {}", tasks.size(), e.what()));
+    }
+
+    return false;
+}
+
+std::vector<ImportedRow> TaskDbInterface::getImportedRows(UserModel& creator)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    std::vector<ImportedRow> importedRows;
+
+    try
+    {
+        selectStatementWhatArgs.push_back(std::any(creator.getUserID()));
+
+        NSBM::results localResult = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectImportedRows, this));
+
+        importedRows.reserve(localResult.rows().size());
+        for (auto row: localResult.rows())
+        {
+            importedRows.push_back({static_cast<std::size_t>(row.at(0).as_uint64()),
+                {row.at(1).as_uint64(), row.at(2).is_null()? 0 : row.at(2).as_uint64()}});
+        }
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::getImportedRows({}) : {}", creator.getUserID(), e.what()));
+    }
+
+    return importedRows;
+}
+
 TaskModel_shp TaskDbInterface::getTaskByTaskID(std::size_t taskId)
 {
     TaskModel_shp newTask = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -97,7 +237,7 @@ TaskModel_shp TaskDbInterface::getTaskByTaskID(std::size_t taskId)
 TaskModel_shp TaskDbInterface::getTaskByDescriptionAndAssignedUser(std::string_view description, UserModel& assignedUser)
 {
     TaskModel_shp newTask = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -129,9 +269,9 @@ TaskModel_shp TaskDbInterface::getParentTask(TaskModel& task)
 
 TaskList TaskDbInterface::getActiveTasksForAssignedUser(UserModel &assignedUser)
 {
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
-    std::cerr << std::format("getAllCurrentActiveTasksForAssignedUser({}) NOT Implemented", assignedUser.getUserID()) << "\n";
+    Logger::warning("getAllCurrentActiveTasksForAssignedUser({}) NOT Implemented\n", assignedUser.getUserID());
 
     selectStatementWhatArgs.clear();
 
@@ -140,7 +280,7 @@ TaskList TaskDbInterface::getActiveTasksForAssignedUser(UserModel &assignedUser)
 
 TaskList TaskDbInterface::getUnstartedDueForStartForAssignedUser(UserModel &assignedUser)
 {
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     TaskList unstartedTasks;
 
@@ -163,7 +303,7 @@ TaskList TaskDbInterface::getUnstartedDueForStartForAssignedUser(UserModel &assi
 
 TaskList TaskDbInterface::getTasksCompletedByAssignedAfterDate(UserModel &assignedUser, std::chrono::year_month_day searchStartDate)
 {
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
     std::size_t userId = assignedUser.getUserID();
     TaskList completedTasks;
 
@@ -171,10 +311,8 @@ TaskList TaskDbInterface::getTasksCompletedByAssignedAfterDate(UserModel &assign
 
     try {
         selectStatementWhatArgs.push_back(std::any(userId));
-        std::cerr << 
-            std::format("getTasksCompletedByAssignedAfterDate({} on or after {}) NOT Implemented",
-                userId, searchStartDate) <<
-            "\n";
+        Logger::warning("getTasksCompletedByAssignedAfterDate({} on or after {}) NOT Implemented\n",
+            userId, searchStartDate);
 
     }
 
@@ -186,223 +324,1129 @@ TaskList TaskDbInterface::getTasksCompletedByAssignedAfterDate(UserModel &assign
     return completedTasks;
 }
 
-/*
- * Private methods.
- */
-TaskModel_shp TaskDbInterface::processResult(NSBM::results& results)
+TaskList TaskDbInterface::getOpenTasksForAssignedUser(UserModel& assignedUser)
 {
-    if (results.rows().empty())
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    TaskList openTasks;
+
+    try
     {
-        appendErrorMessage("Task not found!");
-        return nullptr;
+        selectStatementWhatArgs.push_back(std::any(assignedUser.getUserID()));
+
+        NSBM::results localResults = runQueryAsync(
+            std::bind(&TaskDbInterface::coRoSelectOpenTasksForAssignedUser, this));
+        openTasks = processResults(localResults);
     }
 
-    if (results.rows().size() > 1)
+    catch(const std::exception& e)
     {
-        appendErrorMessage("Too many tasks found to process!");
-        return nullptr;
+        appendErrorMessage(std::format("In TaskDbInterface::getOpenTasksForAssignedUser({}) : {}", assignedUser.getUserID(), e.what()));
     }
 
-    TaskModel_shp newTask = std::make_shared<TaskModel>(TaskModel());
-    NSBM::row_view rv = results.rows().at(0);
-
-    processResultRow(rv, newTask);
-
-    return newTask;
+    return openTasks;
 }
 
-TaskList TaskDbInterface::processResults(NSBM::results& results)
+bool TaskDbInterface::setDependencies(TaskModel& task)
 {
-    TaskList taskList;
+    ProfileZone callZone = prepareForRunQueryAsync();
 
-    if (results.rows().empty())
+    if (!task.isInDatabase())
     {
-        appendErrorMessage("No Tasks found!");
-        return taskList;
+        appendErrorMessage("Task must be in the database before its dependencies can be set!");
+        return false;
     }
 
-    for (auto row: results.rows())
+    try
     {
-        TaskModel_shp newTask = std::make_shared<TaskModel>(TaskModel());
-        processResultRow(row, newTask);
-        taskList.push_back(newTask);
-    }
-    return taskList;
-}
+        NSBA::io_context ctx;
 
-void TaskDbInterface::processResultRow(NSBM::row_view rv, TaskModel_shp newTask)
-{
-    // Required fields.
-    newTask->setTaskID(rv.at(taskIdIdx).as_uint64());
-    newTask->setCreatorID(rv.at(createdByIdx).as_uint64());
-    newTask->setAssignToID(rv.at(assignedToIdx).as_uint64());
-    newTask->setDescription(rv.at(descriptionIdx).as_string());
-    newTask->setPercentageComplete(rv.at(percentageCompleteIdx).as_double());
-    newTask->setCreationDate(convertBoostMySQLDateToChornoDate(rv.at(createdOnIdx).as_date()));
-    newTask->setDueDate(convertBoostMySQLDateToChornoDate(rv.at(requiredDeliveryIdx).as_date()));
-    newTask->setScheduledStart(convertBoostMySQLDateToChornoDate(rv.at(scheduledStartIdx).as_date()));
-    newTask->setEstimatedEffort(rv.at(estimatedEffortHoursIdx).as_uint64());
-    newTask->setActualEffortToDate(rv.at(actualEffortHoursIdx).as_double());
-    newTask->setPriorityGroup(rv.at(schedulePriorityGroupIdx).as_uint64());
-    newTask->setPriority(rv.at(priorityInGroupIdx).as_uint64());
-    newTask->setPersonal(rv.at(personalIdx).as_int64());
+        NSBA::co_spawn(
+            ctx, coRoSetDependencies(task),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
 
-    // Optional fields.
-    if (!rv.at(parentTaskIdx).is_null())
-    {
-        newTask->setParentTaskID(rv.at(parentTaskIdx).as_uint64());
-    }
+        ctx.run();
 
-    if (!rv.at(statusIdx).is_null())
-    {
-        newTask->setStatus(static_cast<TaskModel::TaskStatus>(rv.at(statusIdx).as_uint64()));
+        return true;
     }
 
-    if (!rv.at(actualStartIdx).is_null())
+    catch(const std::exception& e)
     {
-        newTask->setactualStartDate(convertBoostMySQLDateToChornoDate(rv.at(actualStartIdx).as_date()));
+        appendErrorMessage(std::format("In TaskDbInterface::setDependencies({}) : {}", task.getTaskID(), e.what()));
     }
 
-    if (!rv.at(estimatedCompletionIdx).is_null())
-    {
-        newTask->setEstimatedCompletion(convertBoostMySQLDateToChornoDate(rv.at(estimatedCompletionIdx).as_date()));
-    }
-    if (!rv.at(completedIdx).is_null())
-    {
-        newTask->setCompletionDate(convertBoostMySQLDateToChornoDate(rv.at(completedIdx).as_date()));
-    }
+    return false;
+}
 
-    std::size_t dependencyCount = rv.at(dependencyCountIdx).as_uint64();
-    if (dependencyCount > 0)
+bool TaskDbInterface::setParentTasks(const std::vector<ParentAssignment>& parentAssignments)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (parentAssignments.empty())
     {
-        addDependencies(newTask);
+        return true;
     }
 
-    // All the set functions set modified, since this user is new in memory it is not modified.
-    newTask->clearModified();
-}
-
-NSBA::awaitable<NSBM::results> TaskDbInterface::coRoInsertTask(TaskModel &task)
-{
-    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+    try
+    {
+        NSBA::io_context ctx;
 
-    co_await conn.async_connect(dbConnectionParameters);
+        NSBA::co_spawn(
+            ctx, coRoSetParentTasks(parentAssignments),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
 
-    NSBM::results insertResult;
-    std::size_t dependencyCount = task.getDependencies().size();
+        ctx.run();
 
-    co_await conn.async_execute(
-        NSBM::with_params("INSERT INTO Tasks (CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
-            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
-            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount)"
-            " VALUES ({0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}, {11}, {12}, {13}, {14}, {15}, {16}, {17})",
-            task.getCreatorID(),
-            task.getAssignToID(),
-            task.getDescription(),
-            task.rawParentTaskID(),
-            task.getStatusIntVal(),
-            task.getPercentageComplete(),
-            convertChronoDateToBoostMySQLDate(task.getCreationDate()),
-            convertChronoDateToBoostMySQLDate(task.getDueDate()),
-            convertChronoDateToBoostMySQLDate(task.getScheduledStart()),
-            optionalDateConversion(task.rawActualStartDate()),
-            optionalDateConversion(task.rawEstimatedCompletion()),
-            optionalDateConversion(task.rawCompletionDate()),
-            task.getEstimatedEffort(),
-            task.getactualEffortToDate(),
-            task.getPriorityGroup(),
-            task.getPriority(),
-            task.isPersonal(),
-            dependencyCount),
-        insertResult
-    );
+        return true;
+    }
 
-    std::size_t taskID = insertResult.last_insert_id();
-    std::vector<std::size_t> dependencies = task.getDependencies();
-    if (taskID > 0 &&  dependencies.size() > 0)
+    catch(const std::exception& e)
     {
-        NSBM::statement stmt = co_await conn.async_prepare_statement(
-            "INSERT INTO TaskDependencies (TaskID, Dependency) VALUES (?, ?)"
-        );
-        for (auto dependency: dependencies)
-        {
-            NSBM::results result;
-            co_await conn.async_execute(stmt.bind(taskID, dependency), result);
-        }
-        co_await conn.async_close_statement(stmt);
+        appendErrorMessage(std::format("In TaskDbInterface::setParentTasks({} tasks) : {}", parentAssignments.size(),
+            e.what()));
     }
-    co_await conn.async_close();
 
-    co_return insertResult;
+    return false;
 }
 
-std::optional<NSBM::date> TaskDbInterface::optionalDateConversion(std::optional<std::chrono::year_month_day> optDate)
+bool TaskDbInterface::addDependencies(const std::vector<DependencyAssignment>& dependencyAssignments)
 {
-    std::optional<NSBM::date> mySqlDate;
+    ProfileZone callZone = prepareForRunQueryAsync();
 
-    if (optDate.has_value())
+    if (dependencyAssignments.empty())
     {
-        mySqlDate = convertChronoDateToBoostMySQLDate(optDate.value());
+        return true;
     }
-    return mySqlDate;
-}
 
-NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskById()
-{
-    std::size_t taskId = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
-    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+    try
+    {
+        NSBA::io_context ctx;
 
-    co_await conn.async_connect(dbConnectionParameters);
+        NSBA::co_spawn(
+            ctx, coRoAddDependencies(dependencyAssignments),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
 
-    NSBM::results selectResult;
+        ctx.run();
 
-    co_await conn.async_execute(
-        NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
-            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
-            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE TaskID = {0}",
-            taskId),
-        selectResult
-    );
+        return true;
+    }
 
-    co_await conn.async_close();
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::addDependencies({} dependencies) : {}",
+            dependencyAssignments.size(), e.what()));
+    }
 
-    co_return selectResult;
+    return false;
 }
 
-NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskDependencies(const std::size_t taskId)
+TaskList TaskDbInterface::getDependentTasks(std::size_t taskId)
 {
-    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+    ProfileZone callZone = prepareForRunQueryAsync();
 
-    co_await conn.async_connect(dbConnectionParameters);
+    TaskList dependentTasks;
 
-    NSBM::results selectResult;
+    try
+    {
+        selectStatementWhatArgs.push_back(std::any(taskId));
 
-    co_await conn.async_execute(
-        NSBM::with_params("SELECT Dependency FROM TaskDependencies WHERE TaskID = {0} ORDER BY Dependency ASC", taskId), selectResult);
+        NSBM::results localResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectDependentTasks, this));
+        dependentTasks = processResults(localResults);
+    }
 
-    co_await conn.async_close();
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::getDependentTasks({}) : {}", taskId, e.what()));
+    }
 
-    co_return selectResult;
+    return dependentTasks;
 }
 
-void TaskDbInterface::addDependencies(TaskModel_shp newTask)
+std::vector<std::size_t> TaskDbInterface::completeTasksAndReleaseDependents(const std::vector<std::size_t>& completedTaskIDs)
 {
-    std::size_t taskId = newTask->getTaskID();
+    std::vector<std::size_t> releasedTaskIDs;
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (completedTaskIDs.empty())
+    {
+        return releasedTaskIDs;
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+        NSBM::results localResult;
+
+        NSBA::co_spawn(
+            ctx, coRoCompleteTasksAndReleaseDependents(completedTaskIDs),
+            [&localResult](std::exception_ptr ptr, NSBM::results result)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+                localResult = std::move(result);
+            }
+        );
+
+        ctx.run();
+
+        releasedTaskIDs.reserve(localResult.rows().size());
+        for (auto row: localResult.rows())
+        {
+            releasedTaskIDs.push_back(row.at(0).as_uint64());
+        }
+        // A task waiting on several of the completed tasks is selected once per completed task.
+        auto [duplicatesStart, duplicatesEnd] = std::ranges::unique(releasedTaskIDs);
+        releasedTaskIDs.erase(duplicatesStart, duplicatesEnd);
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::completeTasksAndReleaseDependents : {}", e.what()));
+    }
+
+    return releasedTaskIDs;
+}
+
+TaskGraph TaskDbInterface::getTaskGraphForAssignedUser(UserModel& assignedUser)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    TaskGraph taskGraph;
+
+    try
+    {
+        selectStatementWhatArgs.push_back(std::any(assignedUser.getUserID()));
+
+        NSBM::results nodeResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectGraphNodesForAssignedUser, this));
+        NSBM::results edgeResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectGraphEdgesForAssignedUser, this));
+        taskGraph = buildTaskGraph(nodeResults, edgeResults);
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::getTaskGraphForAssignedUser({}) : {}", assignedUser.getUserID(), e.what()));
+    }
+
+    return taskGraph;
+}
+
+TaskGraph TaskDbInterface::getTaskGraphForProject(std::size_t projectTaskID)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    TaskGraph taskGraph;
+
+    try
+    {
+        selectStatementWhatArgs.push_back(std::any(projectTaskID));
+
+        NSBM::results nodeResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectGraphNodesForProject, this));
+        NSBM::results edgeResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectGraphEdgesForProject, this));
+        taskGraph = buildTaskGraph(nodeResults, edgeResults);
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::getTaskGraphForProject({}) : {}", projectTaskID, e.what()));
+    }
+
+    return taskGraph;
+}
+
+TaskStore TaskDbInterface::getTaskStoreForAssignedUser(UserModel& assignedUser)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    TaskStore taskStore;
+
+    try
+    {
+        selectStatementWhatArgs.push_back(std::any(assignedUser.getUserID()));
+
+        NSBM::results taskResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectTasksForAssignedUser, this));
+        NSBM::results dependencyResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectGraphEdgesForAssignedUser, this));
+        taskStore = buildTaskStore(taskResults, dependencyResults);
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::getTaskStoreForAssignedUser({}) : {}", assignedUser.getUserID(), e.what()));
+    }
+
+    return taskStore;
+}
+
+TaskStore TaskDbInterface::getTaskStoreForAllTasks()
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    TaskStore taskStore;
+
+    try
+    {
+        NSBM::results taskResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectAllTasks, this));
+        NSBM::results dependencyResults = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectAllDependencies, this));
+        taskStore = buildTaskStore(taskResults, dependencyResults);
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In TaskDbInterface::getTaskStoreForAllTasks() : {}", e.what()));
+    }
+
+    return taskStore;
+}
+
+/*
+ * Private methods.
+ */
+TaskModel_shp TaskDbInterface::processResult(NSBM::results& results)
+{
+    ProfileZone zone("decode");
+
+    if (results.rows().empty())
+    {
+        appendErrorMessage("Task not found!");
+        return nullptr;
+    }
+
+    if (results.rows().size() > 1)
+    {
+        appendErrorMessage("Too many tasks found to process!");
+        return nullptr;
+    }
+
+    TaskModel_shp newTask = std::make_shared<TaskModel>(TaskModel());
+    NSBM::row_view rv = results.rows().at(0);
+
+    processResultRow(rv, newTask);
+
+    return newTask;
+}
+
+TaskList TaskDbInterface::processResults(NSBM::results& results)
+{
+    TaskList taskList;
+
+    if (results.rows().empty())
+    {
+        emptyResult = true;
+        appendErrorMessage("No Tasks found!");
+        return taskList;
+    }
+
+    TaskList tasksWithDependencies;
+    {
+        ProfileZone zone("decode");
+        for (auto row: results.rows())
+        {
+            TaskModel_shp newTask = std::make_shared<TaskModel>(TaskModel());
+            if (processResultRow(row, newTask, false) > 0)
+            {
+                tasksWithDependencies.push_back(newTask);
+            }
+            taskList.push_back(newTask);
+        }
+    }
+
+    if (!tasksWithDependencies.empty())
+    {
+        addDependenciesToTaskList(tasksWithDependencies);
+    }
+
+    return taskList;
+}
+
+/*
+ * Returns the DependencyCount of the task, when loadDependencies is false the caller is
+ * responsible for loading the dependencies.
+ */
+std::size_t TaskDbInterface::processResultRow(NSBM::row_view rv, TaskModel_shp newTask, bool loadDependencies)
+{
+    // Required fields.
+    newTask->setTaskID(rv.at(taskIdIdx).as_uint64());
+    newTask->setCreatorID(rv.at(createdByIdx).as_uint64());
+    newTask->setAssignToID(rv.at(assignedToIdx).as_uint64());
+    newTask->setDescription(rv.at(descriptionIdx).as_string());
+    newTask->setPercentageComplete(rv.at(percentageCompleteIdx).as_double());
+    newTask->setCreationDate(convertBoostMySQLDateToCompactDate(rv.at(createdOnIdx).as_date()));
+    newTask->setDueDate(convertBoostMySQLDateToCompactDate(rv.at(requiredDeliveryIdx).as_date()));
+    newTask->setScheduledStart(convertBoostMySQLDateToCompactDate(rv.at(scheduledStartIdx).as_date()));
+    newTask->setEstimatedEffort(rv.at(estimatedEffortHoursIdx).as_uint64());
+    newTask->setActualEffortToDate(rv.at(actualEffortHoursIdx).as_double());
+    newTask->setPriorityGroup(rv.at(schedulePriorityGroupIdx).as_uint64());
+    newTask->setPriority(rv.at(priorityInGroupIdx).as_uint64());
+    newTask->setPersonal(rv.at(personalIdx).as_int64());
+
+    // Optional fields.
+    if (!rv.at(parentTaskIdx).is_null())
+    {
+        newTask->setParentTaskID(rv.at(parentTaskIdx).as_uint64());
+    }
+
+    if (!rv.at(statusIdx).is_null())
+    {
+        newTask->setStatus(static_cast<TaskModel::TaskStatus>(rv.at(statusIdx).as_uint64()));
+    }
+
+    if (!rv.at(actualStartIdx).is_null())
+    {
+        newTask->setactualStartDate(convertBoostMySQLDateToCompactDate(rv.at(actualStartIdx).as_date()));
+    }
+
+    if (!rv.at(estimatedCompletionIdx).is_null())
+    {
+        newTask->setEstimatedCompletion(convertBoostMySQLDateToCompactDate(rv.at(estimatedCompletionIdx).as_date()));
+    }
+    if (!rv.at(completedIdx).is_null())
+    {
+        newTask->setCompletionDate(convertBoostMySQLDateToCompactDate(rv.at(completedIdx).as_date()));
+    }
+
+    std::size_t dependencyCount = rv.at(dependencyCountIdx).as_uint64();
+    if (dependencyCount > 0 && loadDependencies)
+    {
+        addDependencies(newTask);
+    }
+
+    // All the set functions set modified, since this user is new in memory it is not modified.
+    newTask->clearModified();
+
+    return dependencyCount;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoInsertTask(TaskModel &task)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results insertResult;
+    std::vector<std::size_t> dependencies = sortedUniqueDependencies(task);
+    std::size_t dependencyCount = dependencies.size();
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("INSERT INTO Tasks (CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount)"
+            " VALUES ({0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}, {11}, {12}, {13}, {14}, {15}, {16}, {17})",
+            task.getCreatorID(),
+            task.getAssignToID(),
+            task.getDescription(),
+            task.rawParentTaskID(),
+            task.getStatusIntVal(),
+            task.getPercentageComplete(),
+            convertCompactDateToBoostMySQLDate(task.getCompactCreationDate()),
+            convertCompactDateToBoostMySQLDate(task.getCompactDueDate()),
+            convertCompactDateToBoostMySQLDate(task.getCompactScheduledStart()),
+            optionalDateConversion(task.getCompactActualStartDate()),
+            optionalDateConversion(task.getCompactEstimatedCompletion()),
+            optionalDateConversion(task.getCompactCompletionDate()),
+            task.getEstimatedEffort(),
+            task.getactualEffortToDate(),
+            task.getPriorityGroup(),
+            task.getPriority(),
+            task.isPersonal(),
+            dependencyCount),
+        insertResult
+    );
+
+    std::size_t taskID = insertResult.last_insert_id();
+    if (taskID > 0 && dependencyCount > 0)
+    {
+        co_await coRoInsertDependencies(conn, taskID, dependencies);
+    }
+    co_await conn.async_close();
+
+    co_return insertResult;
+}
+
+/*
+ * Matches the TaskIDs read back after a multi-row INSERT to the rows of the batch by their import
+ * key. The rows read back must be in TaskID order, rows of one statement get increasing auto
+ * increment values so rows with the same key are matched in the order of the batch.
+ */
+template <typename RowKey>
+static std::vector<std::size_t> matchInsertedTaskIDs(const std::vector<std::uint64_t>& batchKeys,
+    const NSBM::results& insertedRows, RowKey rowKey)
+{
+    struct InsertedIDs
+    {
+        std::vector<std::size_t> taskIDs;
+        std::size_t matched = 0;
+    };
+
+    std::unordered_map<std::uint64_t, InsertedIDs> insertedByKey;
+    insertedByKey.reserve(batchKeys.size());
+    for (auto row: insertedRows.rows())
+    {
+        insertedByKey[rowKey(row)].taskIDs.push_back(row.at(0).as_uint64());
+    }
+
+    std::vector<std::size_t> taskIDs;
+    taskIDs.reserve(batchKeys.size());
+    for (std::uint64_t key: batchKeys)
+    {
+        auto inserted = insertedByKey.find(key);
+        if (inserted == insertedByKey.end() || inserted->second.matched == inserted->second.taskIDs.size())
+        {
+            std::runtime_error InsertedTaskNotFound(std::format("Inserted task with import key {} not found!", key));
+            throw InsertedTaskNotFound;
+        }
+        taskIDs.push_back(inserted->second.taskIDs[inserted->second.matched++]);
+    }
+
+    return taskIDs;
+}
+
+/*
+ * The auto increment values of a multi-row INSERT are only consecutive when
+ * auto_increment_increment is 1 and innodb_autoinc_lock_mode doesn't interleave them with the
+ * inserts of other connections, such as the other import writers. The TaskIDs are read back
+ * instead. The transaction reads a snapshot taken when it started, the only rows it can see with
+ * a TaskID from the first one the INSERT generated are the rows that INSERT added, they are
+ * matched to the batch by the hash of the description. The IDs are only stored in the models
+ * after the COMMIT. If any statement throws the connection is closed without a COMMIT and no
+ * tasks are inserted.
+ */
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoInsertTasks(TaskList& tasks)
+{
+    struct TaskRow
+    {
+        const TaskModel* task;
+        std::vector<std::size_t> dependencies;
+    };
+
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+    std::vector<TaskRow> taskRows;
+    taskRows.reserve(tasks.size());
+    for (const auto& task: tasks)
+    {
+        taskRows.push_back({task.get(), sortedUniqueDependencies(*task)});
+    }
+    std::vector<std::size_t> taskIDs;
+    taskIDs.reserve(tasks.size());
+
+    co_await coRoExecute(conn, "SET TRANSACTION ISOLATION LEVEL REPEATABLE READ", result);
+    co_await coRoExecute(conn, "START TRANSACTION WITH CONSISTENT SNAPSHOT", result);
+
+    std::span<const TaskRow> remainingRows(taskRows);
+    while (!remainingRows.empty())
+    {
+        std::span<const TaskRow> batch = remainingRows.first(std::min(InsertBatchSize, remainingRows.size()));
+        remainingRows = remainingRows.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO Tasks (CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, "
+                "CreatedOn, RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+                "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount) VALUES {0}",
+                NSBM::sequence(batch,
+                    [this](const TaskRow& row, NSBM::format_context_base& ctx)
+                    {
+                        const TaskModel& task = *row.task;
+                        NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})",
+                            task.getCreatorID(),
+                            task.getAssignToID(),
+                            task.getDescription(),
+                            task.rawParentTaskID(),
+                            task.getStatusIntVal(),
+                            task.getPercentageComplete(),
+                            convertCompactDateToBoostMySQLDate(task.getCompactCreationDate()),
+                            convertCompactDateToBoostMySQLDate(task.getCompactDueDate()),
+                            convertCompactDateToBoostMySQLDate(task.getCompactScheduledStart()),
+                            optionalDateConversion(task.getCompactActualStartDate()),
+                            optionalDateConversion(task.getCompactEstimatedCompletion()),
+                            optionalDateConversion(task.getCompactCompletionDate()),
+                            task.getEstimatedEffort(),
+                            task.getactualEffortToDate(),
+                            task.getPriorityGroup(),
+                            task.getPriority(),
+                            task.isPersonal(),
+                            row.dependencies.size());
+                    })),
+            result
+        );
+
+        std::vector<std::uint64_t> batchKeys;
+        batchKeys.reserve(batch.size());
+        for (const auto& row: batch)
+        {
+            batchKeys.push_back(taskImportKey(row.task->getDescription()));
+        }
+
+        NSBM::results insertedRows;
+        co_await coRoExecute(conn,
+            NSBM::with_params("SELECT TaskID, Description FROM Tasks WHERE TaskID >= {0} ORDER BY TaskID ASC",
+                result.last_insert_id()),
+            insertedRows
+        );
+
+        std::vector<std::size_t> batchTaskIDs = matchInsertedTaskIDs(batchKeys, insertedRows,
+            [](NSBM::row_view row) { return taskImportKey(row.at(1).as_string()); });
+        taskIDs.insert(taskIDs.end(), batchTaskIDs.begin(), batchTaskIDs.end());
+    }
+
+    for (std::size_t taskIndex = 0; taskIndex < taskRows.size(); ++taskIndex)
+    {
+        if (!taskRows[taskIndex].dependencies.empty())
+        {
+            co_await coRoInsertDependencies(conn, taskIDs[taskIndex], taskRows[taskIndex].dependencies);
+        }
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    for (std::size_t taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+    {
+        tasks[taskIndex]->setTaskID(taskIDs[taskIndex]);
+    }
+
+    co_return result;
+}
+
+/*
+ * The rows of tasks that have a TaskID are replaced by multi-row INSERT ... ON DUPLICATE KEY
+ * UPDATE statements, one statement updates InsertBatchSize rows with different values where
+ * an UPDATE would need a CASE per column. A row that was deleted since it was imported is
+ * inserted again with its old TaskID. Only the columns the import provides are updated, the
+ * owner, PercentageComplete, Completed and Personal are kept. The remaining tasks are inserted
+ * in the same way as coRoInsertTasks() does, their TaskIDs are read back by ImportKeyHash.
+ */
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoUpsertTasks(TaskList& tasks, const std::vector<ImportHash>& importHashes)
+{
+    struct TaskRow
+    {
+        const TaskModel* task;
+        ImportHash importHash;
+        std::vector<std::size_t> dependencies;
+    };
+
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+    std::vector<TaskRow> existingRows;
+    std::vector<TaskRow> newRows;
+    std::vector<std::size_t> newTaskIndexes;
+    for (std::size_t taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+    {
+        TaskModel& task = *tasks[taskIndex];
+        TaskRow taskRow{&task, importHashes[taskIndex], sortedUniqueDependencies(task)};
+        if (task.getTaskID() > 0)
+        {
+            existingRows.push_back(std::move(taskRow));
+        }
+        else
+        {
+            newRows.push_back(std::move(taskRow));
+            newTaskIndexes.push_back(taskIndex);
+        }
+    }
+    std::vector<std::size_t> newTaskIDs;
+    newTaskIDs.reserve(newRows.size());
+
+    auto formatTaskRow = [this](const TaskRow& row, NSBM::format_context_base& ctx)
+    {
+        const TaskModel& task = *row.task;
+        NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})",
+            task.getTaskID() > 0? std::optional<std::size_t>(task.getTaskID()) : std::nullopt,
+            task.getCreatorID(),
+            task.getAssignToID(),
+            task.getDescription(),
+            task.rawParentTaskID(),
+            task.getStatusIntVal(),
+            task.getPercentageComplete(),
+            convertCompactDateToBoostMySQLDate(task.getCompactCreationDate()),
+            convertCompactDateToBoostMySQLDate(task.getCompactDueDate()),
+            convertCompactDateToBoostMySQLDate(task.getCompactScheduledStart()),
+            optionalDateConversion(task.getCompactActualStartDate()),
+            optionalDateConversion(task.getCompactEstimatedCompletion()),
+            optionalDateConversion(task.getCompactCompletionDate()),
+            task.getEstimatedEffort(),
+            task.getactualEffortToDate(),
+            task.getPriorityGroup(),
+            task.getPriority(),
+            task.isPersonal(),
+            row.dependencies.size(),
+            row.importHash.importKey,
+            row.importHash.content);
+    };
+
+    co_await coRoExecute(conn, "SET TRANSACTION ISOLATION LEVEL REPEATABLE READ", result);
+    co_await coRoExecute(conn, "START TRANSACTION WITH CONSISTENT SNAPSHOT", result);
+
+    std::span<const TaskRow> remainingRows(existingRows);
+    while (!remainingRows.empty())
+    {
+        std::span<const TaskRow> batch = remainingRows.first(std::min(InsertBatchSize, remainingRows.size()));
+        remainingRows = remainingRows.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("DELETE FROM TaskDependencies WHERE TaskID IN ({0})",
+                NSBM::sequence(batch,
+                    [](const TaskRow& row, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "{}", row.task->getTaskID());
+                    })),
+            result
+        );
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO Tasks (TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, "
+                "PercentageComplete, CreatedOn, RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, "
+                "EstimatedEffortHours, ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount, "
+                "ImportKeyHash, ContentHash) VALUES {0} AS NewTask ON DUPLICATE KEY UPDATE "
+                "Description = NewTask.Description, ParentTask = NewTask.ParentTask, Status = NewTask.Status, "
+                "CreatedOn = NewTask.CreatedOn, RequiredDelivery = NewTask.RequiredDelivery, "
+                "ScheduledStart = NewTask.ScheduledStart, ActualStart = NewTask.ActualStart, "
+                "EstimatedCompletion = NewTask.EstimatedCompletion, EstimatedEffortHours = NewTask.EstimatedEffortHours, "
+                "ActualEffortHours = NewTask.ActualEffortHours, SchedulePriorityGroup = NewTask.SchedulePriorityGroup, "
+                "PriorityInGroup = NewTask.PriorityInGroup, DependencyCount = NewTask.DependencyCount, "
+                "ImportKeyHash = NewTask.ImportKeyHash, ContentHash = NewTask.ContentHash",
+                NSBM::sequence(batch, formatTaskRow)),
+            result
+        );
+    }
+
+    remainingRows = newRows;
+    while (!remainingRows.empty())
+    {
+        std::span<const TaskRow> batch = remainingRows.first(std::min(InsertBatchSize, remainingRows.size()));
+        remainingRows = remainingRows.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO Tasks (TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, "
+                "PercentageComplete, CreatedOn, RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, "
+                "EstimatedEffortHours, ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount, "
+                "ImportKeyHash, ContentHash) VALUES {0}",
+                NSBM::sequence(batch, formatTaskRow)),
+            result
+        );
+
+        std::vector<std::uint64_t> batchKeys;
+        batchKeys.reserve(batch.size());
+        for (const auto& row: batch)
+        {
+            batchKeys.push_back(row.importHash.importKey);
+        }
+
+        NSBM::results insertedRows;
+        co_await coRoExecute(conn,
+            NSBM::with_params("SELECT TaskID, ImportKeyHash FROM Tasks WHERE TaskID >= {0} AND ImportKeyHash IN ({1}) "
+                "ORDER BY TaskID ASC", result.last_insert_id(), batchKeys),
+            insertedRows
+        );
+
+        std::vector<std::size_t> batchTaskIDs = matchInsertedTaskIDs(batchKeys, insertedRows,
+            [](NSBM::row_view row) { return row.at(1).as_uint64(); });
+        newTaskIDs.insert(newTaskIDs.end(), batchTaskIDs.begin(), batchTaskIDs.end());
+    }
+
+    for (const auto& existingRow: existingRows)
+    {
+        if (!existingRow.dependencies.empty())
+        {
+            co_await coRoInsertDependencies(conn, existingRow.task->getTaskID(), existingRow.dependencies);
+        }
+    }
+    for (std::size_t newIndex = 0; newIndex < newRows.size(); ++newIndex)
+    {
+        if (!newRows[newIndex].dependencies.empty())
+        {
+            co_await coRoInsertDependencies(conn, newTaskIDs[newIndex], newRows[newIndex].dependencies);
+        }
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    for (std::size_t newIndex = 0; newIndex < newTaskIndexes.size(); ++newIndex)
+    {
+        tasks[newTaskIndexes[newIndex]]->setTaskID(newTaskIDs[newIndex]);
+    }
+
+    co_return result;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectImportedRows()
+{
+    std::size_t creatorID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    // Read from ImportHash_idx alone, the TaskID is part of every secondary index.
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskID, ImportKeyHash, ContentHash FROM Tasks WHERE CreatedBy = {0} AND "
+            "ImportKeyHash IS NOT NULL ORDER BY TaskID ASC", creatorID),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+/*
+ * One UPDATE per InsertBatchSize tasks, the new parent of each task is selected by a CASE on
+ * the TaskID.
+ */
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSetParentTasks(const std::vector<ParentAssignment>& parentAssignments)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    std::span<const ParentAssignment> remainingAssignments(parentAssignments);
+    while (!remainingAssignments.empty())
+    {
+        std::span<const ParentAssignment> batch =
+            remainingAssignments.first(std::min(InsertBatchSize, remainingAssignments.size()));
+        remainingAssignments = remainingAssignments.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("UPDATE Tasks SET ParentTask = CASE TaskID {0} END WHERE TaskID IN ({1})",
+                NSBM::sequence(batch,
+                    [](const ParentAssignment& assignment, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "WHEN {} THEN {}", assignment.taskID, assignment.parentTaskID);
+                    }, " "),
+                NSBM::sequence(batch,
+                    [](const ParentAssignment& assignment, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "{}", assignment.taskID);
+                    })),
+            result
+        );
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+/*
+ * The edges are inserted InsertBatchSize at a time, then DependencyCount of every task that
+ * gained an edge is recounted from TaskDependencies so existing edges are included.
+ */
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoAddDependencies(
+    const std::vector<DependencyAssignment>& dependencyAssignments)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+    std::vector<std::size_t> taskIDs;
+    taskIDs.reserve(dependencyAssignments.size());
+    for (const auto& assignment: dependencyAssignments)
+    {
+        taskIDs.push_back(assignment.taskID);
+    }
+    std::ranges::sort(taskIDs);
+    auto [duplicatesStart, duplicatesEnd] = std::ranges::unique(taskIDs);
+    taskIDs.erase(duplicatesStart, duplicatesEnd);
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    std::span<const DependencyAssignment> remainingAssignments(dependencyAssignments);
+    while (!remainingAssignments.empty())
+    {
+        std::span<const DependencyAssignment> batch =
+            remainingAssignments.first(std::min(InsertBatchSize, remainingAssignments.size()));
+        remainingAssignments = remainingAssignments.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO TaskDependencies (TaskID, Dependency) VALUES {0}",
+                NSBM::sequence(batch,
+                    [](const DependencyAssignment& assignment, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "({}, {})", assignment.taskID, assignment.dependencyTaskID);
+                    })),
+            result
+        );
+    }
+
+    std::span<const std::size_t> remainingTaskIDs(taskIDs);
+    while (!remainingTaskIDs.empty())
+    {
+        std::span<const std::size_t> batch = remainingTaskIDs.first(std::min(InsertBatchSize, remainingTaskIDs.size()));
+        remainingTaskIDs = remainingTaskIDs.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("UPDATE Tasks SET DependencyCount = (SELECT COUNT(*) FROM TaskDependencies "
+                "WHERE TaskDependencies.TaskID = Tasks.TaskID) WHERE TaskID IN ({0})", batch),
+            result
+        );
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+std::optional<NSBM::date> TaskDbInterface::optionalDateConversion(CompactDate optDate)
+{
+    std::optional<NSBM::date> mySqlDate;
+
+    if (optDate.hasValue())
+    {
+        mySqlDate = convertCompactDateToBoostMySQLDate(optDate);
+    }
+    return mySqlDate;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskById()
+{
+    std::size_t taskId = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE TaskID = {0}",
+            taskId),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskDependencies(const std::size_t taskId)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT Dependency FROM TaskDependencies WHERE TaskID = {0} ORDER BY Dependency ASC", taskId), selectResult);
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+void TaskDbInterface::addDependencies(TaskModel_shp newTask)
+{
+    ProfileZone zone("hydrate");
+    std::size_t taskId = newTask->getTaskID();
     NSBM::results localResult = runQueryAsync(
         std::bind(&TaskDbInterface::coRoSelectTaskDependencies, this, std::placeholders::_1), taskId);
 
-    if (!localResult.rows().empty())
+    if (!localResult.rows().empty())
+    {
+        for (auto row: localResult.rows())
+        {
+            newTask->addDependency(row.at(0).as_uint64());
+        }
+    }
+    else
+    {
+        std::runtime_error NoExpectedDependencies("Dependencies expected but not found!");
+        throw NoExpectedDependencies;
+    }
+}
+
+/*
+ * Loads the dependencies of all of the tasks in the list with one query instead of one query
+ * per task.
+ */
+void TaskDbInterface::addDependenciesToTaskList(TaskList& tasksWithDependencies)
+{
+    ProfileZone zone("hydrate");
+    std::unordered_map<std::size_t, TaskModel_shp> tasksByID;
+    std::vector<std::size_t> taskIDs;
+    tasksByID.reserve(tasksWithDependencies.size());
+    taskIDs.reserve(tasksWithDependencies.size());
+    for (auto task: tasksWithDependencies)
+    {
+        tasksByID[task->getTaskID()] = task;
+        taskIDs.push_back(task->getTaskID());
+    }
+
+    selectStatementWhatArgs.clear();
+    selectStatementWhatArgs.push_back(std::any(taskIDs));
+
+    NSBM::results localResult = runQueryAsync(std::bind(&TaskDbInterface::coRoSelectDependenciesForTasks, this));
+
+    for (auto row: localResult.rows())
+    {
+        tasksByID[row.at(0).as_uint64()]->addDependency(row.at(1).as_uint64());
+    }
+
+    for (auto task: tasksWithDependencies)
+    {
+        if (task->getDependencies().empty())
+        {
+            std::runtime_error NoExpectedDependencies(
+                std::format("Dependencies expected but not found for task {}!", task->getTaskID()));
+            throw NoExpectedDependencies;
+        }
+        task->clearModified();
+    }
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectDependenciesForTasks()
+{
+    std::vector<std::size_t> taskIDs = std::any_cast<std::vector<std::size_t>>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskID, Dependency FROM TaskDependencies WHERE TaskID IN ({0})"
+            " ORDER BY TaskID ASC, Dependency ASC", taskIDs),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+/*
+ * The stored edge set is read under FOR UPDATE so that concurrent edits of the same task are
+ * serialized. If any statement throws the connection is closed without a COMMIT and the server
+ * rolls the transaction back, the stored edges and DependencyCount are never out of step.
+ */
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSetDependencies(TaskModel& task)
+{
+    std::size_t taskID = task.getTaskID();
+    std::vector<std::size_t> wanted = sortedUniqueDependencies(task);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    NSBM::results storedResult;
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT Dependency FROM TaskDependencies WHERE TaskID = {0} ORDER BY Dependency ASC FOR UPDATE",
+            taskID),
+        storedResult
+    );
+
+    std::vector<std::size_t> stored;
+    stored.reserve(storedResult.rows().size());
+    for (auto row: storedResult.rows())
     {
-        for (auto row: localResult.rows())
-        {
-            newTask->addDependency(row.at(0).as_uint64());
-        }
+        stored.push_back(row.at(0).as_uint64());
     }
-    else
+    auto [duplicatesStart, duplicatesEnd] = std::ranges::unique(stored);
+    stored.erase(duplicatesStart, duplicatesEnd);
+
+    std::vector<std::size_t> removed;
+    std::vector<std::size_t> added;
+    std::ranges::set_difference(stored, wanted, std::back_inserter(removed));
+    std::ranges::set_difference(wanted, stored, std::back_inserter(added));
+
+    if (!removed.empty())
     {
-        std::runtime_error NoExpectedDependencies("Dependencies expected but not found!");
-        throw NoExpectedDependencies;
+        co_await coRoExecute(conn,
+            NSBM::with_params("DELETE FROM TaskDependencies WHERE TaskID = {0} AND Dependency IN ({1})",
+                taskID, removed),
+            result
+        );
+    }
+
+    if (!added.empty())
+    {
+        co_await coRoInsertDependencies(conn, taskID, added);
     }
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("UPDATE Tasks SET DependencyCount = {0} WHERE TaskID = {1}", wanted.size(), taskID),
+        result
+    );
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
+/*
+ * All of the new edges for a task are written with a single multi-row INSERT.
+ */
+NSBA::awaitable<void> TaskDbInterface::coRoInsertDependencies(NSBM::any_connection& conn, std::size_t taskID,
+    const std::vector<std::size_t>& dependencies)
+{
+    NSBM::results result;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("INSERT INTO TaskDependencies (TaskID, Dependency) VALUES {0}",
+            NSBM::sequence(dependencies,
+                [taskID](std::size_t dependency, NSBM::format_context_base& ctx)
+                {
+                    NSBM::format_sql_to(ctx, "({}, {})", taskID, dependency);
+                })),
+        result
+    );
+}
+
+std::vector<std::size_t> TaskDbInterface::sortedUniqueDependencies(TaskModel& task)
+{
+    std::vector<std::size_t> dependencies = task.getDependencies();
+
+    std::ranges::sort(dependencies);
+    auto [duplicatesStart, duplicatesEnd] = std::ranges::unique(dependencies);
+    dependencies.erase(duplicatesStart, duplicatesEnd);
+
+    return dependencies;
 }
 
 NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskByDescriptionAndAssignedUser()
@@ -411,11 +1455,11 @@ NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskByDescriptionAndAs
     std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[1]);
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results selectResult;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
             "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
             "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE Description = {0}"
@@ -428,6 +1472,343 @@ NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTaskByDescriptionAndAs
     co_return selectResult;
 }
 
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectDependentTasks()
+{
+    std::size_t taskId = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT Tasks.TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM TaskDependencies"
+            " JOIN Tasks ON Tasks.TaskID = TaskDependencies.TaskID WHERE TaskDependencies.Dependency = {0}"
+            " ORDER BY Tasks.TaskID ASC",
+            taskId),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+/*
+ * Only the dependents of the completed tasks are examined, the Dependents_idx index finds them
+ * and the TaskID index on TaskDependencies checks each candidate's remaining dependencies, so the
+ * cost is proportional to the number of affected tasks rather than the size of the tables.
+ * The candidates are selected first because MySQL does not allow the updated table to appear in
+ * a subquery of the UPDATE statement. The select result containing the released task IDs is returned,
+ * a task waiting on more than one of the completed tasks appears once per completed task.
+ */
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoCompleteTasksAndReleaseDependents(
+    const std::vector<std::size_t>& completedTaskIDs)
+{
+    constexpr unsigned int notStarted = static_cast<unsigned int>(TaskModel::TaskStatus::Not_Started);
+    constexpr unsigned int waiting = static_cast<unsigned int>(TaskModel::TaskStatus::Waiting_for_Dependency);
+    constexpr unsigned int complete = static_cast<unsigned int>(TaskModel::TaskStatus::Complete);
+    NSBM::date today = convertChronoDateToBoostMySQLDate(getTodaysDate());
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("UPDATE Tasks SET Status = {0}, Completed = COALESCE(Completed, {1}) WHERE TaskID IN ({2})",
+            complete, today, completedTaskIDs),
+        result
+    );
+
+    NSBM::results releasedResult;
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT Candidates.TaskID FROM TaskDependencies AS Candidates"
+            " JOIN Tasks AS Waiting ON Waiting.TaskID = Candidates.TaskID"
+            " WHERE Candidates.Dependency IN ({0}) AND Waiting.Status = {1}"
+            " AND NOT EXISTS (SELECT 1 FROM TaskDependencies AS Remaining"
+                " JOIN Tasks AS Blocking ON Blocking.TaskID = Remaining.Dependency"
+                " WHERE Remaining.TaskID = Candidates.TaskID AND (Blocking.Status IS NULL OR Blocking.Status <> {2}))"
+            " ORDER BY Candidates.TaskID ASC FOR UPDATE",
+            completedTaskIDs, waiting, complete),
+        releasedResult
+    );
+
+    if (!releasedResult.rows().empty())
+    {
+        std::vector<std::size_t> releasedTaskIDs;
+        releasedTaskIDs.reserve(releasedResult.rows().size());
+        for (auto row: releasedResult.rows())
+        {
+            releasedTaskIDs.push_back(row.at(0).as_uint64());
+        }
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("UPDATE Tasks SET Status = {0} WHERE TaskID IN ({1}) AND Status = {2}",
+                notStarted, releasedTaskIDs, waiting),
+            result
+        );
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    co_return releasedResult;
+}
+
+/*
+ * The graph queries only return the columns the graph needs, node rows are TaskID and
+ * EstimatedEffortHours, edge rows are TaskID and Dependency.
+ */
+TaskGraph TaskDbInterface::buildTaskGraph(NSBM::results& nodeResults, NSBM::results& edgeResults)
+{
+    ProfileZone zone("decode");
+    std::vector<std::size_t> taskIDs;
+    std::vector<unsigned int> effortHours;
+    taskIDs.reserve(nodeResults.rows().size());
+    effortHours.reserve(nodeResults.rows().size());
+    for (auto row: nodeResults.rows())
+    {
+        taskIDs.push_back(row.at(0).as_uint64());
+        effortHours.push_back(static_cast<unsigned int>(row.at(1).as_uint64()));
+    }
+
+    std::vector<TaskGraph::Edge> edges;
+    edges.reserve(edgeResults.rows().size());
+    for (auto row: edgeResults.rows())
+    {
+        edges.push_back({row.at(0).as_uint64(), row.at(1).as_uint64()});
+    }
+
+    return TaskGraph(taskIDs, effortHours, edges);
+}
+
+/*
+ * The task rows use the same columns as processResultRow(), the dependency rows are TaskID and
+ * Dependency. Descriptions are copied into the store's string heap directly from the row.
+ */
+TaskStore TaskDbInterface::buildTaskStore(NSBM::results& taskResults, NSBM::results& dependencyResults)
+{
+    ProfileZone zone("decode");
+    TaskStore taskStore;
+
+    std::size_t descriptionBytes = 0;
+    for (auto row: taskResults.rows())
+    {
+        descriptionBytes += row.at(descriptionIdx).as_string().size();
+    }
+    taskStore.reserve(taskResults.rows().size(), descriptionBytes);
+
+    for (auto row: taskResults.rows())
+    {
+        processResultRow(row, taskStore);
+    }
+
+    std::vector<TaskStore::Dependency> dependencies;
+    dependencies.reserve(dependencyResults.rows().size());
+    for (auto row: dependencyResults.rows())
+    {
+        dependencies.push_back({row.at(0).as_uint64(), row.at(1).as_uint64()});
+    }
+    taskStore.setDependencies(std::move(dependencies));
+
+    return taskStore;
+}
+
+void TaskDbInterface::processResultRow(NSBM::row_view rv, TaskStore& taskStore)
+{
+    TaskStore::TaskRow taskRow;
+
+    // Required fields.
+    taskRow.taskID = rv.at(taskIdIdx).as_uint64();
+    taskRow.creatorID = rv.at(createdByIdx).as_uint64();
+    taskRow.assignToID = rv.at(assignedToIdx).as_uint64();
+    taskRow.description = std::string_view(rv.at(descriptionIdx).as_string());
+    taskRow.percentageComplete = rv.at(percentageCompleteIdx).as_double();
+    taskRow.creationDate = convertBoostMySQLDateToCompactDate(rv.at(createdOnIdx).as_date());
+    taskRow.dueDate = convertBoostMySQLDateToCompactDate(rv.at(requiredDeliveryIdx).as_date());
+    taskRow.scheduledStart = convertBoostMySQLDateToCompactDate(rv.at(scheduledStartIdx).as_date());
+    taskRow.estimatedEffort = rv.at(estimatedEffortHoursIdx).as_uint64();
+    taskRow.actualEffortToDate = rv.at(actualEffortHoursIdx).as_double();
+    taskRow.priorityGroup = rv.at(schedulePriorityGroupIdx).as_uint64();
+    taskRow.priority = rv.at(priorityInGroupIdx).as_uint64();
+    taskRow.personal = rv.at(personalIdx).as_int64();
+
+    // Optional fields.
+    if (!rv.at(parentTaskIdx).is_null())
+    {
+        taskRow.parentTaskID = rv.at(parentTaskIdx).as_uint64();
+    }
+
+    if (!rv.at(statusIdx).is_null())
+    {
+        taskRow.status = static_cast<TaskModel::TaskStatus>(rv.at(statusIdx).as_uint64());
+    }
+
+    if (!rv.at(actualStartIdx).is_null())
+    {
+        taskRow.actualStartDate = convertBoostMySQLDateToCompactDate(rv.at(actualStartIdx).as_date());
+    }
+
+    if (!rv.at(estimatedCompletionIdx).is_null())
+    {
+        taskRow.estimatedCompletion = convertBoostMySQLDateToCompactDate(rv.at(estimatedCompletionIdx).as_date());
+    }
+
+    if (!rv.at(completedIdx).is_null())
+    {
+        taskRow.completionDate = convertBoostMySQLDateToCompactDate(rv.at(completedIdx).as_date());
+    }
+
+    taskStore.append(taskRow);
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTasksForAssignedUser()
+{
+    std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE AsignedTo = {0}"
+            " ORDER BY TaskID ASC", userID),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectAllTasks()
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        "SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks"
+            " ORDER BY TaskID ASC",
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectAllDependencies()
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn, "SELECT TaskID, Dependency FROM TaskDependencies", selectResult);
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectGraphNodesForAssignedUser()
+{
+    std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskID, EstimatedEffortHours FROM Tasks WHERE AsignedTo = {0} ORDER BY TaskID ASC", userID),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectGraphEdgesForAssignedUser()
+{
+    std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskDependencies.TaskID, TaskDependencies.Dependency FROM TaskDependencies"
+            " JOIN Tasks ON Tasks.TaskID = TaskDependencies.TaskID WHERE Tasks.AsignedTo = {0}", userID),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectGraphNodesForProject()
+{
+    std::size_t projectTaskID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("WITH RECURSIVE Project (TaskID) AS (SELECT TaskID FROM Tasks WHERE TaskID = {0}"
+            " UNION ALL SELECT Tasks.TaskID FROM Tasks JOIN Project ON Tasks.ParentTask = Project.TaskID)"
+            " SELECT Tasks.TaskID, Tasks.EstimatedEffortHours FROM Tasks JOIN Project ON Tasks.TaskID = Project.TaskID"
+            " ORDER BY Tasks.TaskID ASC", projectTaskID),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectGraphEdgesForProject()
+{
+    std::size_t projectTaskID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("WITH RECURSIVE Project (TaskID) AS (SELECT TaskID FROM Tasks WHERE TaskID = {0}"
+            " UNION ALL SELECT Tasks.TaskID FROM Tasks JOIN Project ON Tasks.ParentTask = Project.TaskID)"
+            " SELECT TaskDependencies.TaskID, TaskDependencies.Dependency FROM TaskDependencies"
+            " JOIN Project ON TaskDependencies.TaskID = Project.TaskID", projectTaskID),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
 NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectUnstartedDueForStartForAssignedUser()
 {
     constexpr unsigned int notStarted = static_cast<unsigned int>(TaskModel::TaskStatus::Not_Started);
@@ -435,11 +1816,11 @@ NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectUnstartedDueForStartFo
     NSBM::date searchStart = std::any_cast<NSBM::date>(selectStatementWhatArgs[1]);
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results selectResult;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
             "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
             "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE AsignedTo = {0}"
@@ -453,18 +1834,42 @@ NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectUnstartedDueForStartFo
     co_return selectResult;
 }
 
+NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectOpenTasksForAssignedUser()
+{
+    constexpr unsigned int complete = static_cast<unsigned int>(TaskModel::TaskStatus::Complete);
+    std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results selectResult;
+
+    co_await coRoExecute(conn,
+        NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
+            "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
+            "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE AsignedTo = {0}"
+            " AND (Status IS NULL OR Status <> {1}) ORDER BY SchedulePriorityGroup ASC, PriorityInGroup ASC, TaskID ASC",
+            userID, complete),
+        selectResult
+    );
+
+    co_await conn.async_close();
+
+    co_return selectResult;
+}
+
 NSBA::awaitable<NSBM::results> TaskDbInterface::coRoSelectTasksWithStatusForAssignedUserBefore()
 {
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results selectResult;
     std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
     NSBM::date searchStart = convertChronoDateToBoostMySQLDate(std::any_cast<std::chrono::year_month_day>(selectStatementWhatArgs[1]));
     unsigned int status = std::any_cast<unsigned int>(selectStatementWhatArgs[2]);
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT TaskID, CreatedBy, AsignedTo, Description, ParentTask, Status, PercentageComplete, CreatedOn,"
             "RequiredDelivery, ScheduledStart, ActualStart, EstimatedCompletion, Completed, EstimatedEffortHours, "
             "ActualEffortHours, SchedulePriorityGroup, PriorityInGroup, Personal, DependencyCount FROM Tasks WHERE AsignedTo = {0}"
@@ -5,9 +5,13 @@
 #include "commonUtilities.h"
 #include "BoostDBInterfaceCore.h"
 #include <functional>
+#include "ImportHash.h"
 #include <optional>
 #include <string_view>
+#include "TaskGraph.h"
 #include "TaskModel.h"
+#include "TaskStore.h"
+#include <vector>
 
 class TaskDbInterface : public BoostDBInterfaceCore
 {
@@ -16,6 +20,23 @@ public:
     ~TaskDbInterface() = default;
     std::size_t insert(TaskModel& task);
     std::size_t insert(TaskModel_shp task) { return insert(*task); };
+/*
+ * Inserts all of the tasks and their dependencies in one transaction with multi-row INSERT
+ * statements and sets the TaskID of each task. Either all of the tasks are inserted or none are.
+ */
+    bool insertBatch(TaskList& tasks);
+/*
+ * Writes the tasks of a CSV import in one transaction, importHashes[i] is stored with tasks[i].
+ * A task that already has a TaskID replaces its stored row, many rows per INSERT ... ON
+ * DUPLICATE KEY UPDATE statement, and its stored dependencies are replaced by those of the
+ * model. The other tasks are inserted and given a TaskID. Either all of the tasks are written
+ * or none are.
+ */
+    bool upsertBatch(TaskList& tasks, const std::vector<ImportHash>& importHashes);
+/*
+ * The import hashes of the tasks a user created that were written by upsertBatch().
+ */
+    std::vector<ImportedRow> getImportedRows(UserModel& creator);
     TaskModel_shp getTaskByTaskID(std::size_t taskId);
     TaskModel_shp getTaskByDescriptionAndAssignedUser(std::string_view description, UserModel& assignedUser);
     TaskModel_shp getParentTask(TaskModel& task);
@@ -26,23 +47,100 @@ public:
     TaskList getUnstartedDueForStartForAssignedUser(UserModel& assignedUser);
     TaskList getUnstartedDueForStartForAssignedUser(UserModel_shp assignedUser)
         { return getUnstartedDueForStartForAssignedUser(*assignedUser); };
+    TaskList getOpenTasksForAssignedUser(UserModel& assignedUser);
+    TaskList getOpenTasksForAssignedUser(UserModel_shp assignedUser)
+        { return getOpenTasksForAssignedUser(*assignedUser); };
     TaskList getTasksCompletedByAssignedAfterDate(UserModel& assignedUser,
         std::chrono::year_month_day searchStartDate);
     TaskList getTasksCompletedByAssignedAfterDate(UserModel_shp assignedUser,
         std::chrono::year_month_day searchStartDate)
         { return getTasksCompletedByAssignedAfterDate(*assignedUser, searchStartDate); };
+/*
+ * Synchronizes the dependencies stored in the database with the dependencies of the task in
+ * memory. Only the difference is written, removed edges in one DELETE and added edges in one
+ * INSERT, DependencyCount is updated in the same transaction.
+ */
+    bool setDependencies(TaskModel& task);
+    bool setDependencies(TaskModel_shp task) { return setDependencies(*task); };
+/*
+ * Sets the ParentTask column of many tasks in one transaction, used when the parents were not
+ * known at the time the tasks were inserted.
+ */
+    struct ParentAssignment
+    {
+        std::size_t taskID;
+        std::size_t parentTaskID;
+    };
+    bool setParentTasks(const std::vector<ParentAssignment>& parentAssignments);
+/*
+ * Adds dependencies to many tasks in one transaction and recounts DependencyCount for those
+ * tasks, used when the dependencies were not known at the time the tasks were inserted.
+ */
+    struct DependencyAssignment
+    {
+        std::size_t taskID;
+        std::size_t dependencyTaskID;
+    };
+    bool addDependencies(const std::vector<DependencyAssignment>& dependencyAssignments);
+    TaskList getDependentTasks(std::size_t taskId);
+    TaskList getDependentTasks(TaskModel& task) { return getDependentTasks(task.getTaskID()); };
+    TaskList getDependentTasks(TaskModel_shp task) { return getDependentTasks(task->getTaskID()); };
+/*
+ * Marks the tasks as complete and moves every task that was waiting only on completed tasks
+ * from Waiting_for_Dependency to Not_Started. Returns the IDs of the tasks that were released.
+ */
+    std::vector<std::size_t> completeTasksAndReleaseDependents(const std::vector<std::size_t>& completedTaskIDs);
+/*
+ * Build the dependency graph for all tasks assigned to a user, or for a project, which is a task
+ * and all of its sub tasks. Dependencies on tasks outside the graph are ignored.
+ */
+    TaskGraph getTaskGraphForAssignedUser(UserModel& assignedUser);
+    TaskGraph getTaskGraphForAssignedUser(UserModel_shp assignedUser) { return getTaskGraphForAssignedUser(*assignedUser); };
+    TaskGraph getTaskGraphForProject(std::size_t projectTaskID);
+/*
+ * Load tasks directly into the columns of a TaskStore, no TaskModel objects are created.
+ */
+    TaskStore getTaskStoreForAssignedUser(UserModel& assignedUser);
+    TaskStore getTaskStoreForAssignedUser(UserModel_shp assignedUser) { return getTaskStoreForAssignedUser(*assignedUser); };
+    TaskStore getTaskStoreForAllTasks();
+
+    static constexpr std::size_t InsertBatchSize = 1000;
 
 private:
     TaskModel_shp processResult(NSBM::results& results);
     TaskList processResults(NSBM::results& results);
-    void processResultRow(NSBM::row_view rv, TaskModel_shp newTask);
+    std::size_t processResultRow(NSBM::row_view rv, TaskModel_shp newTask, bool loadDependencies=true);
     NSBA::awaitable<NSBM::results> coRoInsertTask(TaskModel& task);
-    std::optional<NSBM::date> optionalDateConversion(std::optional<std::chrono::year_month_day> optDate);
+    NSBA::awaitable<NSBM::results> coRoInsertTasks(TaskList& tasks);
+    NSBA::awaitable<NSBM::results> coRoUpsertTasks(TaskList& tasks, const std::vector<ImportHash>& importHashes);
+    NSBA::awaitable<NSBM::results> coRoSelectImportedRows();
+    NSBA::awaitable<NSBM::results> coRoSetParentTasks(const std::vector<ParentAssignment>& parentAssignments);
+    NSBA::awaitable<NSBM::results> coRoAddDependencies(const std::vector<DependencyAssignment>& dependencyAssignments);
+    std::optional<NSBM::date> optionalDateConversion(CompactDate optDate);
     NSBA::awaitable<NSBM::results> coRoSelectTaskById();
     NSBA::awaitable<NSBM::results> coRoSelectTaskDependencies(const std::size_t taskId);
     void addDependencies(TaskModel_shp newTask);
+    void addDependenciesToTaskList(TaskList& tasksWithDependencies);
+    NSBA::awaitable<NSBM::results> coRoSelectDependenciesForTasks();
+    NSBA::awaitable<NSBM::results> coRoSetDependencies(TaskModel& task);
+    NSBA::awaitable<void> coRoInsertDependencies(NSBM::any_connection& conn, std::size_t taskID,
+        const std::vector<std::size_t>& dependencies);
+    std::vector<std::size_t> sortedUniqueDependencies(TaskModel& task);
     NSBA::awaitable<NSBM::results> coRoSelectTaskByDescriptionAndAssignedUser();
+    NSBA::awaitable<NSBM::results> coRoSelectDependentTasks();
+    NSBA::awaitable<NSBM::results> coRoCompleteTasksAndReleaseDependents(const std::vector<std::size_t>& completedTaskIDs);
+    TaskGraph buildTaskGraph(NSBM::results& nodeResults, NSBM::results& edgeResults);
+    NSBA::awaitable<NSBM::results> coRoSelectGraphNodesForAssignedUser();
+    NSBA::awaitable<NSBM::results> coRoSelectGraphEdgesForAssignedUser();
+    NSBA::awaitable<NSBM::results> coRoSelectGraphNodesForProject();
+    NSBA::awaitable<NSBM::results> coRoSelectGraphEdgesForProject();
+    TaskStore buildTaskStore(NSBM::results& taskResults, NSBM::results& dependencyResults);
+    void processResultRow(NSBM::row_view rv, TaskStore& taskStore);
+    NSBA::awaitable<NSBM::results> coRoSelectTasksForAssignedUser();
+    NSBA::awaitable<NSBM::results> coRoSelectAllTasks();
+    NSBA::awaitable<NSBM::results> coRoSelectAllDependencies();
     NSBA::awaitable<NSBM::results> coRoSelectUnstartedDueForStartForAssignedUser();
+    NSBA::awaitable<NSBM::results> coRoSelectOpenTasksForAssignedUser();
     NSBA::awaitable<NSBM::results> coRoSelectTasksWithStatusForAssignedUserBefore();
 
 private:
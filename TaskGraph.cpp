@@ -0,0 +1,578 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include "TaskGraph.h"
+#include <utility>
+#include <vector>
+
+static constexpr double CriticalSlackTolerance = 1.0e-6;
+static constexpr std::size_t MaxDenseIndexSpread = 4;
+
+TaskGraph::TaskGraph(const std::vector<std::size_t>& taskIDs, const std::vector<unsigned int>& effortHours,
+    const std::vector<Edge>& edges)
+{
+    build(taskIDs, effortHours, edges);
+}
+
+/*
+ * The task IDs are sorted so that a task ID can be converted to a node index with a binary
+ * search, the IDs returned by the database are usually already in order. Auto increment IDs
+ * are nearly contiguous, in that case a direct lookup table replaces the binary search. Edges
+ * that refer to a task that is not part of the graph are ignored and counted.
+ */
+void TaskGraph::build(const std::vector<std::size_t>& taskIDs, const std::vector<unsigned int>& effortHours,
+    const std::vector<Edge>& edges)
+{
+    std::vector<NodeIndex> permutation(taskIDs.size());
+    std::iota(permutation.begin(), permutation.end(), 0);
+    if (!std::ranges::is_sorted(taskIDs))
+    {
+        std::ranges::sort(permutation, [&taskIDs](NodeIndex a, NodeIndex b) { return taskIDs[a] < taskIDs[b]; });
+    }
+
+    nodeTaskIDs.resize(taskIDs.size());
+    nodeEffort.resize(taskIDs.size());
+    for (std::size_t node = 0; node < permutation.size(); ++node)
+    {
+        nodeTaskIDs[node] = taskIDs[permutation[node]];
+        nodeEffort[node] = (permutation[node] < effortHours.size())? static_cast<float>(effortHours[permutation[node]]) : 0.0f;
+    }
+
+    denseNodeIndex.clear();
+    if (!nodeTaskIDs.empty() && nodeTaskIDs.back() - nodeTaskIDs.front() < MaxDenseIndexSpread * nodeTaskIDs.size())
+    {
+        const NodeIndex noNode = static_cast<NodeIndex>(nodeTaskIDs.size());
+        denseNodeIndex.assign(nodeTaskIDs.back() - nodeTaskIDs.front() + 1, noNode);
+        for (NodeIndex node = 0; node < noNode; ++node)
+        {
+            denseNodeIndex[nodeTaskIDs[node] - nodeTaskIDs.front()] = node;
+        }
+    }
+
+    std::vector<std::pair<NodeIndex, NodeIndex>> nodeEdges;
+    nodeEdges.reserve(edges.size());
+    ignoredEdges = 0;
+    for (auto edge: edges)
+    {
+        std::optional<NodeIndex> from = findNode(edge.dependency);
+        std::optional<NodeIndex> to = findNode(edge.taskID);
+        if (from.has_value() && to.has_value())
+        {
+            nodeEdges.emplace_back(*from, *to);
+        }
+        else
+        {
+            ++ignoredEdges;
+        }
+    }
+
+    addedEdges.clear();
+    addedEdgeCount = 0;
+    removedEdges.clear();
+
+    buildAdjacency(nodeEdges);
+}
+
+bool TaskGraph::addEdge(std::size_t taskID, std::size_t dependency)
+{
+    std::optional<NodeIndex> from = findNode(dependency);
+    std::optional<NodeIndex> to = findNode(taskID);
+    if (!from.has_value() || !to.has_value() || *from == *to)
+    {
+        return false;
+    }
+
+    if (hasEdge(*from, *to))
+    {
+        return true;
+    }
+
+    // The new edge closes a cycle if the dependency can already be reached from the task.
+    if (reaches(*to, *from))
+    {
+        return false;
+    }
+
+    if (!removedEdges.erase(edgeKey(*from, *to)))
+    {
+        addedEdges[*from].push_back(*to);
+        ++addedEdgeCount;
+    }
+
+    topologicalOrderValid = false;
+    scheduleValid = false;
+
+    return true;
+}
+
+bool TaskGraph::removeEdge(std::size_t taskID, std::size_t dependency)
+{
+    std::optional<NodeIndex> from = findNode(dependency);
+    std::optional<NodeIndex> to = findNode(taskID);
+    if (!from.has_value() || !to.has_value() || !hasEdge(*from, *to))
+    {
+        return false;
+    }
+
+    auto pending = addedEdges.find(*from);
+    if (pending != addedEdges.end() && std::erase(pending->second, *to))
+    {
+        --addedEdgeCount;
+    }
+    else
+    {
+        removedEdges.insert(edgeKey(*from, *to));
+    }
+
+    topologicalOrderValid = false;
+    scheduleValid = false;
+
+    return true;
+}
+
+bool TaskGraph::setEffort(std::size_t taskID, unsigned int effortHours)
+{
+    std::optional<NodeIndex> node = findNode(taskID);
+    if (!node.has_value())
+    {
+        return false;
+    }
+
+    nodeEffort[*node] = static_cast<float>(effortHours);
+    scheduleValid = false;
+
+    return true;
+}
+
+bool TaskGraph::hasCycle()
+{
+    sortTopologically();
+
+    return cycleFound;
+}
+
+/*
+ * Every node left over by Kahn's algorithm has at least one predecessor that was also left
+ * over, following those predecessors must eventually revisit a node, which closes a cycle.
+ * The cycle is returned in dependency order, each task depends on the task before it.
+ */
+std::vector<std::size_t> TaskGraph::findCycle()
+{
+    std::vector<std::size_t> cycle;
+
+    if (!hasCycle())
+    {
+        return cycle;
+    }
+
+    const NodeIndex noNode = static_cast<NodeIndex>(nodeTaskIDs.size());
+    std::vector<bool> sorted(nodeTaskIDs.size(), false);
+    for (auto node: order)
+    {
+        sorted[node] = true;
+    }
+
+    std::vector<NodeIndex> predecessor(nodeTaskIDs.size(), noNode);
+    for (NodeIndex from = 0; from < noNode; ++from)
+    {
+        if (sorted[from])
+        {
+            continue;
+        }
+        for (NodeIndex edge = successorOffsets[from]; edge < successorOffsets[from + 1]; ++edge)
+        {
+            predecessor[successors[edge]] = from;
+        }
+    }
+
+    NodeIndex start = noNode;
+    for (NodeIndex node = 0; node < noNode; ++node)
+    {
+        if (!sorted[node])
+        {
+            start = node;
+            break;
+        }
+    }
+
+    std::vector<bool> visited(nodeTaskIDs.size(), false);
+    NodeIndex current = start;
+    while (!visited[current])
+    {
+        visited[current] = true;
+        current = predecessor[current];
+    }
+
+    NodeIndex cycleStart = current;
+    do
+    {
+        cycle.push_back(nodeTaskIDs[current]);
+        current = predecessor[current];
+    } while (current != cycleStart);
+
+    std::ranges::reverse(cycle);
+
+    return cycle;
+}
+
+std::optional<std::vector<std::size_t>> TaskGraph::topologicalOrder()
+{
+    if (!sortTopologically())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::size_t> taskOrder;
+    taskOrder.reserve(order.size());
+    for (auto node: order)
+    {
+        taskOrder.push_back(nodeTaskIDs[node]);
+    }
+
+    return taskOrder;
+}
+
+/*
+ * Earliest start is propagated forward in topological order and latest start backwards in
+ * reverse topological order, both passes only walk the successor arrays.
+ */
+bool TaskGraph::computeSchedule()
+{
+    if (scheduleValid)
+    {
+        return true;
+    }
+
+    if (!sortTopologically())
+    {
+        return false;
+    }
+
+    const std::size_t count = nodeTaskIDs.size();
+    earliestStart.assign(count, 0.0);
+    projectDuration = 0.0;
+
+    for (auto node: order)
+    {
+        double earliestFinish = earliestStart[node] + nodeEffort[node];
+        projectDuration = std::max(projectDuration, earliestFinish);
+        for (NodeIndex edge = successorOffsets[node]; edge < successorOffsets[node + 1]; ++edge)
+        {
+            NodeIndex successor = successors[edge];
+            earliestStart[successor] = std::max(earliestStart[successor], earliestFinish);
+        }
+    }
+
+    latestStart.assign(count, 0.0);
+    for (auto node = order.rbegin(); node != order.rend(); ++node)
+    {
+        double latestFinish = projectDuration;
+        for (NodeIndex edge = successorOffsets[*node]; edge < successorOffsets[*node + 1]; ++edge)
+        {
+            latestFinish = std::min(latestFinish, latestStart[successors[edge]]);
+        }
+        latestStart[*node] = latestFinish - nodeEffort[*node];
+    }
+
+    scheduleValid = true;
+
+    return true;
+}
+
+double TaskGraph::getProjectDuration()
+{
+    return computeSchedule()? projectDuration : 0.0;
+}
+
+std::optional<double> TaskGraph::getEarliestStart(std::size_t taskID)
+{
+    std::optional<NodeIndex> node = findNode(taskID);
+    if (!node.has_value() || !computeSchedule())
+    {
+        return std::nullopt;
+    }
+
+    return earliestStart[*node];
+}
+
+std::optional<double> TaskGraph::getLatestStart(std::size_t taskID)
+{
+    std::optional<NodeIndex> node = findNode(taskID);
+    if (!node.has_value() || !computeSchedule())
+    {
+        return std::nullopt;
+    }
+
+    return latestStart[*node];
+}
+
+std::optional<double> TaskGraph::getSlack(std::size_t taskID)
+{
+    std::optional<NodeIndex> node = findNode(taskID);
+    if (!node.has_value() || !computeSchedule())
+    {
+        return std::nullopt;
+    }
+
+    return latestStart[*node] - earliestStart[*node];
+}
+
+/*
+ * A critical task that finishes before the end of the project always has a critical successor
+ * that starts when it finishes, so the walk from a critical task that starts at zero reaches the
+ * end of the project.
+ */
+std::vector<std::size_t> TaskGraph::getCriticalPath()
+{
+    std::vector<std::size_t> criticalPath;
+
+    if (!computeSchedule() || nodeTaskIDs.empty())
+    {
+        return criticalPath;
+    }
+
+    auto isCritical = [this](NodeIndex node)
+    {
+        return std::abs(latestStart[node] - earliestStart[node]) < CriticalSlackTolerance;
+    };
+
+    std::optional<NodeIndex> current;
+    for (auto node: order)
+    {
+        if (earliestStart[node] < CriticalSlackTolerance && isCritical(node))
+        {
+            current = node;
+            break;
+        }
+    }
+
+    while (current.has_value())
+    {
+        NodeIndex node = *current;
+        criticalPath.push_back(nodeTaskIDs[node]);
+
+        double earliestFinish = earliestStart[node] + nodeEffort[node];
+        current.reset();
+        for (NodeIndex edge = successorOffsets[node]; edge < successorOffsets[node + 1]; ++edge)
+        {
+            NodeIndex successor = successors[edge];
+            if (isCritical(successor) && std::abs(earliestStart[successor] - earliestFinish) < CriticalSlackTolerance)
+            {
+                current = successor;
+                break;
+            }
+        }
+    }
+
+    return criticalPath;
+}
+
+/*
+ * Private methods.
+ */
+std::optional<TaskGraph::NodeIndex> TaskGraph::findNode(std::size_t taskID) const
+{
+    if (!denseNodeIndex.empty())
+    {
+        std::size_t offset = taskID - nodeTaskIDs.front();
+        if (taskID < nodeTaskIDs.front() || offset >= denseNodeIndex.size() || denseNodeIndex[offset] == nodeTaskIDs.size())
+        {
+            return std::nullopt;
+        }
+        return denseNodeIndex[offset];
+    }
+
+    auto found = std::ranges::lower_bound(nodeTaskIDs, taskID);
+    if (found == nodeTaskIDs.end() || *found != taskID)
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<NodeIndex>(found - nodeTaskIDs.begin());
+}
+
+/*
+ * Counting sort of the edges by source node, each row of successors is then sorted and
+ * duplicate edges are squeezed out so that hasEdge() can use a binary search.
+ */
+void TaskGraph::buildAdjacency(const std::vector<std::pair<NodeIndex, NodeIndex>>& nodeEdges)
+{
+    const std::size_t count = nodeTaskIDs.size();
+
+    successorOffsets.assign(count + 1, 0);
+    for (auto [from, to]: nodeEdges)
+    {
+        ++successorOffsets[from + 1];
+    }
+    std::partial_sum(successorOffsets.begin(), successorOffsets.end(), successorOffsets.begin());
+
+    successors.resize(nodeEdges.size());
+    std::vector<NodeIndex> insertPosition(successorOffsets.begin(), successorOffsets.end() - 1);
+    for (auto [from, to]: nodeEdges)
+    {
+        successors[insertPosition[from]++] = to;
+    }
+
+    NodeIndex write = 0;
+    for (std::size_t node = 0; node < count; ++node)
+    {
+        auto rowBegin = successors.begin() + successorOffsets[node];
+        auto rowEnd = successors.begin() + successorOffsets[node + 1];
+        std::sort(rowBegin, rowEnd);
+        auto uniqueEnd = std::unique(rowBegin, rowEnd);
+
+        successorOffsets[node] = write;
+        write = static_cast<NodeIndex>(std::copy(rowBegin, uniqueEnd, successors.begin() + write) - successors.begin());
+    }
+    successorOffsets[count] = write;
+    successors.resize(write);
+    successors.shrink_to_fit();
+
+    topologicalOrderValid = false;
+    scheduleValid = false;
+}
+
+void TaskGraph::compactPendingEdges()
+{
+    if (addedEdges.empty() && removedEdges.empty())
+    {
+        return;
+    }
+
+    std::vector<std::pair<NodeIndex, NodeIndex>> nodeEdges;
+    nodeEdges.reserve(edgeCount());
+    for (NodeIndex from = 0; from < nodeTaskIDs.size(); ++from)
+    {
+        for (NodeIndex edge = successorOffsets[from]; edge < successorOffsets[from + 1]; ++edge)
+        {
+            if (!removedEdges.contains(edgeKey(from, successors[edge])))
+            {
+                nodeEdges.emplace_back(from, successors[edge]);
+            }
+        }
+    }
+
+    for (const auto& [from, targets]: addedEdges)
+    {
+        for (auto to: targets)
+        {
+            nodeEdges.emplace_back(from, to);
+        }
+    }
+
+    addedEdges.clear();
+    addedEdgeCount = 0;
+    removedEdges.clear();
+
+    buildAdjacency(nodeEdges);
+}
+
+bool TaskGraph::hasEdge(NodeIndex from, NodeIndex to) const
+{
+    auto rowBegin = successors.begin() + successorOffsets[from];
+    auto rowEnd = successors.begin() + successorOffsets[from + 1];
+    if (std::binary_search(rowBegin, rowEnd, to))
+    {
+        return !removedEdges.contains(edgeKey(from, to));
+    }
+
+    auto pending = addedEdges.find(from);
+    return pending != addedEdges.end() && std::ranges::find(pending->second, to) != pending->second.end();
+}
+
+/*
+ * Depth first search over the current edges including the pending changes, only the part of
+ * the graph reachable from the start node is visited.
+ */
+bool TaskGraph::reaches(NodeIndex from, NodeIndex to) const
+{
+    std::vector<NodeIndex> stack = {from};
+    std::unordered_set<NodeIndex> visited = {from};
+
+    auto visit = [&](NodeIndex next)
+    {
+        if (visited.insert(next).second)
+        {
+            stack.push_back(next);
+        }
+    };
+
+    while (!stack.empty())
+    {
+        NodeIndex node = stack.back();
+        stack.pop_back();
+        if (node == to)
+        {
+            return true;
+        }
+
+        for (NodeIndex edge = successorOffsets[node]; edge < successorOffsets[node + 1]; ++edge)
+        {
+            if (!removedEdges.contains(edgeKey(node, successors[edge])))
+            {
+                visit(successors[edge]);
+            }
+        }
+
+        auto pending = addedEdges.find(node);
+        if (pending != addedEdges.end())
+        {
+            for (auto next: pending->second)
+            {
+                visit(next);
+            }
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Kahn's algorithm, the nodes that are never released belong to or depend on a cycle.
+ */
+bool TaskGraph::sortTopologically()
+{
+    compactPendingEdges();
+
+    if (topologicalOrderValid)
+    {
+        return !cycleFound;
+    }
+
+    const std::size_t count = nodeTaskIDs.size();
+    std::vector<NodeIndex> inDegree(count, 0);
+    for (auto successor: successors)
+    {
+        ++inDegree[successor];
+    }
+
+    order.clear();
+    order.reserve(count);
+    for (NodeIndex node = 0; node < count; ++node)
+    {
+        if (inDegree[node] == 0)
+        {
+            order.push_back(node);
+        }
+    }
+
+    for (std::size_t next = 0; next < order.size(); ++next)
+    {
+        NodeIndex node = order[next];
+        for (NodeIndex edge = successorOffsets[node]; edge < successorOffsets[node + 1]; ++edge)
+        {
+            if (--inDegree[successors[edge]] == 0)
+            {
+                order.push_back(successors[edge]);
+            }
+        }
+    }
+
+    cycleFound = order.size() != count;
+    topologicalOrderValid = true;
+    scheduleValid = false;
+
+    return !cycleFound;
+}
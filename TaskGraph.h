@@ -0,0 +1,92 @@
+#ifndef TASKGRAPH_H_
+#define TASKGRAPH_H_
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/*
+ * In memory analysis of the task dependency graph. The graph is stored in compressed sparse row
+ * (CSR) form, each task is a node and each edge goes from a dependency to the task that depends
+ * on it. Node indexes are 32 bit to keep the adjacency arrays compact for very large graphs.
+ *
+ * Edge changes are kept in a small overlay and merged into the CSR arrays the next time an
+ * analysis is requested, adding an edge is rejected if it would create a cycle.
+ */
+class TaskGraph
+{
+public:
+    struct Edge
+    {
+        std::size_t taskID;
+        std::size_t dependency;
+    };
+
+    TaskGraph() = default;
+    TaskGraph(const std::vector<std::size_t>& taskIDs, const std::vector<unsigned int>& effortHours,
+        const std::vector<Edge>& edges);
+    ~TaskGraph() = default;
+
+    void build(const std::vector<std::size_t>& taskIDs, const std::vector<unsigned int>& effortHours,
+        const std::vector<Edge>& edges);
+    std::size_t nodeCount() const { return nodeTaskIDs.size(); };
+    std::size_t edgeCount() const { return successors.size() + addedEdgeCount - removedEdges.size(); };
+    std::size_t ignoredEdgeCount() const { return ignoredEdges; };
+    bool hasTask(std::size_t taskID) const { return findNode(taskID).has_value(); };
+
+    bool addEdge(std::size_t taskID, std::size_t dependency);
+    bool removeEdge(std::size_t taskID, std::size_t dependency);
+    bool setEffort(std::size_t taskID, unsigned int effortHours);
+
+    bool hasCycle();
+    std::vector<std::size_t> findCycle();
+    std::optional<std::vector<std::size_t>> topologicalOrder();
+
+/*
+ * Critical path method, all times are in hours measured from the start of the graph. The
+ * schedule is computed on demand and cached until the graph changes.
+ */
+    bool computeSchedule();
+    double getProjectDuration();
+    std::optional<double> getEarliestStart(std::size_t taskID);
+    std::optional<double> getLatestStart(std::size_t taskID);
+    std::optional<double> getSlack(std::size_t taskID);
+    std::vector<std::size_t> getCriticalPath();
+
+private:
+    using NodeIndex = std::uint32_t;
+
+    std::optional<NodeIndex> findNode(std::size_t taskID) const;
+    static std::uint64_t edgeKey(NodeIndex from, NodeIndex to)
+        { return (static_cast<std::uint64_t>(from) << 32) | to; };
+    void buildAdjacency(const std::vector<std::pair<NodeIndex, NodeIndex>>& nodeEdges);
+    void compactPendingEdges();
+    bool hasEdge(NodeIndex from, NodeIndex to) const;
+    bool reaches(NodeIndex from, NodeIndex to) const;
+    bool sortTopologically();
+
+    std::vector<std::size_t> nodeTaskIDs;
+    std::vector<NodeIndex> denseNodeIndex;
+    std::vector<float> nodeEffort;
+    std::vector<NodeIndex> successorOffsets;
+    std::vector<NodeIndex> successors;
+    std::size_t ignoredEdges = 0;
+
+    std::unordered_map<NodeIndex, std::vector<NodeIndex>> addedEdges;
+    std::size_t addedEdgeCount = 0;
+    std::unordered_set<std::uint64_t> removedEdges;
+
+    bool topologicalOrderValid = false;
+    bool cycleFound = false;
+    std::vector<NodeIndex> order;
+
+    bool scheduleValid = false;
+    double projectDuration = 0.0;
+    std::vector<double> earliestStart;
+    std::vector<double> latestStart;
+};
+
+#endif // TASKGRAPH_H_
@@ -1,11 +1,13 @@
 #include <chrono>
 #include "commonUtilities.h"
+#include "CompactDate.h"
 #include "GenericDictionary.h"
 #include <iostream>
 #include <memory>
 #include <string>
 #include "TaskModel.h"
 #include "UserModel.h"
+#include <utility>
 #include <vector>
 
 static const TaskModel::TaskStatus UnknowStatus = static_cast<TaskModel::TaskStatus>(-1);
@@ -33,8 +35,7 @@ TaskModel::TaskModel()
   priority{0},
   personal{false}
 {
-    std::chrono::year_month_day today = getTodaysDate();
-    setCreationDate(today);
+    setCreationDate(getTodaysCompactDate());
 }
 
 TaskModel::TaskModel(UserModel_shp creator)
@@ -71,7 +72,7 @@ void TaskModel::addEffortHours(double hours)
 
 std::chrono::year_month_day TaskModel::getactualStartDate() const
 {
-    return actualStartDate.value_or(std::chrono::year_month_day());
+    return actualStartDate.toYearMonthDay();
 }
 
 std::chrono::year_month_day TaskModel::getEstimatedCompletion() const
@@ -120,37 +121,37 @@ void TaskModel::setPercentageComplete(double inPercentComplete)
     percentageComplete = inPercentComplete;
 }
 
-void TaskModel::setCreationDate(std::chrono::year_month_day inCreationDate)
+void TaskModel::setCreationDate(CompactDate inCreationDate)
 {
     modified = true;
     creationDate = inCreationDate;
 }
 
-void TaskModel::setDueDate(std::chrono::year_month_day inDueDate)
+void TaskModel::setDueDate(CompactDate inDueDate)
 {
     modified = true;
     dueDate = inDueDate;
 }
 
-void TaskModel::setScheduledStart(std::chrono::year_month_day startDate)
+void TaskModel::setScheduledStart(CompactDate startDate)
 {
     modified = true;
     scheduledStart = startDate;
 }
 
-void TaskModel::setactualStartDate(std::chrono::year_month_day startDate)
+void TaskModel::setactualStartDate(CompactDate startDate)
 {
     modified = true;
     actualStartDate = startDate;
 }
 
-void TaskModel::setEstimatedCompletion(std::chrono::year_month_day completionDate)
+void TaskModel::setEstimatedCompletion(CompactDate completionDate)
 {
     modified = true;
     estimatedCompletion = completionDate;
 }
 
-void TaskModel::setCompletionDate(std::chrono::year_month_day inCompletionDate)
+void TaskModel::setCompletionDate(CompactDate inCompletionDate)
 {
     modified = true;
     completionDate = inCompletionDate;
@@ -198,6 +199,18 @@ void TaskModel::addDependency(std::size_t taskId)
     dependencies.push_back(taskId);
 }
 
+void TaskModel::removeDependency(std::size_t taskId)
+{
+    modified = true;
+    std::erase(dependencies, taskId);
+}
+
+void TaskModel::setDependencies(std::vector<std::size_t> newDependencies)
+{
+    modified = true;
+    dependencies = std::move(newDependencies);
+}
+
 void TaskModel::setTaskID(std::size_t newID)
 {
     modified = true;
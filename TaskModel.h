@@ -2,6 +2,8 @@
 #define TASKMODEL_H_
 
 #include <chrono>
+#include "commonUtilities.h"
+#include "CompactDate.h"
 #include <format>
 #include <iostream>
 #include <memory>
@@ -30,7 +32,7 @@ public:
     void addEffortHours(double hours);
     void markComplete()
     {
-        setCompletionDate(getTodaysDate());
+        setCompletionDate(getTodaysCompactDate());
         setStatus(TaskModel::TaskStatus::Complete);
     }
     std::size_t getTaskID() const { return taskID; };
@@ -39,23 +41,33 @@ public:
     std::string getDescription() const { return description; };
     TaskModel::TaskStatus getStatus() const { return status.value_or(TaskModel::TaskStatus::Not_Started); };
     unsigned int getStatusIntVal() const { return static_cast<unsigned int>(getStatus()); };
+    std::optional<TaskModel::TaskStatus> rawStatus() const { return status; };
     std::size_t getParentTaskID() const { return parentTaskID.value_or(0); };
     std::optional<std::size_t> rawParentTaskID() const { return parentTaskID; };
     double getPercentageComplete() const { return percentageComplete; };
-    std::chrono::year_month_day getCreationDate() const { return creationDate; };
-    std::chrono::year_month_day getDueDate() const { return dueDate; };
-    std::chrono::year_month_day getScheduledStart() const { return scheduledStart; };
+    std::chrono::year_month_day getCreationDate() const { return creationDate.toYearMonthDay(); };
+    std::chrono::year_month_day getDueDate() const { return dueDate.toYearMonthDay(); };
+    std::chrono::year_month_day getScheduledStart() const { return scheduledStart.toYearMonthDay(); };
     std::chrono::year_month_day getactualStartDate() const;
-    std::optional<std::chrono::year_month_day> rawActualStartDate() const { return actualStartDate; };
+    std::optional<std::chrono::year_month_day> rawActualStartDate() const { return actualStartDate.toOptional(); };
     std::chrono::year_month_day getEstimatedCompletion() const;
-    std::optional<std::chrono::year_month_day> rawEstimatedCompletion() const { return estimatedCompletion; };
+    std::optional<std::chrono::year_month_day> rawEstimatedCompletion() const { return estimatedCompletion.toOptional(); };
     std::chrono::year_month_day getCompletionDate() const ;
-    std::optional<std::chrono::year_month_day> rawCompletionDate() const { return completionDate; };
+    std::optional<std::chrono::year_month_day> rawCompletionDate() const { return completionDate.toOptional(); };
+/*
+ * The dates without conversion to year_month_day, for comparisons and database conversions.
+ */
+    CompactDate getCompactCreationDate() const { return creationDate; };
+    CompactDate getCompactDueDate() const { return dueDate; };
+    CompactDate getCompactScheduledStart() const { return scheduledStart; };
+    CompactDate getCompactActualStartDate() const { return actualStartDate; };
+    CompactDate getCompactEstimatedCompletion() const { return estimatedCompletion; };
+    CompactDate getCompactCompletionDate() const { return completionDate; };
     unsigned int getEstimatedEffort() const { return estimatedEffort; };
     double getactualEffortToDate() const { return actualEffortToDate; };
     unsigned int getPriorityGroup() const { return priorityGroup; };
     unsigned int getPriority() const { return priority; };
-    std::vector<std::size_t> getDependencies() { return dependencies; };
+    std::vector<std::size_t> getDependencies() const { return dependencies; };
     bool isPersonal() const { return personal; };
     void setCreatorID(std::size_t creatorID);
     void setCreatorID(UserModel_shp creator) { setCreatorID(creator->getUserID()); };
@@ -67,12 +79,12 @@ public:
     void setParentTaskID(std::size_t parentTaskID);
     void setParentTaskID(std::shared_ptr<TaskModel> parentTask) { setParentTaskID(parentTask->getTaskID()); };
     void setPercentageComplete(double percentComplete);
-    void setCreationDate(std::chrono::year_month_day creationDate);
-    void setDueDate(std::chrono::year_month_day dueDate);
-    void setScheduledStart(std::chrono::year_month_day startDate);
-    void setactualStartDate(std::chrono::year_month_day startDate);
-    void setEstimatedCompletion(std::chrono::year_month_day completionDate);
-    void setCompletionDate(std::chrono::year_month_day completionDate);
+    void setCreationDate(CompactDate creationDate);
+    void setDueDate(CompactDate dueDate);
+    void setScheduledStart(CompactDate startDate);
+    void setactualStartDate(CompactDate startDate);
+    void setEstimatedCompletion(CompactDate completionDate);
+    void setCompletionDate(CompactDate completionDate);
     void setEstimatedEffort(unsigned int estimatedHours);
     void setActualEffortToDate(double effortHoursYTD);
     void setPriorityGroup(unsigned int priorityGroup);
@@ -82,6 +94,10 @@ public:
     void addDependency(std::size_t taskId);
     void addDependency(TaskModel& dependency) { addDependency(dependency.getTaskID()); };
     void addDependency(std::shared_ptr<TaskModel> dependency) { addDependency(dependency->getTaskID()); };
+    void removeDependency(std::size_t taskId);
+    void removeDependency(TaskModel& dependency) { removeDependency(dependency.getTaskID()); };
+    void removeDependency(std::shared_ptr<TaskModel> dependency) { removeDependency(dependency->getTaskID()); };
+    void setDependencies(std::vector<std::size_t> newDependencies);
     void setTaskID(std::size_t newID);
     std::string taskStatusString() const;
     TaskModel::TaskStatus stringToStatus(std::string statusName) const;
@@ -104,9 +120,9 @@ public:
         os << std::format(outFmtStr, "Assigned To ID", task.assignToID);
         os << std::format(outFmtStr, "Description", task.description);
         os << std::format(outFmtStr, "Percentage Complete", task.percentageComplete);
-        os << std::format(outFmtStr, "Creation Date", task.creationDate);
-        os << std::format(outFmtStr, "Scheduled Start Date", task.scheduledStart);
-        os << std::format(outFmtStr, "Due Date", task.dueDate);
+        os << std::format(outFmtStr, "Creation Date", task.getCreationDate());
+        os << std::format(outFmtStr, "Scheduled Start Date", task.getScheduledStart());
+        os << std::format(outFmtStr, "Due Date", task.getDueDate());
 
         os << "Optional Fields\n";
         if (task.status.has_value())
@@ -117,17 +133,17 @@ public:
         {
             os << std::format(outFmtStr, "Parent ID", task.parentTaskID.value());
         }
-        if (task.actualStartDate.has_value())
+        if (task.actualStartDate.hasValue())
         {
-            os << std::format(outFmtStr, "Actual Start Date", task.actualStartDate.value());
+            os << std::format(outFmtStr, "Actual Start Date", task.actualStartDate.toYearMonthDay());
         }
-        if (task.estimatedCompletion.has_value())
+        if (task.estimatedCompletion.hasValue())
         {
-            os << std::format(outFmtStr, "Estimated Completion Date", task.estimatedCompletion.value());
+            os << std::format(outFmtStr, "Estimated Completion Date", task.estimatedCompletion.toYearMonthDay());
         }
-        if (task.completionDate.has_value())
+        if (task.completionDate.hasValue())
         {
-            os << std::format(outFmtStr, "Completed Date", task.completionDate.value());
+            os << std::format(outFmtStr, "Completed Date", task.completionDate.toYearMonthDay());
         }
 
         return os;
@@ -146,12 +162,12 @@ private:
     std::optional<TaskStatus> status;
     std::optional<std::size_t> parentTaskID;
     double percentageComplete;
-    std::chrono::year_month_day creationDate;
-    std::chrono::year_month_day dueDate;
-    std::chrono::year_month_day scheduledStart;
-    std::optional<std::chrono::year_month_day> actualStartDate;
-    std::optional<std::chrono::year_month_day> estimatedCompletion;
-    std::optional<std::chrono::year_month_day> completionDate;
+    CompactDate creationDate;
+    CompactDate dueDate;
+    CompactDate scheduledStart;
+    CompactDate actualStartDate;
+    CompactDate estimatedCompletion;
+    CompactDate completionDate;
     unsigned int estimatedEffort;
     double actualEffortToDate;
     unsigned int priorityGroup;
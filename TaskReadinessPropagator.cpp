@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <string>
+#include "TaskDbInterface.h"
+#include "TaskModel.h"
+#include "TaskReadinessPropagator.h"
+#include <vector>
+
+TaskReadinessPropagator::TaskReadinessPropagator(TaskDbInterface& taskDbInterfaceIn)
+: taskDbInterface{taskDbInterfaceIn}
+{
+}
+
+void TaskReadinessPropagator::taskCompleted(std::size_t taskID)
+{
+    pendingCompletions.push_back(taskID);
+}
+
+void TaskReadinessPropagator::taskCompleted(TaskModel& task)
+{
+    if (task.getStatus() != TaskModel::TaskStatus::Complete)
+    {
+        task.markComplete();
+    }
+
+    taskCompleted(task.getTaskID());
+}
+
+/*
+ * The pending events are only discarded when the database update succeeds, a failed
+ * propagation can be retried by calling propagate() again.
+ */
+std::vector<std::size_t> TaskReadinessPropagator::propagate()
+{
+    errorMessages.clear();
+
+    std::ranges::sort(pendingCompletions);
+    auto [duplicatesStart, duplicatesEnd] = std::ranges::unique(pendingCompletions);
+    pendingCompletions.erase(duplicatesStart, duplicatesEnd);
+
+    std::vector<std::size_t> releasedTaskIDs = taskDbInterface.completeTasksAndReleaseDependents(pendingCompletions);
+
+    errorMessages = taskDbInterface.getAllErrorMessages();
+    if (!errorMessages.empty())
+    {
+        return releasedTaskIDs;
+    }
+
+    pendingCompletions.clear();
+
+    if (releasedTaskListener)
+    {
+        for (auto releasedTaskID: releasedTaskIDs)
+        {
+            releasedTaskListener(releasedTaskID);
+        }
+    }
+
+    return releasedTaskIDs;
+}
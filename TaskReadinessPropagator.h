@@ -0,0 +1,37 @@
+#ifndef TASKREADINESSPROPAGATOR_H_
+#define TASKREADINESSPROPAGATOR_H_
+
+#include <functional>
+#include <string>
+#include "TaskDbInterface.h"
+#include "TaskModel.h"
+#include <vector>
+
+/*
+ * Collects task completion events and propagates them to the tasks waiting on the completed
+ * tasks. Events are queued until propagate() is called so that a burst of completions is
+ * written with one batched update rather than one update per completed task.
+ */
+class TaskReadinessPropagator
+{
+public:
+    using ReleasedTaskListener = std::function<void(std::size_t releasedTaskID)>;
+
+    TaskReadinessPropagator(TaskDbInterface& taskDbInterface);
+    ~TaskReadinessPropagator() = default;
+    void taskCompleted(std::size_t taskID);
+    void taskCompleted(TaskModel& task);
+    void taskCompleted(TaskModel_shp task) { taskCompleted(*task); };
+    void setReleasedTaskListener(ReleasedTaskListener listener) { releasedTaskListener = listener; };
+    bool hasPendingEvents() const { return !pendingCompletions.empty(); };
+    std::vector<std::size_t> propagate();
+    std::string getAllErrorMessages() const { return errorMessages; };
+
+private:
+    TaskDbInterface& taskDbInterface;
+    std::vector<std::size_t> pendingCompletions;
+    ReleasedTaskListener releasedTaskListener;
+    std::string errorMessages;
+};
+
+#endif // TASKREADINESSPROPAGATOR_H_
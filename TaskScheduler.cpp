@@ -0,0 +1,712 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "commonUtilities.h"
+#include <cstdint>
+#include "ScheduleItemModel.h"
+#include <string>
+#include "TaskModel.h"
+#include "TaskScheduler.h"
+#include <unordered_map>
+#include "UserModel.h"
+#include <utility>
+#include <vector>
+
+static constexpr std::chrono::minutes DefaultDayStart = std::chrono::hours(8) + std::chrono::minutes(30);
+static constexpr std::chrono::minutes DefaultDayEnd = std::chrono::hours(17);
+static constexpr std::int64_t MinutesPerDay = 24 * 60;
+
+TaskScheduler::TaskScheduler(std::size_t userIDIn, WorkingHours workingHoursIn)
+: userID{userIDIn},
+  workingHours{workingHoursIn}
+{
+}
+
+TaskScheduler::TaskScheduler(UserModel& user)
+: userID{user.getUserID()},
+  workingHours{parseTimeOfDay(user.getStartTime()).value_or(DefaultDayStart),
+      parseTimeOfDay(user.getEndTime()).value_or(DefaultDayEnd), false}
+{
+}
+
+TaskScheduler::ScheduleResult TaskScheduler::schedule(const TaskList& openTasks, const ScheduleItemList& fixedItems,
+    std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay)
+{
+    std::chrono::sys_days windowStart = firstDay;
+    Minutes windowStartMinutes = windowStart.time_since_epoch().count() * MinutesPerDay;
+
+    buildFreeSlots(fixedItems, windowStart, lastDay);
+    prepareTasks(openTasks, windowStartMinutes);
+    placements.clear();
+    instantFinishes.clear();
+    placeTasks(windowStartMinutes);
+
+    hasSchedule = true;
+    scheduledFirstDay = firstDay;
+    scheduledLastDay = lastDay;
+    recomputedFrom = windowStartMinutes;
+
+    return collectResult(openTasks);
+}
+
+TaskScheduler::ScheduleResult TaskScheduler::reschedule(const TaskList& openTasks, const ScheduleItemList& fixedItems,
+    std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay)
+{
+    if (!hasSchedule || firstDay != scheduledFirstDay || lastDay != scheduledLastDay)
+    {
+        return schedule(openTasks, fixedItems, firstDay, lastDay);
+    }
+
+    std::chrono::sys_days windowStart = firstDay;
+    Minutes windowStartMinutes = windowStart.time_since_epoch().count() * MinutesPerDay;
+    Minutes windowEndMinutes = (std::chrono::sys_days(lastDay) + std::chrono::days(1)).time_since_epoch().count() * MinutesPerDay;
+
+    PreviousRun previous = takePreviousRun();
+    buildFreeSlots(fixedItems, windowStart, lastDay);
+    prepareTasks(openTasks, windowStartMinutes);
+    mapPreviousTasks(previous);
+
+    Minutes cut = findFirstChange(previous);
+    restorePrefix(previous, cut);
+    placeTasks(cut);
+
+    recomputedFrom = std::clamp(cut, windowStartMinutes, windowEndMinutes);
+
+    return collectResult(openTasks);
+}
+
+std::vector<std::chrono::year_month_day> TaskScheduler::getWorkingDays(std::chrono::year_month_day firstDay,
+    std::chrono::year_month_day lastDay) const
+{
+    std::vector<std::chrono::year_month_day> workingDays;
+
+    for (std::chrono::sys_days day = firstDay; day <= std::chrono::sys_days(lastDay); day += std::chrono::days(1))
+    {
+        if (isWorkingDay(day))
+        {
+            workingDays.push_back(day);
+        }
+    }
+
+    return workingDays;
+}
+
+/*
+ * Private methods.
+ */
+bool TaskScheduler::isWorkingDay(std::chrono::sys_days day) const
+{
+    std::chrono::weekday dayOfWeek(day);
+    return workingHours.includeWeekends || (dayOfWeek != std::chrono::Saturday && dayOfWeek != std::chrono::Sunday);
+}
+
+/*
+ * The free slots are the working hours of each working day with the fixed schedule items cut
+ * out. Previously generated task execution items are not fixed, they are replaced.
+ */
+void TaskScheduler::buildFreeSlots(const ScheduleItemList& fixedItems, std::chrono::sys_days firstDay,
+    std::chrono::sys_days lastDay)
+{
+    busyTimes.clear();
+    busyTimes.reserve(fixedItems.size());
+    for (const auto& item: fixedItems)
+    {
+        if (!item.isGeneratedTaskExecution())
+        {
+            busyTimes.push_back({item.getStartTime().time_since_epoch().count(), item.getEndTime().time_since_epoch().count()});
+        }
+    }
+    std::ranges::sort(busyTimes, {}, [](const FreeSlot& busy) { return std::pair(busy.start, busy.end); });
+
+    freeSlots.clear();
+    auto nextBusy = busyTimes.begin();
+    for (std::chrono::sys_days day = firstDay; day <= lastDay; day += std::chrono::days(1))
+    {
+        if (!isWorkingDay(day))
+        {
+            continue;
+        }
+
+        Minutes midnight = day.time_since_epoch().count() * MinutesPerDay;
+        Minutes freeStart = midnight + workingHours.dayStart.count();
+        Minutes dayEnd = midnight + workingHours.dayEnd.count();
+
+        while (nextBusy != busyTimes.end() && nextBusy->end <= freeStart)
+        {
+            ++nextBusy;
+        }
+
+        for (auto blocked = nextBusy; blocked != busyTimes.end() && blocked->start < dayEnd; ++blocked)
+        {
+            if (blocked->start > freeStart)
+            {
+                freeSlots.push_back({freeStart, blocked->start});
+            }
+            freeStart = std::max(freeStart, blocked->end);
+        }
+
+        if (freeStart < dayEnd)
+        {
+            freeSlots.push_back({freeStart, dayEnd});
+        }
+    }
+}
+
+/*
+ * Completed tasks and tasks on hold are not scheduled. Dependencies on tasks that are not
+ * being scheduled are considered satisfied.
+ */
+void TaskScheduler::prepareTasks(const TaskList& openTasks, Minutes windowStart)
+{
+    sourceIndexes.clear();
+    taskIDs.clear();
+    priorityGroups.clear();
+    priorities.clear();
+    dueDays.clear();
+    baseReleaseTimes.clear();
+    initialMinutes.clear();
+
+    std::unordered_map<std::size_t, TaskIndex> taskIndexes;
+    taskIndexes.reserve(openTasks.size());
+
+    for (std::uint32_t source = 0; source < openTasks.size(); ++source)
+    {
+        const TaskModel& task = *openTasks[source];
+        TaskModel::TaskStatus status = task.getStatus();
+        if (status == TaskModel::TaskStatus::Complete || status == TaskModel::TaskStatus::On_Hold)
+        {
+            continue;
+        }
+
+        taskIndexes[task.getTaskID()] = static_cast<TaskIndex>(taskIDs.size());
+        sourceIndexes.push_back(source);
+        taskIDs.push_back(task.getTaskID());
+        priorityGroups.push_back(task.getPriorityGroup());
+        priorities.push_back(task.getPriority());
+        dueDays.push_back(std::chrono::sys_days(task.getDueDate()).time_since_epoch().count());
+
+        Minutes scheduledStart = std::chrono::sys_days(task.getScheduledStart()).time_since_epoch().count() * MinutesPerDay;
+        baseReleaseTimes.push_back(std::max(windowStart, scheduledStart));
+
+        double remainingHours = task.getEstimatedEffort() - task.getactualEffortToDate();
+        initialMinutes.push_back(std::max<Minutes>(0, std::llround(remainingHours * 60.0)));
+    }
+
+    const std::size_t count = taskIDs.size();
+    releaseTimes = baseReleaseTimes;
+    remainingMinutes = initialMinutes;
+    firstStarts.assign(count, Never);
+    finishTimes.assign(count, Never);
+    unmetDependencies.assign(count, 0);
+    dependentOffsets.assign(count + 1, 0);
+    dependencyOffsets.assign(count + 1, 0);
+
+    std::vector<std::pair<TaskIndex, TaskIndex>> edges;
+    for (TaskIndex task = 0; task < count; ++task)
+    {
+        for (auto dependencyID: openTasks[sourceIndexes[task]]->getDependencies())
+        {
+            auto dependency = taskIndexes.find(dependencyID);
+            if (dependency != taskIndexes.end() && dependency->second != task)
+            {
+                edges.emplace_back(dependency->second, task);
+                ++unmetDependencies[task];
+                ++dependentOffsets[dependency->second + 1];
+            }
+        }
+        dependencyOffsets[task + 1] = static_cast<TaskIndex>(edges.size());
+    }
+
+    for (std::size_t task = 0; task < count; ++task)
+    {
+        dependentOffsets[task + 1] += dependentOffsets[task];
+    }
+
+    dependents.resize(edges.size());
+    dependencies.resize(edges.size());
+    std::vector<TaskIndex> insertPosition(dependentOffsets.begin(), dependentOffsets.end() - 1);
+    for (TaskIndex edge = 0; edge < edges.size(); ++edge)
+    {
+        auto [dependency, task] = edges[edge];
+        dependents[insertPosition[dependency]++] = task;
+        dependencies[edge] = dependency;
+    }
+
+    // Sorted by task ID so the dependencies of a task can be compared between runs.
+    for (TaskIndex task = 0; task < count; ++task)
+    {
+        std::sort(dependencies.begin() + dependencyOffsets[task], dependencies.begin() + dependencyOffsets[task + 1],
+            [this](TaskIndex a, TaskIndex b) { return taskIDs[a] < taskIDs[b]; });
+    }
+}
+
+bool TaskScheduler::higherPriority(TaskIndex a, TaskIndex b) const
+{
+    if (priorityGroups[a] != priorityGroups[b])
+    {
+        return priorityGroups[a] < priorityGroups[b];
+    }
+    if (priorities[a] != priorities[b])
+    {
+        return priorities[a] < priorities[b];
+    }
+    if (dueDays[a] != dueDays[b])
+    {
+        return dueDays[a] < dueDays[b];
+    }
+    return taskIDs[a] < taskIDs[b];
+}
+
+/*
+ * Two heaps drive the placement, the ready heap is ordered by priority and the waiting heap
+ * by release time. A placement ends at the end of the free slot, when the task is finished,
+ * or when a waiting task is released, so a newly released higher priority task can take over.
+ */
+void TaskScheduler::placeTasks(Minutes resumeAt)
+{
+    auto lowerPriority = [this](TaskIndex a, TaskIndex b) { return higherPriority(b, a); };
+    auto laterRelease = [this](TaskIndex a, TaskIndex b) { return releaseTimes[a] > releaseTimes[b]; };
+
+    std::vector<TaskIndex> readyHeap;
+    std::vector<TaskIndex> waitingHeap;
+    for (TaskIndex task = 0; task < taskIDs.size(); ++task)
+    {
+        if (unmetDependencies[task] == 0 && finishTimes[task] == Never)
+        {
+            waitingHeap.push_back(task);
+        }
+    }
+    std::ranges::make_heap(waitingHeap, laterRelease);
+
+    std::size_t slot = std::ranges::upper_bound(freeSlots, resumeAt, {}, &FreeSlot::end) - freeSlots.begin();
+    Minutes now = slot < freeSlots.size()? std::max(resumeAt, freeSlots[slot].start) : resumeAt;
+
+    while (slot < freeSlots.size())
+    {
+        while (!waitingHeap.empty() && releaseTimes[waitingHeap.front()] <= now)
+        {
+            std::ranges::pop_heap(waitingHeap, laterRelease);
+            readyHeap.push_back(waitingHeap.back());
+            waitingHeap.pop_back();
+            std::ranges::push_heap(readyHeap, lowerPriority);
+        }
+
+        if (readyHeap.empty())
+        {
+            if (waitingHeap.empty())
+            {
+                break;
+            }
+
+            now = releaseTimes[waitingHeap.front()];
+            while (slot < freeSlots.size() && freeSlots[slot].end <= now)
+            {
+                ++slot;
+            }
+            if (slot < freeSlots.size())
+            {
+                now = std::max(now, freeSlots[slot].start);
+            }
+            continue;
+        }
+
+        TaskIndex task = readyHeap.front();
+        Minutes end = std::min(freeSlots[slot].end, now + remainingMinutes[task]);
+        if (!waitingHeap.empty() && releaseTimes[waitingHeap.front()] > now)
+        {
+            end = std::min(end, releaseTimes[waitingHeap.front()]);
+        }
+
+        if (end > now)
+        {
+            emitPlacement(task, now, end);
+            remainingMinutes[task] -= end - now;
+            now = end;
+        }
+
+        if (remainingMinutes[task] == 0)
+        {
+            std::ranges::pop_heap(readyHeap, lowerPriority);
+            readyHeap.pop_back();
+            finishTimes[task] = now;
+            if (initialMinutes[task] == 0)
+            {
+                instantFinishes.push_back({task, now, now});
+            }
+
+            for (TaskIndex edge = dependentOffsets[task]; edge < dependentOffsets[task + 1]; ++edge)
+            {
+                TaskIndex dependent = dependents[edge];
+                if (--unmetDependencies[dependent] == 0)
+                {
+                    releaseTimes[dependent] = std::max(releaseTimes[dependent], now);
+                    waitingHeap.push_back(dependent);
+                    std::ranges::push_heap(waitingHeap, laterRelease);
+                }
+            }
+        }
+
+        if (now >= freeSlots[slot].end)
+        {
+            ++slot;
+            if (slot < freeSlots.size())
+            {
+                now = freeSlots[slot].start;
+            }
+        }
+    }
+}
+
+/*
+ * Consecutive placements of the same task are merged into one schedule item.
+ */
+void TaskScheduler::emitPlacement(TaskIndex task, Minutes start, Minutes end)
+{
+    firstStarts[task] = std::min(firstStarts[task], start);
+
+    if (!placements.empty() && placements.back().task == task && placements.back().end == start)
+    {
+        placements.back().end = end;
+        return;
+    }
+
+    placements.push_back({task, start, end});
+}
+
+TaskScheduler::ScheduleResult TaskScheduler::collectResult(const TaskList& openTasks) const
+{
+    ScheduleResult result;
+
+    result.taskExecutionItems.reserve(placements.size());
+    for (auto placement: placements)
+    {
+        std::string title = openTasks[sourceIndexes[placement.task]]->getDescription();
+        if (title.size() > MaxTitleLength)
+        {
+            // Descriptions are UTF-8, a cut before a continuation byte would split a character.
+            std::size_t titleLength = MaxTitleLength;
+            while (titleLength > 0 && (static_cast<unsigned char>(title[titleLength]) & 0xC0) == 0x80)
+            {
+                --titleLength;
+            }
+            title.resize(titleLength);
+        }
+
+        ScheduleItemModel item(userID, ScheduleTime(std::chrono::minutes(placement.start)),
+            ScheduleTime(std::chrono::minutes(placement.end)), ScheduleItemModel::ScheduleItemType::Task_Execution, title);
+        item.setTaskID(taskIDs[placement.task]);
+        result.taskExecutionItems.push_back(item);
+    }
+
+    for (TaskIndex task = 0; task < taskIDs.size(); ++task)
+    {
+        if (remainingMinutes[task] > 0 || unmetDependencies[task] > 0)
+        {
+            result.unscheduledTaskIDs.push_back(taskIDs[task]);
+        }
+    }
+
+    return result;
+}
+
+TaskScheduler::PreviousRun TaskScheduler::takePreviousRun()
+{
+    PreviousRun previous;
+
+    previous.taskIDs = std::move(taskIDs);
+    previous.priorityGroups = std::move(priorityGroups);
+    previous.priorities = std::move(priorities);
+    previous.dueDays = std::move(dueDays);
+    previous.baseReleaseTimes = std::move(baseReleaseTimes);
+    previous.releaseTimes = std::move(releaseTimes);
+    previous.initialMinutes = std::move(initialMinutes);
+    previous.unmetDependencies = std::move(unmetDependencies);
+    previous.firstStarts = std::move(firstStarts);
+    previous.finishTimes = std::move(finishTimes);
+    previous.dependencyOffsets = std::move(dependencyOffsets);
+    previous.dependencies = std::move(dependencies);
+    previous.placements = std::move(placements);
+    previous.instantFinishes = std::move(instantFinishes);
+    previous.busyTimes = std::move(busyTimes);
+
+    return previous;
+}
+
+void TaskScheduler::mapPreviousTasks(PreviousRun& previous) const
+{
+    std::unordered_map<std::size_t, TaskIndex> previousIndexes;
+    previousIndexes.reserve(previous.taskIDs.size());
+    for (TaskIndex previousTask = 0; previousTask < previous.taskIDs.size(); ++previousTask)
+    {
+        previousIndexes[previous.taskIDs[previousTask]] = previousTask;
+    }
+
+    previous.toCurrent.assign(previous.taskIDs.size(), NoTask);
+    previous.fromCurrent.assign(taskIDs.size(), NoTask);
+    for (TaskIndex task = 0; task < taskIDs.size(); ++task)
+    {
+        auto found = previousIndexes.find(taskIDs[task]);
+        if (found != previousIndexes.end())
+        {
+            previous.fromCurrent[task] = found->second;
+            previous.toCurrent[found->second] = task;
+        }
+    }
+}
+
+bool TaskScheduler::sameDependencies(const PreviousRun& previous, TaskIndex previousTask, TaskIndex task) const
+{
+    TaskIndex previousEdge = previous.dependencyOffsets[previousTask];
+    TaskIndex edge = dependencyOffsets[task];
+
+    if (previous.dependencyOffsets[previousTask + 1] - previousEdge != dependencyOffsets[task + 1] - edge)
+    {
+        return false;
+    }
+
+    for ( ; edge < dependencyOffsets[task + 1]; ++edge, ++previousEdge)
+    {
+        if (previous.taskIDs[previous.dependencies[previousEdge]] != taskIDs[dependencies[edge]])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Returns the earliest point in time where the new schedule can differ from the previous one.
+ * Before a task is ready it has no effect on the placement. Once it is ready it only has an
+ * effect when it is placed, or when it would have been chosen over the task that was placed,
+ * or when there is idle free time it could have used. An effort change first has an effect when
+ * the task would finish at a different time.
+ */
+TaskScheduler::Minutes TaskScheduler::findFirstChange(const PreviousRun& previous) const
+{
+    Minutes cut = Never;
+
+    auto [previousBusy, currentBusy] = std::ranges::mismatch(previous.busyTimes, busyTimes);
+    if (previousBusy != previous.busyTimes.end())
+    {
+        cut = std::min(cut, previousBusy->start);
+    }
+    if (currentBusy != busyTimes.end())
+    {
+        cut = std::min(cut, currentBusy->start);
+    }
+
+    for (TaskIndex previousTask = 0; previousTask < previous.taskIDs.size(); ++previousTask)
+    {
+        if (previous.toCurrent[previousTask] == NoTask)
+        {
+            cut = std::min(cut, previous.firstStarts[previousTask]);
+        }
+    }
+
+    for (TaskIndex task = 0; task < taskIDs.size(); ++task)
+    {
+        TaskIndex previousTask = previous.fromCurrent[task];
+        if (previousTask == NoTask)
+        {
+            cut = std::min(cut, firstInfluence(previous, task, NoTask, estimateReadyTime(previous, task)));
+            continue;
+        }
+
+        bool priorityChanged = priorityGroups[task] != previous.priorityGroups[previousTask] ||
+            priorities[task] != previous.priorities[previousTask] || dueDays[task] != previous.dueDays[previousTask];
+        bool readinessChanged = baseReleaseTimes[task] != previous.baseReleaseTimes[previousTask] ||
+            !sameDependencies(previous, previousTask, task);
+        bool effortChanged = initialMinutes[task] != previous.initialMinutes[previousTask];
+
+        if (!priorityChanged && !readinessChanged && !effortChanged)
+        {
+            continue;
+        }
+
+        cut = std::min(cut, previous.finishTimes[previousTask]);
+
+        if (priorityChanged || readinessChanged)
+        {
+            Minutes previousReady = previous.unmetDependencies[previousTask] == 0? previous.releaseTimes[previousTask] : Never;
+            Minutes from = std::min(previousReady, estimateReadyTime(previous, task));
+            cut = std::min(cut, firstInfluence(previous, task, previousTask, from));
+        }
+
+        if (initialMinutes[task] < previous.initialMinutes[previousTask])
+        {
+            cut = std::min(cut, effortReachedTime(previous, previousTask, initialMinutes[task]));
+        }
+    }
+
+    return cut;
+}
+
+/*
+ * The dependencies finish at the same time as in the previous run until the first change, so
+ * their previous finish times give the ready time for a changed task up to that point.
+ */
+TaskScheduler::Minutes TaskScheduler::estimateReadyTime(const PreviousRun& previous, TaskIndex task) const
+{
+    Minutes readyTime = baseReleaseTimes[task];
+
+    for (TaskIndex edge = dependencyOffsets[task]; edge < dependencyOffsets[task + 1]; ++edge)
+    {
+        TaskIndex previousDependency = previous.fromCurrent[dependencies[edge]];
+        if (previousDependency == NoTask || previous.finishTimes[previousDependency] == Never)
+        {
+            return Never;
+        }
+        readyTime = std::max(readyTime, previous.finishTimes[previousDependency]);
+    }
+
+    return readyTime;
+}
+
+TaskScheduler::Minutes TaskScheduler::firstInfluence(const PreviousRun& previous, TaskIndex task,
+    TaskIndex previousTask, Minutes from) const
+{
+    if (from == Never)
+    {
+        return Never;
+    }
+
+    Minutes influence = Never;
+    auto finish = std::ranges::lower_bound(previous.instantFinishes, from, {}, &Placement::start);
+    for ( ; finish != previous.instantFinishes.end(); ++finish)
+    {
+        TaskIndex finished = previous.toCurrent[finish->task];
+        if (finish->task == previousTask || finished == NoTask || higherPriority(task, finished))
+        {
+            influence = finish->start;
+            break;
+        }
+    }
+
+    Minutes time = from;
+    auto placement = std::ranges::upper_bound(previous.placements, from, {}, &Placement::end);
+    for ( ; placement != previous.placements.end(); ++placement)
+    {
+        if (placement->start > time)
+        {
+            Minutes idle = firstFreeTime(time);
+            if (idle < placement->start)
+            {
+                return std::min(influence, idle);
+            }
+        }
+
+        TaskIndex placed = previous.toCurrent[placement->task];
+        if (placement->task == previousTask || placed == NoTask || higherPriority(task, placed))
+        {
+            return std::min(influence, std::max(placement->start, time));
+        }
+
+        time = placement->end;
+        if (time > influence)
+        {
+            return influence;
+        }
+    }
+
+    return std::min(influence, firstFreeTime(time));
+}
+
+TaskScheduler::Minutes TaskScheduler::effortReachedTime(const PreviousRun& previous, TaskIndex previousTask,
+    Minutes effort) const
+{
+    Minutes placedMinutes = 0;
+
+    for (auto placement: previous.placements)
+    {
+        if (placement.task != previousTask)
+        {
+            continue;
+        }
+
+        Minutes length = placement.end - placement.start;
+        if (placedMinutes + length >= effort)
+        {
+            return placement.start + (effort - placedMinutes);
+        }
+        placedMinutes += length;
+    }
+
+    return Never;
+}
+
+TaskScheduler::Minutes TaskScheduler::firstFreeTime(Minutes from) const
+{
+    auto slot = std::ranges::upper_bound(freeSlots, from, {}, &FreeSlot::end);
+    return slot == freeSlots.end()? Never : std::max(from, slot->start);
+}
+
+/*
+ * Keeps the previous placements that start before the cut and rebuilds the placement state at
+ * the cut: the minutes still to place, the tasks that have finished and the dependents they
+ * have released.
+ */
+void TaskScheduler::restorePrefix(const PreviousRun& previous, Minutes cut)
+{
+    placements.clear();
+    instantFinishes.clear();
+
+    std::vector<Minutes> placedMinutes(taskIDs.size(), 0);
+    for (auto placement: previous.placements)
+    {
+        if (placement.start >= cut)
+        {
+            break;
+        }
+
+        TaskIndex task = previous.toCurrent[placement.task];
+        Minutes end = std::min(placement.end, cut);
+        emitPlacement(task, placement.start, end);
+        placedMinutes[task] += end - placement.start;
+        if (placedMinutes[task] >= initialMinutes[task])
+        {
+            finishTimes[task] = end;
+        }
+    }
+
+    for (TaskIndex task = 0; task < taskIDs.size(); ++task)
+    {
+        remainingMinutes[task] = initialMinutes[task] - placedMinutes[task];
+
+        // Tasks without any effort left finish without being placed.
+        TaskIndex previousTask = previous.fromCurrent[task];
+        if (initialMinutes[task] == 0 && previousTask != NoTask && previous.finishTimes[previousTask] < cut)
+        {
+            finishTimes[task] = previous.finishTimes[previousTask];
+        }
+    }
+
+    for (auto finish: previous.instantFinishes)
+    {
+        if (finish.start >= cut)
+        {
+            break;
+        }
+
+        TaskIndex task = previous.toCurrent[finish.task];
+        if (task != NoTask && finishTimes[task] == finish.start)
+        {
+            instantFinishes.push_back({task, finish.start, finish.end});
+        }
+    }
+
+    for (TaskIndex task = 0; task < taskIDs.size(); ++task)
+    {
+        if (finishTimes[task] == Never)
+        {
+            continue;
+        }
+
+        for (TaskIndex edge = dependentOffsets[task]; edge < dependentOffsets[task + 1]; ++edge)
+        {
+            TaskIndex dependent = dependents[edge];
+            --unmetDependencies[dependent];
+            releaseTimes[dependent] = std::max(releaseTimes[dependent], finishTimes[task]);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#ifndef TASKSCHEDULER_H_
+#define TASKSCHEDULER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include "ScheduleItemModel.h"
+#include "TaskModel.h"
+#include "UserModel.h"
+#include <vector>
+
+/*
+ * Generates the "Task Execution" schedule items for one user. The open tasks are packed into
+ * the free time of the working day, the free time is the working hours less the existing fixed
+ * schedule items. Placement is greedy, at every point in time the highest priority task that
+ * is ready is placed, a task is ready when its scheduled start has been reached and all of its
+ * dependencies have been placed. Priority is SchedulePriorityGroup, then PriorityInGroup, then
+ * the required delivery date.
+ */
+class TaskScheduler
+{
+public:
+    using ScheduleTime = ScheduleItemModel::ScheduleTime;
+
+    struct WorkingHours
+    {
+        std::chrono::minutes dayStart;
+        std::chrono::minutes dayEnd;
+        bool includeWeekends;
+    };
+
+    struct ScheduleResult
+    {
+        ScheduleItemList taskExecutionItems;
+        std::vector<std::size_t> unscheduledTaskIDs;
+    };
+
+    TaskScheduler(std::size_t userID, WorkingHours workingHours);
+    TaskScheduler(UserModel& user);
+    ~TaskScheduler() = default;
+
+    ScheduleResult schedule(const TaskList& openTasks, const ScheduleItemList& fixedItems,
+        std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay);
+/*
+ * Incremental version of schedule(). The inputs are compared with the inputs of the previous
+ * call, the placements before the earliest point in time that any change can affect are kept
+ * and the greedy placement is restarted from that point. The result is the same as calling
+ * schedule(). Falls back to schedule() when there is no previous schedule or the window changed.
+ */
+    ScheduleResult reschedule(const TaskList& openTasks, const ScheduleItemList& fixedItems,
+        std::chrono::year_month_day firstDay, std::chrono::year_month_day lastDay);
+    ScheduleTime getRecomputedFrom() const { return ScheduleTime(std::chrono::minutes(recomputedFrom)); };
+    std::vector<std::chrono::year_month_day> getWorkingDays(std::chrono::year_month_day firstDay,
+        std::chrono::year_month_day lastDay) const;
+    WorkingHours getWorkingHours() const { return workingHours; };
+
+    static constexpr std::size_t MaxTitleLength = 128;
+
+private:
+    using TaskIndex = std::uint32_t;
+    using Minutes = std::int64_t;
+
+    static constexpr TaskIndex NoTask = std::numeric_limits<TaskIndex>::max();
+    static constexpr Minutes Never = std::numeric_limits<Minutes>::max();
+
+    struct FreeSlot
+    {
+        Minutes start;
+        Minutes end;
+
+        bool operator==(const FreeSlot& other) const = default;
+    };
+
+    struct Placement
+    {
+        TaskIndex task;
+        Minutes start;
+        Minutes end;
+    };
+
+/*
+ * The inputs and outcome of the previous run that reschedule() needs to find the first change,
+ * plus the mapping between the previous and current task indexes.
+ */
+    struct PreviousRun
+    {
+        std::vector<std::size_t> taskIDs;
+        std::vector<std::uint32_t> priorityGroups;
+        std::vector<std::uint32_t> priorities;
+        std::vector<std::int32_t> dueDays;
+        std::vector<Minutes> baseReleaseTimes;
+        std::vector<Minutes> releaseTimes;
+        std::vector<Minutes> initialMinutes;
+        std::vector<std::uint32_t> unmetDependencies;
+        std::vector<Minutes> firstStarts;
+        std::vector<Minutes> finishTimes;
+        std::vector<TaskIndex> dependencyOffsets;
+        std::vector<TaskIndex> dependencies;
+        std::vector<Placement> placements;
+        std::vector<Placement> instantFinishes;
+        std::vector<FreeSlot> busyTimes;
+        std::vector<TaskIndex> toCurrent;
+        std::vector<TaskIndex> fromCurrent;
+    };
+
+    bool isWorkingDay(std::chrono::sys_days day) const;
+    void buildFreeSlots(const ScheduleItemList& fixedItems, std::chrono::sys_days firstDay, std::chrono::sys_days lastDay);
+    void prepareTasks(const TaskList& openTasks, Minutes windowStart);
+    bool higherPriority(TaskIndex a, TaskIndex b) const;
+    void placeTasks(Minutes resumeAt);
+    void emitPlacement(TaskIndex task, Minutes start, Minutes end);
+    ScheduleResult collectResult(const TaskList& openTasks) const;
+    PreviousRun takePreviousRun();
+    void mapPreviousTasks(PreviousRun& previous) const;
+    bool sameDependencies(const PreviousRun& previous, TaskIndex previousTask, TaskIndex task) const;
+    Minutes findFirstChange(const PreviousRun& previous) const;
+    Minutes estimateReadyTime(const PreviousRun& previous, TaskIndex task) const;
+    Minutes firstInfluence(const PreviousRun& previous, TaskIndex task, TaskIndex previousTask, Minutes from) const;
+    Minutes effortReachedTime(const PreviousRun& previous, TaskIndex previousTask, Minutes effort) const;
+    Minutes firstFreeTime(Minutes from) const;
+    void restorePrefix(const PreviousRun& previous, Minutes cut);
+
+    std::size_t userID;
+    WorkingHours workingHours;
+    std::vector<FreeSlot> busyTimes;
+    std::vector<FreeSlot> freeSlots;
+    bool hasSchedule = false;
+    std::chrono::year_month_day scheduledFirstDay;
+    std::chrono::year_month_day scheduledLastDay;
+    Minutes recomputedFrom = 0;
+
+    // Task data in structure of arrays form, indexed by TaskIndex.
+    std::vector<std::uint32_t> sourceIndexes;
+    std::vector<std::size_t> taskIDs;
+    std::vector<std::uint32_t> priorityGroups;
+    std::vector<std::uint32_t> priorities;
+    std::vector<std::int32_t> dueDays;
+    std::vector<Minutes> baseReleaseTimes;
+    std::vector<Minutes> releaseTimes;
+    std::vector<Minutes> initialMinutes;
+    std::vector<Minutes> remainingMinutes;
+    std::vector<std::uint32_t> unmetDependencies;
+    std::vector<Minutes> firstStarts;
+    std::vector<Minutes> finishTimes;
+    std::vector<TaskIndex> dependentOffsets;
+    std::vector<TaskIndex> dependents;
+    std::vector<TaskIndex> dependencyOffsets;
+    std::vector<TaskIndex> dependencies;
+
+    std::vector<Placement> placements;
+    // Tasks without any effort finish without a placement, they are kept for reschedule().
+    std::vector<Placement> instantFinishes;
+};
+
+#endif // TASKSCHEDULER_H_
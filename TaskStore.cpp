@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <chrono>
+#include "commonUtilities.h"
+#include "CompactDate.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "TaskModel.h"
+#include "TaskStore.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+TaskStore::TaskStore(const TaskList& tasks)
+{
+    reserve(tasks.size());
+    for (const auto& task: tasks)
+    {
+        append(*task);
+    }
+}
+
+void TaskStore::reserve(std::size_t taskCount, std::size_t descriptionBytes)
+{
+    taskIDs.reserve(taskCount);
+    creatorIDs.reserve(taskCount);
+    assignToIDs.reserve(taskCount);
+    parentTaskIDs.reserve(taskCount);
+    statuses.reserve(taskCount);
+    percentageCompletes.reserve(taskCount);
+    creationDays.reserve(taskCount);
+    dueDays.reserve(taskCount);
+    scheduledStartDays.reserve(taskCount);
+    actualStartDays.reserve(taskCount);
+    estimatedCompletionDays.reserve(taskCount);
+    completionDays.reserve(taskCount);
+    estimatedEfforts.reserve(taskCount);
+    actualEfforts.reserve(taskCount);
+    priorityGroups.reserve(taskCount);
+    priorities.reserve(taskCount);
+    personalFlags.reserve(taskCount);
+    descriptionOffsets.reserve(taskCount + 1);
+    descriptionHeap.reserve(descriptionBytes);
+    dependencyOffsets.reserve(taskCount + 1);
+    rowsByTaskID.reserve(taskCount);
+}
+
+void TaskStore::clear()
+{
+    *this = TaskStore();
+}
+
+TaskStore::RowIndex TaskStore::append(const TaskRow& row)
+{
+    RowIndex newRow = static_cast<RowIndex>(taskIDs.size());
+
+    taskIDs.push_back(static_cast<std::uint32_t>(row.taskID));
+    creatorIDs.push_back(static_cast<std::uint32_t>(row.creatorID));
+    assignToIDs.push_back(static_cast<std::uint32_t>(row.assignToID));
+    parentTaskIDs.push_back(static_cast<std::uint32_t>(row.parentTaskID.value_or(NoParent)));
+    statuses.push_back(row.status.has_value()? static_cast<std::uint8_t>(*row.status) : NoStatus);
+    percentageCompletes.push_back(static_cast<float>(row.percentageComplete));
+    creationDays.push_back(row.creationDate.getDayNumber());
+    dueDays.push_back(row.dueDate.getDayNumber());
+    scheduledStartDays.push_back(row.scheduledStart.getDayNumber());
+    actualStartDays.push_back(row.actualStartDate.getDayNumber());
+    estimatedCompletionDays.push_back(row.estimatedCompletion.getDayNumber());
+    completionDays.push_back(row.completionDate.getDayNumber());
+    estimatedEfforts.push_back(static_cast<float>(row.estimatedEffort));
+    actualEfforts.push_back(static_cast<float>(row.actualEffortToDate));
+    priorityGroups.push_back(row.priorityGroup);
+    priorities.push_back(row.priority);
+    personalFlags.push_back(row.personal);
+
+    descriptionHeap.append(row.description);
+    descriptionOffsets.push_back(static_cast<std::uint32_t>(descriptionHeap.size()));
+    dependencyOffsets.push_back(dependencyOffsets.back());
+    rowsByTaskID.emplace(taskIDs.back(), newRow);
+
+    return newRow;
+}
+
+TaskStore::RowIndex TaskStore::append(const TaskModel& task)
+{
+    std::string description = task.getDescription();
+    TaskRow row = {
+        task.getTaskID(), task.getCreatorID(), task.getAssignToID(), description, task.rawParentTaskID(),
+        task.rawStatus(), task.getPercentageComplete(), task.getCompactCreationDate(), task.getCompactDueDate(),
+        task.getCompactScheduledStart(), task.getCompactActualStartDate(), task.getCompactEstimatedCompletion(),
+        task.getCompactCompletionDate(),
+        task.getEstimatedEffort(), task.getactualEffortToDate(), task.getPriorityGroup(), task.getPriority(),
+        task.isPersonal()
+    };
+
+    RowIndex newRow = append(row);
+
+    for (auto dependency: task.getDependencies())
+    {
+        dependencies.push_back(static_cast<std::uint32_t>(dependency));
+    }
+    dependencyOffsets.back() = static_cast<std::uint32_t>(dependencies.size());
+
+    return newRow;
+}
+
+void TaskStore::setDependencies(std::vector<Dependency> newDependencies)
+{
+    std::erase_if(newDependencies, [this](const Dependency& edge) { return !findTask(edge.taskID).has_value(); });
+    std::ranges::sort(newDependencies, {},
+        [this](const Dependency& edge) { return std::pair(*findTask(edge.taskID), edge.dependency); });
+
+    dependencyOffsets.assign(taskIDs.size() + 1, 0);
+    dependencies.clear();
+    dependencies.reserve(newDependencies.size());
+    for (const auto& edge: newDependencies)
+    {
+        ++dependencyOffsets[*findTask(edge.taskID) + 1];
+        dependencies.push_back(static_cast<std::uint32_t>(edge.dependency));
+    }
+
+    for (std::size_t row = 0; row < taskIDs.size(); ++row)
+    {
+        dependencyOffsets[row + 1] += dependencyOffsets[row];
+    }
+}
+
+std::optional<TaskStore::RowIndex> TaskStore::findTask(std::size_t taskID) const
+{
+    auto found = rowsByTaskID.find(static_cast<std::uint32_t>(taskID));
+    if (found == rowsByTaskID.end())
+    {
+        return std::nullopt;
+    }
+
+    return found->second;
+}
+
+TaskModel_shp TaskStore::toTaskModel(RowIndex row) const
+{
+    TaskModel_shp task = std::make_shared<TaskModel>();
+
+    task->setTaskID(taskIDs[row]);
+    task->setCreatorID(creatorIDs[row]);
+    task->setAssignToID(assignToIDs[row]);
+    task->setDescription(std::string(getDescription(row)));
+    task->setPercentageComplete(percentageCompletes[row]);
+    task->setCreationDate(CompactDate(creationDays[row]));
+    task->setDueDate(CompactDate(dueDays[row]));
+    task->setScheduledStart(CompactDate(scheduledStartDays[row]));
+    task->setEstimatedEffort(static_cast<unsigned int>(estimatedEfforts[row]));
+    task->setActualEffortToDate(actualEfforts[row]);
+    task->setPriorityGroup(priorityGroups[row]);
+    task->setPriority(priorities[row]);
+    task->setPersonal(personalFlags[row] != 0);
+
+    if (parentTaskIDs[row] != NoParent)
+    {
+        task->setParentTaskID(parentTaskIDs[row]);
+    }
+    if (statuses[row] != NoStatus)
+    {
+        task->setStatus(static_cast<TaskModel::TaskStatus>(statuses[row]));
+    }
+    if (actualStartDays[row] != NoDate)
+    {
+        task->setactualStartDate(CompactDate(actualStartDays[row]));
+    }
+    if (estimatedCompletionDays[row] != NoDate)
+    {
+        task->setEstimatedCompletion(CompactDate(estimatedCompletionDays[row]));
+    }
+    if (completionDays[row] != NoDate)
+    {
+        task->setCompletionDate(CompactDate(completionDays[row]));
+    }
+
+    auto taskDependencies = getDependencies(row);
+    task->setDependencies(std::vector<std::size_t>(taskDependencies.begin(), taskDependencies.end()));
+
+    task->clearModified();
+
+    return task;
+}
+
+TaskList TaskStore::toTaskList() const
+{
+    TaskList tasks;
+
+    tasks.reserve(taskIDs.size());
+    for (RowIndex row = 0; row < taskIDs.size(); ++row)
+    {
+        tasks.push_back(toTaskModel(row));
+    }
+
+    return tasks;
+}
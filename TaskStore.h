@@ -0,0 +1,140 @@
+#ifndef TASKSTORE_H_
+#define TASKSTORE_H_
+
+#include <chrono>
+#include "CompactDate.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include "TaskModel.h"
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Column (structure of arrays) storage for large numbers of tasks. Reports that aggregate a few
+ * fields over many tasks only touch the columns they need instead of every TaskModel object.
+ * IDs are stored as 32 bit values, the ID columns in the database are INT UNSIGNED. Dates are
+ * stored as day numbers since 1970-01-01, efforts as float. Descriptions are kept in one string
+ * heap indexed by offsets. Tasks are converted back to TaskModel on demand.
+ */
+class TaskStore
+{
+public:
+    using RowIndex = std::uint32_t;
+    using DayNumber = CompactDate::DayNumber;
+
+    static constexpr DayNumber NoDate = CompactDate::NoDate;
+    static constexpr std::uint8_t NoStatus = std::numeric_limits<std::uint8_t>::max();
+    static constexpr std::uint32_t NoParent = 0;
+
+/*
+ * The values of one task, used to append a task without creating a TaskModel first.
+ */
+    struct TaskRow
+    {
+        std::size_t taskID;
+        std::size_t creatorID;
+        std::size_t assignToID;
+        std::string_view description;
+        std::optional<std::size_t> parentTaskID;
+        std::optional<TaskModel::TaskStatus> status;
+        double percentageComplete;
+        CompactDate creationDate;
+        CompactDate dueDate;
+        CompactDate scheduledStart;
+        CompactDate actualStartDate;
+        CompactDate estimatedCompletion;
+        CompactDate completionDate;
+        unsigned int estimatedEffort;
+        double actualEffortToDate;
+        unsigned int priorityGroup;
+        unsigned int priority;
+        bool personal;
+    };
+
+    struct Dependency
+    {
+        std::size_t taskID;
+        std::size_t dependency;
+    };
+
+    TaskStore() = default;
+    explicit TaskStore(const TaskList& tasks);
+    ~TaskStore() = default;
+
+    void reserve(std::size_t taskCount, std::size_t descriptionBytes = 0);
+    void clear();
+    std::size_t size() const { return taskIDs.size(); };
+    bool empty() const { return taskIDs.empty(); };
+    RowIndex append(const TaskRow& row);
+    RowIndex append(const TaskModel& task);
+/*
+ * Replaces the dependencies of all of the tasks, dependencies of tasks that are not in the
+ * store are ignored.
+ */
+    void setDependencies(std::vector<Dependency> dependencies);
+/*
+ * Constant time lookup in an index of the rows by TaskID, the first row appended with the
+ * TaskID is returned.
+ */
+    std::optional<RowIndex> findTask(std::size_t taskID) const;
+    TaskModel_shp toTaskModel(RowIndex row) const;
+    TaskList toTaskList() const;
+
+    static DayNumber toDayNumber(std::chrono::year_month_day date) { return CompactDate(date).getDayNumber(); };
+    static std::chrono::year_month_day toDate(DayNumber day) { return CompactDate(day).toYearMonthDay(); };
+
+/*
+ * Column access.
+ */
+    std::span<const std::uint32_t> getTaskIDs() const { return taskIDs; };
+    std::span<const std::uint32_t> getCreatorIDs() const { return creatorIDs; };
+    std::span<const std::uint32_t> getAssignToIDs() const { return assignToIDs; };
+    std::span<const std::uint32_t> getParentTaskIDs() const { return parentTaskIDs; };
+    std::span<const std::uint8_t> getStatuses() const { return statuses; };
+    std::span<const float> getPercentageCompletes() const { return percentageCompletes; };
+    std::span<const DayNumber> getCreationDays() const { return creationDays; };
+    std::span<const DayNumber> getDueDays() const { return dueDays; };
+    std::span<const DayNumber> getScheduledStartDays() const { return scheduledStartDays; };
+    std::span<const DayNumber> getActualStartDays() const { return actualStartDays; };
+    std::span<const DayNumber> getEstimatedCompletionDays() const { return estimatedCompletionDays; };
+    std::span<const DayNumber> getCompletionDays() const { return completionDays; };
+    std::span<const float> getEstimatedEfforts() const { return estimatedEfforts; };
+    std::span<const float> getActualEfforts() const { return actualEfforts; };
+    std::span<const std::uint32_t> getPriorityGroups() const { return priorityGroups; };
+    std::span<const std::uint32_t> getPriorities() const { return priorities; };
+    std::span<const std::uint8_t> getPersonalFlags() const { return personalFlags; };
+    std::string_view getDescription(RowIndex row) const
+        { return std::string_view(descriptionHeap).substr(descriptionOffsets[row], descriptionOffsets[row + 1] - descriptionOffsets[row]); };
+    std::span<const std::uint32_t> getDependencies(RowIndex row) const
+        { return std::span<const std::uint32_t>(dependencies).subspan(dependencyOffsets[row], dependencyOffsets[row + 1] - dependencyOffsets[row]); };
+
+private:
+    std::vector<std::uint32_t> taskIDs;
+    std::vector<std::uint32_t> creatorIDs;
+    std::vector<std::uint32_t> assignToIDs;
+    std::vector<std::uint32_t> parentTaskIDs;
+    std::vector<std::uint8_t> statuses;
+    std::vector<float> percentageCompletes;
+    std::vector<DayNumber> creationDays;
+    std::vector<DayNumber> dueDays;
+    std::vector<DayNumber> scheduledStartDays;
+    std::vector<DayNumber> actualStartDays;
+    std::vector<DayNumber> estimatedCompletionDays;
+    std::vector<DayNumber> completionDays;
+    std::vector<float> estimatedEfforts;
+    std::vector<float> actualEfforts;
+    std::vector<std::uint32_t> priorityGroups;
+    std::vector<std::uint32_t> priorities;
+    std::vector<std::uint8_t> personalFlags;
+    std::vector<std::uint32_t> descriptionOffsets = {0};
+    std::string descriptionHeap;
+    std::vector<std::uint32_t> dependencyOffsets = {0};
+    std::vector<std::uint32_t> dependencies;
+    std::unordered_map<std::uint32_t, RowIndex> rowsByTaskID;
+};
+
+#endif // TASKSTORE_H_
@@ -1,18 +1,25 @@
+#include <algorithm>
 #include <boost/asio.hpp>
 #include <boost/mysql.hpp>
 #include "CommandLineParser.h"
 #include "BoostDBInterfaceCore.h"
+#include <cstdint>
 #include <exception>
 #include <format>
 #include <functional>
+#include "ImportHash.h"
 #include <iostream>
 #include <optional>
+#include "Profiler.h"
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include "UserDbInterface.h"
 #include "UserModel.h"
 #include <utility>
+#include <vector>
 
 UserDbInterface::UserDbInterface()
 : BoostDBInterfaceCore()
@@ -21,7 +28,7 @@ UserDbInterface::UserDbInterface()
 
 std::size_t UserDbInterface::insert(const UserModel &user)
 {
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -52,10 +59,119 @@ std::size_t UserDbInterface::insert(const UserModel &user)
     }
 }
 
+bool UserDbInterface::insertBatch(UserList& users)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (users.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoInsertUsers(users),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+
+        return true;
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In UserDbInterface::insertBatch({} users) : {}", users.size(), e.what()));
+    }
+
+    return false;
+}
+
+bool UserDbInterface::upsertBatch(UserList& users, const std::vector<ImportHash>& importHashes)
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    if (users.size() != importHashes.size())
+    {
+        appendErrorMessage(std::format("In UserDbInterface::upsertBatch : {} users but {} import hashes",
+            users.size(), importHashes.size()));
+        return false;
+    }
+
+    if (users.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        NSBA::io_context ctx;
+
+        NSBA::co_spawn(
+            ctx, coRoUpsertUsers(users, importHashes),
+            [](std::exception_ptr ptr, NSBM::results)
+            {
+                if (ptr)
+                {
+                    std::rethrow_exception(ptr);
+                }
+            }
+        );
+
+        ctx.run();
+
+        return true;
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In UserDbInterface::upsertBatch({} users) : {}", users.size(), e.what()));
+    }
+
+    return false;
+}
+
+std::vector<ImportedRow> UserDbInterface::getImportedRows()
+{
+    ProfileZone callZone = prepareForRunQueryAsync();
+
+    std::vector<ImportedRow> importedRows;
+
+    try
+    {
+        NSBM::results localResult = runQueryAsync(std::bind(&UserDbInterface::coRoSelectImportedRows, this));
+
+        importedRows.reserve(localResult.rows().size());
+        for (auto row: localResult.rows())
+        {
+            std::string_view middleInitial = row.at(3).is_null()? std::string_view() : row.at(3).as_string();
+            importedRows.push_back({static_cast<std::size_t>(row.at(0).as_uint64()),
+                {userImportKey(row.at(1).as_string(), row.at(2).as_string(), middleInitial),
+                row.at(4).is_null()? 0 : row.at(4).as_uint64()}});
+        }
+    }
+
+    catch(const std::exception& e)
+    {
+        appendErrorMessage(std::format("In UserDbInterface::getImportedRows : {}", e.what()));
+    }
+
+    return importedRows;
+}
+
 UserModel_shp UserDbInterface::getUserByUserID(std::size_t userID)
 {
     UserModel_shp newUser = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -77,7 +193,7 @@ UserModel_shp UserDbInterface::getUserByUserID(std::size_t userID)
 UserModel_shp UserDbInterface::getUserByFullName(std::string_view lastName, std::string_view firstName, std::string_view middleI)
 {
     UserModel_shp newUser = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -101,7 +217,7 @@ UserModel_shp UserDbInterface::getUserByFullName(std::string_view lastName, std:
 UserModel_shp UserDbInterface::getUserByEmail(std::string_view emailAddress)
 {
     UserModel_shp newUser = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -124,7 +240,7 @@ UserModel_shp UserDbInterface::getUserByEmail(std::string_view emailAddress)
 UserModel_shp UserDbInterface::getUserByLoginName(std::string_view loginName)
 {
     UserModel_shp newUser = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -146,7 +262,7 @@ UserModel_shp UserDbInterface::getUserByLoginName(std::string_view loginName)
 UserModel_shp UserDbInterface::getUserByLoginAndPassword(std::string_view loginName, std::string_view password)
 {
     UserModel_shp newUser = nullptr;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -170,7 +286,7 @@ UserModel_shp UserDbInterface::getUserByLoginAndPassword(std::string_view loginN
 UserList UserDbInterface::getAllUsers()
 {
     UserList userList;
-    prepareForRunQueryAsync();
+    ProfileZone callZone = prepareForRunQueryAsync();
 
     try
     {
@@ -189,6 +305,8 @@ UserList UserDbInterface::getAllUsers()
 /**/
 UserModel_shp UserDbInterface::processResult(NSBM::results& results)
 {
+    ProfileZone zone("decode");
+
     if (results.rows().empty())
     {
         appendErrorMessage("User not found!");
@@ -210,6 +328,7 @@ UserModel_shp UserDbInterface::processResult(NSBM::results& results)
 
 UserList UserDbInterface::processResults(NSBM::results& results)
 {
+    ProfileZone zone("decode");
     UserList users;
 
     if (results.rows().empty())
@@ -265,11 +384,11 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectUserByID()
     std::size_t userID = std::any_cast<std::size_t>(selectStatementWhatArgs[0]);
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot FROM UserProfile WHERE UserID = {}", userID),
@@ -289,11 +408,11 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectUserByFullName()
 
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot FROM UserProfile WHERE LastName = {} AND FirstName = {} AND MiddleInitial = {}",
@@ -312,11 +431,11 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectUserByEmailAddress()
 
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot FROM UserProfile WHERE EmailAddress = {}", emailAddr),
@@ -334,11 +453,11 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectUserByLoginName()
 
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot FROM UserProfile WHERE LoginName = {}", loginName),
@@ -354,12 +473,12 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoInsertUser(const UserModel&
 {
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
     // Boolean values are stored as TINYINT and need to be converted.
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("INSERT INTO UserProfile (LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot) VALUES ({0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}, {11})",
@@ -376,15 +495,245 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoInsertUser(const UserModel&
     co_return result;
 }
 
+/*
+ * Matches the UserIDs read back after a multi-row INSERT to the rows of the batch by the login
+ * name, it is unique in UserProfile.
+ */
+static std::vector<std::size_t> matchInsertedUserIDs(const std::vector<std::string>& batchLoginNames,
+    const NSBM::results& insertedRows)
+{
+    std::unordered_map<std::string_view, std::size_t> userIDsByLoginName;
+    userIDsByLoginName.reserve(batchLoginNames.size());
+    for (auto row: insertedRows.rows())
+    {
+        userIDsByLoginName.emplace(row.at(1).as_string(), row.at(0).as_uint64());
+    }
+
+    std::vector<std::size_t> userIDs;
+    userIDs.reserve(batchLoginNames.size());
+    for (const auto& loginName: batchLoginNames)
+    {
+        auto inserted = userIDsByLoginName.find(loginName);
+        if (inserted == userIDsByLoginName.end())
+        {
+            std::runtime_error InsertedUserNotFound(std::format("Inserted user {} not found!", loginName));
+            throw InsertedUserNotFound;
+        }
+        userIDs.push_back(inserted->second);
+    }
+
+    return userIDs;
+}
+
+/*
+ * The auto increment values of a multi-row INSERT are only consecutive when
+ * auto_increment_increment is 1 and innodb_autoinc_lock_mode doesn't interleave them with the
+ * inserts of other connections, so the UserIDs are read back by login name in the same
+ * transaction. The IDs are only stored in the models after the COMMIT. If any statement throws
+ * the connection is closed without a COMMIT and no users are inserted.
+ */
+NSBA::awaitable<NSBM::results> UserDbInterface::coRoInsertUsers(UserList& users)
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+    std::vector<std::size_t> userIDs;
+    userIDs.reserve(users.size());
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    std::span<const UserModel_shp> remainingUsers(users);
+    while (!remainingUsers.empty())
+    {
+        std::span<const UserModel_shp> batch = remainingUsers.first(std::min(InsertBatchSize, remainingUsers.size()));
+        remainingUsers = remainingUsers.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO UserProfile (LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
+                "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
+                "UseLettersForMajorPriority, SeparatePriorityWithDot) VALUES {0}",
+                NSBM::sequence(batch,
+                    [](const UserModel_shp& user, NSBM::format_context_base& ctx)
+                    {
+                        NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})",
+                            user->getLastName(), user->getFirstName(), user->getMiddleInitial(), user->getEmail(),
+                            user->getLoginName(), user->getPassword(), user->getStartTime(), user->getEndTime(),
+                            static_cast<int>(user->isPriorityInSchedule()), static_cast<int>(user->isMinorPriorityInSchedule()),
+                            static_cast<int>(user->isUsingLettersForMaorPriority()),
+                            static_cast<int>(user->isSeparatingPriorityWithDot()));
+                    })),
+            result
+        );
+
+        std::vector<std::string> batchLoginNames;
+        batchLoginNames.reserve(batch.size());
+        for (const auto& user: batch)
+        {
+            batchLoginNames.push_back(user->getLoginName());
+        }
+
+        NSBM::results insertedRows;
+        co_await coRoExecute(conn,
+            NSBM::with_params("SELECT UserID, LoginName FROM UserProfile WHERE LoginName IN ({0})", batchLoginNames),
+            insertedRows
+        );
+
+        std::vector<std::size_t> batchUserIDs = matchInsertedUserIDs(batchLoginNames, insertedRows);
+        userIDs.insert(userIDs.end(), batchUserIDs.begin(), batchUserIDs.end());
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    for (std::size_t userIndex = 0; userIndex < users.size(); ++userIndex)
+    {
+        users[userIndex]->setUserID(userIDs[userIndex]);
+    }
+
+    co_return result;
+}
+
+/*
+ * Users with a UserID are written with INSERT ... ON DUPLICATE KEY UPDATE, the UserID makes
+ * the row a duplicate and only EmailAddress and ContentHash are updated. The name is the
+ * import key and the login name and password were generated from it, none of them change.
+ * The UserIDs of new users are read back by login name as coRoInsertUsers() does.
+ */
+NSBA::awaitable<NSBM::results> UserDbInterface::coRoUpsertUsers(UserList& users, const std::vector<ImportHash>& importHashes)
+{
+    struct UserRow
+    {
+        const UserModel* user;
+        std::uint64_t contentHash;
+    };
+
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+    std::vector<UserRow> existingRows;
+    std::vector<UserRow> newRows;
+    std::vector<std::size_t> newUserIndexes;
+    for (std::size_t userIndex = 0; userIndex < users.size(); ++userIndex)
+    {
+        UserRow userRow{users[userIndex].get(), importHashes[userIndex].content};
+        if (userRow.user->getUserID() > 0)
+        {
+            existingRows.push_back(userRow);
+        }
+        else
+        {
+            newRows.push_back(userRow);
+            newUserIndexes.push_back(userIndex);
+        }
+    }
+    std::vector<std::size_t> newUserIDs;
+    newUserIDs.reserve(newRows.size());
+
+    auto formatUserRow = [](const UserRow& row, NSBM::format_context_base& ctx)
+    {
+        const UserModel& user = *row.user;
+        NSBM::format_sql_to(ctx, "({}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {})",
+            user.getUserID() > 0? std::optional<std::size_t>(user.getUserID()) : std::nullopt,
+            user.getLastName(), user.getFirstName(), user.getMiddleInitial(), user.getEmail(),
+            user.getLoginName(), user.getPassword(), user.getStartTime(), user.getEndTime(),
+            static_cast<int>(user.isPriorityInSchedule()), static_cast<int>(user.isMinorPriorityInSchedule()),
+            static_cast<int>(user.isUsingLettersForMaorPriority()), static_cast<int>(user.isSeparatingPriorityWithDot()),
+            row.contentHash);
+    };
+
+    co_await coRoExecute(conn, "START TRANSACTION", result);
+
+    std::span<const UserRow> remainingRows(existingRows);
+    while (!remainingRows.empty())
+    {
+        std::span<const UserRow> batch = remainingRows.first(std::min(InsertBatchSize, remainingRows.size()));
+        remainingRows = remainingRows.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO UserProfile (UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
+                "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
+                "UseLettersForMajorPriority, SeparatePriorityWithDot, ContentHash) VALUES {0} AS NewUser "
+                "ON DUPLICATE KEY UPDATE EmailAddress = NewUser.EmailAddress, ContentHash = NewUser.ContentHash",
+                NSBM::sequence(batch, formatUserRow)),
+            result
+        );
+    }
+
+    remainingRows = newRows;
+    while (!remainingRows.empty())
+    {
+        std::span<const UserRow> batch = remainingRows.first(std::min(InsertBatchSize, remainingRows.size()));
+        remainingRows = remainingRows.subspan(batch.size());
+
+        co_await coRoExecute(conn,
+            NSBM::with_params("INSERT INTO UserProfile (UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
+                "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
+                "UseLettersForMajorPriority, SeparatePriorityWithDot, ContentHash) VALUES {0}",
+                NSBM::sequence(batch, formatUserRow)),
+            result
+        );
+
+        std::vector<std::string> batchLoginNames;
+        batchLoginNames.reserve(batch.size());
+        for (const auto& row: batch)
+        {
+            batchLoginNames.push_back(row.user->getLoginName());
+        }
+
+        NSBM::results insertedRows;
+        co_await coRoExecute(conn,
+            NSBM::with_params("SELECT UserID, LoginName FROM UserProfile WHERE LoginName IN ({0})", batchLoginNames),
+            insertedRows
+        );
+
+        std::vector<std::size_t> batchUserIDs = matchInsertedUserIDs(batchLoginNames, insertedRows);
+        newUserIDs.insert(newUserIDs.end(), batchUserIDs.begin(), batchUserIDs.end());
+    }
+
+    co_await coRoExecute(conn, "COMMIT", result);
+
+    co_await conn.async_close();
+
+    for (std::size_t newIndex = 0; newIndex < newUserIndexes.size(); ++newIndex)
+    {
+        users[newUserIndexes[newIndex]]->setUserID(newUserIDs[newIndex]);
+    }
+
+    co_return result;
+}
+
+NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectImportedRows()
+{
+    NSBM::any_connection conn(co_await NSBA::this_coro::executor);
+
+    co_await coRoConnect(conn);
+
+    NSBM::results result;
+
+    co_await coRoExecute(conn,
+        "SELECT UserID, LastName, FirstName, MiddleInitial, ContentHash FROM UserProfile ORDER BY UserID",
+        result
+    );
+
+    co_await conn.async_close();
+
+    co_return result;
+}
+
 NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectAllUsers()
 {
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         "SELECT UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot FROM UserProfile ORDER BY UserID",
@@ -403,11 +752,11 @@ NSBA::awaitable<NSBM::results> UserDbInterface::coRoSelectUserByLoginAndPassword
 
     NSBM::any_connection conn(co_await NSBA::this_coro::executor);
 
-    co_await conn.async_connect(dbConnectionParameters);
+    co_await coRoConnect(conn);
 
     NSBM::results result;
 
-    co_await conn.async_execute(
+    co_await coRoExecute(conn,
         NSBM::with_params("SELECT UserID, LastName, FirstName, MiddleInitial, EmailAddress, LoginName, "
             "HashedPassWord, ScheduleDayStart, ScheduleDayEnd, IncludePriorityInSchedule, IncludeMinorPriorityInSchedule, "
             "UseLettersForMajorPriority, SeparatePriorityWithDot FROM UserProfile WHERE LoginName = {} AND HashedPassWord = {}",
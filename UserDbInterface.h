@@ -3,8 +3,10 @@
 
 #include "CommandLineParser.h"
 #include "BoostDBInterfaceCore.h"
+#include "ImportHash.h"
 #include <string_view>
 #include "UserModel.h"
+#include <vector>
 
 class UserDbInterface : public BoostDBInterfaceCore
 {
@@ -13,6 +15,24 @@ public:
     ~UserDbInterface() = default;
     std::size_t insert(const UserModel& user);
     std::size_t insert(UserModel_shp userP) { return insert(*userP); };
+/*
+ * Inserts all of the users in one transaction with multi-row INSERT statements and sets the
+ * UserID of each user. Either all of the users are inserted or none are.
+ */
+    bool insertBatch(UserList& users);
+/*
+ * Writes the users of a CSV import in one transaction, importHashes[i] is stored with users[i].
+ * A user that already has a UserID replaces the e-mail address of the stored row, many rows
+ * per INSERT ... ON DUPLICATE KEY UPDATE statement. The login name and the password are never
+ * replaced. The other users are inserted and given a UserID. Either all of the users are
+ * written or none are.
+ */
+    bool upsertBatch(UserList& users, const std::vector<ImportHash>& importHashes);
+/*
+ * The import hashes of all users. The import key is computed from the name, so users that were
+ * not written by upsertBatch() are included with a content hash of 0.
+ */
+    std::vector<ImportedRow> getImportedRows();
     UserModel_shp getUserByUserID(std::size_t userID);
     UserModel_shp getUserByFullName(std::string_view lastName, std::string_view firstName, std::string_view middleI);
     UserModel_shp getUserByEmail(std::string_view emailAddress);
@@ -20,6 +40,8 @@ public:
     UserModel_shp getUserByLoginAndPassword(std::string_view loginName, std::string_view password);
     UserList getAllUsers();
 
+    static constexpr std::size_t InsertBatchSize = 1000;
+
 private:
     UserModel_shp processResult(NSBM::results& results);
     UserList processResults(NSBM::results& results);
@@ -29,6 +51,9 @@ private:
     NSBA::awaitable<NSBM::results> coRoSelectUserByEmailAddress();
     NSBA::awaitable<NSBM::results> coRoSelectUserByLoginName();
     NSBA::awaitable<NSBM::results> coRoInsertUser(const UserModel& user);
+    NSBA::awaitable<NSBM::results> coRoInsertUsers(UserList& users);
+    NSBA::awaitable<NSBM::results> coRoUpsertUsers(UserList& users, const std::vector<ImportHash>& importHashes);
+    NSBA::awaitable<NSBM::results> coRoSelectImportedRows();
     NSBA::awaitable<NSBM::results> coRoSelectAllUsers();
     NSBA::awaitable<NSBM::results> coRoSelectUserByLoginAndPassword();
 
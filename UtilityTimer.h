@@ -7,9 +7,9 @@
  */
 
 #include <chrono>
+#include <cstddef>
 #include <ctime>
-#include <iomanip>
-#include <iostream>
+#include "Logger.h"
 #include <string_view>
 
 class UtilityTimer
@@ -30,8 +30,13 @@ public:
 
 		using std::chrono::system_clock;
 		auto const now = system_clock::to_time_t(system_clock::now());
-		std::clog << "finished " << whatIsBeingTimed << std::put_time(std::localtime(&now), "%c")
-			  << "\nelapsed time in seconds: " << ElapsedTimeForOutPut << "\n\n\n";
+		// std::localtime() shares one buffer between threads.
+		std::tm localNow{};
+		localtime_r(&now, &localNow);
+		char localNowText[64];
+		std::size_t localNowLength = std::strftime(localNowText, sizeof(localNowText), "%c", &localNow);
+		Logger::info("finished {}{}\nelapsed time in seconds: {}\n\n\n", whatIsBeingTimed,
+			std::string_view(localNowText, localNowLength), ElapsedTimeForOutPut);
 	}
 
 private:
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <functional>
+#include <memory>
+#include "Metrics.h"
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include "WorkStealingPool.h"
+
+struct PoolMetrics
+{
+    Metrics::Gauge workers = Metrics::gauge("planner_pool_workers", "Worker threads of the running pools.");
+    Metrics::Gauge queuedJobs = Metrics::gauge("planner_pool_queued_jobs", "Jobs waiting for a worker.");
+    Metrics::Counter jobs = Metrics::counter("planner_pool_jobs_total", "Jobs taken by a worker.");
+    Metrics::Counter waitSeconds = Metrics::counter("planner_pool_wait_seconds_total",
+        "Time jobs spent queued before a worker took them.", {}, 1e9);
+    Metrics::Counter failedJobs = Metrics::counter("planner_pool_failed_jobs_total",
+        "Jobs that ended with an exception.");
+};
+
+static const PoolMetrics& poolMetrics()
+{
+    static const PoolMetrics metrics;
+    return metrics;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned int workerCount)
+{
+    if (workerCount == 0)
+    {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues.reserve(workerCount);
+    for (unsigned int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    // The queues must all exist before the first worker starts looking for work to steal.
+    workers.reserve(workerCount);
+    for (unsigned int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        workers.emplace_back([this, workerIndex](std::stop_token stopToken) { workerLoop(stopToken, workerIndex); });
+    }
+    poolMetrics().workers.add(workerCount);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    for (auto& worker: workers)
+    {
+        worker.request_stop();
+    }
+    jobAvailable.notify_all();
+    poolMetrics().workers.add(-static_cast<std::int64_t>(workers.size()));
+}
+
+void WorkStealingPool::submit(Job job)
+{
+    // Counted before it is queued so a worker can never finish the job before it is counted.
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        ++queuedJobs;
+        ++unfinishedJobs;
+    }
+
+    WorkerQueue& queue = *queues[nextQueue++ % queues.size()];
+    {
+        std::lock_guard<std::mutex> queueLock(queue.mutex);
+        queue.jobs.push_back({std::move(job), std::chrono::steady_clock::now()});
+    }
+    poolMetrics().queuedJobs.add(1);
+    jobAvailable.notify_one();
+}
+
+void WorkStealingPool::waitForAll()
+{
+    std::unique_lock<std::mutex> stateLock(stateMutex);
+    allJobsDone.wait(stateLock, [this]() { return unfinishedJobs == 0; });
+}
+
+std::string WorkStealingPool::getAllErrorMessages()
+{
+    std::lock_guard<std::mutex> stateLock(stateMutex);
+    return errorMessages;
+}
+
+void WorkStealingPool::clearErrorMessages()
+{
+    std::lock_guard<std::mutex> stateLock(stateMutex);
+    errorMessages.clear();
+}
+
+/*
+ * Private methods.
+ */
+bool WorkStealingPool::takeJob(unsigned int workerIndex, Job& job)
+{
+    {
+        WorkerQueue& ownQueue = *queues[workerIndex];
+        std::lock_guard<std::mutex> queueLock(ownQueue.mutex);
+        if (!ownQueue.jobs.empty())
+        {
+            recordJobTaken(ownQueue.jobs.back());
+            job = std::move(ownQueue.jobs.back().job);
+            ownQueue.jobs.pop_back();
+            --queuedJobs;
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        WorkerQueue& victim = *queues[(workerIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> queueLock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            recordJobTaken(victim.jobs.front());
+            job = std::move(victim.jobs.front().job);
+            victim.jobs.pop_front();
+            --queuedJobs;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::recordJobTaken(const QueuedJob& queuedJob)
+{
+    const PoolMetrics& metrics = poolMetrics();
+    metrics.queuedJobs.add(-1);
+    metrics.jobs.add();
+    std::chrono::nanoseconds waitTime = std::chrono::steady_clock::now() - queuedJob.queuedAt;
+    metrics.waitSeconds.add(static_cast<std::uint64_t>(waitTime.count()));
+}
+
+void WorkStealingPool::workerLoop(std::stop_token stopToken, unsigned int workerIndex)
+{
+    while (!stopToken.stop_requested())
+    {
+        Job job;
+        if (!takeJob(workerIndex, job))
+        {
+            std::unique_lock<std::mutex> stateLock(stateMutex);
+            jobAvailable.wait(stateLock, stopToken, [this]() { return queuedJobs > 0; });
+            continue;
+        }
+
+        std::string jobError;
+        try
+        {
+            job(workerIndex);
+        }
+
+        catch (const std::exception& e)
+        {
+            jobError = std::format("In WorkStealingPool worker {} : {}\n", workerIndex, e.what());
+            poolMetrics().failedJobs.add();
+        }
+
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        errorMessages.append(jobError);
+        if (--unfinishedJobs == 0)
+        {
+            allJobsDone.notify_all();
+        }
+    }
+}
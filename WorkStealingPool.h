@@ -0,0 +1,72 @@
+#ifndef WORKSTEALINGPOOL_H_
+#define WORKSTEALINGPOOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Fixed size thread pool, each worker has its own job queue. Submitted jobs are spread over
+ * the queues, a worker takes jobs from the back of its own queue and when that is empty it
+ * steals from the front of the other queues, so uneven jobs still keep every worker busy.
+ * Jobs receive the index of the worker running them so callers can keep per worker state,
+ * such as database interfaces, that must not be shared between threads.
+ */
+class WorkStealingPool
+{
+public:
+    using Job = std::function<void(unsigned int workerIndex)>;
+
+    explicit WorkStealingPool(unsigned int workerCount = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(queues.size()); };
+    void submit(Job job);
+    void waitForAll();
+/*
+ * Jobs should handle their own errors, an exception that escapes a job is caught by the
+ * worker and its message is kept here.
+ */
+    std::string getAllErrorMessages();
+    void clearErrorMessages();
+
+private:
+    struct QueuedJob
+    {
+        Job job;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    bool takeJob(unsigned int workerIndex, Job& job);
+    static void recordJobTaken(const QueuedJob& queuedJob);
+    void workerLoop(std::stop_token stopToken, unsigned int workerIndex);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::atomic<std::size_t> nextQueue = 0;
+    std::atomic<std::size_t> queuedJobs = 0;
+    std::size_t unfinishedJobs = 0;
+    std::mutex stateMutex;
+    std::condition_variable_any jobAvailable;
+    std::condition_variable allJobsDone;
+    std::string errorMessages;
+    std::vector<std::jthread> workers;
+};
+
+#endif // WORKSTEALINGPOOL_H_
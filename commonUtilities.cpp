@@ -1,22 +1,393 @@
+#include <array>
+#include <bit>
+#include <cctype>
+#include <charconv>
 #include <chrono>
 #include "commonUtilities.h"
+#include "CompactDate.h"
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+/*
+ * Today's date is cached per thread until midnight. Detecting midnight only needs the coarse
+ * realtime clock, which is read from memory without a system call and is at most a few
+ * milliseconds behind system_clock::now().
+ */
+static std::int64_t getSecondsSinceEpoch()
+{
+#ifdef CLOCK_REALTIME_COARSE
+    timespec now;
+    clock_gettime(CLOCK_REALTIME_COARSE, &now);
+    return now.tv_sec;
+#else
+    return std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()).time_since_epoch().count();
+#endif
+}
+
+struct CachedToday
+{
+    CompactDate today;
+    std::chrono::year_month_day todaysDate;
+    std::int64_t nextMidnight = std::numeric_limits<std::int64_t>::min();
+};
+
+static const CachedToday& getCachedToday()
+{
+    constexpr std::int64_t secondsPerDay = 24 * 60 * 60;
+    thread_local CachedToday cachedToday;
+
+    std::int64_t now = getSecondsSinceEpoch();
+    if (now >= cachedToday.nextMidnight || now < cachedToday.nextMidnight - secondsPerDay)
+    {
+        std::int64_t dayNumber = now / secondsPerDay - (now % secondsPerDay < 0);
+        cachedToday.today = CompactDate(static_cast<CompactDate::DayNumber>(dayNumber));
+        cachedToday.todaysDate = cachedToday.today.toYearMonthDay();
+        cachedToday.nextMidnight = (dayNumber + 1) * secondsPerDay;
+    }
+
+    return cachedToday;
+}
+
+CompactDate getTodaysCompactDate()
+{
+    return getCachedToday().today;
+}
 
 std::chrono::year_month_day getTodaysDate()
 {
-    std::chrono::time_point<std::chrono::system_clock> today = std::chrono::system_clock::now();
-    return std::chrono::floor<std::chrono::days>(today);
+    return getCachedToday().todaysDate;
 }
 
 std::chrono::year_month_day getTodaysDatePlus(unsigned int offset)
 {
-    std::chrono::time_point<std::chrono::system_clock> futureDate = std::chrono::system_clock::now();
-    futureDate += std::chrono::days(offset);
-    return std::chrono::floor<std::chrono::days>(futureDate);
+    return getTodaysCompactDate().plusDays(offset).toYearMonthDay();
 }
 
 std::chrono::year_month_day getTodaysDateMinus(unsigned int offset)
 {
-    std::chrono::time_point<std::chrono::system_clock> pastDate = std::chrono::system_clock::now();
-    pastDate -= std::chrono::days(offset);
-    return std::chrono::floor<std::chrono::days>(pastDate);
+    return getTodaysCompactDate().plusDays(-static_cast<int>(offset)).toYearMonthDay();
+}
+
+/*
+ * Civil calendar algorithms from C. Neri and L. Schneider, "Euclidean affine functions and their
+ * application to calendar algorithms". They only use unsigned multiplications, shifts and
+ * selects, so loops over many dates vectorize. Day numbers are shifted by a multiple of 400
+ * years to keep every intermediate value unsigned.
+ */
+static constexpr std::uint32_t calendarShift = 82;
+static constexpr std::uint32_t dayNumberShift = 719468 + 146097 * calendarShift;
+static constexpr std::uint32_t yearShift = 400 * calendarShift;
+
+struct CivilDate
+{
+    std::uint32_t year;
+    std::uint32_t month;
+    std::uint32_t day;
+};
+
+/*
+ * The year is returned shifted by yearShift, NoDate returns the zero date 0000-00-00.
+ */
+static constexpr CivilDate civilFromDays(CompactDate::DayNumber dayNumber)
+{
+    std::uint32_t shiftedDays = static_cast<std::uint32_t>(dayNumber) + dayNumberShift;
+    std::uint32_t centuryNumerator = 4 * shiftedDays + 3;
+    std::uint32_t century = centuryNumerator / 146097;
+    std::uint32_t dayOfCentury = centuryNumerator % 146097 / 4;
+    std::uint64_t yearProduct = std::uint64_t{2939745} * (4 * dayOfCentury + 3);
+    std::uint32_t yearOfCentury = static_cast<std::uint32_t>(yearProduct >> 32);
+    std::uint32_t dayOfYear = static_cast<std::uint32_t>(yearProduct) / 2939745 / 4;
+    std::uint32_t monthAndDay = 2141 * dayOfYear + 197913;
+    std::uint32_t month = monthAndDay >> 16;
+    std::uint32_t day = (monthAndDay & 0xffff) / 2141;
+    std::uint32_t january = dayOfYear >= 306;
+    bool noDate = dayNumber == CompactDate::NoDate;
+
+    return {
+        noDate? yearShift : 100 * century + yearOfCentury + january,
+        noDate? 0 : (january? month - 12 : month),
+        noDate? 0 : day + 1
+    };
+}
+
+static constexpr CompactDate::DayNumber daysFromCivil(std::int32_t year, std::uint32_t month, std::uint32_t day)
+{
+    std::uint32_t january = month <= 2;
+    std::uint32_t shiftedYear = static_cast<std::uint32_t>(year) + yearShift - january;
+    std::uint32_t shiftedMonth = january? month + 12 : month;
+    std::uint32_t century = shiftedYear / 100;
+    std::uint32_t yearDays = 1461 * shiftedYear / 4 - century + century / 4;
+    std::uint32_t monthDays = (979 * shiftedMonth - 2919) / 32;
+    std::uint32_t shiftedDays = yearDays + monthDays + day - 1;
+
+    return month == 0? CompactDate::NoDate : static_cast<CompactDate::DayNumber>(shiftedDays - dayNumberShift);
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0 && civilFromDays(0).year == 1970 + yearShift);
+
+/*
+ * Each block of lanes is converted into local arrays first, the conversion loop doesn't touch
+ * the caller's memory so the compiler doesn't need to check for overlapping spans.
+ */
+static constexpr std::size_t dateLanes = 8;
+
+struct CivilDateLanes
+{
+    std::array<std::uint32_t, dateLanes> years;
+    std::array<std::uint32_t, dateLanes> months;
+    std::array<std::uint32_t, dateLanes> days;
+};
+
+static void civilFromDays(std::span<const CompactDate::DayNumber> dayNumbers, CivilDateLanes& civilDates)
+{
+    for (std::size_t lane = 0; lane < dateLanes; ++lane)
+    {
+        CivilDate civilDate = civilFromDays(dayNumbers[lane]);
+        civilDates.years[lane] = civilDate.year;
+        civilDates.months[lane] = civilDate.month;
+        civilDates.days[lane] = civilDate.day;
+    }
+}
+
+/*
+ * libstdc++ and libc++ lay out year_month_day as a 16 bit year followed by an 8 bit month and
+ * day. When that holds, and the platform is little endian, dates are converted to and from 32 bit
+ * words that the lane loops load and store as vectors. Otherwise the year_month_day
+ * constructor and accessors are used one date at a time.
+ */
+static consteval bool isYearMonthDayPacked()
+{
+    if constexpr (sizeof(std::chrono::year_month_day) == sizeof(std::uint32_t))
+    {
+        return std::bit_cast<std::uint32_t>(std::chrono::year_month_day{std::chrono::year{1}, std::chrono::month{2},
+            std::chrono::day{3}}) == 0x03020001;
+    }
+    return false;
+}
+
+static constexpr bool yearMonthDayIsPacked = isYearMonthDayPacked();
+
+static std::chrono::year_month_day toYearMonthDay(std::uint32_t shiftedYear, std::uint32_t month, std::uint32_t day)
+{
+    return std::chrono::year_month_day{std::chrono::year{static_cast<int>(shiftedYear - yearShift)},
+        std::chrono::month{month}, std::chrono::day{day}};
+}
+
+void convertDaysToDates(std::span<const CompactDate::DayNumber> days, std::span<std::chrono::year_month_day> dates)
+{
+    std::size_t index = 0;
+
+    for ( ; index + dateLanes <= days.size(); index += dateLanes)
+    {
+        CivilDateLanes civilDates;
+        civilFromDays(days.subspan(index, dateLanes), civilDates);
+        if constexpr (yearMonthDayIsPacked)
+        {
+            std::array<std::uint32_t, dateLanes> packedDates;
+            for (std::size_t lane = 0; lane < dateLanes; ++lane)
+            {
+                packedDates[lane] = ((civilDates.years[lane] - yearShift) & 0xffff) | (civilDates.months[lane] << 16) |
+                    (civilDates.days[lane] << 24);
+            }
+            for (std::size_t lane = 0; lane < dateLanes; ++lane)
+            {
+                dates[index + lane] = std::bit_cast<std::chrono::year_month_day>(packedDates[lane]);
+            }
+        }
+        else
+        {
+            for (std::size_t lane = 0; lane < dateLanes; ++lane)
+            {
+                dates[index + lane] = toYearMonthDay(civilDates.years[lane], civilDates.months[lane], civilDates.days[lane]);
+            }
+        }
+    }
+
+    for ( ; index < days.size(); ++index)
+    {
+        CivilDate civilDate = civilFromDays(days[index]);
+        dates[index] = toYearMonthDay(civilDate.year, civilDate.month, civilDate.day);
+    }
+}
+
+void convertDatesToDays(std::span<const std::chrono::year_month_day> dates, std::span<CompactDate::DayNumber> days)
+{
+    std::size_t index = 0;
+
+    for ( ; index + dateLanes <= dates.size(); index += dateLanes)
+    {
+        std::array<std::int32_t, dateLanes> years;
+        std::array<std::uint32_t, dateLanes> months;
+        std::array<std::uint32_t, dateLanes> daysOfMonth;
+        if constexpr (yearMonthDayIsPacked)
+        {
+            std::array<std::uint32_t, dateLanes> packedDates;
+            for (std::size_t lane = 0; lane < dateLanes; ++lane)
+            {
+                packedDates[lane] = std::bit_cast<std::uint32_t>(dates[index + lane]);
+            }
+            for (std::size_t lane = 0; lane < dateLanes; ++lane)
+            {
+                years[lane] = static_cast<std::int16_t>(packedDates[lane] & 0xffff);
+                months[lane] = (packedDates[lane] >> 16) & 0xff;
+                daysOfMonth[lane] = packedDates[lane] >> 24;
+            }
+        }
+        else
+        {
+            for (std::size_t lane = 0; lane < dateLanes; ++lane)
+            {
+                years[lane] = static_cast<int>(dates[index + lane].year());
+                months[lane] = static_cast<unsigned int>(dates[index + lane].month());
+                daysOfMonth[lane] = static_cast<unsigned int>(dates[index + lane].day());
+            }
+        }
+
+        std::array<CompactDate::DayNumber, dateLanes> dayNumbers;
+        for (std::size_t lane = 0; lane < dateLanes; ++lane)
+        {
+            dayNumbers[lane] = daysFromCivil(years[lane], months[lane], daysOfMonth[lane]);
+        }
+        for (std::size_t lane = 0; lane < dateLanes; ++lane)
+        {
+            days[index + lane] = dayNumbers[lane];
+        }
+    }
+
+    for ( ; index < dates.size(); ++index)
+    {
+        days[index] = daysFromCivil(static_cast<int>(dates[index].year()), static_cast<unsigned int>(dates[index].month()),
+            static_cast<unsigned int>(dates[index].day()));
+    }
+}
+
+static void formatISODate(std::uint32_t shiftedYear, std::uint32_t month, std::uint32_t day, char* text)
+{
+    std::uint32_t year = shiftedYear - yearShift;
+
+    text[0] = static_cast<char>('0' + year / 1000);
+    text[1] = static_cast<char>('0' + year / 100 % 10);
+    text[2] = static_cast<char>('0' + year / 10 % 10);
+    text[3] = static_cast<char>('0' + year % 10);
+    text[4] = '-';
+    text[5] = static_cast<char>('0' + month / 10);
+    text[6] = static_cast<char>('0' + month % 10);
+    text[7] = '-';
+    text[8] = static_cast<char>('0' + day / 10);
+    text[9] = static_cast<char>('0' + day % 10);
+}
+
+void formatISODates(std::span<const CompactDate::DayNumber> days, std::span<char> text)
+{
+    std::size_t index = 0;
+
+    for ( ; index + dateLanes <= days.size(); index += dateLanes)
+    {
+        CivilDateLanes civilDates;
+        civilFromDays(days.subspan(index, dateLanes), civilDates);
+        for (std::size_t lane = 0; lane < dateLanes; ++lane)
+        {
+            formatISODate(civilDates.years[lane], civilDates.months[lane], civilDates.days[lane],
+                &text[(index + lane) * ISODateLength]);
+        }
+    }
+
+    for ( ; index < days.size(); ++index)
+    {
+        CivilDate civilDate = civilFromDays(days[index]);
+        formatISODate(civilDate.year, civilDate.month, civilDate.day, &text[index * ISODateLength]);
+    }
+}
+
+std::optional<std::chrono::minutes> parseTimeOfDay(std::string_view timeOfDay)
+{
+    unsigned int hours = 0;
+    unsigned int minutes = 0;
+    const char* current = timeOfDay.data();
+    const char* end = timeOfDay.data() + timeOfDay.size();
+
+    auto [afterHours, hoursError] = std::from_chars(current, end, hours);
+    if (hoursError != std::errc() || afterHours == end || *afterHours != ':')
+    {
+        return std::nullopt;
+    }
+
+    auto [afterMinutes, minutesError] = std::from_chars(afterHours + 1, end, minutes);
+    if (minutesError != std::errc() || afterMinutes - afterHours != 3 || minutes > 59)
+    {
+        return std::nullopt;
+    }
+
+    current = afterMinutes;
+    while (current != end && std::isspace(static_cast<unsigned char>(*current)))
+    {
+        ++current;
+    }
+
+    if (current != end)
+    {
+        // AM or PM in any case, followed by nothing but white space.
+        char meridiem = static_cast<char>(std::toupper(static_cast<unsigned char>(*current)));
+        if ((meridiem != 'A' && meridiem != 'P') || end - current < 2 ||
+            std::toupper(static_cast<unsigned char>(current[1])) != 'M' || hours < 1 || hours > 12)
+        {
+            return std::nullopt;
+        }
+        current += 2;
+        while (current != end && std::isspace(static_cast<unsigned char>(*current)))
+        {
+            ++current;
+        }
+        if (current != end)
+        {
+            return std::nullopt;
+        }
+        hours %= 12;
+        if (meridiem == 'P')
+        {
+            hours += 12;
+        }
+    }
+    else if (hours > 23)
+    {
+        return std::nullopt;
+    }
+
+    return std::chrono::hours(hours) + std::chrono::minutes(minutes);
+}
+
+void appendJSONString(std::string& json, std::string_view text)
+{
+    static constexpr std::string_view hexDigits("0123456789abcdef");
+
+    json.push_back('"');
+    for (char character: text)
+    {
+        switch (character)
+        {
+            case '"': json.append("\\\""); break;
+            case '\\': json.append("\\\\"); break;
+            case '\n': json.append("\\n"); break;
+            case '\r': json.append("\\r"); break;
+            case '\t': json.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20)
+                {
+                    json.append("\\u00");
+                    json.push_back(hexDigits[static_cast<unsigned char>(character) >> 4]);
+                    json.push_back(hexDigits[static_cast<unsigned char>(character) & 0xF]);
+                }
+                else
+                {
+                    json.push_back(character);
+                }
+                break;
+        }
+    }
+    json.push_back('"');
 }
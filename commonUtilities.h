@@ -1,9 +1,42 @@
 #ifndef COMMONUTILITIES_H_
 #define COMMONUTILITIES_H_
 #include <chrono>
+#include "CompactDate.h"
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 
+/*
+ * Today's date is cached, repeated calls don't convert the system clock to a date again.
+ */
+extern CompactDate getTodaysCompactDate();
 extern std::chrono::year_month_day getTodaysDate();
 extern std::chrono::year_month_day getTodaysDatePlus(unsigned int offset);
 extern std::chrono::year_month_day getTodaysDateMinus(unsigned int offset);
+/*
+ * Converts a time of day such as "8:30 AM", "5:00 PM" or "17:00" to minutes after midnight.
+ */
+extern std::optional<std::chrono::minutes> parseTimeOfDay(std::string_view timeOfDay);
+
+/*
+ * Batch date conversions for bulk loads and exports. The output span must be at least as long
+ * as the input, formatISODates() writes ISODateLength characters per date without separators
+ * or a terminating null. Dates must be between MinimumBatchDate and MaximumBatchDate. NoDate
+ * converts to the default year_month_day and formats as 0000-00-00, a default year_month_day
+ * converts to NoDate.
+ */
+constexpr std::size_t ISODateLength = 10;
+constexpr CompactDate MinimumBatchDate{std::chrono::year_month_day{std::chrono::year{0}, std::chrono::January, std::chrono::day{1}}};
+constexpr CompactDate MaximumBatchDate{std::chrono::year_month_day{std::chrono::year{9999}, std::chrono::December, std::chrono::day{31}}};
+extern void convertDaysToDates(std::span<const CompactDate::DayNumber> days, std::span<std::chrono::year_month_day> dates);
+extern void convertDatesToDays(std::span<const std::chrono::year_month_day> dates, std::span<CompactDate::DayNumber> days);
+extern void formatISODates(std::span<const CompactDate::DayNumber> days, std::span<char> text);
+
+/*
+ * Appends the text as a quoted JSON string, escaping quotes, backslashes and control characters.
+ */
+extern void appendJSONString(std::string& json, std::string_view text);
 
 #endif // COMMONUTILITIES_H_
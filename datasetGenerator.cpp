@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstdlib>
+#include "DatasetGenerator.h"
+#include <format>
+#include <iostream>
+#include <string>
+
+/*
+ * Writes a reproducible user file and task file of any size, to load into a local database
+ * with the bulk loader:
+ *
+ *     protoPersonalPlanner -u USER -p PASSWORD --bulk-load --user-data-file USER_FILE --task-data-file TASK_FILE
+ *
+ * Usage: protoDatasetGenerator SETTINGS USER_FILE TASK_FILE
+ * SETTINGS are comma separated name=value pairs, see DatasetGenerator::parseSettings().
+ */
+int main(int argc, char* argv[])
+{
+    if (argc != 4)
+    {
+        std::cerr << std::format("Usage: {} SETTINGS USER_FILE TASK_FILE\n"
+            "SETTINGS is users=N,tasks=N,seed=N,depth=N,fan-in=N,fan-out=N,start=YYYY-MM-DD,days=N, "
+            "names that are left out keep their defaults\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const auto settings = DatasetGenerator::parseSettings(argv[1]);
+    if (!settings.has_value())
+    {
+        std::cerr << std::format("Invalid settings {}: {}\n", argv[1], settings.error());
+        return EXIT_FAILURE;
+    }
+
+    std::string userFileName(argv[2]);
+    std::string taskFileName(argv[3]);
+    DatasetGenerator generator(*settings);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!generator.writeUserFile(userFileName) || !generator.writeTaskFile(taskFileName))
+    {
+        std::cerr << generator.getAllErrorMessages();
+        return EXIT_FAILURE;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::clog << std::format("Wrote {} users to {} and {} tasks with {} parents and {} dependencies to {} in {:.1f}s\n",
+        settings->userCount, userFileName, settings->taskCount, generator.getParentCount(),
+        generator.getDependencyCount(), taskFileName, elapsed.count());
+
+    return EXIT_SUCCESS;
+}
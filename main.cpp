@@ -1,15 +1,34 @@
+#include <algorithm>
+#include "AllocationTracker.h"
+#include "BatchReplanner.h"
 #include <boost/asio.hpp>
 #include <boost/mysql.hpp>
+#include "BulkLoader.h"
+#include <chrono>
 #include "CommandLineParser.h"
 #include "commonUtilities.h"
-#include "CSVReader.h"
+#include "CSVImporter.h"
 #include <exception>
+#include <format>
+#include <fstream>
+#include "HardwareCounters.h"
 #include <iostream>
+#include "LoadTester.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include <numeric>
+#include "Profiler.h"
+#include "QueryStatistics.h"
+#include "ScheduleDbInterface.h"
+#include "SchedulePlanner.h"
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include "TaskDbInterface.h"
 #include "TaskModel.h"
+#include "TaskReadinessPropagator.h"
+#include "TaskStore.h"
 #include "UserDbInterface.h"
 #include "UserModel.h"
 #include "UtilityTimer.h"
@@ -30,22 +49,22 @@ static bool testGetUserByLoginAndPassword(UserDbInterface& userDBInterface, User
     {
         if (*retrievedUser != *insertedUser)
         {
-            std::cerr << "Insertion user and retrieved User are not the same. Test FAILED!\nInserted User:\n" <<
-            *insertedUser << "\n" "Retreived User:\n" << *retrievedUser << "\n";
+            Logger::error("Insertion user and retrieved User are not the same. Test FAILED!\nInserted User:\n{}\n"
+                "Retreived User:\n{}\n", *insertedUser, *retrievedUser);
             return false;
         }
     }
     else
     {
-        std::cerr << "userDBInterface.getUserByLogin(user->getLoginName()) FAILED!\n" <<
-            userDBInterface.getAllErrorMessages() << "\n";
+        Logger::error("userDBInterface.getUserByLogin(user->getLoginName()) FAILED!\n{}\n",
+            userDBInterface.getAllErrorMessages());
         return false;
     }
 
     retrievedUser = userDBInterface.getUserByLoginAndPassword(testName, "NotThePassword");
     if (retrievedUser)
     {
-        std::cerr << "userDBInterface.getUserByLogin(user->getLoginName()) Found user with fake password!\n";
+        Logger::error("userDBInterface.getUserByLogin(user->getLoginName()) Found user with fake password!\n");
         return false;
     }
 
@@ -63,15 +82,15 @@ static bool testGetUserByLoginName(UserDbInterface& userDBInterface, UserModel_s
         }
         else
         {
-            std::cerr << "Insertion user and retrieved User are not the same. Test FAILED!\nInserted User:\n" <<
-            *insertedUser << "\n" "Retreived User:\n" << *retrievedUser << "\n";
+            Logger::error("Insertion user and retrieved User are not the same. Test FAILED!\nInserted User:\n{}\n"
+                "Retreived User:\n{}\n", *insertedUser, *retrievedUser);
             return false;
         }
     }
     else
     {
-        std::cerr << "userDBInterface.getUserByLogin(user->getLoginName()) FAILED!\n" <<
-            userDBInterface.getAllErrorMessages() << "\n";
+        Logger::error("userDBInterface.getUserByLogin(user->getLoginName()) FAILED!\n{}\n",
+            userDBInterface.getAllErrorMessages());
         return false;
     }
 }
@@ -88,15 +107,14 @@ static bool testGetUserByFullName(UserDbInterface& userDBInterface, UserModel_sh
         }
         else
         {
-            std::cerr << "Insertion user and retrieved User are not the same. Test FAILED!\nInserted User:\n" <<
-            *insertedUser << "\n" "Retreived User:\n" << *retrievedUser << "\n";
+            Logger::error("Insertion user and retrieved User are not the same. Test FAILED!\nInserted User:\n{}\n"
+                "Retreived User:\n{}\n", *insertedUser, *retrievedUser);
             return false;
         }
     }
     else
     {
-        std::cerr << "userDBInterface.getUserByFullName() FAILED!\n" <<
-            userDBInterface.getAllErrorMessages() << "\n";
+        Logger::error("userDBInterface.getUserByFullName() FAILED!\n{}\n", userDBInterface.getAllErrorMessages());
         return false;
     }
 }
@@ -113,10 +131,10 @@ static bool testGetAllUsers(UserList userProfileTestData, UserDbInterface& userD
     }
     else
     {
-        std::clog << "Get All users FAILED! " << allUsers.size() << "\n";
+        Logger::info("Get All users FAILED! {}\n", allUsers.size());
         if (userProfileTestData.size() != allUsers.size())
         {
-            std::clog << std::format("Size differs: userProfileTestData.size({}) != llUsers.size({})",
+            Logger::info("Size differs: userProfileTestData.size({}) != llUsers.size({})",
                 userProfileTestData.size(), allUsers.size());
         }
         else
@@ -125,9 +143,8 @@ static bool testGetAllUsers(UserList userProfileTestData, UserDbInterface& userD
             {
                 if (*userProfileTestData[userLisetIdx] != *allUsers[userLisetIdx])
                 {
-                    std::clog << std::format("Original Data [{}]", userLisetIdx) << "\n" <<
-                        *userProfileTestData[userLisetIdx] << std::format("Database Data [{}]", userLisetIdx) << 
-                        "\n" << *allUsers[userLisetIdx] << "\n";
+                    Logger::info("Original Data [{}]\n{}Database Data [{}]\n{}\n", userLisetIdx,
+                        *userProfileTestData[userLisetIdx], userLisetIdx, *allUsers[userLisetIdx]);
                 }
             }
         }
@@ -138,71 +155,64 @@ static bool testGetAllUsers(UserList userProfileTestData, UserDbInterface& userD
     return testPassed;
 }
 
-static void loadTestUsersFromFile(std::string fileName, UserList& userProfileTestData)
-{
-    std::ifstream userData(fileName);
-    
-    for (auto row: CSVRange(userData))
-    {
-        UserModel_shp userIn = std::make_shared<UserModel>(UserModel());
-        userIn->setLastName(row[0]);
-        userIn->setFirstName(row[1]);
-        userIn->setMiddleInitial(row[2]);
-        userIn->setEmail(row[3]);
-        userIn->autoGenerateLoginAndPassword();
-        userProfileTestData.push_back(userIn);
-    }
-}
-
 static bool loadUserProfileTestDataIntoDatabase()
 {
-    // Test one case of the alternate constructor.
-    UserList userProfileTestData = {{std::make_shared<UserModel>("PacMan", "IN", "BW", "pacmaninbw@gmail.com")}};
-    loadTestUsersFromFile(programOptions.userTestDataFile, userProfileTestData);
-
     UserDbInterface userDBInterface;
     bool allTestsPassed = true;
 
+    // Test one case of the alternate constructor and of inserting a single user.
+    UserModel_shp pacMan = std::make_shared<UserModel>("PacMan", "IN", "BW", "pacmaninbw@gmail.com");
+    pacMan->setUserID(userDBInterface.insert(pacMan));
+    if (!pacMan->isInDataBase())
+    {
+        Logger::error("{}\n{}\n", userDBInterface.getAllErrorMessages(), *pacMan);
+        allTestsPassed = false;
+    }
+
+    CSVImporter userImporter;
+    userImporter.setKeepImportedModels(true);
+    if (!userImporter.importUsers(programOptions.userTestDataFile))
+    {
+        Logger::error("{}", userImporter.getAllErrorMessages());
+        allTestsPassed = false;
+    }
+
+    UserList userProfileTestData = userImporter.getImportedUsers();
+    userProfileTestData.insert(userProfileTestData.begin(), pacMan);
+
     for (auto user: userProfileTestData)
     {
-        std::size_t userID = userDBInterface.insert(user);
-        user->setUserID(userID);
-        if (!userID)
+        if (user->isInDataBase())
         {
-            std::cerr << userDBInterface.getAllErrorMessages() << "\n" << *user << "\n";
-            allTestsPassed = false;
-        }
-        else
-        {
-            if (user->isInDataBase())
+            if (!testGetUserByLoginName(userDBInterface, user))
             {
-                if (!testGetUserByLoginName(userDBInterface, user))
-                {
-                    allTestsPassed = false;
-                }
-
-                if (!testGetUserByLoginAndPassword(userDBInterface, user))
-                {
-                    allTestsPassed = false;
-                }
+                allTestsPassed = false;
+            }
 
-                if (!testGetUserByFullName(userDBInterface, user))
-                {
-                    allTestsPassed = false;
-                }
+            if (!testGetUserByLoginAndPassword(userDBInterface, user))
+            {
+                allTestsPassed = false;
             }
-            else
+
+            if (!testGetUserByFullName(userDBInterface, user))
             {
-                std::clog << "Primary key for user: " << user->getLastName() << ", " << user->getFirstName() << " not set!\n";
-                if (programOptions.verboseOutput)
-                {
-                    std::clog << *user << "\n\n";
-                }
                 allTestsPassed = false;
             }
         }
+        else
+        {
+            Logger::info("Primary key for user: {}, {} not set!\n", user->getLastName(), user->getFirstName());
+            if (programOptions.verboseOutput)
+            {
+                Logger::info("{}\n\n", *user);
+            }
+            allTestsPassed = false;
+        }
     }
 
+    // The writers of the importer insert their batches in parallel, getAllUsers() is in UserID order.
+    std::ranges::sort(userProfileTestData, {}, &UserModel::getUserID);
+
     if (allTestsPassed)
     {
         allTestsPassed = testGetAllUsers(userProfileTestData, userDBInterface);
@@ -212,12 +222,12 @@ static bool loadUserProfileTestDataIntoDatabase()
 
     if (allTestsPassed)
     {
-        std::clog << "Insertion and retrieval of users test PASSED!\n";
+        Logger::info("Insertion and retrieval of users test PASSED!\n");
         return true;
     }
     else
     {
-        std::cerr << "Some or all insertion and retrieval of users test FAILED!\n";
+        Logger::error("Some or all insertion and retrieval of users test FAILED!\n");
         return false;
     }
 }
@@ -233,18 +243,18 @@ static bool testGetTaskByDescription(TaskDbInterface& taskDBInterface, TaskModel
         }
         else
         {
-            std::clog << "Inserted and retrieved Task are not the same! Test FAILED!\n";
+            Logger::info("Inserted and retrieved Task are not the same! Test FAILED!\n");
             if (verboseOutput)
             {
-                std::clog << "Inserted Task:\n" << task << "\n" "Retreived Task:\n" << *testInDB << "\n";
+                Logger::info("Inserted Task:\n{}\nRetreived Task:\n{}\n", task, *testInDB);
             }
             return false;
         }
     }
     else
     {
-        std::cerr << "userDBInterface.getTaskByDescription(task.getDescription())) FAILED!\n" 
-            << taskDBInterface.getAllErrorMessages() << "\n";
+        Logger::error("userDBInterface.getTaskByDescription(task.getDescription())) FAILED!\n{}\n",
+            taskDBInterface.getAllErrorMessages());
         return false;
     }
 }
@@ -260,18 +270,18 @@ static bool testGetTaskByID(TaskDbInterface& taskDBInterface, TaskModel& task, b
         }
         else
         {
-            std::clog << "Inserted and retrieved Task are not the same! Test FAILED!\n";
+            Logger::info("Inserted and retrieved Task are not the same! Test FAILED!\n");
             if (verboseOutput)
             {
-                std::clog << "Inserted Task:\n" << task << "\n" "Retreived Task:\n" << *testInDB << "\n";
+                Logger::info("Inserted Task:\n{}\nRetreived Task:\n{}\n", task, *testInDB);
             }
             return false;
         }
     }
     else
     {
-        std::cerr << "userDBInterface.getTaskByDescription(task.getTaskByTaskID())) FAILED!\n" 
-            << taskDBInterface.getAllErrorMessages() << "\n";
+        Logger::error("userDBInterface.getTaskByDescription(task.getTaskByTaskID())) FAILED!\n{}\n",
+            taskDBInterface.getAllErrorMessages());
         return false;
     }
 }
@@ -281,156 +291,415 @@ static bool testGetUnstartedTasks(TaskDbInterface& taskDBInterface, UserModel_sh
     TaskList notStartedList = taskDBInterface.getUnstartedDueForStartForAssignedUser(assigned);
     if (!notStartedList.empty())
     {
-        std::clog << std::format("Find unstarted tasks for user({}) PASSED!\n", assigned->getUserID());
+        Logger::info("Find unstarted tasks for user({}) PASSED!\n", assigned->getUserID());
         
         if (verboseOutput)
         {
-            std::clog << std::format("User {} has {} unstarted tasks\n",
-                assigned->getUserID(), notStartedList.size());
+            Logger::info("User {} has {} unstarted tasks\n", assigned->getUserID(), notStartedList.size());
             for (auto task: notStartedList)
             {
-                std::clog << *task << "\n";
+                Logger::info("{}\n", *task);
             }
         }
         return true; 
     }
 
-    std::cerr << std::format("taskDBInterface.getUnstartedDueForStartForAssignedUser({}) FAILED!\n", assigned->getUserID()) <<
-        taskDBInterface.getAllErrorMessages() << "\n";
+    Logger::error("taskDBInterface.getUnstartedDueForStartForAssignedUser({}) FAILED!\n{}\n", assigned->getUserID(),
+        taskDBInterface.getAllErrorMessages());
 
     return false;
 }
 
-struct UserTaskTestData
+static bool testSetDependencies(TaskDbInterface& taskDBInterface, TaskList& insertedTasks, bool verboseOutput)
 {
-    char majorPriority;
-    unsigned int minorPriority;
-    std::string description;
-    std::string dueDate;
-    unsigned int estimatedEffortHours;
-    double actualEffortHours;
-    std::size_t parentTask;
-    std::string dependencies;
-    std::string status;
-    std::string scheduledStartDate;
-    std::string actualStartDate;
-    std::string createdDate;
-    std::string dueDate2;
-    std::string estimatedCompletionDate;
-};
-
-static std::chrono::year_month_day stringToDate(std::string dateString)
+    if (insertedTasks.size() < 4)
+    {
+        return true;
+    }
+
+    TaskModel_shp dependentTask = insertedTasks.back();
+    std::vector<std::vector<std::size_t>> dependencySets = {
+        {insertedTasks[0]->getTaskID(), insertedTasks[1]->getTaskID()},
+        {insertedTasks[1]->getTaskID(), insertedTasks[2]->getTaskID()},
+        {}
+    };
+
+    for (auto dependencySet: dependencySets)
+    {
+        dependentTask->setDependencies(dependencySet);
+        if (!taskDBInterface.setDependencies(dependentTask))
+        {
+            Logger::error("taskDBInterface.setDependencies() FAILED!\n{}\n", taskDBInterface.getAllErrorMessages());
+            return false;
+        }
+
+        TaskModel_shp testInDB = taskDBInterface.getTaskByTaskID(dependentTask->getTaskID());
+        if (!testInDB || testInDB->getDependencies() != dependencySet)
+        {
+            Logger::info("Stored and expected dependencies are not the same! Test FAILED!\n");
+            if (verboseOutput && testInDB)
+            {
+                Logger::info("Expected Task:\n{}\nRetreived Task:\n{}\n", *dependentTask, *testInDB);
+            }
+            return false;
+        }
+    }
+
+    Logger::info("Set task dependencies test PASSED!\n");
+
+    return true;
+}
+
+static bool testGetDependentTasks(TaskDbInterface& taskDBInterface, TaskList& insertedTasks, bool verboseOutput)
 {
-    std::chrono::year_month_day dateValue = getTodaysDate();
+    if (insertedTasks.size() < 2)
+    {
+        return true;
+    }
 
-    // First try the ISO standard date.
-    std::istringstream ss(dateString);
-    ss >> std::chrono::parse("%Y-%m-%d", dateValue);
-    if (!ss.fail())
+    TaskModel_shp dependency = insertedTasks.front();
+    TaskModel_shp dependentTask = insertedTasks.back();
+    dependentTask->setDependencies({dependency->getTaskID()});
+    if (!taskDBInterface.setDependencies(dependentTask))
     {
-        return dateValue;
+        Logger::error("taskDBInterface.setDependencies() FAILED!\n{}\n", taskDBInterface.getAllErrorMessages());
+        return false;
     }
 
-    // The ISO standard didn't work, try some local dates
-    std::locale usEnglish("en_US.UTF-8");
-    std::vector<std::string> legalFormats = {
-        {"%B %d, %Y"},
-        {"%m/%d/%Y"},
-        {"%m-%d-%Y"}
-    };
+    TaskList dependents = taskDBInterface.getDependentTasks(dependency);
+    bool testPassed = std::ranges::any_of(dependents,
+        [&dependentTask](TaskModel_shp task) { return *task == dependentTask; });
+
+    dependentTask->setDependencies({});
+    taskDBInterface.setDependencies(dependentTask);
 
-    ss.imbue(usEnglish);
-    for (auto legalFormat: legalFormats)
+    if (!testPassed)
     {
-        ss >> std::chrono::parse(legalFormat, dateValue);
-        if (!ss.fail())
+        Logger::info("Task {} not found in dependents of task {}! Test FAILED!\n",
+            dependentTask->getTaskID(), dependency->getTaskID());
+        if (verboseOutput)
         {
-            return dateValue;
+            for (auto task: dependents)
+            {
+                Logger::info("{}\n", *task);
+            }
         }
+        return false;
     }
 
-    return dateValue;
+    Logger::info("Get dependent tasks test PASSED!\n");
+
+    return true;
 }
 
-static std::vector<UserTaskTestData> loadTasksFromDataFile(std::string taskFileName)
+static bool testGenerateSchedule(UserModel_shp user, bool verboseOutput)
 {
-    std::vector<UserTaskTestData> inputTaskData;
-
-    std::ifstream taskDataFile(taskFileName);
-    
-    for (auto row: CSVRange(taskDataFile))
-    {
-        UserTaskTestData currentTask;
-        currentTask.majorPriority = row[0][0];
-        currentTask.minorPriority = std::stoi(row[1]);
-        currentTask.description = row[2];
-        currentTask.dueDate = row[3];
-        currentTask.estimatedEffortHours = std::stoi(row[4]);
-        currentTask.actualEffortHours = std::stod(row[5]);
-        currentTask.parentTask = std::stoi(row[6]);
-        currentTask.status = row[7];
-        currentTask.scheduledStartDate = row[8];
-        currentTask.actualStartDate = row[9];
-        currentTask.createdDate = row[10];
-        currentTask.dueDate2 = row[11];
-        if (row.size() > 12)
+    constexpr unsigned int scheduleDays = 14;
+    std::chrono::year_month_day firstDay = getTodaysDate();
+    std::chrono::year_month_day lastDay = getTodaysDatePlus(scheduleDays - 1);
+
+    SchedulePlanner planner;
+    if (!planner.planUser(user, firstDay, lastDay))
+    {
+        Logger::error("planner.planUser({}) FAILED!\n{}\n", user->getUserID(), planner.getAllErrorMessages());
+        return false;
+    }
+
+    ScheduleDbInterface scheduleDbInterface;
+    ScheduleItemList storedItems = scheduleDbInterface.getScheduleItemsForUser(*user, firstDay, lastDay);
+    std::size_t generatedItems = std::ranges::count_if(storedItems,
+        [](const ScheduleItemModel& item) { return item.isGeneratedTaskExecution(); });
+
+    if (generatedItems != planner.getLastResult().taskExecutionItems.size())
+    {
+        Logger::info("Generated {} schedule items but found {} in the database! Test FAILED!\n",
+            planner.getLastResult().taskExecutionItems.size(), generatedItems);
+        return false;
+    }
+
+    if (verboseOutput)
+    {
+        for (const auto& item: storedItems)
         {
-            currentTask.estimatedCompletionDate = row[12];
+            Logger::info("{}\n", item);
         }
+    }
+
+    Logger::info("Generate schedule for user({}) PASSED!\n", user->getUserID());
+
+    return true;
+}
 
-        inputTaskData.push_back(currentTask);
+static bool testIncrementalReschedule(TaskDbInterface& taskDBInterface, TaskList& insertedTasks, UserModel_shp user,
+    bool verboseOutput)
+{
+    constexpr unsigned int scheduleDays = 14;
+    std::chrono::year_month_day firstDay = getTodaysDate();
+    std::chrono::year_month_day lastDay = getTodaysDatePlus(scheduleDays - 1);
+
+    SchedulePlanner planner;
+    if (!planner.planUser(user, firstDay, lastDay) || !planner.replanUser(user, firstDay, lastDay))
+    {
+        Logger::error("planner.replanUser({}) FAILED!\n{}\n", user->getUserID(), planner.getAllErrorMessages());
+        return false;
     }
 
-    return inputTaskData;
+    if (!planner.getLastChanges().removedItems.empty() || !planner.getLastChanges().addedItems.empty())
+    {
+        Logger::info("Rescheduling without any edits changed the schedule! Test FAILED!\n");
+        return false;
+    }
+
+    if (insertedTasks.size() < 2)
+    {
+        return true;
+    }
+
+    TaskModel_shp dependentTask = insertedTasks.back();
+    dependentTask->setDependencies({insertedTasks.front()->getTaskID()});
+    if (!taskDBInterface.setDependencies(dependentTask) || !planner.replanUser(user, firstDay, lastDay))
+    {
+        Logger::error("Edit and replan FAILED!\n{}{}\n", taskDBInterface.getAllErrorMessages(),
+            planner.getAllErrorMessages());
+        return false;
+    }
+
+    SchedulePlanner fullPlanner;
+    bool testPassed = fullPlanner.planUser(user, firstDay, lastDay) &&
+        fullPlanner.getLastResult().taskExecutionItems == planner.getLastResult().taskExecutionItems;
+
+    dependentTask->setDependencies({});
+    taskDBInterface.setDependencies(dependentTask);
+
+    if (!testPassed)
+    {
+        Logger::info("Incremental and full schedules are not the same! Test FAILED!\n");
+        if (verboseOutput)
+        {
+            for (const auto& item: planner.getLastResult().taskExecutionItems)
+            {
+                Logger::info("{}\n", item);
+            }
+        }
+        return false;
+    }
+
+    if (verboseOutput)
+    {
+        Logger::info("Rescheduling removed {} and added {} schedule items\n",
+            planner.getLastChanges().removedItems.size(), planner.getLastChanges().addedItems.size());
+    }
+
+    Logger::info("Incremental reschedule for user({}) PASSED!\n", user->getUserID());
+
+    return true;
 }
 
-static void commonTaskInit(TaskModel_shp newTask, const UserTaskTestData taskData)
+static bool testBatchReplan(bool verboseOutput)
 {
-    // Required fields first.
-    newTask->setEstimatedEffort(taskData.estimatedEffortHours);
-    newTask->setActualEffortToDate(taskData.actualEffortHours);
-    newTask->setDueDate(stringToDate(taskData.dueDate));
-    newTask->setScheduledStart(stringToDate(taskData.scheduledStartDate));
-    newTask->setStatus(taskData.status);
-    newTask->setPriorityGroup(taskData.majorPriority);
-    newTask->setPriority(taskData.minorPriority);
-    newTask->setPercentageComplete(0.0);
+    constexpr unsigned int scheduleDays = 14;
+    std::chrono::year_month_day firstDay = getTodaysDate();
+    std::chrono::year_month_day lastDay = getTodaysDatePlus(scheduleDays - 1);
 
-    // Optional fields
-    if (taskData.parentTask)
+    UserDbInterface userDBInterface;
+    UserList allUsers = userDBInterface.getAllUsers();
+
+    BatchReplanner replanner;
+    if (!replanner.replanUsers(allUsers, firstDay, lastDay) || replanner.getPlannedUserCount() != allUsers.size())
     {
-        newTask->setParentTaskID(taskData.parentTask);
+        Logger::error("replanner.replanUsers() planned {} of {} users, FAILED!\n{}\n",
+            replanner.getPlannedUserCount(), allUsers.size(), replanner.getAllErrorMessages());
+        return false;
     }
-    if (!taskData.actualStartDate.empty())
+
+    if (verboseOutput || programOptions.enableExecutionTime)
     {
-        newTask->setactualStartDate(stringToDate(taskData.actualStartDate));
+        BatchReplanner::PhaseTimings timings = replanner.getPhaseTimings();
+        Logger::info("Batch replan of {} users on {} workers: load {:.3f}s schedule {:.3f}s write {:.3f}s"
+            " elapsed {:.3f}s\n", allUsers.size(), replanner.getWorkerCount(), timings.load.count(),
+            timings.schedule.count(), timings.write.count(), timings.elapsed.count());
     }
-    if (!taskData.estimatedCompletionDate.empty())
+
+    Logger::info("Batch replan of all users PASSED!\n");
+
+    return true;
+}
+
+static bool testTaskStore(TaskDbInterface& taskDBInterface, UserModel_shp user, bool verboseOutput)
+{
+    TaskStore taskStore = taskDBInterface.getTaskStoreForAssignedUser(user);
+    if (taskStore.empty())
     {
-        newTask->setEstimatedCompletion(stringToDate(taskData.estimatedCompletionDate));
+        Logger::error("taskDBInterface.getTaskStoreForAssignedUser({}) FAILED!\n{}\n", user->getUserID(),
+            taskDBInterface.getAllErrorMessages());
+        return false;
     }
-    if (!taskData.createdDate.empty())
+
+    double estimatedEffortTotal = 0.0;
+    for (TaskStore::RowIndex row = 0; row < taskStore.size(); ++row)
     {
-        // Override the auto date creation with the actual creation date.
-        newTask->setCreationDate(stringToDate(taskData.createdDate));
+        TaskModel_shp storedTask = taskStore.toTaskModel(row);
+        TaskModel_shp taskInDB = taskDBInterface.getTaskByTaskID(storedTask->getTaskID());
+        if (!taskInDB || !(*taskInDB == storedTask) || taskInDB->rawStatus() != storedTask->rawStatus() ||
+            taskInDB->getDueDate() != storedTask->getDueDate() ||
+            taskInDB->getEstimatedEffort() != storedTask->getEstimatedEffort() ||
+            taskInDB->getDependencies() != storedTask->getDependencies())
+        {
+            Logger::info("Task {} from the TaskStore does not match the database! Test FAILED!\n",
+                storedTask->getTaskID());
+            if (verboseOutput)
+            {
+                Logger::info("{}\n", *storedTask);
+            }
+            return false;
+        }
+        estimatedEffortTotal += taskInDB->getEstimatedEffort();
     }
+
+    std::span<const float> estimatedEfforts = taskStore.getEstimatedEfforts();
+    if (std::accumulate(estimatedEfforts.begin(), estimatedEfforts.end(), 0.0) != estimatedEffortTotal)
+    {
+        Logger::info("TaskStore estimated effort column does not match the tasks! Test FAILED!\n");
+        return false;
+    }
+
+    Logger::info("TaskStore for user({}) PASSED!\n", user->getUserID());
+
+    return true;
 }
 
-static TaskModel_shp creatOddTask(const UserModel_shp userOne, const UserTaskTestData taskData)
+/*
+ * Tasks A, B and C are in progress. D waits on A and B, E waits on A and C, F is on hold with a
+ * dependency on A and G waits on B. Completing A and B releases D and G only, completing C then
+ * releases E.
+ */
+static bool testCompleteTasksAndReleaseDependents(TaskDbInterface& taskDBInterface, UserModel_shp user,
+    bool verboseOutput)
 {
-    TaskModel_shp newTask = std::make_shared<TaskModel>(userOne, taskData.description);
-    commonTaskInit(newTask, taskData);
+    struct ReadinessTestTask
+    {
+        std::string_view name;
+        TaskModel::TaskStatus status;
+        std::vector<std::size_t> dependencyIndexes;
+    };
+    const std::vector<ReadinessTestTask> testTasks = {
+        {"A", TaskModel::TaskStatus::Work_in_Progress, {}},
+        {"B", TaskModel::TaskStatus::Work_in_Progress, {}},
+        {"C", TaskModel::TaskStatus::Work_in_Progress, {}},
+        {"D", TaskModel::TaskStatus::Waiting_for_Dependency, {0, 1}},
+        {"E", TaskModel::TaskStatus::Waiting_for_Dependency, {0, 2}},
+        {"F", TaskModel::TaskStatus::On_Hold, {0}},
+        {"G", TaskModel::TaskStatus::Waiting_for_Dependency, {1}}
+    };
+
+    TaskList tasks;
+    for (const auto& testTask: testTasks)
+    {
+        TaskModel_shp task = std::make_shared<TaskModel>(user, std::format("Readiness test task {}", testTask.name));
+        task->setStatus(testTask.status);
+        task->setScheduledStart(getTodaysCompactDate());
+        task->setDueDate(CompactDate(getTodaysDatePlus(7)));
+        task->setEstimatedEffort(1);
+        task->setPriorityGroup(1);
+        task->setPriority(1);
+        for (auto dependencyIndex: testTask.dependencyIndexes)
+        {
+            task->addDependency(tasks[dependencyIndex]);
+        }
+        task->setTaskID(taskDBInterface.insert(task));
+        if (!task->isInDatabase())
+        {
+            Logger::error("taskDBInterface.insert() FAILED!\n{}\n", taskDBInterface.getAllErrorMessages());
+            return false;
+        }
+        tasks.push_back(task);
+    }
+
+    auto checkStatuses = [&tasks, &testTasks, &taskDBInterface](std::vector<TaskModel::TaskStatus> expectedStatuses)
+    {
+        for (std::size_t index = 0; index < tasks.size(); ++index)
+        {
+            TaskModel_shp taskInDB = taskDBInterface.getTaskByTaskID(tasks[index]->getTaskID());
+            if (!taskInDB || taskInDB->getStatus() != expectedStatuses[index])
+            {
+                Logger::info("Task {} has status {}, expected {}! Test FAILED!\n", testTasks[index].name,
+                    taskInDB? static_cast<int>(taskInDB->getStatus()) : -1, static_cast<int>(expectedStatuses[index]));
+                return false;
+            }
+        }
+        return true;
+    };
+
+    TaskReadinessPropagator propagator(taskDBInterface);
+    std::vector<std::size_t> listenedTaskIDs;
+    propagator.setReleasedTaskListener([&listenedTaskIDs](std::size_t releasedTaskID)
+        { listenedTaskIDs.push_back(releasedTaskID); });
+
+    propagator.taskCompleted(tasks[0]);
+    propagator.taskCompleted(tasks[1]);
+    std::vector<std::size_t> releasedTaskIDs = propagator.propagate();
+    std::vector<std::size_t> expectedTaskIDs = {tasks[3]->getTaskID(), tasks[6]->getTaskID()};
+    if (!propagator.getAllErrorMessages().empty() || releasedTaskIDs != expectedTaskIDs ||
+        listenedTaskIDs != expectedTaskIDs)
+    {
+        Logger::error("Completing tasks A and B released {} tasks, expected D and G! Test FAILED!\n{}\n",
+            releasedTaskIDs.size(), propagator.getAllErrorMessages());
+        return false;
+    }
+
+    using enum TaskModel::TaskStatus;
+    if (!checkStatuses({Complete, Complete, Work_in_Progress, Not_Started, Waiting_for_Dependency, On_Hold, Not_Started}))
+    {
+        return false;
+    }
 
-    return newTask;
+    releasedTaskIDs = taskDBInterface.completeTasksAndReleaseDependents({tasks[2]->getTaskID()});
+    if (releasedTaskIDs != std::vector<std::size_t>{tasks[4]->getTaskID()} ||
+        !checkStatuses({Complete, Complete, Complete, Not_Started, Not_Started, On_Hold, Not_Started}))
+    {
+        Logger::error("Completing task C did not release only task E! Test FAILED!\n{}\n",
+            taskDBInterface.getAllErrorMessages());
+        return false;
+    }
+
+    if (verboseOutput)
+    {
+        for (auto task: tasks)
+        {
+            Logger::info("{}\n", *task);
+        }
+    }
+
+    Logger::info("Complete tasks and release dependents test PASSED!\n");
+
+    return true;
 }
 
-static TaskModel_shp creatEvenTask(const UserModel_shp userOne, const UserTaskTestData taskData)
+/*
+ * A short run of the default operation mix against the test data. Every operation must succeed,
+ * unstarted task queries for users without unstarted tasks included.
+ */
+static bool testLoadTester(bool verboseOutput)
 {
-    TaskModel_shp newTask = std::make_shared<TaskModel>(userOne);
-    newTask->setDescription(taskData.description);
-    commonTaskInit(newTask, taskData);
+    LoadTester::Settings settings;
+    settings.virtualUsers = 2;
+    settings.duration = std::chrono::seconds(3);
+
+    LoadTester loadTester(settings);
+    if (!loadTester.runLoadTest())
+    {
+        Logger::error("LoadTester::runLoadTest() with the default mix FAILED!\n{}\n", loadTester.getAllErrorMessages());
+        return false;
+    }
 
-    return newTask;
+    if (verboseOutput)
+    {
+        Logger::info("{}\n", loadTester.getTextReport());
+    }
+
+    Logger::info("Load test with the default operation mix PASSED!\n");
+
+    return true;
 }
 
 static bool loadUserTaskestDataIntoDatabase()
@@ -439,46 +708,33 @@ static bool loadUserTaskestDataIntoDatabase()
     UserModel_shp userOne = userDbInterface.getUserByUserID(1);
     if (!userOne)
     {
-        std::cerr << "Failed to retrieve userOne from DataBase!\n";
+        Logger::error("Failed to retrieve userOne from DataBase!\n");
         return false;
     }
 
     TaskDbInterface taskDBInterface;
     bool allTestsPassed = true;
-    std::size_t lCount = 0;
-    std::vector<UserTaskTestData> userTaskTestData = loadTasksFromDataFile(programOptions.taskTestDataFile);
 
-    for (auto taskTestData: userTaskTestData)
+    CSVImporter taskImporter;
+    taskImporter.setKeepImportedModels(true);
+    if (!taskImporter.importTasks(programOptions.taskTestDataFile, userOne))
     {
-        // Try both constructors on an alternating basis.
-        TaskModel_shp testTask = (lCount & 0x000001)? creatOddTask(userOne, taskTestData) :
-            creatEvenTask(userOne, taskTestData);
-        testTask->setTaskID(taskDBInterface.insert(testTask));
+        Logger::error("{}", taskImporter.getAllErrorMessages());
+        allTestsPassed = false;
+    }
 
-        if (testTask->isInDatabase())
+    TaskList insertedTasks = taskImporter.getImportedTasks();
+    for (auto testTask: insertedTasks)
+    {
+        if (!testGetTaskByID(taskDBInterface, *testTask, programOptions.verboseOutput))
         {
-            if (!testGetTaskByID(taskDBInterface, *testTask, programOptions.verboseOutput))
-            {
-                allTestsPassed = false;
-            }
-
-            if (!testGetTaskByDescription(taskDBInterface, *testTask, *userOne, programOptions.verboseOutput))
-            {
-                allTestsPassed = false;
-            }
+            allTestsPassed = false;
         }
-        else
+
+        if (!testGetTaskByDescription(taskDBInterface, *testTask, *userOne, programOptions.verboseOutput))
         {
-            std::cerr << taskDBInterface.getAllErrorMessages() << *testTask << "\n";
-            std::clog << "Primary key for task: " << testTask->getTaskID() << ", " << testTask->getDescription() <<
-            " not set!\n";
-            if (programOptions.verboseOutput)
-            {
-                std::clog << *testTask << "\n\n";
-            }
             allTestsPassed = false;
         }
-        ++lCount;
     }
 
     if (allTestsPassed)
@@ -488,39 +744,334 @@ static bool loadUserTaskestDataIntoDatabase()
 
     if (allTestsPassed)
     {
-        std::clog << "All Task insertions and retrival tests PASSED\n";
+        allTestsPassed = testSetDependencies(taskDBInterface, insertedTasks, programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testGetDependentTasks(taskDBInterface, insertedTasks, programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testGenerateSchedule(userOne, programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testIncrementalReschedule(taskDBInterface, insertedTasks, userOne, programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testBatchReplan(programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testTaskStore(taskDBInterface, userOne, programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testCompleteTasksAndReleaseDependents(taskDBInterface, userOne, programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        allTestsPassed = testLoadTester(programOptions.verboseOutput);
+    }
+
+    if (allTestsPassed)
+    {
+        Logger::info("All Task insertions and retrival tests PASSED\n");
     }
     else
     {
-        std::clog << "Some or all Task related tests FAILED!\n";
+        Logger::info("Some or all Task related tests FAILED!\n");
     }
 
     return allTestsPassed;
 }
 
+/*
+ * Initial load of large user and task files, the tasks are owned by the user with UserID 1.
+ */
+static bool bulkLoadDataFiles()
+{
+    BulkLoader bulkLoader;
+    bulkLoader.setStagingDirectory(programOptions.bulkLoadDirectory);
+
+    bool loadedUsers = bulkLoader.loadUsers(programOptions.userTestDataFile);
+    Logger::info("Bulk loaded {} of {} users from {}\n", bulkLoader.getLoadedCount(),
+        bulkLoader.getRecordCount(), programOptions.userTestDataFile);
+    if (!loadedUsers)
+    {
+        Logger::error("{}\n", bulkLoader.getAllErrorMessages());
+    }
+
+    UserDbInterface userDbInterface;
+    UserModel_shp userOne = userDbInterface.getUserByUserID(1);
+    if (!userOne)
+    {
+        Logger::error("Failed to retrieve userOne from DataBase!\n");
+        return false;
+    }
+
+    bool loadedTasks = bulkLoader.loadTasks(programOptions.taskTestDataFile, userOne);
+    Logger::info("Bulk loaded {} of {} tasks from {}\n", bulkLoader.getLoadedCount(),
+        bulkLoader.getRecordCount(), programOptions.taskTestDataFile);
+    if (!loadedTasks)
+    {
+        Logger::error("{}\n", bulkLoader.getAllErrorMessages());
+    }
+
+    return loadedUsers && loadedTasks;
+}
+
+/*
+ * Daily re-import of the user and task files, the tasks are owned by the user with UserID 1.
+ */
+static bool synchronizeDataFiles()
+{
+    CSVImporter importer;
+
+    bool syncedUsers = importer.syncUsers(programOptions.userTestDataFile);
+    Logger::info("Synchronized {} users from {}: {} written, {} unchanged\n", importer.getRecordCount(),
+        programOptions.userTestDataFile, importer.getImportedCount(), importer.getUnchangedCount());
+    if (!syncedUsers)
+    {
+        Logger::error("{}", importer.getAllErrorMessages());
+    }
+
+    UserDbInterface userDbInterface;
+    UserModel_shp userOne = userDbInterface.getUserByUserID(1);
+    if (!userOne)
+    {
+        Logger::error("Failed to retrieve userOne from DataBase!\n");
+        return false;
+    }
+
+    bool syncedTasks = importer.syncTasks(programOptions.taskTestDataFile, userOne);
+    Logger::info("Synchronized {} tasks from {}: {} written, {} unchanged\n", importer.getRecordCount(),
+        programOptions.taskTestDataFile, importer.getImportedCount(), importer.getUnchangedCount());
+    if (!syncedTasks)
+    {
+        Logger::error("{}", importer.getAllErrorMessages());
+    }
+
+    return syncedUsers && syncedTasks;
+}
+
+static bool writeJSONReport(const std::string& fileName, const std::string& report)
+{
+    std::ofstream reportFile(fileName);
+    if (!(reportFile << report))
+    {
+        Logger::error("Can't write the report to {}\n", fileName);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Concurrent load against the users and tasks already in the database, such as those of a bulk
+ * load. The inserts add tasks that are not removed afterwards.
+ */
+static bool runLoadTest()
+{
+    const auto mix = LoadTester::parseMix(programOptions.loadTestMix);
+    if (!mix.has_value())
+    {
+        Logger::error("Invalid load test mix {}: {}\n", programOptions.loadTestMix, mix.error());
+        return false;
+    }
+
+    LoadTester::Settings settings;
+    settings.virtualUsers = programOptions.loadTestUsers;
+    settings.duration = std::chrono::seconds(programOptions.loadTestSeconds);
+    settings.targetRate = programOptions.loadTestRate;
+    settings.mix = *mix;
+
+    LoadTester loadTester(settings);
+    bool succeeded = loadTester.runLoadTest();
+    if (!succeeded)
+    {
+        Logger::error("{}", loadTester.getAllErrorMessages());
+    }
+
+    Logger::info("\nLoad test\n{}\n", loadTester.getTextReport());
+    if (!programOptions.loadTestJSONFile.empty() &&
+        !writeJSONReport(programOptions.loadTestJSONFile, loadTester.getJSONReport()))
+    {
+        succeeded = false;
+    }
+
+    return succeeded;
+}
+
+/*
+ * Every run is profiled and its statements measured, the reports are only written when they are
+ * requested. A trace is written and the metrics are served while the program runs, both are
+ * closed here.
+ */
+static bool writeReports()
+{
+    bool reportsWritten = true;
+    Metrics::stopEndpoint();
+    if (Profiler::isTracing() && !Profiler::stopTrace())
+    {
+        Logger::error("Can't write the trace to {}\n", programOptions.traceFile);
+        reportsWritten = false;
+    }
+
+    // The text reports are written directly, after the messages logged before them.
+    Logger::flush();
+    if (programOptions.profileOutput)
+    {
+        std::clog << "\nProfile of the database calls\n" << Profiler::getTextReport() << "\n";
+    }
+
+    if (programOptions.queryStatisticsOutput)
+    {
+        std::clog << "\nDatabase statements\n" << QueryStatistics::getTextReport() << "\n";
+    }
+
+    if (programOptions.hardwareCountersOutput && HardwareCounters::isEnabled())
+    {
+        std::clog << "\nHardware counters per zone call\n" << HardwareCounters::getTextReport() << "\n";
+    }
+
+    if (!programOptions.profileJSONFile.empty() &&
+        !writeJSONReport(programOptions.profileJSONFile, Profiler::getJSONReport()))
+    {
+        reportsWritten = false;
+    }
+    if (!programOptions.queryStatisticsJSONFile.empty() &&
+        !writeJSONReport(programOptions.queryStatisticsJSONFile, QueryStatistics::getJSONReport()))
+    {
+        reportsWritten = false;
+    }
+    if (!programOptions.hardwareCountersJSONFile.empty() && HardwareCounters::isEnabled() &&
+        !writeJSONReport(programOptions.hardwareCountersJSONFile, HardwareCounters::getJSONReport()))
+    {
+        reportsWritten = false;
+    }
+
+    return reportsWritten;
+}
+
+/*
+ * Each database method is checked against its own budget, or the budget for every method, with
+ * the most allocations any one of its calls made.
+ */
+static bool checkAllocationBudgets()
+{
+    bool withinBudgets = true;
+    for (const auto& zone: Profiler::getReport())
+    {
+        if (zone.depth != 0)
+        {
+            continue;
+        }
+
+        const AllocationBudget* zoneBudget = nullptr;
+        for (const auto& budget: programOptions.allocationBudgets)
+        {
+            if (budget.method.empty()? zoneBudget == nullptr :
+                zone.name.find(budget.method + "(") != std::string_view::npos)
+            {
+                zoneBudget = &budget;
+            }
+        }
+
+        if (zoneBudget != nullptr && zone.maximumAllocations > zoneBudget->allocations)
+        {
+            Logger::error("Allocation budget exceeded: {} made {} allocations in one call, "
+                "the budget is {}\n", zone.name, zone.maximumAllocations, zoneBudget->allocations);
+            withinBudgets = false;
+        }
+    }
+
+    return withinBudgets;
+}
+
 int main(int argc, char* argv[])
 {
     try {
 		if (const auto progOptions = parseCommandLine(argc, argv); progOptions.has_value())
 		{
 			programOptions = *progOptions;
+            QueryStatistics::setSlowQueryThreshold(std::chrono::milliseconds(programOptions.slowQueryMs));
+            QueryStatistics::setMeasuringResultBytes(programOptions.queryStatisticsOutput ||
+                !programOptions.queryStatisticsJSONFile.empty());
+            if (programOptions.allocationStatistics || !programOptions.allocationBudgets.empty())
+            {
+                AllocationTracker::enable();
+            }
+            // Without the counters the program runs as usual, only the report is missing.
+            if ((programOptions.hardwareCountersOutput || !programOptions.hardwareCountersJSONFile.empty()) &&
+                !HardwareCounters::enable())
+            {
+                Logger::error("Hardware counters aren't available, there will be no counter report\n{}",
+                    HardwareCounters::getErrorMessage());
+            }
+            if (!programOptions.metricsSocket.empty() && !Metrics::startEndpoint(programOptions.metricsSocket))
+            {
+                Logger::error("Can't serve metrics on {}\n{}", programOptions.metricsSocket,
+                    Metrics::getEndpointErrorMessage());
+                return EXIT_FAILURE;
+            }
+            if (!programOptions.traceFile.empty() && !Profiler::startTrace(programOptions.traceFile))
+            {
+                Logger::error("Can't create the trace file {}\n", programOptions.traceFile);
+                Metrics::stopEndpoint();
+                return EXIT_FAILURE;
+            }
             UtilityTimer stopWatch;
-            if (loadUserProfileTestDataIntoDatabase())
+            bool succeeded = false;
+            if (programOptions.bulkLoad)
             {
-                if (!loadUserTaskestDataIntoDatabase())
+                succeeded = bulkLoadDataFiles();
+                if (programOptions.enableExecutionTime)
                 {
-                    return EXIT_FAILURE;
+                    stopWatch.stopTimerAndReport("Bulk load of users and tasks into MySQL database\n");
+                }
+            }
+            else if (programOptions.syncDataFiles)
+            {
+                succeeded = synchronizeDataFiles();
+                if (programOptions.enableExecutionTime)
+                {
+                    stopWatch.stopTimerAndReport("Synchronization of users and tasks with MySQL database\n");
+                }
+            }
+            else if (programOptions.loadTest)
+            {
+                succeeded = runLoadTest();
+                if (programOptions.enableExecutionTime)
+                {
+                    stopWatch.stopTimerAndReport("Load test of the MySQL database\n");
                 }
             }
             else
+            {
+                succeeded = loadUserProfileTestDataIntoDatabase() && loadUserTaskestDataIntoDatabase();
+                if (succeeded)
+                {
+                    Logger::info("All tests Passed\n");
+                    if (programOptions.enableExecutionTime)
+                    {
+                        stopWatch.stopTimerAndReport("Testing of Insertion and retrieval of users and tasks in MySQL database\n");
+                    }
+                }
+            }
+            if (!writeReports() || !checkAllocationBudgets())
             {
                 return EXIT_FAILURE;
             }
-            std::clog << "All tests Passed\n";
-			if (programOptions.enableExecutionTime)
-			{
-                stopWatch.stopTimerAndReport("Testing of Insertion and retrieval of users and tasks in MySQL database\n");
-			}
+            return succeeded? EXIT_SUCCESS : EXIT_FAILURE;
         }
         else
 		{
@@ -530,7 +1081,8 @@ int main(int argc, char* argv[])
 			}
 		}
     } catch (const std::exception& err) {
-        std::cerr << "Error: " << err.what() << "\n";
+        Logger::error("Error: {}\n", err.what());
+        writeReports();
         return EXIT_FAILURE;
     }
 
@@ -0,0 +1,647 @@
+#include <algorithm>
+#include "AllocationTracker.h"
+#include <array>
+#include <chrono>
+#include "commonUtilities.h"
+#include "CompactDate.h"
+#include "CSVParser.h"
+#include "DateParser.h"
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional>
+#include "GenericDictionary.h"
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include "TaskModel.h"
+#include "UserModel.h"
+#include <vector>
+
+/*
+ * Microbenchmarks of the models and of the decoding done for every row and record, in the
+ * style of Google Benchmark. Each benchmark runs its operation in a loop, the number of
+ * iterations grows until a run takes at least minimumRunTime, the fastest of the timed runs is
+ * reported in nanoseconds per operation. Heap allocations and bytes per operation are counted
+ * by AllocationTracker during the last run.
+ *
+ * Nothing needs the database, the rows are synthetic and generated from a fixed seed so that
+ * runs can be compared. The JSON report is meant to be diffed between builds.
+ *
+ * Usage: protoModelBenchmarks [--filter TEXT] [--json FILE]
+ */
+
+static constexpr std::chrono::duration<double> minimumRunTime = std::chrono::milliseconds(20);
+static constexpr unsigned int repetitions = 5;
+// Synthetic rows are reused in a cycle, a power of two so the index is a mask.
+static constexpr std::size_t syntheticRowCount = 1024;
+
+/*
+ * Keeps the compiler from removing a benchmark whose result is never used.
+ */
+static volatile double benchmarkSink;
+
+struct MicroBenchmark
+{
+    std::string_view name;
+    // Runs the operation the given number of times, returns a value that depends on all of them.
+    std::function<double(std::size_t iterations)> run;
+};
+
+struct MicroBenchmarkResult
+{
+    std::string_view name;
+    std::size_t iterations;
+    double nanosecondsPerOperation;
+    double allocationsPerOperation;
+    double bytesPerOperation;
+};
+
+/*
+ * The columns of a Tasks row the way a row_view presents them to processResultRow(), strings
+ * point into storage owned by the result set and dates are days since the epoch.
+ */
+struct SyntheticTaskRow
+{
+    std::uint64_t taskID;
+    std::uint64_t createdBy;
+    std::uint64_t assignedTo;
+    std::string_view description;
+    std::optional<std::uint64_t> parentTask;
+    std::optional<std::uint64_t> status;
+    double percentageComplete;
+    std::chrono::sys_days createdOn;
+    std::chrono::sys_days requiredDelivery;
+    std::chrono::sys_days scheduledStart;
+    std::optional<std::chrono::sys_days> actualStart;
+    std::optional<std::chrono::sys_days> estimatedCompletion;
+    std::optional<std::chrono::sys_days> completed;
+    std::uint64_t estimatedEffortHours;
+    double actualEffortHours;
+    std::uint64_t schedulePriorityGroup;
+    std::uint64_t priorityInGroup;
+    std::int64_t personal;
+};
+
+struct SyntheticUserRow
+{
+    std::uint64_t userID;
+    std::string_view lastName;
+    std::string_view firstName;
+    std::string_view middleInitial;
+    std::string_view emailAddress;
+    std::string_view loginName;
+    std::string_view password;
+    std::string_view startDay;
+    std::string_view endDay;
+    std::optional<std::int64_t> priorityGroup;
+    std::optional<std::int64_t> priority;
+    std::optional<std::int64_t> useLetters;
+    std::optional<std::int64_t> dotSeparation;
+};
+
+/*
+ * The text the synthetic rows point into, like the buffer of a result set.
+ */
+struct SyntheticRows
+{
+    std::vector<std::string> text;
+    std::vector<SyntheticTaskRow> tasks;
+    std::vector<SyntheticUserRow> users;
+};
+
+static SyntheticRows makeSyntheticRows()
+{
+    std::mt19937_64 generator(20250805);
+    std::uniform_int_distribution<unsigned int> statusDistribution(0, 5);
+    std::uniform_int_distribution<unsigned int> groupDistribution(1, 4);
+    std::uniform_int_distribution<unsigned int> effortDistribution(1, 40);
+    std::uniform_int_distribution<int> dayDistribution(-400, 200);
+
+    const std::chrono::sys_days today = std::chrono::sys_days(getTodaysDate());
+
+    SyntheticRows rows;
+    // Reserved so that the string_views stay valid.
+    rows.text.reserve(syntheticRowCount * 7);
+    auto store = [&rows](std::string text) -> std::string_view { return rows.text.emplace_back(std::move(text)); };
+
+    for (std::size_t row = 0; row < syntheticRowCount; ++row)
+    {
+        unsigned int status = statusDistribution(generator);
+        std::chrono::sys_days created = today + std::chrono::days(dayDistribution(generator));
+        SyntheticTaskRow taskRow{};
+        taskRow.taskID = row + 1;
+        taskRow.createdBy = 1;
+        taskRow.assignedTo = 1 + row % 100;
+        taskRow.description = store(std::format("Archive project {} website to external storage", row));
+        if (row % 8 == 0 && row > 0)
+        {
+            taskRow.parentTask = row;
+        }
+        if (status < 5)
+        {
+            taskRow.status = status;
+        }
+        taskRow.percentageComplete = status == 4? 100.0 : 0.0;
+        taskRow.createdOn = created;
+        taskRow.requiredDelivery = created + std::chrono::days(30);
+        taskRow.scheduledStart = created;
+        if (status >= 3)
+        {
+            taskRow.actualStart = created + std::chrono::days(2);
+            taskRow.estimatedCompletion = created + std::chrono::days(25);
+        }
+        if (status == 4)
+        {
+            taskRow.completed = created + std::chrono::days(20);
+        }
+        taskRow.estimatedEffortHours = effortDistribution(generator);
+        taskRow.actualEffortHours = taskRow.estimatedEffortHours * 0.75;
+        taskRow.schedulePriorityGroup = groupDistribution(generator);
+        taskRow.priorityInGroup = row % 100;
+        taskRow.personal = row % 10 == 0;
+        rows.tasks.push_back(taskRow);
+
+        SyntheticUserRow userRow{};
+        userRow.userID = row + 1;
+        userRow.lastName = store(std::format("Lastname{}", row));
+        userRow.firstName = store(std::format("Firstname{}", row));
+        userRow.middleInitial = store("Q");
+        userRow.emailAddress = store(std::format("firstname{}.lastname{}@example.com", row, row));
+        userRow.loginName = store(std::format("Lastname{}Fi{}", row, row % 10));
+        userRow.password = store(std::format("Pw{:08x}", generator() & 0xffffffff));
+        userRow.startDay = "8:30 AM";
+        userRow.endDay = "5:00 PM";
+        if (row % 2 == 0)
+        {
+            userRow.priorityGroup = 1;
+            userRow.priority = 1;
+            userRow.useLetters = 1;
+            userRow.dotSeparation = 0;
+        }
+        rows.users.push_back(userRow);
+    }
+
+    return rows;
+}
+
+static CompactDate toCompactDate(std::chrono::sys_days date)
+{
+    return CompactDate(static_cast<CompactDate::DayNumber>(date.time_since_epoch().count()));
+}
+
+/*
+ * The same calls as TaskDbInterface::processResultRow() without loading the dependencies.
+ */
+static void hydrateTask(const SyntheticTaskRow& row, TaskModel_shp newTask)
+{
+    newTask->setTaskID(row.taskID);
+    newTask->setCreatorID(row.createdBy);
+    newTask->setAssignToID(row.assignedTo);
+    newTask->setDescription(std::string(row.description));
+    newTask->setPercentageComplete(row.percentageComplete);
+    newTask->setCreationDate(toCompactDate(row.createdOn));
+    newTask->setDueDate(toCompactDate(row.requiredDelivery));
+    newTask->setScheduledStart(toCompactDate(row.scheduledStart));
+    newTask->setEstimatedEffort(row.estimatedEffortHours);
+    newTask->setActualEffortToDate(row.actualEffortHours);
+    newTask->setPriorityGroup(row.schedulePriorityGroup);
+    newTask->setPriority(row.priorityInGroup);
+    newTask->setPersonal(row.personal);
+
+    if (row.parentTask)
+    {
+        newTask->setParentTaskID(*row.parentTask);
+    }
+    if (row.status)
+    {
+        newTask->setStatus(static_cast<TaskModel::TaskStatus>(*row.status));
+    }
+    if (row.actualStart)
+    {
+        newTask->setactualStartDate(toCompactDate(*row.actualStart));
+    }
+    if (row.estimatedCompletion)
+    {
+        newTask->setEstimatedCompletion(toCompactDate(*row.estimatedCompletion));
+    }
+    if (row.completed)
+    {
+        newTask->setCompletionDate(toCompactDate(*row.completed));
+    }
+
+    newTask->clearModified();
+}
+
+/*
+ * The same calls as UserDbInterface::processResultRow().
+ */
+static void hydrateUser(const SyntheticUserRow& row, UserModel_shp newUser)
+{
+    newUser->setUserID(row.userID);
+    newUser->setLastName(std::string(row.lastName));
+    newUser->setFirstName(std::string(row.firstName));
+    newUser->setMiddleInitial(std::string(row.middleInitial));
+    newUser->setEmail(std::string(row.emailAddress));
+    newUser->setLoginName(std::string(row.loginName));
+    newUser->setPassword(std::string(row.password));
+    newUser->setStartTime(std::string(row.startDay));
+    newUser->setEndTime(std::string(row.endDay));
+    if (row.priorityGroup)
+    {
+        newUser->setPriorityInSchedule(*row.priorityGroup);
+    }
+    if (row.priority)
+    {
+        newUser->setMinorPriorityInSchedule(*row.priority);
+    }
+    if (row.useLetters)
+    {
+        newUser->setUsingLettersForMaorPriority(*row.useLetters);
+    }
+    if (row.dotSeparation)
+    {
+        newUser->setSeparatingPriorityWithDot(*row.dotSeparation);
+    }
+
+    newUser->clearModified();
+}
+
+/*
+ * Task rows in the format of the task test data, every fourth description is quoted and
+ * contains delimiters and escaped quotes.
+ */
+static std::string makeSyntheticTaskCSV()
+{
+    std::string text;
+    for (std::size_t row = 0; row < syntheticRowCount; ++row)
+    {
+        std::string description = row % 4 == 0?
+            std::format("\"Review \"\"{}\"\", update schedule, notify owners\"", row) :
+            std::format("Archive project {} website to external storage", row);
+        text.append(std::format("{},{},{},2025-05-05,{},1.0,0,Work in Progress,2025-04-08,2025-04-08,2025-04-01,2025-06-30,\n",
+            static_cast<char>('A' + row % 4), row % 100, description, 1 + row % 40));
+    }
+
+    return text;
+}
+
+static std::vector<std::string> makeSyntheticDateStrings()
+{
+    std::mt19937_64 generator(20250806);
+    std::uniform_int_distribution<CompactDate::DayNumber> dayDistribution(
+        CompactDate(std::chrono::year{2000}/1/1).getDayNumber(), CompactDate(std::chrono::year{2030}/12/31).getDayNumber());
+
+    std::vector<std::string> dates;
+    for (std::size_t row = 0; row < syntheticRowCount; ++row)
+    {
+        std::chrono::year_month_day date = CompactDate(dayDistribution(generator)).toYearMonthDay();
+        dates.push_back(row % 2 == 0? std::format("{:%Y-%m-%d}", date) :
+            std::format("{:%B} {}, {}", date.month(), static_cast<unsigned int>(date.day()), static_cast<int>(date.year())));
+    }
+
+    return dates;
+}
+
+static std::vector<MicroBenchmark> makeMicroBenchmarks()
+{
+    auto rows = std::make_shared<const SyntheticRows>(makeSyntheticRows());
+    auto csvText = std::make_shared<const std::string>(makeSyntheticTaskCSV());
+    auto dateStrings = std::make_shared<const std::vector<std::string>>(makeSyntheticDateStrings());
+    auto statusDictionary = std::make_shared<const GenericDictionary<TaskModel::TaskStatus, std::string>>(
+        std::initializer_list<GenericDictionary<TaskModel::TaskStatus, std::string>::DictType>{
+            {TaskModel::TaskStatus::Not_Started, "Not Started"},
+            {TaskModel::TaskStatus::On_Hold, "On Hold"},
+            {TaskModel::TaskStatus::Waiting_for_Dependency, "Waiting for Dependency"},
+            {TaskModel::TaskStatus::Work_in_Progress, "Work in Progress"},
+            {TaskModel::TaskStatus::Complete, "Completed"}
+        });
+    auto task = std::make_shared<TaskModel>();
+    hydrateTask(rows->tasks[1], task);
+    task->setDependencies({1, 2, 3});
+    auto user = std::make_shared<UserModel>();
+    hydrateUser(rows->users[1], user);
+
+    // Inputs and output buffers of the batch date benchmarks, built here so that the runs only time the conversions.
+    std::vector<std::chrono::year_month_day> creationDates;
+    std::vector<CompactDate::DayNumber> creationDays;
+    for (const auto& row: rows->tasks)
+    {
+        creationDates.push_back(row.createdOn);
+        creationDays.push_back(toCompactDate(row.createdOn).getDayNumber());
+    }
+    auto dates = std::make_shared<const std::vector<std::chrono::year_month_day>>(std::move(creationDates));
+    auto days = std::make_shared<const std::vector<CompactDate::DayNumber>>(std::move(creationDays));
+    auto convertedDates = std::make_shared<std::vector<std::chrono::year_month_day>>(days->size());
+    auto formattedText = std::make_shared<std::string>(days->size() * ISODateLength, ' ');
+
+    const std::array<std::string, 5> statusNames = {
+        "Not Started", "On Hold", "Waiting for Dependency", "Work in Progress", "Completed"
+    };
+
+    return {
+        {"TaskModel default construction", [](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    TaskModel newTask;
+                    sum += newTask.getCompactCreationDate().getDayNumber();
+                }
+                return sum;
+            }},
+        {"TaskModel copy", [task](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    TaskModel copy = *task;
+                    sum += copy.getEstimatedEffort();
+                }
+                return sum;
+            }},
+        {"UserModel construction", [](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    UserModel newUser("Lastname", "Firstname", "Q", "firstname.lastname@example.com");
+                    sum += newUser.getLastName().size();
+                }
+                return sum;
+            }},
+        {"UserModel copy", [user](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    UserModel copy = *user;
+                    sum += copy.getUserID();
+                }
+                return sum;
+            }},
+        {"task row hydration", [rows](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    TaskModel_shp newTask = std::make_shared<TaskModel>(TaskModel());
+                    hydrateTask(rows->tasks[iteration & (syntheticRowCount - 1)], newTask);
+                    sum += newTask->getTaskID();
+                }
+                return sum;
+            }},
+        {"user row hydration", [rows](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    UserModel_shp newUser = std::make_shared<UserModel>(UserModel());
+                    hydrateUser(rows->users[iteration & (syntheticRowCount - 1)], newUser);
+                    sum += newUser->getUserID();
+                }
+                return sum;
+            }},
+        {"GenericDictionary lookupID", [statusDictionary, statusNames](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    auto status = statusDictionary->lookupID(statusNames[iteration % statusNames.size()]);
+                    sum += status.has_value()? static_cast<double>(*status) : -1.0;
+                }
+                return sum;
+            }},
+        {"GenericDictionary lookupName", [statusDictionary](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    auto name = statusDictionary->lookupName(static_cast<TaskModel::TaskStatus>(iteration % 5));
+                    sum += name.has_value()? name->size() : 0;
+                }
+                return sum;
+            }},
+        {"TaskModel status to string", [task](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    sum += task->taskStatusString().size();
+                }
+                return sum;
+            }},
+        {"CSVParser record", [csvText](std::size_t iterations)
+            {
+                std::optional<CSVParser> parser;
+                parser.emplace(csvText->data(), csvText->size());
+                CSVRecord record;
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    if (!parser->readNextRecord(record))
+                    {
+                        parser.emplace(csvText->data(), csvText->size());
+                        parser->readNextRecord(record);
+                    }
+                    sum += record.size();
+                }
+                return sum;
+            }},
+        {"DateParser parse, ISO and month name", [dateStrings](std::size_t iterations)
+            {
+                DateParser dateParser;
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    auto date = dateParser.parse((*dateStrings)[iteration & (syntheticRowCount - 1)]);
+                    sum += date.has_value()? CompactDate(*date).getDayNumber() : 0;
+                }
+                return sum;
+            }},
+        {"DateParser parseAs ISO", [dateStrings](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    // The even rows are ISO dates.
+                    auto date = DateParser::parseAs((*dateStrings)[(2 * iteration) & (syntheticRowCount - 1)],
+                        DateParser::Format::ISO);
+                    sum += date.has_value()? CompactDate(*date).getDayNumber() : 0;
+                }
+                return sum;
+            }},
+        {"CompactDate to year_month_day", [rows](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    CompactDate date = toCompactDate(rows->tasks[iteration & (syntheticRowCount - 1)].createdOn);
+                    sum += static_cast<unsigned int>(date.toYearMonthDay().day());
+                }
+                return sum;
+            }},
+        {"year_month_day to CompactDate", [dates](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    sum += CompactDate((*dates)[iteration & (syntheticRowCount - 1)]).getDayNumber();
+                }
+                return sum;
+            }},
+        {"convertDaysToDates, per date", [days, convertedDates](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t done = 0; done < iterations; done += days->size())
+                {
+                    std::size_t count = std::min(days->size(), iterations - done);
+                    convertDaysToDates(std::span(*days).first(count), *convertedDates);
+                    sum += static_cast<unsigned int>((*convertedDates)[count - 1].day());
+                }
+                return sum;
+            }},
+        {"formatISODates, per date", [days, formattedText](std::size_t iterations)
+            {
+                double sum = 0.0;
+                for (std::size_t done = 0; done < iterations; done += days->size())
+                {
+                    std::size_t count = std::min(days->size(), iterations - done);
+                    formatISODates(std::span(*days).first(count), *formattedText);
+                    sum += (*formattedText)[count * ISODateLength - 1];
+                }
+                return sum;
+            }}
+    };
+}
+
+/*
+ * Returns the time of one run of the given number of iterations.
+ */
+static std::chrono::duration<double> timeMicroBenchmark(const MicroBenchmark& benchmark, std::size_t iterations)
+{
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point start = clock::now();
+    benchmarkSink = benchmark.run(iterations);
+    return clock::now() - start;
+}
+
+static MicroBenchmarkResult runMicroBenchmark(const MicroBenchmark& benchmark)
+{
+    // Grows the iterations the way Google Benchmark does, to about minimumRunTime per run.
+    std::size_t iterations = 1;
+    std::chrono::duration<double> elapsed = timeMicroBenchmark(benchmark, iterations);
+    while (elapsed < minimumRunTime)
+    {
+        double scale = elapsed.count() > 0.0? minimumRunTime / elapsed * 1.4 : 100.0;
+        iterations = static_cast<std::size_t>(iterations * std::clamp(scale, 2.0, 100.0));
+        elapsed = timeMicroBenchmark(benchmark, iterations);
+    }
+
+    std::chrono::duration<double> fastest = elapsed;
+    AllocationTracker::Counts allocationsBefore{};
+    AllocationTracker::Counts allocationsAfter{};
+    for (unsigned int repetition = 0; repetition < repetitions; ++repetition)
+    {
+        allocationsBefore = AllocationTracker::getThreadCounts();
+        fastest = std::min(fastest, timeMicroBenchmark(benchmark, iterations));
+        allocationsAfter = AllocationTracker::getThreadCounts();
+    }
+
+    return {
+        benchmark.name,
+        iterations,
+        fastest.count() * 1e9 / iterations,
+        static_cast<double>(allocationsAfter.allocations - allocationsBefore.allocations) / iterations,
+        static_cast<double>(allocationsAfter.bytes - allocationsBefore.bytes) / iterations
+    };
+}
+
+static std::string getJSONReport(const std::vector<MicroBenchmarkResult>& results)
+{
+    std::string json("{\"context\":{\"date\":");
+    appendJSONString(json, std::format("{:%Y-%m-%d}", getTodaysDate()));
+#ifdef NDEBUG
+    json.append(",\"build\":\"release\"");
+#else
+    json.append(",\"build\":\"debug\"");
+#endif
+#ifdef __VERSION__
+    json.append(",\"compiler\":");
+    appendJSONString(json, __VERSION__);
+#endif
+    json.append(std::format(",\"repetitions\":{}}},\"benchmarks\":[", repetitions));
+
+    for (const auto& result: results)
+    {
+        json.append(&result == results.data()? "{\"name\":" : ",{\"name\":");
+        appendJSONString(json, result.name);
+        json.append(std::format(",\"iterations\":{},\"nsPerOp\":{:.3f},\"allocationsPerOp\":{:.3f},\"bytesPerOp\":{:.1f}}}",
+            result.iterations, result.nanosecondsPerOperation, result.allocationsPerOperation, result.bytesPerOperation));
+    }
+    json.append("]}\n");
+
+    return json;
+}
+
+int main(int argc, char* argv[])
+{
+#ifndef NDEBUG
+    std::clog << "Benchmarks were built without NDEBUG, configure with -DCMAKE_BUILD_TYPE=Release for useful numbers.\n";
+#endif
+
+    std::string_view filter;
+    std::string jsonFile;
+    for (int argument = 1; argument < argc; ++argument)
+    {
+        std::string_view option = argv[argument];
+        if (option == "--filter" && argument + 1 < argc)
+        {
+            filter = argv[++argument];
+        }
+        else if (option == "--json" && argument + 1 < argc)
+        {
+            jsonFile = argv[++argument];
+        }
+        else
+        {
+            std::cerr << std::format("Usage: {} [--filter TEXT] [--json FILE]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    AllocationTracker::enable();
+
+    std::vector<MicroBenchmarkResult> results;
+    std::cout << std::format("{:<40} {:>12} {:>12} {:>12} {:>12}\n", "Benchmark", "ns/op", "allocs/op", "bytes/op",
+        "iterations");
+    for (const auto& benchmark: makeMicroBenchmarks())
+    {
+        if (benchmark.name.find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+        const MicroBenchmarkResult& result = results.emplace_back(runMicroBenchmark(benchmark));
+        std::cout << std::format("{:<40} {:>12.1f} {:>12.2f} {:>12.1f} {:>12}\n", result.name,
+            result.nanosecondsPerOperation, result.allocationsPerOperation, result.bytesPerOperation, result.iterations);
+    }
+
+    if (!jsonFile.empty())
+    {
+        std::ofstream reportFile(jsonFile);
+        if (!(reportFile << getJSONReport(results)))
+        {
+            std::cerr << std::format("Can't write the report to {}\n", jsonFile);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1081 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include "commonUtilities.h"
+#include "CompactDate.h"
+#include "CSVChunker.h"
+#include "CSVParser.h"
+#include "DateParser.h"
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <locale>
+#include <map>
+#include <memory>
+#include <optional>
+#include "QueryStatistics.h"
+#include <random>
+#include <ranges>
+#include "ScheduleItemModel.h"
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include "TaskAggregator.h"
+#include "TaskGraph.h"
+#include "TaskModel.h"
+#include "TaskScheduler.h"
+#include "TaskStore.h"
+#include <vector>
+#include "WorkStealingPool.h"
+
+/*
+ * Benchmarks for code that doesn't need the database. All data is synthetic and generated
+ * from a fixed seed so that runs can be compared.
+ *
+ * Usage: protoPlannerBenchmarks [rowCount]
+ */
+
+static constexpr std::size_t defaultRowCount = 5'000'000;
+static constexpr unsigned int repetitions = 10;
+
+/*
+ * Keeps the compiler from removing a benchmark whose result is never used.
+ */
+static volatile double benchmarkSink;
+
+static TaskStore makeSyntheticTaskStore(std::size_t rowCount, unsigned int groupCount = 4)
+{
+    std::mt19937_64 generator(20250801);
+    std::uniform_int_distribution<unsigned int> statusDistribution(0, 5);
+    std::uniform_int_distribution<unsigned int> groupDistribution(1, groupCount);
+    std::uniform_int_distribution<unsigned int> effortDistribution(1, 40);
+    std::uniform_int_distribution<int> dayDistribution(-400, 200);
+
+    const std::chrono::sys_days today = std::chrono::sys_days(getTodaysDate());
+
+    TaskStore taskStore;
+    taskStore.reserve(rowCount);
+
+    for (std::size_t row = 0; row < rowCount; ++row)
+    {
+        TaskStore::TaskRow taskRow = {};
+        unsigned int status = statusDistribution(generator);
+        std::chrono::sys_days created = today + std::chrono::days(dayDistribution(generator));
+
+        taskRow.taskID = row + 1;
+        taskRow.creatorID = 1;
+        taskRow.assignToID = 1 + row % 1000;
+        if (status < 5)
+        {
+            taskRow.status = static_cast<TaskModel::TaskStatus>(status);
+        }
+        taskRow.creationDate = created;
+        taskRow.scheduledStart = created;
+        taskRow.dueDate = created + std::chrono::days(30);
+        if (taskRow.status == TaskModel::TaskStatus::Complete)
+        {
+            taskRow.completionDate = created + std::chrono::days(20);
+        }
+        taskRow.estimatedEffort = effortDistribution(generator);
+        taskRow.actualEffortToDate = taskRow.estimatedEffort * 0.75;
+        taskRow.priorityGroup = groupDistribution(generator);
+        taskRow.priority = static_cast<unsigned int>(row % 100);
+
+        taskStore.append(taskRow);
+    }
+
+    return taskStore;
+}
+
+static void reportBenchmark(std::string_view name, std::size_t rowCount, std::function<double()> benchmark)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::chrono::duration<double> fastest = std::chrono::duration<double>::max();
+    for (unsigned int repetition = 0; repetition < repetitions; ++repetition)
+    {
+        clock::time_point start = clock::now();
+        benchmarkSink = benchmark();
+        fastest = std::min<std::chrono::duration<double>>(fastest, clock::now() - start);
+    }
+
+    std::cout << std::format("{:<40} {:>10.3f} ms {:>10.1f} M rows/sec\n", name, fastest.count() * 1000.0,
+        rowCount / fastest.count() / 1'000'000.0);
+}
+
+/*
+ * Compares the aggregation kernels with plain scalar loops over the same columns. The row count
+ * leaves a remainder after the full sets of lanes, and the wide range of priority groups goes
+ * through the histogram and past 255. All efforts are multiples of 0.25 so the sums are exact.
+ */
+static bool verifyTaskAggregator()
+{
+    auto fail = [](std::string_view what)
+    {
+        std::cerr << std::format("TaskAggregator FAILED: {}\n", what);
+        return false;
+    };
+
+    const std::chrono::year_month_day today = getTodaysDate();
+    const TaskStore::DayNumber todayNumber = TaskStore::toDayNumber(today);
+    const std::chrono::year_month_day lastDay = std::chrono::sys_days(today) + std::chrono::days(30);
+    const TaskStore::DayNumber lastDayNumber = TaskStore::toDayNumber(lastDay);
+    const std::uint8_t completeStatus = static_cast<std::uint8_t>(TaskModel::TaskStatus::Complete);
+
+    for (unsigned int groupCount : {4u, 300u})
+    {
+        TaskStore taskStore = makeSyntheticTaskStore(1'003, groupCount);
+        TaskAggregator aggregator(taskStore);
+        std::span<const std::uint8_t> statuses = taskStore.getStatuses();
+        std::span<const std::uint32_t> groups = taskStore.getPriorityGroups();
+        std::span<const float> estimated = taskStore.getEstimatedEfforts();
+        std::span<const float> actual = taskStore.getActualEfforts();
+        std::span<const TaskStore::DayNumber> dueDays = taskStore.getDueDays();
+        std::span<const TaskStore::DayNumber> completionDays = taskStore.getCompletionDays();
+
+        double estimatedTotal = 0.0;
+        TaskAggregator::StatusCounts statusCounts{};
+        std::size_t overdue = 0;
+        std::size_t dueSoon = 0;
+        std::size_t completedSoon = 0;
+        std::map<std::uint32_t, TaskAggregator::EffortTotals> groupTotals;
+        std::map<std::uint32_t, TaskAggregator::EffortTotals> completeGroupTotals;
+        for (std::size_t row = 0; row < taskStore.size(); ++row)
+        {
+            estimatedTotal += estimated[row];
+            ++statusCounts[std::min<std::size_t>(statuses[row], TaskAggregator::StatusSlots - 1)];
+            if (dueDays[row] < todayNumber && statuses[row] != completeStatus)
+            {
+                ++overdue;
+            }
+            if (dueDays[row] >= todayNumber && dueDays[row] <= lastDayNumber)
+            {
+                ++dueSoon;
+            }
+            if (completionDays[row] >= todayNumber && completionDays[row] <= lastDayNumber)
+            {
+                ++completedSoon;
+            }
+            for (auto* totals : {&groupTotals, &completeGroupTotals})
+            {
+                if (totals == &completeGroupTotals && statuses[row] != completeStatus)
+                {
+                    continue;
+                }
+                TaskAggregator::EffortTotals& groupTotal = (*totals)[groups[row]];
+                groupTotal.priorityGroup = groups[row];
+                ++groupTotal.taskCount;
+                groupTotal.estimatedEffort += estimated[row];
+                groupTotal.actualEffort += actual[row];
+            }
+        }
+
+        auto sameTotals = [](const TaskAggregator::EffortTotalsList& result,
+            const std::map<std::uint32_t, TaskAggregator::EffortTotals>& expected)
+        {
+            return std::ranges::equal(result, expected | std::views::values,
+                [](const TaskAggregator::EffortTotals& left, const TaskAggregator::EffortTotals& right)
+                {
+                    return left.priorityGroup == right.priorityGroup && left.taskCount == right.taskCount &&
+                        left.estimatedEffort == right.estimatedEffort && left.actualEffort == right.actualEffort;
+                });
+        };
+
+        if (TaskAggregator::sum(estimated) != estimatedTotal)
+        {
+            return fail("sum");
+        }
+        if (aggregator.countByStatus() != statusCounts)
+        {
+            return fail("count by status");
+        }
+        if (aggregator.countOverdue(today) != overdue || aggregator.countDueBetween(today, lastDay) != dueSoon ||
+            aggregator.countCompletedBetween(today, lastDay) != completedSoon)
+        {
+            return fail("counts over day columns");
+        }
+        if (!sameTotals(aggregator.effortByPriorityGroup(), groupTotals) ||
+            !sameTotals(aggregator.effortByPriorityGroup(TaskModel::TaskStatus::Complete), completeGroupTotals))
+        {
+            return fail(std::format("effort by priority group over {} groups", groupCount));
+        }
+        if (TaskAggregator::minMax(groups) != std::array<std::uint32_t, 2>{groupTotals.begin()->first,
+            groupTotals.rbegin()->first})
+        {
+            return fail("minimum and maximum");
+        }
+    }
+
+    return true;
+}
+
+static void benchmarkTaskAggregator(std::size_t rowCount)
+{
+    TaskStore taskStore = makeSyntheticTaskStore(rowCount);
+    TaskAggregator aggregator(taskStore);
+    std::chrono::year_month_day today = getTodaysDate();
+
+    std::cout << std::format("TaskAggregator over {} tasks, fastest of {} runs\n", rowCount, repetitions);
+
+    reportBenchmark("sum estimated effort", rowCount,
+        [&taskStore]() { return TaskAggregator::sum(taskStore.getEstimatedEfforts()); });
+    reportBenchmark("count by status", rowCount,
+        [&aggregator]() { return static_cast<double>(aggregator.countByStatus()[0]); });
+    reportBenchmark("count overdue", rowCount,
+        [&aggregator, today]() { return static_cast<double>(aggregator.countOverdue(today)); });
+    reportBenchmark("count due in next 30 days", rowCount,
+        [&aggregator, today]()
+        {
+            std::chrono::year_month_day lastDay = std::chrono::sys_days(today) + std::chrono::days(30);
+            return static_cast<double>(aggregator.countDueBetween(today, lastDay));
+        });
+    reportBenchmark("effort by priority group", rowCount,
+        [&aggregator]() { return aggregator.effortByPriorityGroup().front().estimatedEffort; });
+    reportBenchmark("effort by priority group, complete", rowCount,
+        [&aggregator]()
+        {
+            return aggregator.effortByPriorityGroup(TaskModel::TaskStatus::Complete).front().actualEffort;
+        });
+
+    // The same report computed from TaskModel objects, for comparison.
+    std::size_t modelCount = std::min<std::size_t>(rowCount, 1'000'000);
+    TaskStore modelStore = makeSyntheticTaskStore(modelCount);
+    TaskList tasks = modelStore.toTaskList();
+    reportBenchmark("effort by priority group, TaskList", modelCount,
+        [&tasks]()
+        {
+            std::array<double, 5> estimatedEfforts{};
+            for (const auto& task: tasks)
+            {
+                estimatedEfforts[task->getPriorityGroup()] += task->getEstimatedEffort();
+            }
+            return estimatedEfforts[1];
+        });
+}
+
+/*
+ * Compares the batch date kernels with std::chrono for every day they support.
+ */
+static bool verifyDateKernels()
+{
+    std::vector<CompactDate::DayNumber> days;
+    for (CompactDate::DayNumber day = MinimumBatchDate.getDayNumber(); day <= MaximumBatchDate.getDayNumber(); ++day)
+    {
+        days.push_back(day);
+    }
+    days.push_back(CompactDate::NoDate);
+
+    std::vector<std::chrono::year_month_day> dates(days.size());
+    std::vector<CompactDate::DayNumber> roundTrip(days.size());
+    std::string text(days.size() * ISODateLength, ' ');
+    convertDaysToDates(days, dates);
+    convertDatesToDays(dates, roundTrip);
+    formatISODates(days, text);
+
+    for (std::size_t index = 0; index < days.size(); ++index)
+    {
+        std::chrono::year_month_day expected = CompactDate(days[index]).toYearMonthDay();
+        std::string expectedText = expected.ok()? std::format("{:%Y-%m-%d}", expected) : "0000-00-00";
+        if (dates[index] != expected || roundTrip[index] != days[index] ||
+            text.compare(index * ISODateLength, ISODateLength, expectedText) != 0)
+        {
+            std::cerr << std::format("Date kernels FAILED for day number {}, expected {}\n", days[index], expectedText);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void benchmarkDateKernels(std::size_t rowCount)
+{
+    std::mt19937_64 generator(20250802);
+    std::uniform_int_distribution<CompactDate::DayNumber> dayDistribution(
+        CompactDate(std::chrono::year_month_day{std::chrono::year{1000}, std::chrono::January, std::chrono::day{1}}).getDayNumber(),
+        MaximumBatchDate.getDayNumber());
+
+    std::vector<CompactDate::DayNumber> days(rowCount);
+    for (auto& day: days)
+    {
+        day = dayDistribution(generator);
+    }
+    std::vector<std::chrono::year_month_day> dates(rowCount);
+    std::vector<CompactDate::DayNumber> roundTrip(rowCount);
+    std::string text(rowCount * ISODateLength, ' ');
+
+    std::cout << std::format("Date kernels over {} dates, fastest of {} runs\n", rowCount, repetitions);
+
+    reportBenchmark("days to year_month_day, std::chrono", rowCount,
+        [&days, &dates]()
+        {
+            for (std::size_t index = 0; index < days.size(); ++index)
+            {
+                dates[index] = std::chrono::sys_days(std::chrono::days(days[index]));
+            }
+            return static_cast<double>(static_cast<int>(dates.back().year()));
+        });
+    reportBenchmark("days to year_month_day", rowCount,
+        [&days, &dates]()
+        {
+            convertDaysToDates(days, dates);
+            return static_cast<double>(static_cast<int>(dates.back().year()));
+        });
+    reportBenchmark("year_month_day to days, std::chrono", rowCount,
+        [&dates, &roundTrip]()
+        {
+            for (std::size_t index = 0; index < dates.size(); ++index)
+            {
+                roundTrip[index] = std::chrono::sys_days(dates[index]).time_since_epoch().count();
+            }
+            return static_cast<double>(roundTrip.back());
+        });
+    reportBenchmark("year_month_day to days", rowCount,
+        [&dates, &roundTrip]()
+        {
+            convertDatesToDays(dates, roundTrip);
+            return static_cast<double>(roundTrip.back());
+        });
+    reportBenchmark("days to YYYY-MM-DD, std::format", rowCount,
+        [&days, &text]()
+        {
+            for (std::size_t index = 0; index < days.size(); ++index)
+            {
+                std::format_to(&text[index * ISODateLength], "{:%Y-%m-%d}",
+                    std::chrono::year_month_day(std::chrono::sys_days(std::chrono::days(days[index]))));
+            }
+            return static_cast<double>(text.back());
+        });
+    reportBenchmark("days to YYYY-MM-DD", rowCount,
+        [&days, &text]()
+        {
+            formatISODates(days, text);
+            return static_cast<double>(text.back());
+        });
+}
+
+/*
+ * Quoting, line ending and empty field cases for the CSV parser.
+ */
+static bool verifyCSVParser()
+{
+    struct CSVTestCase
+    {
+        std::string_view text;
+        std::vector<std::vector<std::string>> expectedRecords;
+    };
+
+    const std::vector<CSVTestCase> testCases = {
+        {"a,b,c\n1,2,3\n", {{"a", "b", "c"}, {"1", "2", "3"}}},
+        {"a,b,c\r\n1,2,3", {{"a", "b", "c"}, {"1", "2", "3"}}},
+        {"a,,c,\n\n\r\n,\n", {{"a", "", "c", ""}, {"", ""}}},
+        {"\"a, b\",\"say \"\"hi\"\"\",\"\"\n", {{"a, b", "say \"hi\"", ""}}},
+        {"\"two\nlines\",x\nnext,\"\"\"\"\n", {{"two\nlines", "x"}, {"next", "\""}}},
+        {"0123456789abcdefghij,0123456789abcdefghij0123456789\n", {{"0123456789abcdefghij", "0123456789abcdefghij0123456789"}}},
+        {"trailing,", {{"trailing", ""}}},
+        {"a\rb,c\r\n\rd\ne\r,f\r", {{"a\rb", "c"}, {"\rd"}, {"e\r", "f"}}}
+    };
+
+    for (const auto& testCase: testCases)
+    {
+        CSVParser parser(testCase.text.data(), testCase.text.size());
+        // Copies the fields, unescaped fields point into the record which is reused for the next record.
+        std::vector<std::vector<std::string>> records;
+        for (const auto& record: parser)
+        {
+            records.emplace_back(record.begin(), record.end());
+        }
+        if (records != testCase.expectedRecords || !parser.getAllErrorMessages().empty())
+        {
+            std::cerr << std::format("CSV parser FAILED for input [{}]\n{}", testCase.text, parser.getAllErrorMessages());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Splits text at every chunk size from 1 byte to the whole text, the chunks parsed one after
+ * the other must give the same records and line numbers as parsing the whole text. The inputs
+ * put quoted line breaks, CRLF, lone CRs and a last record without a line break on chunk
+ * boundaries.
+ */
+static bool verifyCSVChunks()
+{
+    const std::vector<std::string_view> testCases = {
+        "a,\"one\ntwo\nthree\",b\n\"x\ny\",2,3\nlast,row,here\n",
+        "\"say \"\"hi\nthere\"\"\",1\n2,\"\"\"\n\"\"\"\n",
+        "a,b\r\n\"q\r\nr\",c\r\n\r\nd,e\r\n",
+        "a,b\nc,\"d\ne\"",
+        "x,y\r\nz",
+        "a\rb,c\n\rd,\"e\r\"\r\nf\r\rg\n"
+    };
+
+    struct ParsedRecord
+    {
+        std::vector<std::string> fields;
+        std::size_t lineNumber;
+        bool operator==(const ParsedRecord&) const = default;
+    };
+    auto parse = [](const char* text, std::size_t length, std::size_t firstLineNumber,
+        std::vector<ParsedRecord>& records)
+    {
+        CSVParser parser(text, length, ',', firstLineNumber);
+        for (const auto& record: parser)
+        {
+            records.push_back({std::vector<std::string>(record.begin(), record.end()), record.getLineNumber()});
+        }
+        return parser.getAllErrorMessages().empty();
+    };
+
+    WorkStealingPool pool(2);
+    for (std::string_view text: testCases)
+    {
+        std::vector<ParsedRecord> expected;
+        parse(text.data(), text.size(), 1, expected);
+
+        for (std::size_t chunkSize = 1; chunkSize <= text.size(); ++chunkSize)
+        {
+            std::vector<CSVChunk> chunks = splitCSVIntoChunks(text, chunkSize, pool);
+            std::vector<ParsedRecord> records;
+            std::size_t nextOffset = 0;
+            bool chunksValid = true;
+            for (const CSVChunk& chunk: chunks)
+            {
+                chunksValid = chunksValid && chunk.offset == nextOffset && chunk.length > 0 &&
+                    parse(text.data() + chunk.offset, chunk.length, chunk.firstLineNumber, records);
+                nextOffset = chunk.offset + chunk.length;
+            }
+            if (!chunksValid || nextOffset != text.size() || records != expected)
+            {
+                std::cerr << std::format("CSV chunks FAILED for input [{}] split every {} bytes into {} chunks\n",
+                    text, chunkSize, chunks.size());
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Rows in the format of the task test data, every fourth description is quoted and contains
+ * delimiters and escaped quotes.
+ */
+static std::string makeSyntheticTaskCSV(std::size_t rowCount)
+{
+    std::mt19937_64 generator(20250803);
+    std::uniform_int_distribution<unsigned int> groupDistribution('A', 'D');
+    std::uniform_int_distribution<unsigned int> effortDistribution(1, 40);
+
+    std::string text;
+    text.reserve(rowCount * 140);
+    for (std::size_t row = 0; row < rowCount; ++row)
+    {
+        std::string description = row % 4 == 0?
+            std::format("\"Review \"\"{}\"\", update schedule, notify owners\"", row) :
+            std::format("Archive project {} website to external storage", row);
+        text.append(std::format("{},{},{},2025-05-05,{},1.0,0,Work in Progress,2025-04-08,2025-04-08,2025-04-01,2025-06-30,\n",
+            static_cast<char>(groupDistribution(generator)), row % 100, description, effortDistribution(generator)));
+    }
+
+    return text;
+}
+
+static void benchmarkCSVParser(std::size_t rowCount)
+{
+    rowCount = std::min<std::size_t>(rowCount, 1'000'000);
+    std::string text = makeSyntheticTaskCSV(rowCount);
+
+    std::cout << std::format("CSV parsing of {} task rows ({} MB), fastest of {} runs\n", rowCount,
+        text.size() / (1024 * 1024), repetitions);
+
+    // The line based approach the parser replaced, without quote handling.
+    reportBenchmark("std::getline and split into strings", rowCount,
+        [&text]()
+        {
+            std::istringstream input(text);
+            std::string line;
+            std::size_t fieldCount = 0;
+            while (std::getline(input, line))
+            {
+                std::vector<std::string> fields;
+                std::size_t fieldStart = 0;
+                for (std::size_t comma = line.find(','); comma != std::string::npos; comma = line.find(',', fieldStart))
+                {
+                    fields.emplace_back(line, fieldStart, comma - fieldStart);
+                    fieldStart = comma + 1;
+                }
+                fields.emplace_back(line, fieldStart);
+                fieldCount += fields.size();
+            }
+            return static_cast<double>(fieldCount);
+        });
+    reportBenchmark("CSVParser", rowCount,
+        [&text]()
+        {
+            CSVParser parser(text.data(), text.size());
+            CSVRecord record;
+            std::size_t fieldCount = 0;
+            while (parser.readNextRecord(record))
+            {
+                fieldCount += record.size();
+            }
+            return static_cast<double>(fieldCount);
+        });
+}
+
+/*
+ * Every accepted format, spacing, invalid dates and text that is not a date.
+ */
+static bool verifyDateParser()
+{
+    using namespace std::chrono;
+
+    struct DateTestCase
+    {
+        std::string_view text;
+        std::expected<year_month_day, DateParser::Error> expected;
+    };
+
+    const std::vector<DateTestCase> testCases = {
+        {"2025-04-08", year{2025}/April/8},
+        {"2025-4-8", year{2025}/April/8},
+        {"April 8, 2025", year{2025}/April/8},
+        {" apr 08,2025 ", year{2025}/April/8},
+        {"DECEMBER 31, 1999", year{1999}/December/31},
+        {"04/08/2025", year{2025}/April/8},
+        {"4-8-2025", year{2025}/April/8},
+        {"2024-02-29", year{2024}/February/29},
+        {"", std::unexpected(DateParser::Error::Blank)},
+        {"   ", std::unexpected(DateParser::Error::Blank)},
+        {"2025-02-29", std::unexpected(DateParser::Error::InvalidDate)},
+        {"13/01/2025", std::unexpected(DateParser::Error::InvalidDate)},
+        {"Aprl 8, 2025", std::unexpected(DateParser::Error::UnknownFormat)},
+        {"2025-04-08x", std::unexpected(DateParser::Error::UnknownFormat)},
+        {"20250408", std::unexpected(DateParser::Error::UnknownFormat)},
+        {"04/08/25", std::unexpected(DateParser::Error::UnknownFormat)},
+        {"04/08-2025", std::unexpected(DateParser::Error::UnknownFormat)}
+    };
+
+    // One parser for all cases, the cached format must not change any result.
+    DateParser dateParser;
+    for (const auto& testCase: testCases)
+    {
+        auto date = dateParser.parse(testCase.text);
+        bool matches = date.has_value() == testCase.expected.has_value() &&
+            (date.has_value()? *date == *testCase.expected : date.error() == testCase.expected.error());
+        if (!matches)
+        {
+            std::cerr << std::format("Date parser FAILED for input [{}]\n", testCase.text);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * The times of day in the user profiles, 12 and 24 hour, and text that is not a time.
+ */
+static bool verifyTimeOfDay()
+{
+    using namespace std::chrono;
+
+    struct TimeTestCase
+    {
+        std::string_view text;
+        std::optional<minutes> expected;
+    };
+
+    const std::vector<TimeTestCase> testCases = {
+        {"8:30 AM", hours{8} + minutes{30}},
+        {"8:30 pm", hours{20} + minutes{30}},
+        {"12:00 AM", minutes{0}},
+        {"12:15PM", hours{12} + minutes{15}},
+        {"5:00 PM  ", hours{17}},
+        {"17:00", hours{17}},
+        {"0:05", minutes{5}},
+        {"8:30 Pxyz", std::nullopt},
+        {"8:30 P", std::nullopt},
+        {"8:30 PM x", std::nullopt},
+        {"8:30 AMPM", std::nullopt},
+        {"13:00 PM", std::nullopt},
+        {"24:00", std::nullopt},
+        {"8:60", std::nullopt},
+        {"8:5", std::nullopt},
+        {"", std::nullopt}
+    };
+
+    for (const auto& testCase: testCases)
+    {
+        if (parseTimeOfDay(testCase.text) != testCase.expected)
+        {
+            std::cerr << std::format("Time of day parser FAILED for input [{}]\n", testCase.text);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * The date conversion the parser replaced, one stream per call and a locale for the
+ * formats other than ISO.
+ */
+static std::chrono::year_month_day parseDateWithStream(std::string_view dateString)
+{
+    std::chrono::year_month_day dateValue{};
+
+    std::istringstream ss{std::string(dateString)};
+    ss >> std::chrono::parse("%Y-%m-%d", dateValue);
+    if (!ss.fail())
+    {
+        return dateValue;
+    }
+
+    std::locale usEnglish("en_US.UTF-8");
+    std::vector<std::string> legalFormats = {{"%B %d, %Y"}, {"%m/%d/%Y"}, {"%m-%d-%Y"}};
+    ss.imbue(usEnglish);
+    for (auto legalFormat: legalFormats)
+    {
+        ss.clear();
+        ss.seekg(0);
+        ss >> std::chrono::parse(legalFormat, dateValue);
+        if (!ss.fail())
+        {
+            return dateValue;
+        }
+    }
+
+    return dateValue;
+}
+
+static void benchmarkDateParser(std::size_t rowCount)
+{
+    rowCount = std::min<std::size_t>(rowCount, 1'000'000);
+    std::mt19937_64 generator(20250804);
+    std::uniform_int_distribution<CompactDate::DayNumber> dayDistribution(
+        CompactDate(std::chrono::year{2000}/1/1).getDayNumber(), CompactDate(std::chrono::year{2030}/12/31).getDayNumber());
+
+    // Four columns, one per format, the way a file exported by another tool might look.
+    std::vector<std::string> dates;
+    dates.reserve(rowCount);
+    for (std::size_t row = 0; row < rowCount; ++row)
+    {
+        std::chrono::year_month_day date = CompactDate(dayDistribution(generator)).toYearMonthDay();
+        switch (row % 4)
+        {
+            case 0: dates.push_back(std::format("{:%Y-%m-%d}", date)); break;
+            case 1: dates.push_back(std::format("{:%B} {}, {}", date.month(), static_cast<unsigned int>(date.day()),
+                static_cast<int>(date.year()))); break;
+            case 2: dates.push_back(std::format("{:%m/%d/%Y}", date)); break;
+            default: dates.push_back(std::format("{:%m-%d-%Y}", date)); break;
+        }
+    }
+
+    std::cout << std::format("Date parsing of {} dates in 4 formats, fastest of {} runs\n", rowCount, repetitions);
+
+    reportBenchmark("std::chrono::parse with istringstream", rowCount,
+        [&dates]()
+        {
+            double daySum = 0.0;
+            for (const auto& date: dates)
+            {
+                daySum += CompactDate(parseDateWithStream(date)).getDayNumber();
+            }
+            return daySum;
+        });
+    reportBenchmark("DateParser, one per column", rowCount,
+        [&dates]()
+        {
+            std::array<DateParser, 4> columnParsers;
+            double daySum = 0.0;
+            for (std::size_t row = 0; row < dates.size(); ++row)
+            {
+                auto date = columnParsers[row % columnParsers.size()].parse(dates[row]);
+                daySum += date.has_value()? CompactDate(*date).getDayNumber() : 0;
+            }
+            return daySum;
+        });
+}
+
+/*
+ * Parameters that go into HashedPassWord must be redacted from the query logs, the others are
+ * kept when every placeholder that uses them can be matched to another column.
+ */
+static bool verifyQueryRedaction()
+{
+    struct RedactionTestCase
+    {
+        std::string_view sql;
+        std::vector<bool> expectedRedacted;
+    };
+
+    const std::vector<RedactionTestCase> testCases = {
+        {"SELECT TaskID FROM Tasks WHERE TaskID = {}", {false}},
+        {"INSERT INTO UserProfile (LastName, FirstName, LoginName, HashedPassWord) VALUES ({}, {}, {}, {})",
+            {false, false, false, true}},
+        {"INSERT INTO UserProfile (LoginName, HashedPassWord) VALUES ({}, {}), ({}, {}), ({}, {})",
+            {false, true, false, true, false, true}},
+        {"UPDATE UserProfile SET LoginName = {}, HashedPassWord = {} WHERE UserID = {}", {false, true, false}},
+        {"UPDATE UserProfile SET HashedPassWord = {1} WHERE LoginName = {0}", {false, true}},
+        {"UPDATE UserProfile SET HashedPassWord = {0} WHERE LoginName = {0}", {true}},
+        {"SELECT UserID FROM UserProfile WHERE LoginName = {} AND HashedPassWord = {}", {false, true}},
+        {"SELECT UserID FROM UserProfile AS u WHERE u.LoginName={} AND u.HashedPassWord<>{}", {false, true}},
+        {"SELECT UserID FROM UserProfile WHERE LoginName = {} AND HashedPassWord = SHA2({}, 256)", {false, true}},
+        {"INSERT INTO `UserProfile` (`LoginName`, `HashedPassWord`) VALUES ({}, {})", {false, true}},
+        {"UPDATE UserProfile SET `HashedPassWord` = {} WHERE `UserProfile`.`LoginName` = {}", {true, false}},
+        {"SELECT '{{}}' FROM UserProfile WHERE `hashedpassword` = {} AND LoginName = {}", {true, false}}
+    };
+
+    for (const auto& testCase: testCases)
+    {
+        std::vector<bool> redacted = QueryStatistics::findRedactedParameters(testCase.sql,
+            testCase.expectedRedacted.size());
+        if (redacted != testCase.expectedRedacted)
+        {
+            std::cerr << std::format("Query redaction FAILED for [{}]\n", testCase.sql);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Seeded random edit sequences, after every edit the incremental reschedule() must produce the
+ * same schedule as a full schedule() of the edited tasks. The edits change priorities, efforts,
+ * dates, statuses and dependencies, add and remove tasks and add and remove fixed items.
+ */
+static bool verifyIncrementalReschedule()
+{
+    using namespace std::chrono;
+    using ScheduleTime = ScheduleItemModel::ScheduleTime;
+
+    constexpr unsigned int sequenceCount = 40;
+    constexpr unsigned int editsPerSequence = 25;
+    constexpr std::size_t initialTaskCount = 30;
+    constexpr int windowDays = 14;
+    const year_month_day firstDay = year{2025}/March/3;
+    const year_month_day lastDay = sys_days(firstDay) + days(windowDays - 1);
+    const TaskScheduler::WorkingHours workingHours{hours{8}, hours{17}, false};
+
+    for (unsigned int sequence = 0; sequence < sequenceCount; ++sequence)
+    {
+        std::mt19937_64 generator(20250806 + sequence);
+        auto uniform = [&generator](int low, int high)
+            { return std::uniform_int_distribution<int>(low, high)(generator); };
+        auto dayOffset = [&firstDay](int offset) { return CompactDate(sys_days(firstDay) + days(offset)); };
+
+        std::size_t nextTaskID = 1;
+        auto makeTask = [&]()
+        {
+            TaskModel_shp task = std::make_shared<TaskModel>();
+            task->setTaskID(nextTaskID++);
+            task->setStatus(static_cast<TaskModel::TaskStatus>(uniform(0, 3)));
+            task->setPriorityGroup(static_cast<unsigned int>(uniform(1, 4)));
+            task->setPriority(static_cast<unsigned int>(uniform(0, 9)));
+            task->setScheduledStart(dayOffset(uniform(-5, windowDays / 2)));
+            task->setDueDate(dayOffset(uniform(0, windowDays + 7)));
+            task->setEstimatedEffort(static_cast<unsigned int>(uniform(0, 12)));
+            task->setActualEffortToDate(uniform(0, 3) * 0.5);
+            return task;
+        };
+        auto addRandomDependency = [&](TaskList& tasks, std::size_t index)
+        {
+            // Dependencies only go to tasks with lower IDs, so the tasks never form a cycle.
+            std::size_t dependency = static_cast<std::size_t>(uniform(0, static_cast<int>(tasks.size()) - 1));
+            if (tasks[dependency]->getTaskID() < tasks[index]->getTaskID())
+            {
+                tasks[index]->addDependency(tasks[dependency]->getTaskID());
+            }
+        };
+        auto makeFixedItem = [&]()
+        {
+            ScheduleTime start = ScheduleTime(sys_days(firstDay) + days(uniform(0, windowDays - 1))) +
+                hours{uniform(7, 16)} + minutes{15 * uniform(0, 3)};
+            return ScheduleItemModel(1, start, start + minutes{30 * uniform(1, 6)},
+                ScheduleItemModel::ScheduleItemType::Meeting, "Meeting");
+        };
+
+        TaskList tasks;
+        for (std::size_t index = 0; index < initialTaskCount; ++index)
+        {
+            tasks.push_back(makeTask());
+            for (int dependency = uniform(0, 2); dependency > 0; --dependency)
+            {
+                addRandomDependency(tasks, index);
+            }
+        }
+        ScheduleItemList fixedItems;
+        for (int item = uniform(0, 6); item > 0; --item)
+        {
+            fixedItems.push_back(makeFixedItem());
+        }
+
+        TaskScheduler incremental(1, workingHours);
+        incremental.schedule(tasks, fixedItems, firstDay, lastDay);
+
+        for (unsigned int edit = 0; edit < editsPerSequence; ++edit)
+        {
+            std::size_t index = static_cast<std::size_t>(uniform(0, static_cast<int>(tasks.size()) - 1));
+            TaskModel& task = *tasks[index];
+            switch (uniform(0, 9))
+            {
+                case 0:
+                    task.setPriorityGroup(static_cast<unsigned int>(uniform(1, 4)));
+                    task.setPriority(static_cast<unsigned int>(uniform(0, 9)));
+                    break;
+                case 1: task.setEstimatedEffort(static_cast<unsigned int>(uniform(0, 12))); break;
+                case 2: task.setActualEffortToDate(uniform(0, 6) * 0.5); break;
+                case 3: task.setScheduledStart(dayOffset(uniform(-5, windowDays))); break;
+                case 4: task.setDueDate(dayOffset(uniform(0, windowDays + 7))); break;
+                case 5: task.setStatus(static_cast<TaskModel::TaskStatus>(uniform(0, 4))); break;
+                case 6:
+                    if (!task.getDependencies().empty() && uniform(0, 1) == 0)
+                    {
+                        task.removeDependency(task.getDependencies().front());
+                    }
+                    else
+                    {
+                        addRandomDependency(tasks, index);
+                    }
+                    break;
+                case 7:
+                    tasks.push_back(makeTask());
+                    addRandomDependency(tasks, tasks.size() - 1);
+                    break;
+                case 8:
+                    if (tasks.size() > 1)
+                    {
+                        tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(index));
+                    }
+                    break;
+                default:
+                    if (!fixedItems.empty() && uniform(0, 1) == 0)
+                    {
+                        fixedItems.erase(fixedItems.begin() + uniform(0, static_cast<int>(fixedItems.size()) - 1));
+                    }
+                    else
+                    {
+                        fixedItems.push_back(makeFixedItem());
+                    }
+                    break;
+            }
+
+            TaskScheduler full(1, workingHours);
+            TaskScheduler::ScheduleResult expected = full.schedule(tasks, fixedItems, firstDay, lastDay);
+            TaskScheduler::ScheduleResult result = incremental.reschedule(tasks, fixedItems, firstDay, lastDay);
+            if (result.taskExecutionItems != expected.taskExecutionItems ||
+                result.unscheduledTaskIDs != expected.unscheduledTaskIDs)
+            {
+                std::cerr << std::format("Incremental reschedule FAILED for sequence {} after edit {}, {} items"
+                    " instead of {}\n", sequence, edit, result.taskExecutionItems.size(),
+                    expected.taskExecutionItems.size());
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Titles of schedule items are cut to MaxTitleLength bytes without splitting a UTF-8 character.
+ * The two byte character in the first description straddles the limit and is dropped, the one
+ * in the second description ends right at the limit and is kept.
+ */
+static bool verifyTitleTruncation()
+{
+    using namespace std::chrono;
+
+    const year_month_day firstDay = year{2025}/March/3;
+    const std::string straddling = std::string(TaskScheduler::MaxTitleLength - 1, 'a') + "\u00e9 tail";
+    const std::string ending = std::string(TaskScheduler::MaxTitleLength - 2, 'b') + "\u00e9 tail";
+
+    TaskList tasks;
+    for (const auto& description: {straddling, ending})
+    {
+        TaskModel_shp task = std::make_shared<TaskModel>();
+        task->setTaskID(tasks.size() + 1);
+        task->setDescription(description);
+        task->setScheduledStart(CompactDate(firstDay));
+        task->setDueDate(CompactDate(firstDay));
+        task->setEstimatedEffort(1);
+        tasks.push_back(task);
+    }
+
+    TaskScheduler scheduler(1, TaskScheduler::WorkingHours{hours{8}, hours{17}, false});
+    TaskScheduler::ScheduleResult result = scheduler.schedule(tasks, {}, firstDay, firstDay);
+    if (result.taskExecutionItems.size() != 2 ||
+        result.taskExecutionItems[0].getTitle() != straddling.substr(0, TaskScheduler::MaxTitleLength - 1) ||
+        result.taskExecutionItems[1].getTitle() != ending.substr(0, TaskScheduler::MaxTitleLength))
+    {
+        std::cerr << std::format("Title truncation FAILED, {} items\n", result.taskExecutionItems.size());
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * A hand checked graph. Task 20 and 30 depend on 10 and 40 depends on 20 and 30, 50 stands
+ * alone. Efforts are 2, 3, 4, 1 and 5 hours, so the critical path is 10, 30, 40 and takes
+ * 7 hours. Making 50 depend on 40 and then dropping the dependency of 40 on 30 goes through the
+ * edit overlay and moves the critical path to 10, 20, 40, 50.
+ */
+static bool verifyTaskGraph()
+{
+    auto fail = [](std::string_view what)
+    {
+        std::cerr << std::format("TaskGraph FAILED: {}\n", what);
+        return false;
+    };
+
+    TaskGraph graph({10, 20, 30, 40, 50}, {2, 3, 4, 1, 5}, {{20, 10}, {30, 10}, {40, 20}, {40, 30}, {40, 99}});
+    if (graph.nodeCount() != 5 || graph.edgeCount() != 4 || graph.ignoredEdgeCount() != 1)
+    {
+        return fail("node, edge or ignored edge count");
+    }
+
+    auto order = graph.topologicalOrder();
+    if (!order.has_value() || order->size() != 5 || graph.hasCycle())
+    {
+        return fail("no topological order for an acyclic graph");
+    }
+    auto position = [&order](std::size_t taskID) { return std::ranges::find(*order, taskID) - order->begin(); };
+    if (position(10) > position(20) || position(10) > position(30) || position(20) > position(40) ||
+        position(30) > position(40))
+    {
+        return fail("a task is ordered before one of its dependencies");
+    }
+
+    if (graph.getProjectDuration() != 7.0 || graph.getEarliestStart(40) != 6.0 || graph.getLatestStart(20) != 3.0 ||
+        graph.getSlack(20) != 1.0 || graph.getSlack(50) != 2.0 ||
+        graph.getCriticalPath() != std::vector<std::size_t>{10, 30, 40})
+    {
+        return fail("critical path method");
+    }
+
+    if (graph.addEdge(10, 40) || graph.hasCycle())
+    {
+        return fail("an edge that closes a cycle was accepted");
+    }
+
+    if (!graph.addEdge(50, 40) || !graph.removeEdge(40, 30) || graph.edgeCount() != 4)
+    {
+        return fail("editing edges");
+    }
+    if (graph.getProjectDuration() != 11.0 || graph.getEarliestStart(50) != 6.0 || graph.getSlack(30) != 5.0 ||
+        graph.getCriticalPath() != std::vector<std::size_t>{10, 20, 40, 50})
+    {
+        return fail("critical path method after editing edges");
+    }
+
+    // Tasks 1, 2 and 3 depend on each other in a circle, 4 depends on the circle.
+    TaskGraph cyclicGraph({1, 2, 3, 4, 5}, {1, 1, 1, 1, 1}, {{2, 1}, {3, 2}, {1, 3}, {4, 3}});
+    std::vector<std::size_t> cycle = cyclicGraph.findCycle();
+    std::ranges::sort(cycle);
+    if (!cyclicGraph.hasCycle() || cyclicGraph.topologicalOrder().has_value() || cyclicGraph.computeSchedule() ||
+        cycle != std::vector<std::size_t>{1, 2, 3})
+    {
+        return fail("cycle detection");
+    }
+
+    if (!cyclicGraph.removeEdge(1, 3) || cyclicGraph.hasCycle() || cyclicGraph.getProjectDuration() != 4.0)
+    {
+        return fail("removing the edge that closes the cycle");
+    }
+
+    return true;
+}
+
+/*
+ * Every task depends on up to 2 of the 1000 tasks before it, the way the tasks of a project
+ * are close together.
+ */
+static void benchmarkTaskGraph(std::size_t rowCount)
+{
+    rowCount = std::min<std::size_t>(rowCount, 1'000'000);
+    std::mt19937_64 generator(20250805);
+    std::uniform_int_distribution<unsigned int> effortDistribution(1, 40);
+    std::uniform_int_distribution<std::size_t> dependencyDistribution(1, 1000);
+
+    std::vector<std::size_t> taskIDs(rowCount);
+    std::vector<unsigned int> effortHours(rowCount);
+    std::vector<TaskGraph::Edge> edges;
+    edges.reserve(rowCount * 2);
+    for (std::size_t row = 0; row < rowCount; ++row)
+    {
+        taskIDs[row] = row + 1;
+        effortHours[row] = effortDistribution(generator);
+        for (unsigned int dependency = 0; dependency < 2; ++dependency)
+        {
+            std::size_t distance = dependencyDistribution(generator);
+            if (distance <= row)
+            {
+                edges.push_back({row + 1, row + 1 - distance});
+            }
+        }
+    }
+
+    std::cout << std::format("TaskGraph of {} tasks and {} dependencies, fastest of {} runs\n", rowCount, edges.size(),
+        repetitions);
+
+    reportBenchmark("build CSR graph", rowCount,
+        [&]()
+        {
+            TaskGraph graph(taskIDs, effortHours, edges);
+            return static_cast<double>(graph.edgeCount());
+        });
+    reportBenchmark("build, topological order and schedule", rowCount,
+        [&]()
+        {
+            TaskGraph graph(taskIDs, effortHours, edges);
+            return graph.getProjectDuration();
+        });
+
+    TaskGraph graph(taskIDs, effortHours, edges);
+    unsigned int effortChange = 0;
+    reportBenchmark("schedule after an effort change", rowCount,
+        [&]()
+        {
+            ++effortChange;
+            graph.setEffort(taskIDs[effortChange % taskIDs.size()], effortChange % 40 + 1);
+            return graph.getProjectDuration();
+        });
+}
+
+int main(int argc, char* argv[])
+{
+#ifndef NDEBUG
+    std::clog << "Benchmarks were built without NDEBUG, configure with -DCMAKE_BUILD_TYPE=Release for useful numbers.\n";
+#endif
+
+    std::size_t rowCount = argc > 1? std::strtoull(argv[1], nullptr, 10) : defaultRowCount;
+    if (rowCount == 0)
+    {
+        std::cerr << std::format("Usage: {} [rowCount]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!verifyTaskAggregator() || !verifyDateKernels() || !verifyCSVParser() || !verifyCSVChunks() ||
+        !verifyDateParser() || !verifyTimeOfDay() || !verifyQueryRedaction() || !verifyIncrementalReschedule() ||
+        !verifyTitleTruncation() || !verifyTaskGraph())
+    {
+        return EXIT_FAILURE;
+    }
+
+    benchmarkTaskAggregator(rowCount);
+    benchmarkDateKernels(rowCount);
+    benchmarkCSVParser(rowCount);
+    benchmarkDateParser(rowCount);
+    benchmarkTaskGraph(rowCount);
+
+    return EXIT_SUCCESS;
+}